@@ -0,0 +1,87 @@
+import argparse
+import glob
+import os
+import sys
+
+# Columns written by duckstation-regtest -hashinterval, after the frame number.
+HASH_COLUMNS = ["display", "audio", "ram", "state"]
+
+
+def find_hash_log(path):
+    # Accept either the log itself, or the dump directory the runner wrote it to (dumpdir/<game title>/hashes.txt).
+    if os.path.isfile(path):
+        return path
+
+    for candidate in [os.path.join(path, "hashes.txt")] + sorted(glob.glob(os.path.join(path, "*", "hashes.txt"))):
+        if os.path.isfile(candidate):
+            return candidate
+
+    raise FileNotFoundError("No hash log found in '%s'" % path)
+
+
+def load_hash_log(path):
+    hashes = {}
+    with open(find_hash_log(path), "r") as f:
+        for line in f:
+            if line.startswith("#"):
+                continue
+
+            fields = line.split()
+            if len(fields) != len(HASH_COLUMNS) + 1:
+                continue
+
+            hashes[int(fields[0])] = dict(zip(HASH_COLUMNS, fields[1:]))
+
+    return hashes
+
+
+def find_first_divergence(base_hashes, test_hashes, columns=HASH_COLUMNS):
+    # Returns (frame, [differing columns]), or None if every frame present in both logs matches.
+    for frame in sorted(set(base_hashes.keys()) & set(test_hashes.keys())):
+        differ = [c for c in columns if base_hashes[frame][c] != test_hashes[frame][c]]
+        if differ:
+            return frame, differ
+
+    return None
+
+
+def compare_regtest_hashes(base_path, test_path, columns=HASH_COLUMNS):
+    base_hashes = load_hash_log(base_path)
+    test_hashes = load_hash_log(test_path)
+
+    missing = sorted(set(base_hashes.keys()) - set(test_hashes.keys()))
+    if missing:
+        print("%u frames missing from test log, first is %u" % (len(missing), missing[0]))
+
+    divergence = find_first_divergence(base_hashes, test_hashes, columns)
+    if divergence is None:
+        print("%u frames compared, no differences" % len(set(base_hashes.keys()) & set(test_hashes.keys())))
+        return not missing
+
+    frame, differ = divergence
+    print("First divergence at frame %u in %s" % (frame, ", ".join(differ)))
+    for column in differ:
+        print("  %-8s %s != %s" % (column, base_hashes[frame][column], test_hashes[frame][column]))
+
+    return False
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Find the first frame where two regression test hash logs differ")
+    parser.add_argument("base", action="store", help="Hash log or dump directory of the baseline run")
+    parser.add_argument("test", action="store", help="Hash log or dump directory of the run to check")
+    parser.add_argument("-columns", action="store", default=",".join(HASH_COLUMNS),
+                        help="Comma separated columns to compare. Runs with -frameskip only match in audio,ram, "
+                             "since skipped frames leave the display and the VRAM in save states stale")
+
+    args = parser.parse_args()
+    columns = [c.strip() for c in args.columns.split(",") if c.strip()]
+    unknown = [c for c in columns if c not in HASH_COLUMNS]
+    if unknown or not columns:
+        print("Unknown columns: %s, expected some of %s" % (", ".join(unknown), ", ".join(HASH_COLUMNS)))
+        sys.exit(1)
+
+    if not compare_regtest_hashes(args.base, args.test, columns):
+        sys.exit(1)
+    else:
+        sys.exit(0)
@@ -0,0 +1,102 @@
+import argparse
+import os
+import struct
+import subprocess
+import sys
+import multiprocessing
+from functools import partial
+
+
+def get_movie_frame_count(movie):
+    with open(movie, "rb") as f:
+        magic, version, start_frame, frame_count, event_count = struct.unpack("<5I", f.read(20))
+        if magic != 0x564F4D44:
+            raise ValueError("'%s' is not an input movie" % movie)
+
+        return frame_count
+
+
+def run_runner(runner, movie, game, args):
+    # -movie must come first, so that the remaining arguments override the recorded settings.
+    args = [runner, "-log", "error", "-movie", movie] + args + ["--", game]
+    print("Running '%s'" % (" ".join(args)))
+    return subprocess.run(args).returncode == 0
+
+
+def render_chunk(runner, movie, game, chunk_frames, cargs, chunk):
+    start_frame, path = chunk
+    return run_runner(runner, movie, game, ["-moviestart", str(start_frame), "-frames", str(chunk_frames),
+                                            "-capture", path] + cargs)
+
+
+def render_input_movie(runner, movie, game, output, chunk_frames, parallel, ffmpeg, audio_codec, cargs):
+    frame_count = get_movie_frame_count(movie)
+    if frame_count == 0:
+        print("Movie is empty")
+        return False
+
+    # Play the whole movie once without capturing, saving keyframes where each chunk starts. The keyframes must come
+    # from the same renderer and resolution as the chunks, since the state they contain differs between renderers.
+    print("Generating keyframes for %u frames every %u frames" % (frame_count, chunk_frames))
+    if not run_runner(runner, movie, game, ["-moviekeyframes", str(chunk_frames)] + cargs):
+        print("Failed to generate keyframes")
+        return False
+
+    base, ext = os.path.splitext(output)
+    chunks = [(start, "%s.part%05u%s" % (base, start // chunk_frames, ext))
+              for start in range(0, frame_count, chunk_frames)]
+
+    print("Rendering %u chunks on %u processors" % (len(chunks), parallel))
+    func = partial(render_chunk, runner, movie, game, chunk_frames, cargs)
+    pool = multiprocessing.Pool(parallel)
+    results = pool.map(func, chunks, chunksize=1)
+    pool.close()
+    if not all(results):
+        print("Failed to render one or more chunks")
+        return False
+
+    list_path = base + ".parts.txt"
+    with open(list_path, "w") as f:
+        for _, path in chunks:
+            f.write("file '%s'\n" % os.path.realpath(path).replace("'", "'\\''"))
+
+    # Video frames line up exactly at chunk boundaries, so they can be copied. Each chunk's audio starts and ends on
+    # a partial encoder frame with its own priming samples, so copying it leaves audible gaps at every join. The audio
+    # is decoded and encoded again as one continuous stream instead.
+    print("Concatenating %u chunks to '%s'" % (len(chunks), output))
+    if subprocess.run([ffmpeg, "-y", "-f", "concat", "-safe", "0", "-i", list_path, "-c:v", "copy", "-c:a", audio_codec,
+                       output]).returncode != 0:
+        print("Failed to concatenate chunks")
+        return False
+
+    os.remove(list_path)
+    for _, path in chunks:
+        os.remove(path)
+
+    return True
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Render an input movie to video, encoding chunks in parallel")
+    parser.add_argument("-runner", action="store", required=True, help="Path to DuckStation regression test runner")
+    parser.add_argument("-movie", action="store", required=True, help="Input movie to render")
+    parser.add_argument("-game", action="store", required=True, help="Game image the movie was recorded with")
+    parser.add_argument("-output", action="store", required=True, help="Video file to write")
+    parser.add_argument("-chunkframes", action="store", type=int, default=3600, help="Number of frames per chunk")
+    parser.add_argument("-parallel", action="store", type=int, default=multiprocessing.cpu_count(), help="Number of processes to run")
+    parser.add_argument("-renderer", action="store", type=str, help="Renderer to use")
+    parser.add_argument("-upscale", action="store", type=int, help="Upscale multiplier")
+    parser.add_argument("-ffmpeg", action="store", default="ffmpeg", help="Path to ffmpeg, used to join the chunks")
+    parser.add_argument("-audiocodec", action="store", default="aac", help="Codec to re-encode the joined audio with")
+
+    args = parser.parse_args()
+    cargs = []
+    if (args.renderer is not None):
+        cargs += ["-renderer", args.renderer]
+    if (args.upscale is not None):
+        cargs += ["-upscale", str(args.upscale)]
+
+    if not render_input_movie(args.runner, os.path.realpath(args.movie), os.path.realpath(args.game), os.path.realpath(args.output), args.chunkframes, args.parallel, args.ffmpeg, args.audiocodec, cargs):
+        sys.exit(1)
+    else:
+        sys.exit(0)
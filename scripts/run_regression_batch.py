@@ -0,0 +1,232 @@
+import argparse
+import glob
+import hashlib
+import json
+import os
+import queue
+import re
+import subprocess
+import sys
+import time
+import multiprocessing
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+from compare_regtest_hashes import load_hash_log, find_first_divergence
+
+# Example manifest. Game paths are relative to the manifest, any key can be set per-run or in "defaults".
+# Setting "hashinterval" records hashes of the display, audio, RAM and save state, and setting "dumpinterval" to 0
+# skips the PNG dumps, which are much slower to write.
+# {
+#   "defaults": { "frames": 3600, "dumpinterval": 600, "hashinterval": 1, "renderer": "Software", "args": [] },
+#   "runs": [
+#     { "name": "ridge-racer", "game": "games/Ridge Racer (USA).chd" },
+#     { "name": "ridge-racer-pgxp", "game": "games/Ridge Racer (USA).chd", "args": ["-pgxp"] }
+#   ]
+# }
+
+DEFAULT_RUN = {"frames": 36000, "dumpinterval": 600, "hashinterval": 0, "renderer": "Software", "args": [],
+               "timeout": None}
+
+
+def load_manifest(path):
+    with open(path, "r") as f:
+        manifest = json.load(f)
+
+    basedir = os.path.dirname(os.path.realpath(path))
+    defaults = dict(DEFAULT_RUN)
+    defaults.update(manifest.get("defaults", {}))
+
+    runs = []
+    names = set()
+    for entry in manifest["runs"]:
+        run = dict(defaults)
+        run.update(entry)
+        run["game"] = os.path.join(basedir, run["game"])
+        if "name" not in run:
+            run["name"] = Path(run["game"]).stem
+        if run["name"] in names:
+            raise ValueError("Duplicate run name '%s' in manifest" % run["name"])
+
+        names.add(run["name"])
+        runs.append(run)
+
+    return runs
+
+
+def get_cpu_list():
+    if hasattr(os, "sched_getaffinity"):
+        return sorted(os.sched_getaffinity(0))
+    else:
+        return list(range(multiprocessing.cpu_count()))
+
+
+def hash_frames(rundir):
+    # The runner dumps to rundir/<game title>/frame_NNNNN.png.
+    frames = {}
+    for path in glob.glob(os.path.join(rundir, "*", "frame_*.png")):
+        matches = re.match("frame_([0-9]+).png", Path(path).name)
+        if matches is None:
+            continue
+
+        with open(path, "rb") as f:
+            frames[str(int(matches[1]))] = hashlib.md5(f.read()).hexdigest()
+
+    return frames
+
+
+def run_one(runner, destdir, cpus, run):
+    rundir = os.path.join(destdir, run["name"])
+    os.makedirs(rundir, exist_ok=True)
+
+    # Don't let frames from an earlier batch in the same directory count towards this one.
+    for path in glob.glob(os.path.join(rundir, "*", "frame_*.png")) + glob.glob(os.path.join(rundir, "*", "hashes.txt")):
+        os.remove(path)
+
+    args = [runner,
+            "-log", "error",
+            "-dumpdir", rundir,
+            "-frames", str(run["frames"]),
+            "-renderer", run["renderer"],
+    ]
+    if run["dumpinterval"] > 0:
+        args += ["-dumpinterval", str(run["dumpinterval"])]
+    if run["hashinterval"] > 0:
+        args += ["-hashinterval", str(run["hashinterval"])]
+    args += run["args"]
+    args += ["--", run["game"]]
+
+    # Each process is pinned to its own core, so runs don't migrate and disturb each other's timings. The affinity is
+    # set from here rather than with preexec_fn, which isn't safe to use when the parent has multiple threads.
+    cpu = cpus.get()
+
+    print("Running '%s' on CPU %u" % (run["name"], cpu))
+    start_time = time.monotonic()
+    try:
+        proc = subprocess.Popen(args)
+        if hasattr(os, "sched_setaffinity"):
+            try:
+                os.sched_setaffinity(proc.pid, {cpu})
+            except OSError:
+                # Already exited.
+                pass
+
+        try:
+            status = "ok" if proc.wait(timeout=run["timeout"]) == 0 else "failed"
+        except subprocess.TimeoutExpired:
+            proc.kill()
+            proc.wait()
+            status = "timeout"
+    finally:
+        cpus.put(cpu)
+
+    elapsed = time.monotonic() - start_time
+    print("Finished '%s' in %.2f seconds: %s" % (run["name"], elapsed, status))
+    result = {"name": run["name"], "game": run["game"], "status": status, "time": elapsed,
+              "frames": hash_frames(rundir)}
+    if run["hashinterval"] > 0 and status == "ok":
+        result["hashes"] = {str(f): h for f, h in load_hash_log(rundir).items()}
+    return result
+
+
+def compare_to_baseline(result, baseline):
+    if result["status"] != "ok":
+        return False, "runner %s" % result["status"]
+    if baseline is None:
+        return True, "no baseline"
+
+    base_frames = baseline["frames"]
+    test_frames = result["frames"]
+    missing = sorted(int(f) for f in base_frames if f not in test_frames)
+    differ = sorted(int(f) for f in base_frames if f in test_frames and base_frames[f] != test_frames[f])
+    result["missing_frames"] = missing
+    result["differing_frames"] = differ
+
+    details = "%+.2fs vs baseline" % (result["time"] - baseline["time"])
+    if missing:
+        details += ", missing frames [%s]" % ",".join(map(str, missing))
+    if differ:
+        details += ", differences in frames [%s]" % ",".join(map(str, differ))
+
+    hashes_match = True
+    if "hashes" in baseline:
+        base_hashes = {int(f): h for f, h in baseline["hashes"].items()}
+        test_hashes = {int(f): h for f, h in result.get("hashes", {}).items()}
+        missing_hashes = len([f for f in base_hashes if f not in test_hashes])
+        if missing_hashes > 0:
+            details += ", %u hashed frames missing" % missing_hashes
+            hashes_match = False
+
+        divergence = find_first_divergence(base_hashes, test_hashes)
+        if divergence is not None:
+            result["first_divergence"] = {"frame": divergence[0], "differs": divergence[1]}
+            details += ", first divergence at frame %u in %s" % (divergence[0], ",".join(divergence[1]))
+            hashes_match = False
+
+    return (not missing and not differ and hashes_match), details
+
+
+def run_regression_batch(runner, manifest, destdir, parallel, baseline_path):
+    runs = load_manifest(manifest)
+    os.makedirs(destdir, exist_ok=True)
+
+    baseline = {}
+    if baseline_path is not None:
+        with open(baseline_path, "r") as f:
+            baseline = {r["name"]: r for r in json.load(f)["runs"]}
+
+    cpus = queue.Queue()
+    cpu_list = get_cpu_list()
+    parallel = min(parallel, len(cpu_list))
+    for cpu in cpu_list[:parallel]:
+        cpus.put(cpu)
+
+    # Start the longest runs first, so a long game doesn't end up running alone at the end.
+    runs.sort(key=lambda r: r["frames"], reverse=True)
+
+    print("Processing %u runs on %u processors" % (len(runs), parallel))
+    start_time = time.monotonic()
+    with ThreadPoolExecutor(max_workers=parallel) as pool:
+        results = list(pool.map(lambda r: run_one(runner, destdir, cpus, r), runs))
+    total_time = time.monotonic() - start_time
+
+    # Runs which were in the baseline but have been dropped from the manifest would otherwise go unnoticed.
+    run_names = set(r["name"] for r in results)
+    for name in sorted(n for n in baseline if n not in run_names):
+        results.append({"name": name, "game": baseline[name]["game"], "status": "missing", "time": 0.0, "frames": {}})
+
+    passed = 0
+    results.sort(key=lambda r: r["name"])
+    for result in results:
+        if result["status"] == "missing":
+            result["passed"], details = False, "in baseline but not in manifest"
+        else:
+            result["passed"], details = compare_to_baseline(result, baseline.get(result["name"]))
+        passed += int(result["passed"])
+        print("%s %-40s %8.2fs  %s" % ("PASS" if result["passed"] else "FAIL", result["name"], result["time"],
+                                       details))
+
+    report_path = os.path.join(destdir, "report.json")
+    with open(report_path, "w") as f:
+        json.dump({"runner": runner, "total_time": total_time, "runs": results}, f, indent=2)
+
+    print("%u/%u runs passed in %.2f seconds, report written to '%s'" % (passed, len(results), total_time,
+                                                                          report_path))
+    return passed == len(results)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Run a manifest of regression tests in parallel and report results")
+    parser.add_argument("-runner", action="store", required=True, help="Path to DuckStation regression test runner")
+    parser.add_argument("-manifest", action="store", required=True, help="JSON manifest of games and settings to run")
+    parser.add_argument("-destdir", action="store", required=True, help="Base directory to dump frames and report to")
+    parser.add_argument("-parallel", action="store", type=int, default=multiprocessing.cpu_count(), help="Number of processes to run")
+    parser.add_argument("-baseline", action="store", help="Report from a previous run to compare frame hashes against")
+
+    args = parser.parse_args()
+
+    if not run_regression_batch(os.path.realpath(args.runner), args.manifest, os.path.realpath(args.destdir),
+                                args.parallel, args.baseline):
+        sys.exit(1)
+    else:
+        sys.exit(0)
@@ -70,6 +70,7 @@ if __name__ == "__main__":
     parser.add_argument("-pgxp", action="store_true", help="Enable PGXP")
     parser.add_argument("-pgxpcpu", action="store_true", help="Enable PGXP CPU mode")
     parser.add_argument("-cpu", action="store", help="CPU execution mode")
+    parser.add_argument("-frameskip", action="store", type=int, help="Fast forward frame skip interval")
 
     args = parser.parse_args()
     cargs = []
@@ -81,6 +82,8 @@ if __name__ == "__main__":
         cargs += ["-pgxp-cpu"]
     if (args.cpu is not None):
         cargs += ["-cpu", args.cpu]
+    if (args.frameskip is not None):
+        cargs += ["-frameskip", str(args.frameskip)]
 
     if not run_regression_tests(args.runner, os.path.realpath(args.gamedir), os.path.realpath(args.destdir), args.dumpinterval, args.frames, args.parallel, args.renderer, cargs):
         sys.exit(1)
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "common/log.h"
+#include "common/string_util.h"
+#include "common/types.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+struct CapturedMessages
+{
+  std::mutex mutex;
+  std::vector<std::pair<std::string, std::string>> messages; // channel,message
+};
+
+static void CaptureLogCallback(void* pUserParam, const char* channelName, const char* functionName, LOGLEVEL level,
+                               std::string_view message)
+{
+  CapturedMessages* captured = static_cast<CapturedMessages*>(pUserParam);
+  std::unique_lock lock(captured->mutex);
+  captured->messages.emplace_back(channelName, message);
+}
+} // namespace
+
+TEST(Log, AsyncPreservesPerThreadOrder)
+{
+  static constexpr u32 NUM_THREADS = 4;
+  static constexpr u32 NUM_MESSAGES = 500;
+
+  CapturedMessages captured;
+  Log::RegisterCallback(&CaptureLogCallback, &captured);
+  Log::SetAsyncLogging(true);
+
+  std::vector<std::thread> threads;
+  for (u32 i = 0; i < NUM_THREADS; i++)
+  {
+    threads.emplace_back([i]() {
+      for (u32 j = 0; j < NUM_MESSAGES; j++)
+        Log::FastWrite("LogTest", LOGLEVEL_INFO, "{} {}", i, j);
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  Log::SetAsyncLogging(false);
+  Log::UnregisterCallback(&CaptureLogCallback, &captured);
+
+  u32 next_message[NUM_THREADS] = {};
+  for (const auto& [channel, message] : captured.messages)
+  {
+    ASSERT_EQ(channel, "LogTest");
+
+    const std::vector<std::string_view> parts = StringUtil::SplitString(message, ' ');
+    ASSERT_EQ(parts.size(), 2u);
+    const u32 thread = StringUtil::FromChars<u32>(parts[0]).value_or(NUM_THREADS);
+    ASSERT_LT(thread, NUM_THREADS);
+    ASSERT_EQ(StringUtil::FromChars<u32>(parts[1]), next_message[thread]);
+    next_message[thread]++;
+  }
+
+  for (u32 i = 0; i < NUM_THREADS; i++)
+    ASSERT_EQ(next_message[i], NUM_MESSAGES);
+}
+
+TEST(Log, AsyncCountsDroppedMessages)
+{
+  static constexpr u32 NUM_MESSAGES = 20000;
+
+  CapturedMessages captured;
+  Log::RegisterCallback(&CaptureLogCallback, &captured);
+  Log::SetAsyncLogging(true);
+
+  // Each message is large enough that the buffer fills up faster than it is drained.
+  const std::string padding(200, 'x');
+  std::thread thread([&padding]() {
+    for (u32 i = 0; i < NUM_MESSAGES; i++)
+      Log::FastWrite("LogTest", LOGLEVEL_INFO, "{} {}", i, padding);
+  });
+  thread.join();
+
+  Log::SetAsyncLogging(false);
+  Log::UnregisterCallback(&CaptureLogCallback, &captured);
+
+  u32 received = 0;
+  u32 dropped = 0;
+  for (const auto& [channel, message] : captured.messages)
+  {
+    if (channel == "Log")
+      dropped += StringUtil::FromChars<u32>(message.substr(0, message.find(' '))).value_or(0);
+    else
+      received++;
+  }
+
+  ASSERT_GT(received, 0u);
+  ASSERT_EQ(received + dropped, NUM_MESSAGES);
+}
+
+TEST(Log, AsyncDisableWhileWritingLosesNothing)
+{
+  static constexpr u32 NUM_THREADS = 4;
+  static constexpr u32 NUM_MESSAGES = 20000;
+
+  CapturedMessages captured;
+  Log::RegisterCallback(&CaptureLogCallback, &captured);
+  Log::SetAsyncLogging(true);
+
+  // Keep writing while async logging is switched off, so that some writers race with the final drain.
+  std::atomic_bool started{false};
+  std::vector<std::thread> threads;
+  for (u32 i = 0; i < NUM_THREADS; i++)
+  {
+    threads.emplace_back([i, &started]() {
+      for (u32 j = 0; j < NUM_MESSAGES; j++)
+      {
+        Log::FastWrite("LogTest", LOGLEVEL_INFO, "{} {}", i, j);
+        started.store(true, std::memory_order_relaxed);
+      }
+    });
+  }
+  while (!started.load(std::memory_order_relaxed))
+    std::this_thread::yield();
+
+  Log::SetAsyncLogging(false);
+  for (std::thread& thread : threads)
+    thread.join();
+  Log::UnregisterCallback(&CaptureLogCallback, &captured);
+
+  u32 received = 0;
+  u32 dropped = 0;
+  for (const auto& [channel, message] : captured.messages)
+  {
+    if (channel == "Log")
+      dropped += StringUtil::FromChars<u32>(message.substr(0, message.find(' '))).value_or(0);
+    else
+      received++;
+  }
+
+  ASSERT_EQ(received + dropped, NUM_THREADS * NUM_MESSAGES);
+}
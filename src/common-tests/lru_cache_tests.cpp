@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "common/lru_cache.h"
+#include "common/types.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+TEST(LRUCache, EvictsLeastRecentlyUsed)
+{
+  LRUCache<u32, u32> cache(3);
+  cache.Insert(1, 10);
+  cache.Insert(2, 20);
+  cache.Insert(3, 30);
+
+  // touching 1 makes 2 the oldest
+  ASSERT_NE(cache.Lookup(1u), nullptr);
+  cache.Insert(4, 40);
+
+  ASSERT_EQ(cache.GetSize(), 3u);
+  ASSERT_EQ(cache.Lookup(2u), nullptr);
+  ASSERT_EQ(*cache.Lookup(1u), 10u);
+  ASSERT_EQ(*cache.Lookup(3u), 30u);
+  ASSERT_EQ(*cache.Lookup(4u), 40u);
+}
+
+TEST(LRUCache, ReplaceExistingKey)
+{
+  LRUCache<std::string, u32> cache(2);
+  cache.Insert("a", 1);
+  cache.Insert("b", 2);
+  cache.Insert("a", 3);
+  cache.Insert("c", 4);
+
+  ASSERT_EQ(cache.GetSize(), 2u);
+  ASSERT_EQ(*cache.Lookup("a"), 3u);
+  ASSERT_EQ(cache.Lookup("b"), nullptr);
+  ASSERT_TRUE(cache.Remove("a"));
+  ASSERT_FALSE(cache.Remove("a"));
+  ASSERT_EQ(cache.GetSize(), 1u);
+}
+
+TEST(LRUCache, CostBudget)
+{
+  LRUCache<u32, u32> cache(100);
+  cache.Insert(1, 1, 40);
+  cache.Insert(2, 2, 40);
+  ASSERT_EQ(cache.GetTotalCost(), 80u);
+
+  cache.Insert(3, 3, 30);
+  ASSERT_EQ(cache.GetTotalCost(), 70u);
+  ASSERT_EQ(cache.Lookup(1u), nullptr);
+
+  // an entry larger than the whole budget is still cached
+  cache.Insert(4, 4, 150);
+  ASSERT_EQ(cache.GetSize(), 1u);
+  ASSERT_EQ(*cache.Lookup(4u), 4u);
+
+  // growing an existing entry keeps it, but evicts everything older
+  cache.Insert(5, 5, 10);
+  cache.Insert(5, 5, 200);
+  ASSERT_EQ(cache.GetSize(), 1u);
+  ASSERT_EQ(cache.GetTotalCost(), 200u);
+
+  cache.SetMaxCapacity(300);
+  cache.Insert(6, 6, 50);
+  ASSERT_EQ(cache.GetTotalCost(), 250u);
+  cache.Clear();
+  ASSERT_EQ(cache.GetTotalCost(), 0u);
+}
+
+TEST(LRUCache, ManualEvict)
+{
+  LRUCache<u32, u32> cache(2, true);
+  cache.Insert(1, 1);
+  cache.Insert(2, 2);
+  cache.Insert(3, 3);
+
+  // nothing is evicted until asked
+  ASSERT_EQ(cache.GetSize(), 3u);
+  ASSERT_NE(cache.Lookup(1u), nullptr);
+
+  cache.ManualEvict();
+  ASSERT_EQ(cache.GetSize(), 2u);
+  ASSERT_EQ(cache.Lookup(2u), nullptr);
+}
+
+TEST(LRUCache, Statistics)
+{
+  LRUCache<u32, u32> cache(4);
+  cache.Insert(1, 1);
+  cache.Lookup(1u);
+  cache.Lookup(1u);
+  cache.Lookup(2u);
+  ASSERT_EQ(cache.GetHitCount(), 2u);
+  ASSERT_EQ(cache.GetMissCount(), 1u);
+
+  cache.ResetStatistics();
+  ASSERT_EQ(cache.GetHitCount(), 0u);
+  ASSERT_EQ(cache.GetMissCount(), 0u);
+}
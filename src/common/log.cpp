@@ -2,15 +2,23 @@
 // SPDX-License-Identifier: CC-BY-NC-ND-4.0
 
 #include "log.h"
+#include "align.h"
 #include "assert.h"
 #include "file_system.h"
 #include "small_string.h"
+#include "threading.h"
 #include "timer.h"
 
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #if defined(_WIN32)
@@ -32,6 +40,61 @@ struct RegisteredCallback
   Log::CallbackFunctionType Function;
   void* Parameter;
 };
+
+enum : u32
+{
+  ASYNC_RING_SIZE = 256 * 1024,
+  ASYNC_RING_MASK = ASYNC_RING_SIZE - 1,
+  ASYNC_RING_WAKE_THRESHOLD = ASYNC_RING_SIZE / 2,
+  ASYNC_RECORD_ALIGNMENT = 8,
+  ASYNC_MAX_MESSAGE_LENGTH = 16 * 1024,
+  ASYNC_FLUSH_INTERVAL_MS = 50,
+};
+
+// Records are written contiguously. A zero size marks the rest of the buffer as unused, and the next record is at the
+// start of the buffer.
+struct AsyncRecordHeader
+{
+  u32 size;
+  u32 message_length;
+  Common::Timer::Value timestamp;
+  const char* channel_name;
+  const char* function_name;
+  LOGLEVEL level;
+};
+static_assert((sizeof(AsyncRecordHeader) % ASYNC_RECORD_ALIGNMENT) == 0);
+
+// Single producer, single consumer. Only the owning thread advances write_pos, and only the log thread advances
+// read_pos. Positions increase monotonically and are masked when indexing the buffer.
+struct AsyncRing
+{
+  std::unique_ptr<u8[]> buffer = std::make_unique<u8[]>(ASYNC_RING_SIZE);
+  alignas(64) std::atomic<u32> write_pos{0};
+  alignas(64) std::atomic<u32> read_pos{0};
+  std::atomic<u32> dropped_messages{0};
+  std::atomic_bool owner_exited{false};
+
+  // Set by the owning thread while it is appending a record. Disabling async logging waits for this to clear before
+  // the final drain, so that nothing is appended after it.
+  std::atomic_bool writing{false};
+};
+
+struct AsyncRingOwner
+{
+  std::shared_ptr<AsyncRing> ring;
+
+  ~AsyncRingOwner()
+  {
+    if (ring)
+      ring->owner_exited.store(true, std::memory_order_release);
+  }
+};
+
+struct AsyncPendingRecord
+{
+  Common::Timer::Value timestamp;
+  const AsyncRecordHeader* header;
+};
 } // namespace
 
 static void RegisterCallback(CallbackFunctionType callbackFunction, void* pUserParam,
@@ -50,6 +113,15 @@ static void DebugOutputLogCallback(void* pUserParam, const char* channelName, co
                                    std::string_view message);
 static void FileOutputLogCallback(void* pUserParam, const char* channelName, const char* functionName, LOGLEVEL level,
                                   std::string_view message);
+static AsyncRing* GetAsyncRingForCurrentThread();
+static bool AsyncWrite(const char* channelName, const char* functionName, LOGLEVEL level, std::string_view message);
+static bool AsyncWriteFmtArgs(const char* channelName, const char* functionName, LOGLEVEL level, fmt::string_view fmt,
+                              fmt::format_args args);
+static void AsyncThreadEntryPoint();
+static void DrainAsyncRings();
+static void DrainAsyncRings(const std::unique_lock<std::mutex>& lock);
+static void StopAsyncThread();
+
 template<typename T>
 static void FormatLogMessageAndPrint(const char* channelName, const char* functionName, LOGLEVEL level,
                                      std::string_view message, bool timestamp, bool ansi_color_code, bool newline,
@@ -69,13 +141,24 @@ static std::mutex s_callback_mutex;
 static Common::Timer::Value s_start_timestamp = Common::Timer::GetCurrentValue();
 
 static std::string s_log_filter;
-static LOGLEVEL s_log_level = LOGLEVEL_TRACE;
+static std::atomic<LOGLEVEL> s_log_level{LOGLEVEL_TRACE};
 static bool s_console_output_enabled = false;
 static bool s_console_output_timestamps = true;
 static bool s_file_output_enabled = false;
 static bool s_file_output_timestamp = false;
 static bool s_debug_output_enabled = false;
 
+static std::atomic_bool s_async_enabled{false};
+static std::mutex s_async_mutex;
+static std::condition_variable s_async_cv;
+static std::vector<std::shared_ptr<AsyncRing>> s_async_rings;
+static std::thread s_async_thread;
+static bool s_async_shutdown = false;
+static thread_local AsyncRingOwner s_async_ring_owner;
+
+// Set by the log thread while dispatching a record, so timestamps reflect when the message was written.
+static thread_local Common::Timer::Value s_dispatch_timestamp = 0;
+
 #ifdef _WIN32
 static HANDLE s_hConsoleStdIn = NULL;
 static HANDLE s_hConsoleStdOut = NULL;
@@ -90,6 +173,12 @@ std::unique_ptr<std::FILE, void (*)(std::FILE*)> s_file_handle(nullptr, [](std::
   }
 });
 
+// Declared last so the log thread is stopped before anything it uses is destroyed.
+static struct AsyncThreadStopper
+{
+  ~AsyncThreadStopper() { Log::SetAsyncLogging(false); }
+} s_async_thread_stopper;
+
 void Log::RegisterCallback(CallbackFunctionType callbackFunction, void* pUserParam)
 {
   std::unique_lock lock(s_callback_mutex);
@@ -127,7 +216,9 @@ void Log::UnregisterCallback(CallbackFunctionType callbackFunction, void* pUserP
 
 float Log::GetCurrentMessageTime()
 {
-  return static_cast<float>(Common::Timer::ConvertValueToSeconds(Common::Timer::GetCurrentValue() - s_start_timestamp));
+  const Common::Timer::Value timestamp = (s_dispatch_timestamp != 0) ? s_dispatch_timestamp :
+                                                                       Common::Timer::GetCurrentValue();
+  return static_cast<float>(Common::Timer::ConvertValueToSeconds(timestamp - s_start_timestamp));
 }
 
 bool Log::IsConsoleOutputCurrentlyAvailable()
@@ -427,9 +518,11 @@ void Log::FileOutputLogCallback(void* pUserParam, const char* channelName, const
   if (!s_file_output_enabled)
     return;
 
+  // The log thread flushes once per batch instead.
   FormatLogMessageAndPrint(channelName, functionName, level, message, true, false, true, [](std::string_view message) {
     std::fwrite(message.data(), 1, message.size(), s_file_handle.get());
-    std::fflush(s_file_handle.get());
+    if (!s_async_enabled.load(std::memory_order_relaxed))
+      std::fflush(s_file_handle.get());
   });
 }
 
@@ -463,12 +556,12 @@ void Log::SetFileOutputParams(bool enabled, const char* filename, bool timestamp
 
 LOGLEVEL Log::GetLogLevel()
 {
-  return s_log_level;
+  return s_log_level.load(std::memory_order_relaxed);
 }
 
 bool Log::IsLogVisible(LOGLEVEL level, const char* channelName)
 {
-  if (level > s_log_level)
+  if (level > s_log_level.load(std::memory_order_relaxed))
     return false;
 
   std::unique_lock lock(s_callback_mutex);
@@ -479,7 +572,7 @@ void Log::SetLogLevel(LOGLEVEL level)
 {
   std::unique_lock lock(s_callback_mutex);
   DebugAssert(level < LOGLEVEL_COUNT);
-  s_log_level = level;
+  s_log_level.store(level, std::memory_order_relaxed);
 }
 
 void Log::SetLogFilter(std::string_view filter)
@@ -492,11 +585,17 @@ void Log::SetLogFilter(std::string_view filter)
 ALWAYS_INLINE_RELEASE bool Log::FilterTest(LOGLEVEL level, const char* channelName,
                                            const std::unique_lock<std::mutex>& lock)
 {
-  return (level <= s_log_level && s_log_filter.find(channelName) == std::string::npos);
+  return (level <= s_log_level.load(std::memory_order_relaxed) && s_log_filter.find(channelName) == std::string::npos);
 }
 
 void Log::Write(const char* channelName, LOGLEVEL level, std::string_view message)
 {
+  if (s_async_enabled.load(std::memory_order_relaxed))
+  {
+    if (level > s_log_level.load(std::memory_order_relaxed) || AsyncWrite(channelName, nullptr, level, message))
+      return;
+  }
+
   std::unique_lock lock(s_callback_mutex);
   if (!FilterTest(level, channelName, lock))
     return;
@@ -506,6 +605,12 @@ void Log::Write(const char* channelName, LOGLEVEL level, std::string_view messag
 
 void Log::Write(const char* channelName, const char* functionName, LOGLEVEL level, std::string_view message)
 {
+  if (s_async_enabled.load(std::memory_order_relaxed))
+  {
+    if (level > s_log_level.load(std::memory_order_relaxed) || AsyncWrite(channelName, functionName, level, message))
+      return;
+  }
+
   std::unique_lock lock(s_callback_mutex);
   if (!FilterTest(level, channelName, lock))
     return;
@@ -515,6 +620,15 @@ void Log::Write(const char* channelName, const char* functionName, LOGLEVEL leve
 
 void Log::WriteFmtArgs(const char* channelName, LOGLEVEL level, fmt::string_view fmt, fmt::format_args args)
 {
+  if (s_async_enabled.load(std::memory_order_relaxed))
+  {
+    if (level > s_log_level.load(std::memory_order_relaxed) ||
+        AsyncWriteFmtArgs(channelName, nullptr, level, fmt, args))
+    {
+      return;
+    }
+  }
+
   std::unique_lock lock(s_callback_mutex);
   if (!FilterTest(level, channelName, lock))
     return;
@@ -528,6 +642,15 @@ void Log::WriteFmtArgs(const char* channelName, LOGLEVEL level, fmt::string_view
 void Log::WriteFmtArgs(const char* channelName, const char* functionName, LOGLEVEL level, fmt::string_view fmt,
                        fmt::format_args args)
 {
+  if (s_async_enabled.load(std::memory_order_relaxed))
+  {
+    if (level > s_log_level.load(std::memory_order_relaxed) ||
+        AsyncWriteFmtArgs(channelName, functionName, level, fmt, args))
+    {
+      return;
+    }
+  }
+
   std::unique_lock lock(s_callback_mutex);
   if (!FilterTest(level, channelName, lock))
     return;
@@ -537,3 +660,228 @@ void Log::WriteFmtArgs(const char* channelName, const char* functionName, LOGLEV
 
   ExecuteCallbacks(channelName, functionName, level, std::string_view(buffer.data(), buffer.size()), lock);
 }
+
+bool Log::IsAsyncLoggingEnabled()
+{
+  return s_async_enabled.load(std::memory_order_relaxed);
+}
+
+void Log::SetAsyncLogging(bool enabled)
+{
+  std::unique_lock lock(s_async_mutex);
+  if (s_async_enabled.load(std::memory_order_relaxed) == enabled)
+    return;
+
+  if (enabled)
+  {
+    s_async_shutdown = false;
+    s_async_thread = std::thread(&Log::AsyncThreadEntryPoint);
+    s_async_enabled.store(true, std::memory_order_release);
+  }
+  else
+  {
+    // Writers set their ring's flag before checking whether async logging is enabled, and this checks the flags after
+    // disabling it, so any writer either sees it disabled and writes synchronously, or is waited for here. A ring
+    // created after this point belongs to a writer which will see it disabled. Registering a ring needs the mutex,
+    // which is held here, but a writer never takes it while its flag is set.
+    s_async_enabled.store(false, std::memory_order_seq_cst);
+    for (const std::shared_ptr<AsyncRing>& ring : s_async_rings)
+    {
+      while (ring->writing.load(std::memory_order_seq_cst))
+        std::this_thread::yield();
+    }
+
+    // Nothing else can be appended now, so the log thread's final drain picks up everything.
+    lock.unlock();
+    StopAsyncThread();
+  }
+}
+
+void Log::StopAsyncThread()
+{
+  {
+    std::unique_lock lock(s_async_mutex);
+    s_async_shutdown = true;
+  }
+  s_async_cv.notify_one();
+  if (s_async_thread.joinable())
+    s_async_thread.join();
+}
+
+Log::AsyncRing* Log::GetAsyncRingForCurrentThread()
+{
+  AsyncRing* ring = s_async_ring_owner.ring.get();
+  if (ring) [[likely]]
+    return ring;
+
+  s_async_ring_owner.ring = std::make_shared<AsyncRing>();
+  ring = s_async_ring_owner.ring.get();
+
+  std::unique_lock lock(s_async_mutex);
+  s_async_rings.push_back(s_async_ring_owner.ring);
+  return ring;
+}
+
+bool Log::AsyncWrite(const char* channelName, const char* functionName, LOGLEVEL level, std::string_view message)
+{
+  AsyncRing* ring = GetAsyncRingForCurrentThread();
+
+  // Async logging may have been disabled since the caller checked, see SetAsyncLogging().
+  ring->writing.store(true, std::memory_order_seq_cst);
+  if (!s_async_enabled.load(std::memory_order_seq_cst)) [[unlikely]]
+  {
+    ring->writing.store(false, std::memory_order_release);
+    return false;
+  }
+
+  const u32 message_length = static_cast<u32>(std::min<size_t>(message.length(), ASYNC_MAX_MESSAGE_LENGTH));
+  const u32 record_size = Common::AlignUpPow2(static_cast<u32>(sizeof(AsyncRecordHeader)) + message_length,
+                                              ASYNC_RECORD_ALIGNMENT);
+
+  u32 write_pos = ring->write_pos.load(std::memory_order_relaxed);
+  const u32 read_pos = ring->read_pos.load(std::memory_order_acquire);
+  const u32 space_to_end = ASYNC_RING_SIZE - (write_pos & ASYNC_RING_MASK);
+  const u32 space_needed = record_size + ((space_to_end < record_size) ? space_to_end : 0);
+  if ((ASYNC_RING_SIZE - (write_pos - read_pos)) < space_needed) [[unlikely]]
+  {
+    ring->dropped_messages.fetch_add(1, std::memory_order_relaxed);
+    ring->writing.store(false, std::memory_order_release);
+    s_async_cv.notify_one();
+    return true;
+  }
+
+  if (space_to_end < record_size)
+  {
+    static constexpr u32 wrap_marker = 0;
+    std::memcpy(&ring->buffer[write_pos & ASYNC_RING_MASK], &wrap_marker, sizeof(wrap_marker));
+    write_pos += space_to_end;
+  }
+
+  const AsyncRecordHeader header = {
+    record_size, message_length, Common::Timer::GetCurrentValue(), channelName, functionName, level};
+  u8* const ptr = &ring->buffer[write_pos & ASYNC_RING_MASK];
+  std::memcpy(ptr, &header, sizeof(header));
+  std::memcpy(ptr + sizeof(header), message.data(), message_length);
+  ring->write_pos.store(write_pos + record_size, std::memory_order_release);
+  ring->writing.store(false, std::memory_order_release);
+
+  // The log thread wakes up periodically anyway, only poke it when the buffer is getting full.
+  if ((write_pos + record_size - read_pos) >= ASYNC_RING_WAKE_THRESHOLD)
+    s_async_cv.notify_one();
+
+  return true;
+}
+
+bool Log::AsyncWriteFmtArgs(const char* channelName, const char* functionName, LOGLEVEL level, fmt::string_view fmt,
+                            fmt::format_args args)
+{
+  fmt::memory_buffer buffer;
+  fmt::vformat_to(std::back_inserter(buffer), fmt, args);
+  return AsyncWrite(channelName, functionName, level, std::string_view(buffer.data(), buffer.size()));
+}
+
+void Log::AsyncThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Log Writer");
+
+  std::unique_lock lock(s_async_mutex);
+  while (!s_async_shutdown)
+  {
+    s_async_cv.wait_for(lock, std::chrono::milliseconds(ASYNC_FLUSH_INTERVAL_MS));
+    lock.unlock();
+    DrainAsyncRings();
+    lock.lock();
+  }
+
+  // Pick up anything written while the last batch was being dispatched.
+  lock.unlock();
+  DrainAsyncRings();
+}
+
+void Log::DrainAsyncRings()
+{
+  std::unique_lock lock(s_callback_mutex);
+  DrainAsyncRings(lock);
+}
+
+void Log::DrainAsyncRings(const std::unique_lock<std::mutex>& lock)
+{
+  std::vector<std::shared_ptr<AsyncRing>> rings;
+  {
+    std::unique_lock async_lock(s_async_mutex);
+    rings = s_async_rings;
+  }
+
+  // Gather everything written so far, and sort it so messages from different threads are interleaved correctly.
+  std::vector<u32> end_positions;
+  std::vector<AsyncPendingRecord> records;
+  end_positions.reserve(rings.size());
+  for (const std::shared_ptr<AsyncRing>& ring : rings)
+  {
+    const u32 end_pos = ring->write_pos.load(std::memory_order_acquire);
+    u32 pos = ring->read_pos.load(std::memory_order_relaxed);
+    while (pos != end_pos)
+    {
+      const AsyncRecordHeader* header =
+        reinterpret_cast<const AsyncRecordHeader*>(&ring->buffer[pos & ASYNC_RING_MASK]);
+      if (header->size == 0)
+      {
+        pos += ASYNC_RING_SIZE - (pos & ASYNC_RING_MASK);
+        continue;
+      }
+
+      records.push_back(AsyncPendingRecord{header->timestamp, header});
+      pos += header->size;
+    }
+
+    end_positions.push_back(end_pos);
+  }
+
+  std::stable_sort(records.begin(), records.end(),
+                   [](const AsyncPendingRecord& lhs, const AsyncPendingRecord& rhs) {
+                     return lhs.timestamp < rhs.timestamp;
+                   });
+
+  for (const AsyncPendingRecord& record : records)
+  {
+    const AsyncRecordHeader* header = record.header;
+    if (!FilterTest(header->level, header->channel_name, lock))
+      continue;
+
+    s_dispatch_timestamp = header->timestamp;
+    ExecuteCallbacks(header->channel_name, header->function_name, header->level,
+                     std::string_view(reinterpret_cast<const char*>(header + 1), header->message_length), lock);
+  }
+  s_dispatch_timestamp = 0;
+
+  for (const std::shared_ptr<AsyncRing>& ring : rings)
+  {
+    const u32 dropped = ring->dropped_messages.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) [[unlikely]]
+    {
+      ExecuteCallbacks("Log", nullptr, LOGLEVEL_WARNING,
+                       TinyString::from_format("{} messages dropped, log buffer was full.", dropped), lock);
+    }
+  }
+
+  if (s_file_output_enabled && !records.empty())
+    std::fflush(s_file_handle.get());
+
+  for (size_t i = 0; i < rings.size(); i++)
+    rings[i]->read_pos.store(end_positions[i], std::memory_order_release);
+
+  // Forget about threads which have exited, once everything they wrote has been dispatched.
+  std::unique_lock async_lock(s_async_mutex);
+  for (auto iter = s_async_rings.begin(); iter != s_async_rings.end();)
+  {
+    AsyncRing* ring = iter->get();
+    if (ring->owner_exited.load(std::memory_order_acquire) &&
+        ring->read_pos.load(std::memory_order_relaxed) == ring->write_pos.load(std::memory_order_acquire))
+    {
+      iter = s_async_rings.erase(iter);
+      continue;
+    }
+
+    ++iter;
+  }
+}
@@ -52,6 +52,12 @@ void SetDebugOutputParams(bool enabled);
 // adds a file output
 void SetFileOutputParams(bool enabled, const char* filename, bool timestamps = true);
 
+// Asynchronous logging. Messages are formatted on the emitting thread and appended to a per-thread ring buffer,
+// then filtered and passed to the callbacks by a background thread. Messages are dropped and counted if a thread's
+// buffer fills up. Channel and function names must have static storage duration while enabled.
+bool IsAsyncLoggingEnabled();
+void SetAsyncLogging(bool enabled);
+
 // Returns the current global filtering level.
 LOGLEVEL GetLogLevel();
 
@@ -3,18 +3,24 @@
 
 #pragma once
 #include "heterogeneous_containers.h"
+#include "types.h"
+
 #include <cstdint>
 #include <map>
 
+/// Least-recently-used cache. Entries are kept on an intrusive recency list, so finding the eviction victim is O(1).
+/// Each entry has a cost, and the capacity is a budget for the total cost of all entries. With the default cost of
+/// one, the capacity is simply the maximum number of entries; passing sizes in bytes turns it into a memory budget.
 template<class K, class V>
 class LRUCache
 {
-  using CounterType = std::uint64_t;
-
   struct Item
   {
     V value;
-    CounterType last_access;
+    std::size_t cost;
+    const K* key;
+    Item* newer;
+    Item* older;
   };
 
   using MapType = std::conditional_t<std::is_same_v<K, std::string>, StringMap<Item>, std::map<K, Item>>;
@@ -24,18 +30,34 @@ public:
     : m_max_capacity(max_capacity), m_manual_evict(manual_evict)
   {
   }
+  LRUCache(const LRUCache&) = delete;
+  LRUCache& operator=(const LRUCache&) = delete;
   ~LRUCache() = default;
 
   std::size_t GetSize() const { return m_items.size(); }
   std::size_t GetMaxCapacity() const { return m_max_capacity; }
+  std::size_t GetTotalCost() const { return m_total_cost; }
+  u64 GetHitCount() const { return m_hits; }
+  u64 GetMissCount() const { return m_misses; }
 
-  void Clear() { m_items.clear(); }
+  void ResetStatistics()
+  {
+    m_hits = 0;
+    m_misses = 0;
+  }
+
+  void Clear()
+  {
+    m_items.clear();
+    m_newest = nullptr;
+    m_oldest = nullptr;
+    m_total_cost = 0;
+  }
 
   void SetMaxCapacity(std::size_t capacity)
   {
     m_max_capacity = capacity;
-    if (m_items.size() > m_max_capacity)
-      Evict(m_items.size() - m_max_capacity);
+    EvictToCapacity(0);
   }
 
   template<typename KeyT>
@@ -43,46 +65,47 @@ public:
   {
     auto iter = m_items.find(key);
     if (iter == m_items.end())
+    {
+      m_misses++;
       return nullptr;
+    }
 
-    iter->second.last_access = ++m_last_counter;
+    m_hits++;
+    MoveToFront(&iter->second);
     return &iter->second.value;
   }
 
-  V* Insert(K key, V value)
+  V* Insert(K key, V value, std::size_t cost = 1)
   {
-    ShrinkForNewItem();
-
     auto iter = m_items.find(key);
     if (iter != m_items.end())
     {
-      iter->second.value = std::move(value);
-      iter->second.last_access = ++m_last_counter;
-      return &iter->second.value;
-    }
-    else
-    {
-      Item it;
-      it.last_access = ++m_last_counter;
-      it.value = std::move(value);
-      auto ip = m_items.emplace(std::move(key), std::move(it));
-      return &ip.first->second.value;
+      Item* item = &iter->second;
+      m_total_cost = m_total_cost - item->cost + cost;
+      item->value = std::move(value);
+      item->cost = cost;
+      MoveToFront(item);
+      if (!m_manual_evict)
+        EvictToCapacity(0);
+      return &item->value;
     }
+
+    if (!m_manual_evict)
+      EvictToCapacity(cost, false);
+
+    iter = m_items.emplace(std::move(key), Item{std::move(value), cost, nullptr, nullptr, nullptr}).first;
+    Item* item = &iter->second;
+    item->key = &iter->first;
+    LinkFront(item);
+    m_total_cost += cost;
+    return &item->value;
   }
 
+  /// Removes the specified number of least recently used entries.
   void Evict(std::size_t count = 1)
   {
-    while (!m_items.empty() && count > 0)
-    {
-      typename MapType::iterator lowest = m_items.end();
-      for (auto iter = m_items.begin(); iter != m_items.end(); ++iter)
-      {
-        if (lowest == m_items.end() || iter->second.last_access < lowest->second.last_access)
-          lowest = iter;
-      }
-      m_items.erase(lowest);
-      count--;
-    }
+    for (; count > 0 && m_oldest; count--)
+      RemoveItem(m_oldest);
   }
 
   template<typename KeyT>
@@ -91,33 +114,83 @@ public:
     auto iter = m_items.find(key);
     if (iter == m_items.end())
       return false;
+
+    Item* item = &iter->second;
+    Unlink(item);
+    m_total_cost -= item->cost;
     m_items.erase(iter);
     return true;
   }
+
   void SetManualEvict(bool block)
   {
     m_manual_evict = block;
     if (!m_manual_evict)
       ManualEvict();
   }
+
   void ManualEvict()
   {
     // evict if we went over
-    while (m_items.size() > m_max_capacity)
-      Evict(m_items.size() - m_max_capacity);
+    EvictToCapacity(0);
   }
 
 private:
-  void ShrinkForNewItem()
+  /// Evicts the oldest entries until an entry with the specified cost would fit. Unless the newest entry is about to
+  /// be displaced by an insert, it is kept, so that a single entry larger than the whole budget is still usable.
+  void EvictToCapacity(std::size_t new_cost, bool keep_newest = true)
+  {
+    while (m_oldest && (m_total_cost + new_cost) > m_max_capacity && (!keep_newest || m_oldest != m_newest))
+      RemoveItem(m_oldest);
+  }
+
+  void RemoveItem(Item* item)
+  {
+    Unlink(item);
+    m_total_cost -= item->cost;
+
+    // The key lives in the node being erased, so erase by iterator rather than comparing against a dying key.
+    m_items.erase(m_items.find(*item->key));
+  }
+
+  void LinkFront(Item* item)
+  {
+    item->older = m_newest;
+    item->newer = nullptr;
+    if (m_newest)
+      m_newest->newer = item;
+    else
+      m_oldest = item;
+    m_newest = item;
+  }
+
+  void Unlink(Item* item)
+  {
+    if (item->newer)
+      item->newer->older = item->older;
+    else
+      m_newest = item->older;
+    if (item->older)
+      item->older->newer = item->newer;
+    else
+      m_oldest = item->newer;
+  }
+
+  void MoveToFront(Item* item)
   {
-    if (m_items.size() < m_max_capacity)
+    if (m_newest == item)
       return;
 
-    Evict(m_items.size() - (m_max_capacity - 1));
+    Unlink(item);
+    LinkFront(item);
   }
 
   MapType m_items;
-  CounterType m_last_counter = 0;
+  Item* m_newest = nullptr;
+  Item* m_oldest = nullptr;
+  std::size_t m_total_cost = 0;
   std::size_t m_max_capacity = 0;
+  u64 m_hits = 0;
+  u64 m_misses = 0;
   bool m_manual_evict = false;
-};
\ No newline at end of file
+};
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "util/cd_image.h"
+
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/path.h"
+
+#include "libchdr/cdrom.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+namespace {
+enum class EcmSectorType : u8
+{
+  Raw = 0x00,
+  Mode1 = 0x01,
+  Mode2Form1 = 0x02,
+  Mode2Form2 = 0x03,
+};
+
+using RawSector = std::array<u8, CDImage::RAW_SECTOR_SIZE>;
+} // namespace
+
+// Builds a sector the way a mastering tool would, with the EDC/ECC generated by libchdr, which the ECM reader's own
+// implementation is checked against.
+static RawSector MakeReferenceSector(EcmSectorType type, std::mt19937& rng)
+{
+  RawSector sector;
+  for (u8& value : sector)
+    value = static_cast<u8>(rng());
+
+  std::memset(&sector[0], 0, 12);
+  std::memset(&sector[1], 0xFF, 10);
+  sector[0x0F] = (type == EcmSectorType::Mode1) ? 0x01 : 0x02;
+
+  switch (type)
+  {
+    case EcmSectorType::Mode1:
+    {
+      std::memset(&sector[2068], 0, 8);
+      edc_set(&sector[2064], edc_compute(sector.data(), 2064));
+      ecc_generate(sector.data());
+    }
+    break;
+
+    case EcmSectorType::Mode2Form1:
+    {
+      // The subheader is stored twice, and form 1 is flagged in the submode byte.
+      sector[0x12] &= ~0x20;
+      std::memcpy(&sector[0x14], &sector[0x10], 4);
+      edc_set(&sector[2072], edc_compute(&sector[16], 2056));
+
+      // Mode 2 parity is generated with the address zeroed.
+      u8 address[3];
+      std::memcpy(address, &sector[0x0C], sizeof(address));
+      std::memset(&sector[0x0C], 0, sizeof(address));
+      ecc_generate(sector.data());
+      std::memcpy(&sector[0x0C], address, sizeof(address));
+    }
+    break;
+
+    case EcmSectorType::Mode2Form2:
+    {
+      sector[0x12] |= 0x20;
+      std::memcpy(&sector[0x14], &sector[0x10], 4);
+      edc_set(&sector[2348], edc_compute(&sector[16], 2332));
+    }
+    break;
+
+    default:
+      break;
+  }
+
+  return sector;
+}
+
+static void WriteEcmRecordHeader(std::vector<u8>& ecm, EcmSectorType type, u32 count)
+{
+  u32 value = count - 1;
+  u8 bits = static_cast<u8>(type) | static_cast<u8>((value & 0x1F) << 2);
+  value >>= 5;
+  while (value != 0)
+  {
+    ecm.push_back(bits | 0x80);
+    bits = static_cast<u8>(value & 0x7F);
+    value >>= 7;
+  }
+  ecm.push_back(bits);
+}
+
+// Stores the sector as the ECM encoder would, dropping everything the reader has to regenerate.
+static void WriteEcmSector(std::vector<u8>& ecm, EcmSectorType type, const RawSector& sector)
+{
+  switch (type)
+  {
+    case EcmSectorType::Mode1:
+    {
+      WriteEcmRecordHeader(ecm, type, 1);
+      ecm.insert(ecm.end(), &sector[0x0C], &sector[0x0F]);
+      ecm.insert(ecm.end(), &sector[0x10], &sector[0x810]);
+    }
+    break;
+
+    case EcmSectorType::Mode2Form1:
+    case EcmSectorType::Mode2Form2:
+    {
+      // Mode 2 records don't include the sync pattern and header, so those are stored raw.
+      WriteEcmRecordHeader(ecm, EcmSectorType::Raw, 16);
+      ecm.insert(ecm.end(), &sector[0x00], &sector[0x10]);
+      WriteEcmRecordHeader(ecm, type, 1);
+      ecm.insert(ecm.end(), &sector[0x14], &sector[(type == EcmSectorType::Mode2Form1) ? 0x818 : 0x92C]);
+    }
+    break;
+
+    default:
+    {
+      WriteEcmRecordHeader(ecm, type, CDImage::RAW_SECTOR_SIZE);
+      ecm.insert(ecm.end(), sector.begin(), sector.end());
+    }
+    break;
+  }
+}
+
+static void CheckSectors(CDImage* image, const std::vector<RawSector>& sectors, const char* pass)
+{
+  ASSERT_TRUE(image->Seek(1, CDImage::Position{0, 0, 0}));
+
+  RawSector sector;
+  for (size_t i = 0; i < sectors.size(); i++)
+  {
+    ASSERT_TRUE(image->ReadRawSector(sector.data(), nullptr)) << pass << ": sector " << i;
+    ASSERT_EQ(std::memcmp(sector.data(), sectors[i].data(), sector.size()), 0)
+      << pass << ": sector " << i << " differs from the reference";
+  }
+}
+
+TEST(CDImageEcm, ReconstructsSectorsLikeLibchdr)
+{
+  static constexpr u32 NUM_SECTORS = 4000;
+  static constexpr EcmSectorType types[] = {EcmSectorType::Mode1, EcmSectorType::Mode2Form1,
+                                            EcmSectorType::Mode2Form2, EcmSectorType::Raw};
+
+  std::mt19937 rng(0x45434D31);
+  std::vector<RawSector> sectors;
+  std::vector<u8> ecm = {'E', 'C', 'M', 0};
+  sectors.reserve(NUM_SECTORS);
+  for (u32 i = 0; i < NUM_SECTORS; i++)
+  {
+    const EcmSectorType type = types[rng() % std::size(types)];
+    sectors.push_back(MakeReferenceSector(type, rng));
+    WriteEcmSector(ecm, type, sectors.back());
+  }
+
+  // End marker, followed by the EDC of the whole image, which the reader doesn't check.
+  static constexpr u8 end_marker[] = {0xFC, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0x00};
+  ecm.insert(ecm.end(), std::begin(end_marker), std::end(end_marker));
+
+  const std::string path = Path::Combine(std::filesystem::temp_directory_path().string(), "duckstation-tests.ecm");
+  Error error;
+  ASSERT_TRUE(FileSystem::WriteBinaryFile(path.c_str(), ecm.data(), ecm.size(), &error)) << error.GetDescription();
+
+  {
+    std::unique_ptr<CDImage> image = CDImage::OpenEcmImage(path.c_str(), &error);
+    ASSERT_TRUE(image) << error.GetDescription();
+    ASSERT_EQ(image->GetLBACount(), NUM_SECTORS);
+
+    CheckSectors(image.get(), sectors, "streamed");
+
+    ASSERT_EQ(image->Precache(), CDImage::PrecacheResult::Success);
+    ASSERT_TRUE(image->IsPrecached());
+    CheckSectors(image.get(), sectors, "precached");
+  }
+
+  FileSystem::DeleteFile(path.c_str());
+}
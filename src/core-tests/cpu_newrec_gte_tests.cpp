@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "core/bus.h"
+#include "core/cpu_code_cache.h"
+#include "core/cpu_core.h"
+#include "core/cpu_core_private.h"
+#include "core/cpu_types.h"
+#include "core/settings.h"
+#include "core/timing_event.h"
+
+#include "common/error.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+#ifdef ENABLE_NEWREC
+
+using namespace CPU;
+
+namespace {
+class CodeBuilder
+{
+public:
+  const std::vector<u32>& GetCode() const { return m_code; }
+  u32 GetPC() const { return PROGRAM_ADDRESS + static_cast<u32>(m_code.size() * sizeof(u32)); }
+
+  void Nop() { m_code.push_back(0); }
+  void IType(InstructionOp op, Reg rs, Reg rt, u16 imm)
+  {
+    m_code.push_back((static_cast<u32>(op) << 26) | (static_cast<u32>(rs) << 21) | (static_cast<u32>(rt) << 16) |
+                     ZeroExtend32(imm));
+  }
+  void Cop2LoadStore(InstructionOp op, Reg base, u32 reg, u16 offset)
+  {
+    m_code.push_back((static_cast<u32>(op) << 26) | (static_cast<u32>(base) << 21) | (reg << 16) |
+                     ZeroExtend32(offset));
+  }
+  void Cop2Move(CopCommonInstruction op, Reg rt, u32 rd)
+  {
+    m_code.push_back((static_cast<u32>(InstructionOp::cop2) << 26) | (static_cast<u32>(op) << 21) |
+                     (static_cast<u32>(rt) << 16) | (rd << 11));
+  }
+  void Cop2Command(u32 bits) { m_code.push_back((static_cast<u32>(InstructionOp::cop2) << 26) | (1u << 25) | bits); }
+  void Branch(InstructionOp op, Reg rs, Reg rt, u32 target)
+  {
+    IType(op, rs, rt, static_cast<u16>((static_cast<s32>(target) - static_cast<s32>(GetPC() + 4)) >> 2));
+  }
+  void Jump(u32 target)
+  {
+    m_code.push_back((static_cast<u32>(InstructionOp::j) << 26) | ((target >> 2) & 0x03FFFFFFu));
+  }
+
+  static constexpr u32 PROGRAM_ADDRESS = 0x80001000;
+
+private:
+  std::vector<u32> m_code;
+};
+
+struct InputRecord
+{
+  u32 sxy[3];
+  u32 sz[4];
+  u32 zsf3;
+  u32 zsf4;
+  u32 flag;
+};
+} // namespace
+
+static constexpr u32 NUM_RECORDS = 1024;
+static constexpr u32 INPUT_ADDRESS = 0x80010000;
+static constexpr u32 OUTPUT_ADDRESS = 0x80040000;
+static constexpr u32 DONE_ADDRESS = 0x80000800;
+static constexpr u32 OUTPUT_WORDS_PER_COMMAND = GTE::NUM_REGS;
+
+// The commands that the x64 and AArch64 recompilers generate inline, everything else is a call to the same C++
+// implementation that the interpreter uses.
+static constexpr u32 s_inline_commands[] = {0x06, 0x2D, 0x2E};
+
+// Loads the inputs of NCLIP and AVSZ3/AVSZ4 from each record, executes each command, and stores the whole register
+// file after it. Writes 1 to DONE_ADDRESS once every record has been processed.
+static std::vector<u32> BuildProgram(std::mt19937& rng)
+{
+  CodeBuilder cb;
+  cb.IType(InstructionOp::lui, Reg::zero, Reg::a0, static_cast<u16>(INPUT_ADDRESS >> 16));
+  cb.IType(InstructionOp::lui, Reg::zero, Reg::a1, static_cast<u16>(OUTPUT_ADDRESS >> 16));
+  cb.IType(InstructionOp::ori, Reg::zero, Reg::a2, static_cast<u16>(NUM_RECORDS));
+
+  const u32 loop_pc = cb.GetPC();
+  for (const u32 command : s_inline_commands)
+  {
+    for (u32 i = 0; i < 3; i++)
+      cb.Cop2LoadStore(InstructionOp::lwc2, Reg::a0, 12 + i, static_cast<u16>(offsetof(InputRecord, sxy) + i * 4));
+    for (u32 i = 0; i < 4; i++)
+      cb.Cop2LoadStore(InstructionOp::lwc2, Reg::a0, 16 + i, static_cast<u16>(offsetof(InputRecord, sz) + i * 4));
+
+    static constexpr std::pair<u32, u32> control_inputs[] = {
+      {29, offsetof(InputRecord, zsf3)}, {30, offsetof(InputRecord, zsf4)}, {31, offsetof(InputRecord, flag)}};
+    for (const auto& [reg, offset] : control_inputs)
+    {
+      cb.IType(InstructionOp::lw, Reg::a0, Reg::t0, static_cast<u16>(offset));
+      cb.Nop();
+      cb.Cop2Move(CopCommonInstruction::ctcn, Reg::t0, reg);
+    }
+
+    // sf/lm don't affect these commands, but the recompiler shouldn't care either.
+    cb.Nop();
+    cb.Cop2Command((static_cast<u32>(rng()) & 0x01FFFFC0u) | command);
+    cb.Nop();
+
+    for (u32 i = 0; i < GTE::NUM_DATA_REGS; i++)
+      cb.Cop2LoadStore(InstructionOp::swc2, Reg::a1, i, static_cast<u16>(i * sizeof(u32)));
+    for (u32 i = 0; i < GTE::NUM_CONTROL_REGS; i++)
+    {
+      cb.Cop2Move(CopCommonInstruction::cfcn, Reg::t0, i);
+      cb.Nop();
+      cb.IType(InstructionOp::sw, Reg::a1, Reg::t0, static_cast<u16>((GTE::NUM_DATA_REGS + i) * sizeof(u32)));
+    }
+
+    cb.IType(InstructionOp::addiu, Reg::a1, Reg::a1, static_cast<u16>(OUTPUT_WORDS_PER_COMMAND * sizeof(u32)));
+  }
+
+  cb.IType(InstructionOp::addiu, Reg::a0, Reg::a0, static_cast<u16>(sizeof(InputRecord)));
+  cb.IType(InstructionOp::addiu, Reg::a2, Reg::a2, static_cast<u16>(-1));
+  cb.Branch(InstructionOp::bne, Reg::a2, Reg::zero, loop_pc);
+  cb.Nop();
+
+  cb.IType(InstructionOp::ori, Reg::zero, Reg::t1, 1);
+  cb.IType(InstructionOp::lui, Reg::zero, Reg::a3, static_cast<u16>(DONE_ADDRESS >> 16));
+  cb.IType(InstructionOp::sw, Reg::a3, Reg::t1, static_cast<u16>(DONE_ADDRESS));
+  cb.Jump(cb.GetPC());
+  cb.Nop();
+
+  return cb.GetCode();
+}
+
+static std::vector<InputRecord> BuildInputs(std::mt19937& rng)
+{
+  // Bias towards the extremes, so that the MAC0 overflow and OTZ saturation paths are exercised.
+  static constexpr u16 special_values[] = {0x0000, 0x0001, 0xFFFF, 0x03FF, 0xFC00, 0x7FFF, 0x8000, 0x7F00, 0x8100};
+  const auto value16 = [&rng]() {
+    const u32 special = static_cast<u32>(rng() % (std::size(special_values) * 2));
+    return (special < std::size(special_values)) ? special_values[special] : static_cast<u16>(rng());
+  };
+
+  std::vector<InputRecord> records(NUM_RECORDS);
+  for (InputRecord& rec : records)
+  {
+    for (u32& sxy : rec.sxy)
+      sxy = ZeroExtend32(value16()) | (ZeroExtend32(value16()) << 16);
+    for (u32& sz : rec.sz)
+      sz = value16();
+    rec.zsf3 = value16();
+    rec.zsf4 = value16();
+    rec.flag = static_cast<u32>(rng());
+  }
+
+  return records;
+}
+
+static void ExitWhenDone(void* param, TickCount ticks, TickCount ticks_late)
+{
+  u32& remaining_checks = *static_cast<u32*>(param);
+  u32 done;
+  std::memcpy(&done, &Bus::g_ram[DONE_ADDRESS & Bus::g_ram_mask], sizeof(done));
+  if (done == 0 && --remaining_checks > 0)
+    return;
+
+  TimingEvents::CancelRunningEvent();
+  ExitExecution();
+}
+
+static std::vector<u32> RunProgram(CPUExecutionMode mode, const std::vector<u32>& code,
+                                   const std::vector<InputRecord>& inputs)
+{
+  g_settings.cpu_execution_mode = mode;
+  TimingEvents::Reset();
+  CPU::Reset();
+  CodeCache::Reset();
+  Bus::Reset();
+
+  std::memcpy(&Bus::g_ram[CodeBuilder::PROGRAM_ADDRESS & Bus::g_ram_mask], code.data(), code.size() * sizeof(u32));
+  std::memcpy(&Bus::g_ram[INPUT_ADDRESS & Bus::g_ram_mask], inputs.data(), inputs.size() * sizeof(InputRecord));
+  g_state.cop0_regs.sr.CE2 = true;
+  SetPC(CodeBuilder::PROGRAM_ADDRESS);
+
+  // Bail out eventually if the program never finishes, the done flag will catch that.
+  u32 remaining_checks = 1000;
+  TimingEvent event("Test", 1000000, 1000000, &ExitWhenDone, &remaining_checks);
+  event.Activate();
+  CPU::Execute();
+  event.Deactivate();
+
+  u32 done;
+  std::memcpy(&done, &Bus::g_ram[DONE_ADDRESS & Bus::g_ram_mask], sizeof(done));
+  EXPECT_EQ(done, 1u) << Settings::GetCPUExecutionModeName(mode) << " did not finish the program";
+
+  std::vector<u32> output(NUM_RECORDS * std::size(s_inline_commands) * OUTPUT_WORDS_PER_COMMAND);
+  std::memcpy(output.data(), &Bus::g_ram[OUTPUT_ADDRESS & Bus::g_ram_mask], output.size() * sizeof(u32));
+  return output;
+}
+
+TEST(CPUNewRec, InlineGTECommandsMatchInterpreter)
+{
+  // PGXP culling sends NCLIP through the C++ implementation, and fastmem isn't needed.
+  g_settings.gpu_pgxp_enable = false;
+  g_settings.cpu_fastmem_mode = CPUFastmemMode::Disabled;
+  g_settings.cpu_execution_mode = CPUExecutionMode::Interpreter;
+
+  Error error;
+  ASSERT_TRUE(CodeCache::ProcessStartup(&error)) << error.GetDescription();
+  ASSERT_TRUE(Bus::AllocateMemory(false, &error)) << error.GetDescription();
+  TimingEvents::Initialize();
+  Bus::Initialize();
+  CPU::Initialize();
+
+  std::mt19937 rng(0x4E524543);
+  const std::vector<u32> code = BuildProgram(rng);
+  const std::vector<InputRecord> inputs = BuildInputs(rng);
+  const std::vector<u32> expected = RunProgram(CPUExecutionMode::Interpreter, code, inputs);
+  const std::vector<u32> actual = RunProgram(CPUExecutionMode::NewRec, code, inputs);
+
+  for (size_t i = 0; i < expected.size(); i++)
+  {
+    // Stop at the first difference, the rest would most likely report the same problem.
+    const size_t command = (i / OUTPUT_WORDS_PER_COMMAND) % std::size(s_inline_commands);
+    const size_t record = i / (OUTPUT_WORDS_PER_COMMAND * std::size(s_inline_commands));
+    ASSERT_EQ(actual[i], expected[i]) << "command 0x" << std::hex << s_inline_commands[command] << std::dec
+                                      << " differs from the interpreter in register " << (i % OUTPUT_WORDS_PER_COMMAND)
+                                      << " of record " << record;
+  }
+
+  CPU::Shutdown();
+  Bus::Shutdown();
+  TimingEvents::Shutdown();
+  Bus::ReleaseMemory();
+  CodeCache::ProcessShutdown();
+}
+
+#endif // ENABLE_NEWREC
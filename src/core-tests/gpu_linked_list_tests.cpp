@@ -0,0 +1,336 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "core/gpu.h"
+#include "core/settings.h"
+#include "core/timing_event.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <random>
+#include <vector>
+
+namespace {
+enum : u32
+{
+  EVENT_DRAW = 0xE0000001,
+  EVENT_CLUT = 0xE0000002,
+  EVENT_FILL = 0xE0000003,
+  EVENT_WRITE = 0xE0000004,
+  EVENT_COPY = 0xE0000005,
+};
+
+// Records everything that a backend would see, so that two GPUs fed the same commands can be compared.
+class RecordingGPU final : public GPU
+{
+public:
+  explicit RecordingGPU(TickCount max_run_ahead)
+  {
+    m_max_run_ahead = max_run_ahead;
+    UpdateFifoAddressTracking();
+  }
+
+  const Threading::Thread* GetSWThread() const override { return nullptr; }
+  bool IsHardwareRenderer() const override { return false; }
+  void FlushRender() override {}
+
+  const std::vector<u32>& GetEvents() const { return m_events; }
+  TickCount GetPendingTicks() const { return m_pending_command_ticks; }
+  u32 GetQueuedWords() const { return m_fifo.GetSize(); }
+  u32 GetStatus() const { return m_GPUSTAT.bits; }
+
+protected:
+  void DispatchRenderCommand() override
+  {
+    const GPURenderCommand rc{m_render_command.bits};
+    Record({EVENT_DRAW, rc.bits, m_draw_mode.mode_reg.bits, m_draw_mode.palette_reg.bits, m_drawing_area.left,
+            m_drawing_area.top, m_drawing_area.right, m_drawing_area.bottom, static_cast<u32>(m_drawing_offset.x),
+            static_cast<u32>(m_drawing_offset.y)});
+
+    if (rc.primitive == GPUPrimitive::Line && rc.polyline)
+    {
+      m_events.insert(m_events.end(), m_blit_buffer.begin(), m_blit_buffer.end());
+    }
+    else
+    {
+      // The command word has already been removed by the handler.
+      u32 remaining_words;
+      if (rc.primitive == GPUPrimitive::Polygon)
+      {
+        const u32 words_per_vertex = 1 + BoolToUInt32(rc.texture_enable) + BoolToUInt32(rc.shading_enable);
+        remaining_words = words_per_vertex * (rc.quad_polygon ? 4 : 3) + BoolToUInt32(!rc.shading_enable) - 1;
+      }
+      else if (rc.primitive == GPUPrimitive::Line)
+      {
+        remaining_words = rc.shading_enable ? 3 : 2;
+      }
+      else
+      {
+        remaining_words =
+          1 + BoolToUInt32(rc.texture_enable) + BoolToUInt32(rc.rectangle_size == GPUDrawRectangleSize::Variable);
+      }
+
+      // PGXP looks vertices up by address, so those have to come through too.
+      for (u32 i = 0; i < remaining_words; i++)
+      {
+        u32 address;
+        const u32 value = FifoPopWithAddress(&address);
+        Record({value, address});
+      }
+    }
+
+    AddCommandTicks(static_cast<TickCount>(rc.bits & 0xFFu));
+  }
+
+  void UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit) override
+  {
+    Record({EVENT_CLUT, reg.bits, BoolToUInt32(clut_is_8bit)});
+  }
+
+  void UpdateDisplay() override {}
+
+  void FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color) override
+  {
+    Record({EVENT_FILL, x, y, width, height, color});
+  }
+
+  void UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask, bool check_mask) override
+  {
+    Record({EVENT_WRITE, x, y, width, height, BoolToUInt32(set_mask), BoolToUInt32(check_mask)});
+    const u16* pixels = static_cast<const u16*>(data);
+    for (u32 i = 0; i < width * height; i++)
+      m_events.push_back(pixels[i]);
+  }
+
+  void CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height) override
+  {
+    Record({EVENT_COPY, src_x, src_y, dst_x, dst_y, width, height});
+  }
+
+private:
+  void Record(std::initializer_list<u32> values) { m_events.insert(m_events.end(), values); }
+
+  std::vector<u32> m_events;
+};
+
+struct Node
+{
+  u32 address;
+  u32 word_count;
+};
+} // namespace
+
+static u32 MakePosition(std::mt19937& rng)
+{
+  return (static_cast<u32>(rng()) % 256) | ((static_cast<u32>(rng()) % 256) << 16);
+}
+
+// Builds a random GP0 packet stream with everything an ordering table can contain: environment commands, every kind
+// of primitive, poly-lines, fills, and transfers which have to go through the FIFO.
+static std::vector<u32> BuildPackets(std::mt19937& rng)
+{
+  std::vector<u32> words;
+  for (u32 i = 0; i < 2000; i++)
+  {
+    switch (rng() % 12)
+    {
+      case 0:
+        words.push_back((rng() % 2) ? 0x00000000u : 0x01000000u);
+        break;
+
+      case 1:
+        words.push_back(0xE1000000u | (static_cast<u32>(rng()) & 0x3FFFu));
+        words.push_back(0xE2000000u | (static_cast<u32>(rng()) & 0xFFFFFu));
+        break;
+
+      case 2:
+        words.push_back(0xE3000000u | ((static_cast<u32>(rng()) % 64) | ((static_cast<u32>(rng()) % 64) << 10)));
+        words.push_back(0xE4000000u | ((static_cast<u32>(rng()) % 1024) | ((static_cast<u32>(rng()) % 512) << 10)));
+        words.push_back(0xE5000000u | (static_cast<u32>(rng()) & 0x3FFFFFu));
+        words.push_back(0xE6000000u | (static_cast<u32>(rng()) & 0x3u));
+        break;
+
+      case 3:
+      case 4:
+      case 5:
+      {
+        const GPURenderCommand rc{((0x20u + static_cast<u32>(rng()) % 0x20u) << 24) |
+                                  (static_cast<u32>(rng()) & 0xFFFFFFu)};
+        const u32 num_vertices = rc.quad_polygon ? 4 : 3;
+        words.push_back(rc.bits);
+        for (u32 v = 0; v < num_vertices; v++)
+        {
+          if (rc.shading_enable && v > 0)
+            words.push_back(static_cast<u32>(rng()) & 0xFFFFFFu);
+          words.push_back(MakePosition(rng));
+          if (rc.texture_enable)
+            words.push_back(static_cast<u32>(rng()));
+        }
+      }
+      break;
+
+      case 6:
+      {
+        // Single lines.
+        const u32 command = ((static_cast<u32>(rng()) % 2) ? 0x40u : 0x50u) | (static_cast<u32>(rng()) % 8);
+        words.push_back((command << 24) | (static_cast<u32>(rng()) & 0xFFFFFFu));
+        words.push_back(MakePosition(rng));
+        if (command & 0x10)
+          words.push_back(static_cast<u32>(rng()) & 0xFFFFFFu);
+        words.push_back(MakePosition(rng));
+      }
+      break;
+
+      case 7:
+      {
+        // Poly-lines, always through the FIFO.
+        const bool shaded = (rng() % 2) != 0;
+        words.push_back(((shaded ? 0x58u : 0x48u) << 24) | (static_cast<u32>(rng()) & 0xFFFFFFu));
+        const u32 num_vertices = 2 + static_cast<u32>(rng()) % 6;
+        for (u32 v = 0; v < num_vertices; v++)
+        {
+          if (shaded && v > 0)
+            words.push_back(static_cast<u32>(rng()) & 0xFFFFFFu);
+          words.push_back(MakePosition(rng));
+        }
+        words.push_back(0x55555555u);
+      }
+      break;
+
+      case 8:
+      case 9:
+      {
+        const GPURenderCommand rc{((0x60u + static_cast<u32>(rng()) % 0x20u) << 24) |
+                                  (static_cast<u32>(rng()) & 0xFFFFFFu)};
+        words.push_back(rc.bits);
+        words.push_back(MakePosition(rng));
+        if (rc.texture_enable)
+          words.push_back(static_cast<u32>(rng()));
+        if (rc.rectangle_size == GPUDrawRectangleSize::Variable)
+          words.push_back((static_cast<u32>(rng()) % 64) | ((static_cast<u32>(rng()) % 64) << 16));
+      }
+      break;
+
+      case 10:
+      {
+        words.push_back(0x02000000u | (static_cast<u32>(rng()) & 0xFFFFFFu));
+        words.push_back(MakePosition(rng));
+        words.push_back((static_cast<u32>(rng()) % 64) | ((static_cast<u32>(rng()) % 32) << 16));
+      }
+      break;
+
+      case 11:
+      default:
+      {
+        if (rng() % 2)
+        {
+          const u32 width = 1 + static_cast<u32>(rng()) % 16;
+          const u32 height = 1 + static_cast<u32>(rng()) % 8;
+          words.push_back(0xA0000000u);
+          words.push_back(MakePosition(rng));
+          words.push_back(width | (height << 16));
+          for (u32 w = 0; w < (width * height + 1) / 2; w++)
+            words.push_back(static_cast<u32>(rng()));
+        }
+        else
+        {
+          words.push_back(0x80000000u);
+          words.push_back(MakePosition(rng));
+          words.push_back(MakePosition(rng));
+          words.push_back((1 + static_cast<u32>(rng()) % 32) | ((1 + static_cast<u32>(rng()) % 32) << 16));
+        }
+      }
+      break;
+    }
+  }
+
+  return words;
+}
+
+// Splits the stream into ordering table nodes at random points, so that packets end up spanning nodes. Each node is
+// placed after a header word, like a real ordering table.
+static std::vector<Node> BuildNodes(const std::vector<u32>& words, std::vector<u8>* ram, std::mt19937& rng)
+{
+  std::vector<Node> nodes;
+  ram->resize((words.size() * 2 + 1024) * sizeof(u32));
+
+  u32 address = 0x100;
+  for (size_t pos = 0; pos < words.size();)
+  {
+    const u32 word_count = std::min(1 + static_cast<u32>(rng()) % 24, static_cast<u32>(words.size() - pos));
+    address += sizeof(u32);
+    std::memcpy(&(*ram)[address], &words[pos], word_count * sizeof(u32));
+    nodes.push_back(Node{address, word_count});
+    address += word_count * sizeof(u32) + (static_cast<u32>(rng()) % 4) * sizeof(u32);
+    pos += word_count;
+  }
+
+  return nodes;
+}
+
+static void CompareLinkedListPaths(TickCount max_run_ahead, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<u8> ram;
+  const std::vector<Node> nodes = BuildNodes(BuildPackets(rng), &ram, rng);
+
+  RecordingGPU fifo_gpu(max_run_ahead);
+  RecordingGPU in_place_gpu(max_run_ahead);
+  for (RecordingGPU* gpu : {&fifo_gpu, &in_place_gpu})
+  {
+    gpu->Reset(true);
+    gpu->WriteRegister(4, 0x04000002u); // GP1(04h) DMA direction CPU to GP0
+  }
+
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    const Node& node = nodes[i];
+    fifo_gpu.DMAWrite(node.address, reinterpret_cast<const u32*>(&ram[node.address]), node.word_count);
+    fifo_gpu.EndDMAWrite();
+    in_place_gpu.DMAWriteLinkedListNode(ram.data(), node.address, node.word_count);
+
+    ASSERT_EQ(in_place_gpu.GetPendingTicks(), fifo_gpu.GetPendingTicks()) << "node " << i;
+    ASSERT_EQ(in_place_gpu.GetQueuedWords(), fifo_gpu.GetQueuedWords()) << "node " << i;
+    ASSERT_EQ(in_place_gpu.GetStatus(), fifo_gpu.GetStatus()) << "node " << i;
+
+    // Let some of the queued commands run between nodes, like the command tick event would. Drain the FIFO before it
+    // fills up, real DMA would stall instead.
+    TickCount ticks = static_cast<TickCount>(rng() % 64);
+    if (fifo_gpu.GetQueuedWords() > 1024)
+      ticks = fifo_gpu.GetPendingTicks();
+    fifo_gpu.CommandTickEvent(ticks);
+    in_place_gpu.CommandTickEvent(ticks);
+  }
+
+  while (fifo_gpu.GetQueuedWords() > 0 || fifo_gpu.GetPendingTicks() > 0)
+  {
+    fifo_gpu.CommandTickEvent(1000);
+    in_place_gpu.CommandTickEvent(1000);
+  }
+
+  ASSERT_EQ(in_place_gpu.GetQueuedWords(), 0u);
+  ASSERT_EQ(in_place_gpu.GetStatus(), fifo_gpu.GetStatus());
+
+  const std::vector<u32>& expected = fifo_gpu.GetEvents();
+  const std::vector<u32>& actual = in_place_gpu.GetEvents();
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++)
+    ASSERT_EQ(actual[i], expected[i]) << "event log differs at word " << i;
+}
+
+TEST(GPU, LinkedListNodesMatchFIFO)
+{
+  g_settings.gpu_pgxp_enable = true;
+  TimingEvents::Initialize();
+
+  // Unlimited run-ahead executes every complete packet in place, the default stops part way through nodes.
+  CompareLinkedListPaths(0x10000000, 0x4F54424C);
+  CompareLinkedListPaths(128, 0x464F4331);
+  CompareLinkedListPaths(0, 0x464F4332);
+
+  TimingEvents::Shutdown();
+  g_settings.gpu_pgxp_enable = false;
+}
@@ -0,0 +1,12 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+#include "core/gte_types.h"
+
+namespace GTE::Reference {
+
+/// Executes a GTE command on the given register file with the scalar implementation.
+void ExecuteInstruction(Regs& regs, u32 inst_bits);
+
+} // namespace GTE::Reference
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "core/input_movie.h"
+
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/path.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+static std::string GetTestMoviePath()
+{
+  return Path::Combine(std::filesystem::temp_directory_path().string(), "duckstation-tests.mov");
+}
+
+// Writes the file the same way recording does: a placeholder header, the events as they happen, then the final
+// header once recording stops.
+static void WriteMovie(const std::string& path, u32 start_frame, u32 frame_count,
+                       const std::vector<InputMovie::FileEvent>& events, u32 header_event_count)
+{
+  Error error;
+  FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(path.c_str(), "wb", &error);
+  ASSERT_TRUE(fp) << error.GetDescription();
+  ASSERT_TRUE(InputMovie::WriteFileHeader(fp.get(), start_frame, 0, 0, &error)) << error.GetDescription();
+  for (const InputMovie::FileEvent& ev : events)
+    ASSERT_TRUE(InputMovie::WriteFileEvent(fp.get(), ev, &error)) << error.GetDescription();
+  ASSERT_TRUE(InputMovie::WriteFileHeader(fp.get(), start_frame, frame_count, header_event_count, &error))
+    << error.GetDescription();
+}
+
+static std::vector<InputMovie::FileEvent> MakeEvents(u32 count, u32 frame_count, std::mt19937& rng)
+{
+  std::vector<InputMovie::FileEvent> events(count);
+  u32 frame = 0;
+  for (InputMovie::FileEvent& ev : events)
+  {
+    // Several changes on one frame are common, e.g. both sticks moving.
+    frame = std::min(frame + static_cast<u32>(rng() % 4), frame_count);
+    ev.frame = frame;
+    ev.slot = static_cast<u8>(rng() % 8);
+    ev.reserved = 0;
+    ev.bind_index = static_cast<u16>(rng() % 32);
+    ev.value = static_cast<float>(rng() % 1001) / 1000.0f;
+  }
+
+  return events;
+}
+
+TEST(InputMovie, RecordedEventsPlayBackUnchanged)
+{
+  const std::string path = GetTestMoviePath();
+  std::mt19937 rng(0x444D4F56);
+
+  for (const u32 count : {0u, 1u, 5000u})
+  {
+    const u32 start_frame = static_cast<u32>(rng());
+    const u32 frame_count = 10000;
+    const std::vector<InputMovie::FileEvent> events = MakeEvents(count, frame_count, rng);
+    WriteMovie(path, start_frame, frame_count, events, count);
+
+    u32 read_start_frame, read_frame_count;
+    std::vector<InputMovie::FileEvent> read_events;
+    Error error;
+    ASSERT_TRUE(InputMovie::ReadFile(path.c_str(), &read_start_frame, &read_frame_count, &read_events, &error))
+      << error.GetDescription();
+    EXPECT_EQ(read_start_frame, start_frame);
+    EXPECT_EQ(read_frame_count, frame_count);
+    ASSERT_EQ(read_events.size(), events.size());
+    EXPECT_EQ(std::memcmp(read_events.data(), events.data(), events.size() * sizeof(InputMovie::FileEvent)), 0);
+  }
+
+  FileSystem::DeleteFile(path.c_str());
+}
+
+TEST(InputMovie, RejectsEventCountLargerThanFile)
+{
+  const std::string path = GetTestMoviePath();
+  std::mt19937 rng(0x54524E43);
+  const std::vector<InputMovie::FileEvent> events = MakeEvents(100, 1000, rng);
+
+  // One event short, e.g. a crash before the last write was flushed, and a corrupted count.
+  for (const u32 header_event_count : {101u, 0xFFFFFFFFu})
+  {
+    WriteMovie(path, 0, 1000, events, header_event_count);
+
+    u32 start_frame, frame_count;
+    std::vector<InputMovie::FileEvent> read_events;
+    Error error;
+    EXPECT_FALSE(InputMovie::ReadFile(path.c_str(), &start_frame, &frame_count, &read_events, &error));
+    EXPECT_NE(error.GetDescription().find("truncated"), std::string::npos) << error.GetDescription();
+  }
+
+  FileSystem::DeleteFile(path.c_str());
+}
+
+TEST(InputMovie, RejectsEventsOutOfOrder)
+{
+  const std::string path = GetTestMoviePath();
+  std::mt19937 rng(0x4F524452);
+
+  std::vector<InputMovie::FileEvent> events = MakeEvents(100, 1000, rng);
+  const u32 swapped_frame = events[10].frame;
+  events[10].frame = events[90].frame;
+  events[90].frame = swapped_frame;
+  WriteMovie(path, 0, 1000, events, static_cast<u32>(events.size()));
+
+  u32 start_frame, frame_count;
+  std::vector<InputMovie::FileEvent> read_events;
+  Error error;
+  EXPECT_FALSE(InputMovie::ReadFile(path.c_str(), &start_frame, &frame_count, &read_events, &error));
+
+  // Events past the end of the movie would never be applied.
+  events = MakeEvents(100, 1000, rng);
+  WriteMovie(path, 0, events.back().frame - 1, events, static_cast<u32>(events.size()));
+  EXPECT_FALSE(InputMovie::ReadFile(path.c_str(), &start_frame, &frame_count, &read_events, &error));
+
+  FileSystem::DeleteFile(path.c_str());
+}
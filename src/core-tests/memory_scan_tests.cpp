@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "core/bus.h"
+#include "core/cheats.h"
+#include "core/settings.h"
+
+#include "common/align.h"
+#include "common/bitutils.h"
+#include "common/error.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+struct ReferenceElement
+{
+  u32 address;
+  u32 last_value;
+  bool matched;
+};
+} // namespace
+
+static constexpr MemoryScan::Operator s_operators[] = {
+  MemoryScan::Operator::Any,
+  MemoryScan::Operator::LessThanLast,
+  MemoryScan::Operator::LessEqualLast,
+  MemoryScan::Operator::GreaterThanLast,
+  MemoryScan::Operator::GreaterEqualLast,
+  MemoryScan::Operator::NotEqualLast,
+  MemoryScan::Operator::EqualLast,
+  MemoryScan::Operator::DecreasedBy,
+  MemoryScan::Operator::IncreasedBy,
+  MemoryScan::Operator::ChangedBy,
+  MemoryScan::Operator::Equal,
+  MemoryScan::Operator::NotEqual,
+  MemoryScan::Operator::LessThan,
+  MemoryScan::Operator::LessEqual,
+  MemoryScan::Operator::GreaterThan,
+  MemoryScan::Operator::GreaterEqual,
+};
+
+static u32 ReadElement(u32 address, MemoryAccessSize size, bool is_signed)
+{
+  const u8* ptr = &Bus::g_unprotected_ram[address & Bus::g_ram_mask];
+  switch (size)
+  {
+    case MemoryAccessSize::Byte:
+      return is_signed ? SignExtend32(*ptr) : ZeroExtend32(*ptr);
+
+    case MemoryAccessSize::HalfWord:
+    {
+      u16 value;
+      std::memcpy(&value, ptr, sizeof(value));
+      return is_signed ? SignExtend32(value) : ZeroExtend32(value);
+    }
+
+    case MemoryAccessSize::Word:
+    default:
+    {
+      u32 value;
+      std::memcpy(&value, ptr, sizeof(value));
+      return value;
+    }
+  }
+}
+
+static void WriteElement(u32 address, MemoryAccessSize size, u32 value)
+{
+  std::memcpy(&Bus::g_unprotected_ram[address & Bus::g_ram_mask], &value, 1u << static_cast<u32>(size));
+}
+
+// Values near the comparison value and near the wrap-around points, so that every operator sees both outcomes, and
+// differences overflow in both directions.
+static u32 MakeValue(u32 comp_value, std::mt19937& rng)
+{
+  static constexpr u32 special_values[] = {0x00000000, 0x00000001, 0x0000007F, 0x00000080, 0x000000FF,
+                                           0x00007FFF, 0x00008000, 0x0000FFFF, 0x7FFFFFFF, 0x80000000,
+                                           0xFFFFFF80, 0xFFFF8000, 0xFFFFFFFF};
+  switch (rng() % 3)
+  {
+    case 0:
+      return comp_value + static_cast<u32>(static_cast<s32>(rng() % 5) - 2);
+    case 1:
+      return special_values[rng() % std::size(special_values)];
+    default:
+      return static_cast<u32>(rng());
+  }
+}
+
+// Scans the same random memory with MemoryScan and with Result::Filter() on each element, then changes some of the
+// memory and refines the scan, comparing every match along the way. Operators relative to the last value can only
+// match on the first search if nothing changed, so first_op can be Any to give the refines something to work with.
+static void CompareScan(MemoryAccessSize size, bool is_signed, MemoryScan::Operator first_op, MemoryScan::Operator op,
+                        std::mt19937& rng)
+{
+  const u32 element_size = 1u << static_cast<u32>(size);
+
+  // Unaligned starts, and lengths which leave partial vectors and partial bitmap words at the end.
+  const u32 start_address = 0x1000 + static_cast<u32>(rng() % 8);
+  const u32 end_address = start_address + 1000 + static_cast<u32>(rng() % 4000);
+  const u32 first_address = Common::AlignUpPow2(start_address, element_size);
+  const u32 comp_value = MakeValue(0, rng);
+
+  std::vector<ReferenceElement> elements;
+  for (u32 address = first_address; address < end_address; address += element_size)
+  {
+    WriteElement(address, size, MakeValue(comp_value, rng));
+    elements.push_back(ReferenceElement{address, ReadElement(address, size, is_signed), true});
+  }
+
+  MemoryScan scan;
+  scan.SetSize(size);
+  scan.SetValueSigned(is_signed);
+  scan.SetOperator(first_op);
+  scan.SetValue(comp_value);
+  scan.SetStartAddress(start_address);
+  scan.SetEndAddress(end_address);
+
+  for (u32 pass = 0; pass < 3; pass++)
+  {
+    if (pass == 0)
+    {
+      scan.Search();
+    }
+    else
+    {
+      // Change about half of the elements, some of them by exactly the comparison value.
+      for (const ReferenceElement& elem : elements)
+      {
+        if (rng() % 2)
+        {
+          const u32 old_value = ReadElement(elem.address, size, is_signed);
+          WriteElement(elem.address, size,
+                       (rng() % 2) ? (old_value + ((rng() % 2) ? comp_value : (0u - comp_value))) :
+                                     MakeValue(old_value, rng));
+        }
+      }
+
+      scan.SetOperator(op);
+      scan.SearchAgain();
+    }
+
+    std::vector<MemoryScan::Result> expected;
+    for (ReferenceElement& elem : elements)
+    {
+      MemoryScan::Result res;
+      res.address = elem.address;
+      res.value = ReadElement(elem.address, size, is_signed);
+      res.last_value = (pass == 0) ? res.value : elem.last_value;
+      res.value_changed = false;
+      elem.matched = elem.matched && res.Filter((pass == 0) ? first_op : op, comp_value, is_signed);
+      elem.last_value = res.value;
+      if (elem.matched)
+        expected.push_back(res);
+    }
+
+    ASSERT_EQ(scan.GetResultCount(), static_cast<u32>(expected.size())) << "pass " << pass;
+
+    const MemoryScan::ResultVector& results = scan.GetResults();
+    ASSERT_EQ(results.size(), std::min<size_t>(expected.size(), MemoryScan::MAX_LISTED_RESULTS)) << "pass " << pass;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+      ASSERT_EQ(results[i].address, expected[i].address) << "pass " << pass << ", result " << i;
+      ASSERT_EQ(results[i].value, expected[i].value) << "pass " << pass << ", result " << i;
+    }
+  }
+}
+
+TEST(MemoryScan, MatchesScalarFilter)
+{
+  g_settings.cpu_fastmem_mode = CPUFastmemMode::Disabled;
+  g_settings.enable_8mb_ram = false;
+
+  Error error;
+  ASSERT_TRUE(Bus::AllocateMemory(false, &error)) << error.GetDescription();
+  Bus::Initialize();
+
+  std::mt19937 rng(0x5343414E);
+  for (const MemoryAccessSize size : {MemoryAccessSize::Byte, MemoryAccessSize::HalfWord, MemoryAccessSize::Word})
+  {
+    for (const bool is_signed : {false, true})
+    {
+      for (const MemoryScan::Operator op : s_operators)
+      {
+        for (u32 iteration = 0; iteration < 8; iteration++)
+        {
+          SCOPED_TRACE(testing::Message() << "size " << static_cast<u32>(size) << ", signed " << is_signed
+                                          << ", operator " << static_cast<u32>(op) << ", iteration " << iteration);
+          CompareScan(size, is_signed, (iteration & 1) ? MemoryScan::Operator::Any : op, op, rng);
+          if (testing::Test::HasFatalFailure())
+            break;
+        }
+      }
+    }
+  }
+
+  Bus::Shutdown();
+  Bus::ReleaseMemory();
+}
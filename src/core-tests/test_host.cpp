@@ -0,0 +1,319 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+// Host interface for the core tests. No system is ever booted, so nothing here is expected to be called, these only
+// exist to satisfy the linker.
+
+#include "core/achievements.h"
+#include "core/fullscreen_ui.h"
+#include "core/game_list.h"
+#include "core/host.h"
+#include "core/system.h"
+
+#include "util/gpu_device.h"
+#include "util/imgui_fullscreen.h"
+#include "util/imgui_manager.h"
+#include "util/input_manager.h"
+#include "util/platform_misc.h"
+
+#include "common/log.h"
+#include "common/small_string.h"
+
+#include <cstdlib>
+#include <cstring>
+
+Log_SetChannel(TestHost);
+
+void Host::ReportFatalError(std::string_view title, std::string_view message)
+{
+  ERROR_LOG("ReportFatalError: {}", message);
+  std::abort();
+}
+
+void Host::ReportErrorAsync(std::string_view title, std::string_view message)
+{
+  ERROR_LOG("ReportErrorAsync: {}", message);
+}
+
+bool Host::ConfirmMessage(std::string_view title, std::string_view message)
+{
+  return true;
+}
+
+void Host::ReportDebuggerMessage(std::string_view message)
+{
+  //
+}
+
+std::span<const std::pair<const char*, const char*>> Host::GetAvailableLanguageList()
+{
+  return {};
+}
+
+bool Host::ChangeLanguage(const char* new_language)
+{
+  return false;
+}
+
+s32 Host::Internal::GetTranslatedStringImpl(std::string_view context, std::string_view msg,
+                                            std::string_view disambiguation, char* tbuf, size_t tbuf_space)
+{
+  if (msg.size() > tbuf_space)
+    return -1;
+  else if (msg.empty())
+    return 0;
+
+  std::memcpy(tbuf, msg.data(), msg.size());
+  return static_cast<s32>(msg.size());
+}
+
+std::string Host::TranslatePluralToString(const char* context, const char* msg, const char* disambiguation, int count)
+{
+  return std::string(msg);
+}
+
+SmallString Host::TranslatePluralToSmallString(const char* context, const char* msg, const char* disambiguation,
+                                               int count)
+{
+  return SmallString(msg);
+}
+
+void Host::LoadSettings(SettingsInterface& si, std::unique_lock<std::mutex>& lock)
+{
+  //
+}
+
+void Host::CheckForSettingsChanges(const Settings& old_settings)
+{
+  //
+}
+
+void Host::CommitBaseSettingChanges()
+{
+  //
+}
+
+bool Host::ResourceFileExists(std::string_view filename, bool allow_override)
+{
+  return false;
+}
+
+std::optional<DynamicHeapArray<u8>> Host::ReadResourceFile(std::string_view filename, bool allow_override)
+{
+  return std::nullopt;
+}
+
+std::optional<std::string> Host::ReadResourceFileToString(std::string_view filename, bool allow_override)
+{
+  return std::nullopt;
+}
+
+std::optional<std::time_t> Host::GetResourceFileTimestamp(std::string_view filename, bool allow_override)
+{
+  return std::nullopt;
+}
+
+void Host::OnSystemStarting()
+{
+  //
+}
+
+void Host::OnSystemStarted()
+{
+  //
+}
+
+void Host::OnSystemDestroyed()
+{
+  //
+}
+
+void Host::OnSystemPaused()
+{
+  //
+}
+
+void Host::OnSystemResumed()
+{
+  //
+}
+
+void Host::OnIdleStateChanged()
+{
+  //
+}
+
+void Host::OnPerformanceCountersUpdated()
+{
+  //
+}
+
+void Host::OnGameChanged(const std::string& disc_path, const std::string& game_serial, const std::string& game_name)
+{
+  //
+}
+
+void Host::OnMediaCaptureStarted()
+{
+  //
+}
+
+void Host::OnMediaCaptureStopped()
+{
+  //
+}
+
+void Host::PumpMessagesOnCPUThread()
+{
+  //
+}
+
+void Host::RunOnCPUThread(std::function<void()> function, bool block /* = false */)
+{
+  function();
+}
+
+void Host::RequestResizeHostDisplay(s32 width, s32 height)
+{
+  //
+}
+
+void Host::RequestExitApplication(bool save_state_if_running)
+{
+  //
+}
+
+void Host::RequestExitBigPicture()
+{
+  //
+}
+
+void Host::RequestSystemShutdown(bool allow_confirm, bool save_state)
+{
+  //
+}
+
+bool Host::IsFullscreen()
+{
+  return false;
+}
+
+void Host::SetFullscreen(bool enabled)
+{
+  //
+}
+
+std::optional<WindowInfo> Host::AcquireRenderWindow(bool recreate_window)
+{
+  return std::nullopt;
+}
+
+void Host::ReleaseRenderWindow()
+{
+  //
+}
+
+void Host::FrameDone()
+{
+  //
+}
+
+void Host::OpenURL(std::string_view url)
+{
+  //
+}
+
+bool Host::CopyTextToClipboard(std::string_view text)
+{
+  return false;
+}
+
+void Host::SetMouseMode(bool relative, bool hide_cursor)
+{
+  //
+}
+
+void Host::OnAchievementsLoginRequested(Achievements::LoginRequestReason reason)
+{
+  //
+}
+
+void Host::OnAchievementsLoginSuccess(const char* username, u32 points, u32 sc_points, u32 unread_messages)
+{
+  //
+}
+
+void Host::OnAchievementsRefreshed()
+{
+  //
+}
+
+void Host::OnAchievementsHardcoreModeChanged(bool enabled)
+{
+  //
+}
+
+void Host::OnCoverDownloaderOpenRequested()
+{
+  //
+}
+
+bool Host::ShouldPreferHostFileSelector()
+{
+  return false;
+}
+
+void Host::OpenHostFileSelectorAsync(std::string_view title, bool select_directory, FileSelectorCallback callback,
+                                     FileSelectorFilters filters /* = FileSelectorFilters() */,
+                                     std::string_view initial_directory /* = std::string_view() */)
+{
+  callback(std::string());
+}
+
+std::optional<u32> InputManager::ConvertHostKeyboardStringToCode(std::string_view str)
+{
+  return std::nullopt;
+}
+
+std::optional<std::string> InputManager::ConvertHostKeyboardCodeToString(u32 code)
+{
+  return std::nullopt;
+}
+
+const char* InputManager::ConvertHostKeyboardCodeToIcon(u32 code)
+{
+  return nullptr;
+}
+
+void Host::AddFixedInputBindings(SettingsInterface& si)
+{
+  //
+}
+
+void Host::OnInputDeviceConnected(std::string_view identifier, std::string_view device_name)
+{
+  //
+}
+
+void Host::OnInputDeviceDisconnected(InputBindingKey key, std::string_view identifier)
+{
+  //
+}
+
+std::optional<WindowInfo> Host::GetTopLevelWindowInfo()
+{
+  return std::nullopt;
+}
+
+void Host::RefreshGameListAsync(bool invalidate_cache)
+{
+  //
+}
+
+void Host::CancelGameListRefresh()
+{
+  //
+}
+
+BEGIN_HOTKEY_LIST(g_host_hotkeys)
+END_HOTKEY_LIST()
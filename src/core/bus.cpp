@@ -164,6 +164,7 @@ static void UnmapFastmemViews();
 static u8* GetLUTFastmemPointer(u32 address, u8* ram_ptr);
 
 static void SetRAMPageWritable(u32 page_index, bool writable);
+static void LoadChangedRAMPages(const u8* data);
 
 static void KernelInitializedHook();
 static bool SideloadEXE(const std::string& path, Error* error);
@@ -431,7 +432,7 @@ void Bus::Reset()
   }
 }
 
-bool Bus::DoState(StateWrapper& sw)
+bool Bus::DoState(StateWrapper& sw, bool is_memory_state)
 {
   u32 ram_size = g_ram_size;
   sw.DoEx(&ram_size, 52, static_cast<u32>(RAM_2MB_SIZE));
@@ -440,6 +441,12 @@ bool Bus::DoState(StateWrapper& sw)
     const bool using_8mb_ram = (ram_size == RAM_8MB_SIZE);
     SetRAMSize(using_8mb_ram);
     RemapFastmemViews();
+
+    if (is_memory_state)
+    {
+      CPU::CodeCache::InvalidateAllRAMBlocks();
+      is_memory_state = false;
+    }
   }
 
   sw.Do(&g_exp1_access_time);
@@ -447,7 +454,18 @@ bool Bus::DoState(StateWrapper& sw)
   sw.Do(&g_bios_access_time);
   sw.Do(&g_cdrom_access_time);
   sw.Do(&g_spu_access_time);
-  sw.DoBytes(g_ram, g_ram_size);
+
+  if (sw.IsReading() && is_memory_state)
+  {
+    // Runahead loads a memory state every time the input changes. Rolling back a few frames rarely touches code, so
+    // keep the compiled blocks for any pages which are unchanged, instead of throwing them all away.
+    if (const u8* ram_data = sw.ReadBytesInPlace(g_ram_size))
+      LoadChangedRAMPages(ram_data);
+  }
+  else
+  {
+    sw.DoBytes(g_ram, g_ram_size);
+  }
 
   if (sw.GetVersion() < 58) [[unlikely]]
   {
@@ -469,6 +487,27 @@ bool Bus::DoState(StateWrapper& sw)
   return !sw.HasError();
 }
 
+void Bus::LoadChangedRAMPages(const u8* data)
+{
+  const u32 num_pages = g_ram_size / HOST_PAGE_SIZE;
+  for (u32 i = 0; i < num_pages; i++)
+  {
+    u8* page = &g_ram[i * HOST_PAGE_SIZE];
+    const u8* src = &data[i * HOST_PAGE_SIZE];
+
+    // Code pages are write protected, so they have to be unprotected and their blocks invalidated before copying.
+    if (g_ram_code_bits[i])
+    {
+      if (std::memcmp(page, src, HOST_PAGE_SIZE) == 0)
+        continue;
+
+      CPU::CodeCache::InvalidateBlocksForStateLoad(i);
+    }
+
+    std::memcpy(page, src, HOST_PAGE_SIZE);
+  }
+}
+
 std::tuple<TickCount, TickCount, TickCount> Bus::CalculateMemoryTiming(MEMDELAY mem_delay, COMDELAY common_delay)
 {
   // from nocash spec
@@ -130,7 +130,7 @@ void CleanupMemoryMap();
 void Initialize();
 void Shutdown();
 void Reset();
-bool DoState(StateWrapper& sw);
+bool DoState(StateWrapper& sw, bool is_memory_state);
 
 using MemoryReadHandler = u32 (*)(VirtualMemoryAddress address);
 using MemoryWriteHandler = void (*)(VirtualMemoryAddress, u32);
@@ -421,7 +421,7 @@ static std::array<std::array<u8, 2>, 2> s_cd_audio_volume_matrix{};
 static std::array<std::array<u8, 2>, 2> s_next_cd_audio_volume_matrix{};
 
 static std::array<s32, 4> s_xa_last_samples{};
-static std::array<std::array<s16, XA_RESAMPLE_RING_BUFFER_SIZE>, 2> s_xa_resample_ring_buffer{};
+static std::array<std::array<s16, XA_RESAMPLE_RING_BUFFER_SIZE * 2>, 2> s_xa_resample_ring_buffer{};
 static u8 s_xa_resample_p = 0;
 static u8 s_xa_resample_sixstep = 6;
 
@@ -719,7 +719,13 @@ bool CDROM::DoState(StateWrapper& sw)
   sw.Do(&s_cd_audio_volume_matrix);
   sw.Do(&s_next_cd_audio_volume_matrix);
   sw.Do(&s_xa_last_samples);
-  sw.Do(&s_xa_resample_ring_buffer);
+  for (auto& ring_buffer : s_xa_resample_ring_buffer)
+  {
+    // only the first half is saved, the second half is a mirror
+    sw.DoArray(ring_buffer.data(), XA_RESAMPLE_RING_BUFFER_SIZE);
+    if (sw.IsReading())
+      std::copy_n(ring_buffer.data(), XA_RESAMPLE_RING_BUFFER_SIZE, ring_buffer.data() + XA_RESAMPLE_RING_BUFFER_SIZE);
+  }
   sw.Do(&s_xa_resample_p);
   sw.Do(&s_xa_resample_sixstep);
   sw.Do(&s_param_fifo);
@@ -3228,6 +3234,12 @@ void CDROM::DecodeXAADPCMChunks(const u8* chunk_ptr, s16* samples)
     const u8* headers_ptr = chunk_ptr + 4;
     const u8* words_ptr = chunk_ptr + 16;
 
+    // Only the filter has a dependency on the previous sample, so the sample data for each block can be extracted and
+    // shifted four words at a time. NOTE: assumes LE
+    std::array<GSVector4i, WORDS_PER_BLOCK / 4> words;
+    for (u32 word = 0; word < WORDS_PER_BLOCK; word += 4)
+      words[word / 4] = GSVector4i::load<false>(&words_ptr[word * sizeof(u32)]);
+
     for (u32 block = 0; block < NUM_BLOCKS; block++)
     {
       const XA_ADPCMBlockHeader block_header{headers_ptr[block]};
@@ -3236,32 +3248,40 @@ void CDROM::DecodeXAADPCMChunks(const u8* chunk_ptr, s16* samples)
       const s32 filter_pos = s_xa_adpcm_filter_table_pos[filter];
       const s32 filter_neg = s_xa_adpcm_filter_table_neg[filter];
 
+      // move the nibble/byte for this block to the top of the word, then sign extend it back down
+      std::array<s32, WORDS_PER_BLOCK> block_samples;
+      const s32 sample_shift_left = IS_8BIT ? (24 - static_cast<s32>(block) * 8) : (28 - static_cast<s32>(block) * 4);
+      const GSVector4i sample_mask = GSVector4i::cxpr(static_cast<s32>(IS_8BIT ? 0xFF000000u : 0xF0000000u));
+      for (u32 word = 0; word < WORDS_PER_BLOCK; word += 4)
+      {
+        GSVector4i::store<false>(&block_samples[word],
+                                 (words[word / 4].sll32(sample_shift_left) & sample_mask).sra32(16 + shift));
+      }
+
       s16* out_samples_ptr =
         IS_STEREO ? &samples[(block / 2) * (WORDS_PER_BLOCK * 2) + (block % 2)] : &samples[block * WORDS_PER_BLOCK];
       constexpr u32 out_samples_increment = IS_STEREO ? 2 : 1;
 
-      for (u32 word = 0; word < 28; word++)
-      {
-        // NOTE: assumes LE
-        u32 word_data;
-        std::memcpy(&word_data, &words_ptr[word * sizeof(u32)], sizeof(word_data));
-
-        // extract nibble from block
-        const u32 nibble = IS_8BIT ? ((word_data >> (block * 8)) & 0xFF) : ((word_data >> (block * 4)) & 0x0F);
-        const s16 sample = static_cast<s16>(Truncate16(nibble << (IS_8BIT ? 8 : 12))) >> shift;
+      // mix in previous values
+      s32* prev = IS_STEREO ? &s_xa_last_samples[(block & 1) * 2] : &s_xa_last_samples[0];
+      s32 prev0 = prev[0];
+      s32 prev1 = prev[1];
 
-        // mix in previous values
-        s32* prev = IS_STEREO ? &s_xa_last_samples[(block & 1) * 2] : &s_xa_last_samples[0];
+      for (u32 word = 0; word < WORDS_PER_BLOCK; word++)
+      {
         const s32 interp_sample = std::clamp<s32>(
-          static_cast<s32>(sample) + ((prev[0] * filter_pos) >> 6) + ((prev[1] * filter_neg) >> 6), -32767, 32768);
+          block_samples[word] + ((prev0 * filter_pos) >> 6) + ((prev1 * filter_neg) >> 6), -32767, 32768);
 
         // update previous values
-        prev[1] = prev[0];
-        prev[0] = interp_sample;
+        prev1 = prev0;
+        prev0 = interp_sample;
 
         *out_samples_ptr = static_cast<s16>(interp_sample);
         out_samples_ptr += out_samples_increment;
       }
+
+      prev[0] = prev0;
+      prev[1] = prev1;
     }
 
     samples += SAMPLES_PER_CHUNK;
@@ -3272,36 +3292,57 @@ void CDROM::DecodeXAADPCMChunks(const u8* chunk_ptr, s16* samples)
 template<bool STEREO>
 void CDROM::ResampleXAADPCM(const s16* frames_in, u32 num_frames_in)
 {
+  static constexpr std::array<std::array<s16, XA_RESAMPLE_ZIGZAG_TABLE_SIZE>, XA_RESAMPLE_NUM_ZIGZAG_TABLES> tables = {
+    {{0,      0x0,     0x0,     0x0,    0x0,     -0x0002, 0x000A,  -0x0022, 0x0041, -0x0054,
+      0x0034, 0x0009,  -0x010A, 0x0400, -0x0A78, 0x234C,  0x6794,  -0x1780, 0x0BCD, -0x0623,
+      0x0350, -0x016D, 0x006B,  0x000A, -0x0010, 0x0011,  -0x0008, 0x0003,  -0x0001},
+     {0,       0x0,    0x0,     -0x0002, 0x0,    0x0003,  -0x0013, 0x003C,  -0x004B, 0x00A2,
+      -0x00E3, 0x0132, -0x0043, -0x0267, 0x0C9D, 0x74BB,  -0x11B4, 0x09B8,  -0x05BF, 0x0372,
+      -0x01A8, 0x00A6, -0x001B, 0x0005,  0x0006, -0x0008, 0x0003,  -0x0001, 0x0},
+     {0,      0x0,     -0x0001, 0x0003,  -0x0002, -0x0005, 0x001F,  -0x004A, 0x00B3, -0x0192,
+      0x02B1, -0x039E, 0x04F8,  -0x05A6, 0x7939,  -0x05A6, 0x04F8,  -0x039E, 0x02B1, -0x0192,
+      0x00B3, -0x004A, 0x001F,  -0x0005, -0x0002, 0x0003,  -0x0001, 0x0,     0x0},
+     {0,       -0x0001, 0x0003,  -0x0008, 0x0006, 0x0005,  -0x001B, 0x00A6, -0x01A8, 0x0372,
+      -0x05BF, 0x09B8,  -0x11B4, 0x74BB,  0x0C9D, -0x0267, -0x0043, 0x0132, -0x00E3, 0x00A2,
+      -0x004B, 0x003C,  -0x0013, 0x0003,  0x0,    -0x0002, 0x0,     0x0,    0x0},
+     {-0x0001, 0x0003,  -0x0008, 0x0011,  -0x0010, 0x000A, 0x006B,  -0x016D, 0x0350, -0x0623,
+      0x0BCD,  -0x1780, 0x6794,  0x234C,  -0x0A78, 0x0400, -0x010A, 0x0009,  0x0034, -0x0054,
+      0x0041,  -0x0022, 0x000A,  -0x0001, 0x0,     0x0001, 0x0,     0x0,     0x0},
+     {0x0002,  -0x0008, 0x0010,  -0x0023, 0x002B, 0x001A,  -0x00EB, 0x027B,  -0x0548, 0x0AFA,
+      -0x16FA, 0x53E0,  0x3C07,  -0x1249, 0x080E, -0x0347, 0x015B,  -0x0044, -0x0017, 0x0046,
+      -0x0023, 0x0011,  -0x0005, 0x0,     0x0,    0x0,     0x0,     0x0,     0x0},
+     {-0x0005, 0x0011,  -0x0023, 0x0046, -0x0017, -0x0044, 0x015B,  -0x0347, 0x080E, -0x1249,
+      0x3C07,  0x53E0,  -0x16FA, 0x0AFA, -0x0548, 0x027B,  -0x00EB, 0x001A,  0x002B, -0x0023,
+      0x0010,  -0x0008, 0x0002,  0x0,    0x0,     0x0,     0x0,     0x0,     0x0}}};
+
+  // Taps are reversed and padded out to the ring buffer size, so that the filter can be applied to a contiguous window
+  // of the mirrored ring buffer, oldest sample first.
+  static constexpr auto reversed_tables = []() {
+    std::array<std::array<s16, XA_RESAMPLE_RING_BUFFER_SIZE>, XA_RESAMPLE_NUM_ZIGZAG_TABLES> ret = {};
+    for (u32 i = 0; i < XA_RESAMPLE_NUM_ZIGZAG_TABLES; i++)
+    {
+      for (u32 j = 0; j < XA_RESAMPLE_ZIGZAG_TABLE_SIZE; j++)
+        ret[i][j] = tables[i][XA_RESAMPLE_ZIGZAG_TABLE_SIZE - 1 - j];
+    }
+    return ret;
+  }();
+
   static constexpr auto zigzag_interpolate = [](const s16* ringbuf, u32 table_index, u32 p) -> s16 {
-    static std::array<std::array<s16, 29>, 7> tables = {
-      {{0,      0x0,     0x0,     0x0,    0x0,     -0x0002, 0x000A,  -0x0022, 0x0041, -0x0054,
-        0x0034, 0x0009,  -0x010A, 0x0400, -0x0A78, 0x234C,  0x6794,  -0x1780, 0x0BCD, -0x0623,
-        0x0350, -0x016D, 0x006B,  0x000A, -0x0010, 0x0011,  -0x0008, 0x0003,  -0x0001},
-       {0,       0x0,    0x0,     -0x0002, 0x0,    0x0003,  -0x0013, 0x003C,  -0x004B, 0x00A2,
-        -0x00E3, 0x0132, -0x0043, -0x0267, 0x0C9D, 0x74BB,  -0x11B4, 0x09B8,  -0x05BF, 0x0372,
-        -0x01A8, 0x00A6, -0x001B, 0x0005,  0x0006, -0x0008, 0x0003,  -0x0001, 0x0},
-       {0,      0x0,     -0x0001, 0x0003,  -0x0002, -0x0005, 0x001F,  -0x004A, 0x00B3, -0x0192,
-        0x02B1, -0x039E, 0x04F8,  -0x05A6, 0x7939,  -0x05A6, 0x04F8,  -0x039E, 0x02B1, -0x0192,
-        0x00B3, -0x004A, 0x001F,  -0x0005, -0x0002, 0x0003,  -0x0001, 0x0,     0x0},
-       {0,       -0x0001, 0x0003,  -0x0008, 0x0006, 0x0005,  -0x001B, 0x00A6, -0x01A8, 0x0372,
-        -0x05BF, 0x09B8,  -0x11B4, 0x74BB,  0x0C9D, -0x0267, -0x0043, 0x0132, -0x00E3, 0x00A2,
-        -0x004B, 0x003C,  -0x0013, 0x0003,  0x0,    -0x0002, 0x0,     0x0,    0x0},
-       {-0x0001, 0x0003,  -0x0008, 0x0011,  -0x0010, 0x000A, 0x006B,  -0x016D, 0x0350, -0x0623,
-        0x0BCD,  -0x1780, 0x6794,  0x234C,  -0x0A78, 0x0400, -0x010A, 0x0009,  0x0034, -0x0054,
-        0x0041,  -0x0022, 0x000A,  -0x0001, 0x0,     0x0001, 0x0,     0x0,     0x0},
-       {0x0002,  -0x0008, 0x0010,  -0x0023, 0x002B, 0x001A,  -0x00EB, 0x027B,  -0x0548, 0x0AFA,
-        -0x16FA, 0x53E0,  0x3C07,  -0x1249, 0x080E, -0x0347, 0x015B,  -0x0044, -0x0017, 0x0046,
-        -0x0023, 0x0011,  -0x0005, 0x0,     0x0,    0x0,     0x0,     0x0,     0x0},
-       {-0x0005, 0x0011,  -0x0023, 0x0046, -0x0017, -0x0044, 0x015B,  -0x0347, 0x080E, -0x1249,
-        0x3C07,  0x53E0,  -0x16FA, 0x0AFA, -0x0548, 0x027B,  -0x00EB, 0x001A,  0x002B, -0x0023,
-        0x0010,  -0x0008, 0x0002,  0x0,    0x0,     0x0,     0x0,     0x0,     0x0}}};
+    const s16* window = &ringbuf[(p - (XA_RESAMPLE_ZIGZAG_TABLE_SIZE - 1)) & 0x1F];
+    const s16* table = reversed_tables[table_index].data();
 
-    const s16* table = tables[table_index].data();
-    s32 sum = 0;
-    for (u32 i = 0; i < 29; i++)
-      sum += (static_cast<s32>(ringbuf[(p - i) & 0x1F]) * static_cast<s32>(table[i])) >> 15;
+    // Each product is shifted individually, and (sample * tap) >> 15 always fits in 16 bits since no tap is -0x8000.
+    // Reassemble it from the high and low halves of the product, and widen while summing.
+    GSVector4i sum = GSVector4i::zero();
+    for (u32 i = 0; i < XA_RESAMPLE_RING_BUFFER_SIZE; i += 8)
+    {
+      const GSVector4i samples = GSVector4i::load<false>(&window[i]);
+      const GSVector4i taps = GSVector4i::load<false>(&table[i]);
+      const GSVector4i terms = samples.mul16hs(taps).sll16<1>() | samples.mul16l(taps).srl16<15>();
+      sum = sum.add32(terms.madd_s16(GSVector4i::cxpr16(1)));
+    }
 
-    return static_cast<s16>(std::clamp<s32>(sum, -0x8000, 0x7FFF));
+    return static_cast<s16>(std::clamp<s32>(sum.addv_s32(), -0x8000, 0x7FFF));
   };
 
   s16* const left_ringbuf = s_xa_resample_ring_buffer[0].data();
@@ -3311,11 +3352,10 @@ void CDROM::ResampleXAADPCM(const s16* frames_in, u32 num_frames_in)
 
   for (u32 in_sample_index = 0; in_sample_index < num_frames_in; in_sample_index++)
   {
-    // TODO: We can vectorize the multiplications in zigzag_interpolate by duplicating the sample in the ringbuffer at
-    // offset +32, allowing it to wrap once.
-    left_ringbuf[p] = *(frames_in++);
+    // The ring buffer is mirrored at +32, so the filter window never has to wrap.
+    left_ringbuf[p] = left_ringbuf[p + XA_RESAMPLE_RING_BUFFER_SIZE] = *(frames_in++);
     if constexpr (STEREO)
-      right_ringbuf[p] = *(frames_in++);
+      right_ringbuf[p] = right_ringbuf[p + XA_RESAMPLE_RING_BUFFER_SIZE] = *(frames_in++);
     p = (p + 1) % 32;
     sixstep--;
 
@@ -3342,30 +3382,34 @@ void CDROM::ResampleXAADPCM18900(const s16* frames_in, u32 num_frames_in)
   // somehow. This doesn't appear to use a zigzag pattern like psx-spx suggests, therefore it is restricted to only
   // 18900hz resampling. Duplicating the 18900hz samples to 37800hz sounds even more awful than lower sample rate audio
   // should, with a big spike at ~16KHz, especially with music in FMVs. Fortunately, few games actually use 18900hz XA.
+  static constexpr u32 NUM_TAPS = 25;
+  static constexpr std::array<std::array<s16, XA_RESAMPLE_RING_BUFFER_SIZE>, 7> tables = {{
+    {{0x0,     -0x5,  0x11,   -0x23, 0x46,  -0x17, -0x44, 0x15b, -0x347, 0x80e, -0x1249, 0x3c07, 0x53e0,
+      -0x16fa, 0xafa, -0x548, 0x27b, -0xeb, 0x1a,  0x2b,  -0x23, 0x10,   -0x8,  0x2,     0x0}},
+    {{0x0,     -0x2,  0xa,    -0x22, 0x41,   -0x54, 0x34, 0x9,   -0x10a, 0x400, -0xa78, 0x234c, 0x6794,
+      -0x1780, 0xbcd, -0x623, 0x350, -0x16d, 0x6b,  0xa,  -0x10, 0x11,   -0x8,  0x3,    -0x1}},
+    {{-0x2,    0x0,   0x3,    -0x13, 0x3c,   -0x4b, 0xa2,  -0xe3, 0x132, -0x43, -0x267, 0xc9d, 0x74bb,
+      -0x11b4, 0x9b8, -0x5bf, 0x372, -0x1a8, 0xa6,  -0x1b, 0x5,   0x6,   -0x8,  0x3,    -0x1}},
+    {{-0x1,   0x3,   -0x2,   -0x5,  0x1f,   -0x4a, 0xb3,  -0x192, 0x2b1, -0x39e, 0x4f8, -0x5a6, 0x7939,
+      -0x5a6, 0x4f8, -0x39e, 0x2b1, -0x192, 0xb3,  -0x4a, 0x1f,   -0x5,  -0x2,   0x3,   -0x1}},
+    {{-0x1,  0x3,    -0x8,  0x6,   0x5,   -0x1b, 0xa6,  -0x1a8, 0x372, -0x5bf, 0x9b8, -0x11b4, 0x74bb,
+      0xc9d, -0x267, -0x43, 0x132, -0xe3, 0xa2,  -0x4b, 0x3c,   -0x13, 0x3,    0x0,   -0x2}},
+    {{-0x1,   0x3,    -0x8,  0x11,   -0x10, 0xa,  0x6b,  -0x16d, 0x350, -0x623, 0xbcd, -0x1780, 0x6794,
+      0x234c, -0xa78, 0x400, -0x10a, 0x9,   0x34, -0x54, 0x41,   -0x22, 0xa,    -0x2,  0x0}},
+    {{0x0,    0x2,     -0x8,  0x10,   -0x23, 0x2b,  0x1a,  -0xeb, 0x27b, -0x548, 0xafa, -0x16fa, 0x53e0,
+      0x3c07, -0x1249, 0x80e, -0x347, 0x15b, -0x44, -0x17, 0x46,  -0x23, 0x11,   -0x5,  0x0}},
+  }};
+
+  // Taps are zero-padded to the ring buffer size, and applied to a contiguous window of the mirrored ring buffer.
   static constexpr auto interpolate = [](const s16* ringbuf, u32 table_index, u32 p) -> s16 {
-    static std::array<std::array<s16, 25>, 7> tables = {{
-      {{0x0,     -0x5,  0x11,   -0x23, 0x46,  -0x17, -0x44, 0x15b, -0x347, 0x80e, -0x1249, 0x3c07, 0x53e0,
-        -0x16fa, 0xafa, -0x548, 0x27b, -0xeb, 0x1a,  0x2b,  -0x23, 0x10,   -0x8,  0x2,     0x0}},
-      {{0x0,     -0x2,  0xa,    -0x22, 0x41,   -0x54, 0x34, 0x9,   -0x10a, 0x400, -0xa78, 0x234c, 0x6794,
-        -0x1780, 0xbcd, -0x623, 0x350, -0x16d, 0x6b,  0xa,  -0x10, 0x11,   -0x8,  0x3,    -0x1}},
-      {{-0x2,    0x0,   0x3,    -0x13, 0x3c,   -0x4b, 0xa2,  -0xe3, 0x132, -0x43, -0x267, 0xc9d, 0x74bb,
-        -0x11b4, 0x9b8, -0x5bf, 0x372, -0x1a8, 0xa6,  -0x1b, 0x5,   0x6,   -0x8,  0x3,    -0x1}},
-      {{-0x1,   0x3,   -0x2,   -0x5,  0x1f,   -0x4a, 0xb3,  -0x192, 0x2b1, -0x39e, 0x4f8, -0x5a6, 0x7939,
-        -0x5a6, 0x4f8, -0x39e, 0x2b1, -0x192, 0xb3,  -0x4a, 0x1f,   -0x5,  -0x2,   0x3,   -0x1}},
-      {{-0x1,  0x3,    -0x8,  0x6,   0x5,   -0x1b, 0xa6,  -0x1a8, 0x372, -0x5bf, 0x9b8, -0x11b4, 0x74bb,
-        0xc9d, -0x267, -0x43, 0x132, -0xe3, 0xa2,  -0x4b, 0x3c,   -0x13, 0x3,    0x0,   -0x2}},
-      {{-0x1,   0x3,    -0x8,  0x11,   -0x10, 0xa,  0x6b,  -0x16d, 0x350, -0x623, 0xbcd, -0x1780, 0x6794,
-        0x234c, -0xa78, 0x400, -0x10a, 0x9,   0x34, -0x54, 0x41,   -0x22, 0xa,    -0x2,  0x0}},
-      {{0x0,    0x2,     -0x8,  0x10,   -0x23, 0x2b,  0x1a,  -0xeb, 0x27b, -0x548, 0xafa, -0x16fa, 0x53e0,
-        0x3c07, -0x1249, 0x80e, -0x347, 0x15b, -0x44, -0x17, 0x46,  -0x23, 0x11,   -0x5,  0x0}},
-    }};
-
+    const s16* window = &ringbuf[(p + XA_RESAMPLE_RING_BUFFER_SIZE - NUM_TAPS) & 0x1F];
     const s16* table = tables[table_index].data();
-    s32 sum = 0;
-    for (u32 i = 0; i < 25; i++)
-      sum += (static_cast<s32>(ringbuf[(p + 32 - 25 + i) & 0x1F]) * static_cast<s32>(table[i]));
 
-    return static_cast<s16>(std::clamp<s32>(sum >> 15, -0x8000, 0x7FFF));
+    GSVector4i sum = GSVector4i::zero();
+    for (u32 i = 0; i < XA_RESAMPLE_RING_BUFFER_SIZE; i += 8)
+      sum = sum.add32(GSVector4i::load<false>(&window[i]).madd_s16(GSVector4i::load<false>(&table[i])));
+
+    return static_cast<s16>(std::clamp<s32>(sum.addv_s32() >> 15, -0x8000, 0x7FFF));
   };
 
   s16* const left_ringbuf = s_xa_resample_ring_buffer[0].data();
@@ -3380,9 +3424,9 @@ void CDROM::ResampleXAADPCM18900(const s16* frames_in, u32 num_frames_in)
       sixstep -= 7;
       p = (p + 1) % 32;
 
-      left_ringbuf[p] = *(frames_in++);
+      left_ringbuf[p] = left_ringbuf[p + XA_RESAMPLE_RING_BUFFER_SIZE] = *(frames_in++);
       if constexpr (STEREO)
-        right_ringbuf[p] = *(frames_in++);
+        right_ringbuf[p] = right_ringbuf[p + XA_RESAMPLE_RING_BUFFER_SIZE] = *(frames_in++);
 
       in_sample_index++;
     }
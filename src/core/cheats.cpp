@@ -8,12 +8,17 @@
 #include "host.h"
 #include "system.h"
 
+#include "common/align.h"
 #include "common/file_system.h"
+#include "common/gsvector.h"
 #include "common/log.h"
 #include "common/small_string.h"
 #include "common/string_util.h"
 
+#include <algorithm>
+#include <bit>
 #include <cctype>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <type_traits>
@@ -24,25 +29,6 @@ static std::array<u32, 256> cht_register; // Used for D7 ,51 & 52 cheat types
 
 using KeyValuePairVector = std::vector<std::pair<std::string, std::string>>;
 
-static bool IsValidScanAddress(PhysicalMemoryAddress address)
-{
-  if ((address & CPU::SCRATCHPAD_ADDR_MASK) == CPU::SCRATCHPAD_ADDR &&
-      (address & CPU::SCRATCHPAD_OFFSET_MASK) < CPU::SCRATCHPAD_SIZE)
-  {
-    return true;
-  }
-
-  address &= CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
-
-  if (address < Bus::RAM_MIRROR_END)
-    return true;
-
-  if (address >= Bus::BIOS_BASE && address < (Bus::BIOS_BASE + Bus::BIOS_SIZE))
-    return true;
-
-  return false;
-}
-
 template<typename T>
 NEVER_INLINE static T DoMemoryRead(VirtualMemoryAddress address)
 {
@@ -2813,118 +2799,373 @@ std::optional<CheatCode::Activation> CheatCode::ParseActivationName(const char*
   return std::nullopt;
 }
 
-MemoryScan::MemoryScan() = default;
+namespace {
+struct ScanRegion
+{
+  PhysicalMemoryAddress start;
+  u32 size;
+};
+
+using ScanSpanFunction = u32 (*)(const u8* values, const u8* last_values, u32 count, u32 comp_value, u64* match_bits,
+                                 bool refine);
+} // namespace
+
+// Everything the debugger can read directly from host memory, in address order. RAM is split at 2MB so that each
+// region stays contiguous in the host mapping regardless of the mirroring of the active RAM size.
+static constexpr std::array<ScanRegion, 17> s_scan_regions = {{
+  {0x00000000, Bus::RAM_2MB_SIZE},
+  {0x00200000, Bus::RAM_2MB_SIZE},
+  {0x00400000, Bus::RAM_2MB_SIZE},
+  {0x00600000, Bus::RAM_2MB_SIZE},
+  {CPU::SCRATCHPAD_ADDR, CPU::SCRATCHPAD_SIZE},
+  {Bus::BIOS_BASE, Bus::BIOS_SIZE},
+  {0x80000000, Bus::RAM_2MB_SIZE},
+  {0x80200000, Bus::RAM_2MB_SIZE},
+  {0x80400000, Bus::RAM_2MB_SIZE},
+  {0x80600000, Bus::RAM_2MB_SIZE},
+  {0x80000000 | CPU::SCRATCHPAD_ADDR, CPU::SCRATCHPAD_SIZE},
+  {0x80000000 | Bus::BIOS_BASE, Bus::BIOS_SIZE},
+  {0xA0000000, Bus::RAM_2MB_SIZE},
+  {0xA0200000, Bus::RAM_2MB_SIZE},
+  {0xA0400000, Bus::RAM_2MB_SIZE},
+  {0xA0600000, Bus::RAM_2MB_SIZE},
+  {0xA0000000 | Bus::BIOS_BASE, Bus::BIOS_SIZE},
+}};
+
+static const u8* GetScanHostPointer(PhysicalMemoryAddress address)
+{
+  if ((address & CPU::SCRATCHPAD_ADDR_MASK) == CPU::SCRATCHPAD_ADDR)
+    return &CPU::g_state.scratchpad[address & CPU::SCRATCHPAD_OFFSET_MASK];
 
-MemoryScan::~MemoryScan() = default;
-
-void MemoryScan::ResetSearch()
-{
-  m_results.clear();
+  address &= CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
+  if (address < Bus::RAM_MIRROR_END)
+    return Bus::g_unprotected_ram ? &Bus::g_unprotected_ram[address & Bus::g_ram_mask] : nullptr;
+  else
+    return Bus::g_bios ? &Bus::g_bios[address & Bus::BIOS_MASK] : nullptr;
 }
 
-void MemoryScan::Search()
+static u32 GetScanValue(const u8* ptr, MemoryAccessSize size, bool is_signed)
 {
-  m_results.clear();
-
-  switch (m_size)
+  switch (size)
   {
     case MemoryAccessSize::Byte:
-      SearchBytes();
-      break;
+      return is_signed ? SignExtend32(*ptr) : ZeroExtend32(*ptr);
 
     case MemoryAccessSize::HalfWord:
-      SearchHalfwords();
-      break;
+    {
+      u16 value;
+      std::memcpy(&value, ptr, sizeof(value));
+      return is_signed ? SignExtend32(value) : ZeroExtend32(value);
+    }
 
     case MemoryAccessSize::Word:
-      SearchWords();
-      break;
-
     default:
-      break;
+    {
+      u32 value;
+      std::memcpy(&value, ptr, sizeof(value));
+      return value;
+    }
   }
 }
 
-void MemoryScan::SearchBytes()
-{
-  for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address++)
+template<typename T>
+ALWAYS_INLINE static GSVector4i LoadScanElements(const u8* ptr)
+{
+  if constexpr (std::is_same_v<T, u8>)
+    return GSVector4i::load32(ptr).u8to32();
+  else if constexpr (std::is_same_v<T, s8>)
+    return GSVector4i::load32(ptr).s8to32();
+  else if constexpr (std::is_same_v<T, u16>)
+    return GSVector4i::loadl(ptr).u16to32();
+  else if constexpr (std::is_same_v<T, s16>)
+    return GSVector4i::loadl(ptr).s16to32();
+  else
+    return GSVector4i::load<false>(ptr);
+}
+
+ALWAYS_INLINE static u32 GetScanLaneMask(const GSVector4i v)
+{
+  return static_cast<u32>(GSVector4::cast(v).mask());
+}
+
+/// Vector version of Result::Filter(), operating on four values extended to 32 bits. Returns a 4-bit mask.
+template<MemoryScan::Operator op, bool is_signed>
+ALWAYS_INLINE static u32 CompareScanElements(const GSVector4i value, const GSVector4i last_value,
+                                             const GSVector4i comp_value)
+{
+  using Operator = MemoryScan::Operator;
+
+  // Unsigned ordering is done by flipping the sign bit and using signed compares.
+  static constexpr auto gt = [](const GSVector4i lhs, const GSVector4i rhs) {
+    if constexpr (is_signed)
+      return GetScanLaneMask(lhs.gt32(rhs));
+    else
+      return GetScanLaneMask((lhs ^ GSVector4i::cxpr(INT32_MIN)).gt32(rhs ^ GSVector4i::cxpr(INT32_MIN)));
+  };
+  static constexpr auto lt = [](const GSVector4i lhs, const GSVector4i rhs) {
+    if constexpr (is_signed)
+      return GetScanLaneMask(lhs.lt32(rhs));
+    else
+      return GetScanLaneMask((lhs ^ GSVector4i::cxpr(INT32_MIN)).lt32(rhs ^ GSVector4i::cxpr(INT32_MIN)));
+  };
+  static constexpr auto eq = [](const GSVector4i lhs, const GSVector4i rhs) { return GetScanLaneMask(lhs.eq32(rhs)); };
+
+  if constexpr (op == Operator::Equal)
+    return eq(value, comp_value);
+  else if constexpr (op == Operator::NotEqual)
+    return eq(value, comp_value) ^ 0xF;
+  else if constexpr (op == Operator::GreaterThan)
+    return gt(value, comp_value);
+  else if constexpr (op == Operator::GreaterEqual)
+    return lt(value, comp_value) ^ 0xF;
+  else if constexpr (op == Operator::LessThan)
+    return lt(value, comp_value);
+  else if constexpr (op == Operator::LessEqual)
+    return gt(value, comp_value) ^ 0xF;
+  else if constexpr (op == Operator::IncreasedBy)
+    return eq(value.sub32(last_value), comp_value);
+  else if constexpr (op == Operator::DecreasedBy)
+    return eq(last_value.sub32(value), comp_value);
+  else if constexpr (op == Operator::ChangedBy && is_signed)
+    return eq(last_value.sub32(value), comp_value) | eq(value.sub32(last_value), comp_value);
+  else if constexpr (op == Operator::ChangedBy)
+    return eq(value.max_u32(last_value).sub32(value.min_u32(last_value)), comp_value);
+  else if constexpr (op == Operator::EqualLast)
+    return eq(value, last_value);
+  else if constexpr (op == Operator::NotEqualLast)
+    return eq(value, last_value) ^ 0xF;
+  else if constexpr (op == Operator::GreaterThanLast)
+    return gt(value, last_value);
+  else if constexpr (op == Operator::GreaterEqualLast)
+    return lt(value, last_value) ^ 0xF;
+  else if constexpr (op == Operator::LessThanLast)
+    return lt(value, last_value);
+  else if constexpr (op == Operator::LessEqualLast)
+    return gt(value, last_value) ^ 0xF;
+  else // if constexpr (op == Operator::Any)
+    return 0xF;
+}
+
+template<MemoryScan::Operator op, typename T>
+static u32 ScanSpanElements(const u8* values, const u8* last_values, u32 count, u32 comp_value, u64* match_bits,
+                            bool refine)
+{
+  static constexpr bool is_signed = std::is_signed_v<T>;
+  static constexpr u32 BITS_PER_WORD = 64;
+  const u32 num_words = (count + (BITS_PER_WORD - 1)) / BITS_PER_WORD;
+
+  // abs() can't produce a negative difference, except for INT32_MIN which wraps.
+  if (op == MemoryScan::Operator::ChangedBy && is_signed && static_cast<s32>(comp_value) < 0 &&
+      comp_value != static_cast<u32>(INT32_MIN))
   {
-    if (!IsValidScanAddress(address))
+    std::fill_n(match_bits, num_words, 0);
+    return 0;
+  }
+
+  const GSVector4i comp = GSVector4i(static_cast<s32>(comp_value));
+  u32 match_count = 0;
+
+  for (u32 word = 0; word < num_words; word++)
+  {
+    // When refining, whole words without any remaining matches can be skipped.
+    if (refine && match_bits[word] == 0)
       continue;
 
-    const u8 bvalue = DoMemoryRead<u8>(address);
+    const u32 first = word * BITS_PER_WORD;
+    const u32 word_count = std::min(count - first, BITS_PER_WORD);
+    u64 word_bits = 0;
+    u32 i = 0;
+    for (; (i + 4) <= word_count; i += 4)
+    {
+      const u32 offset = (first + i) * sizeof(T);
+      const u32 mask = CompareScanElements<op, is_signed>(LoadScanElements<T>(values + offset),
+                                                          LoadScanElements<T>(last_values + offset), comp);
+      word_bits |= static_cast<u64>(mask) << i;
+    }
+    if (i < word_count)
+    {
+      // Pad the tail out so the loads don't run past the end of the region.
+      const u32 remaining = word_count - i;
+      const u32 offset = (first + i) * sizeof(T);
+      alignas(VECTOR_ALIGNMENT) u8 value_tail[16] = {};
+      alignas(VECTOR_ALIGNMENT) u8 last_value_tail[16] = {};
+      std::memcpy(value_tail, values + offset, remaining * sizeof(T));
+      std::memcpy(last_value_tail, last_values + offset, remaining * sizeof(T));
+      const u32 mask = CompareScanElements<op, is_signed>(LoadScanElements<T>(value_tail),
+                                                          LoadScanElements<T>(last_value_tail), comp);
+      word_bits |= static_cast<u64>(mask & ((1u << remaining) - 1u)) << i;
+    }
 
-    Result res;
-    res.address = address;
-    res.value = m_signed ? SignExtend32(bvalue) : ZeroExtend32(bvalue);
-    res.last_value = res.value;
-    res.value_changed = false;
+    if (refine)
+      word_bits &= match_bits[word];
 
-    if (res.Filter(m_operator, m_value, m_signed))
-      m_results.push_back(res);
+    match_bits[word] = word_bits;
+    match_count += static_cast<u32>(std::popcount(word_bits));
   }
+
+  return match_count;
 }
 
-void MemoryScan::SearchHalfwords()
+template<typename T>
+static ScanSpanFunction GetScanSpanFunction(MemoryScan::Operator op)
 {
-  for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address += 2)
+#define SCAN_OPERATOR_CASE(name)                                                                                       \
+  case MemoryScan::Operator::name:                                                                                     \
+    return &ScanSpanElements<MemoryScan::Operator::name, T>;
+
+  switch (op)
   {
-    if (!IsValidScanAddress(address))
-      continue;
+    SCAN_OPERATOR_CASE(Any)
+    SCAN_OPERATOR_CASE(LessThanLast)
+    SCAN_OPERATOR_CASE(LessEqualLast)
+    SCAN_OPERATOR_CASE(GreaterThanLast)
+    SCAN_OPERATOR_CASE(GreaterEqualLast)
+    SCAN_OPERATOR_CASE(NotEqualLast)
+    SCAN_OPERATOR_CASE(EqualLast)
+    SCAN_OPERATOR_CASE(DecreasedBy)
+    SCAN_OPERATOR_CASE(IncreasedBy)
+    SCAN_OPERATOR_CASE(ChangedBy)
+    SCAN_OPERATOR_CASE(Equal)
+    SCAN_OPERATOR_CASE(NotEqual)
+    SCAN_OPERATOR_CASE(LessThan)
+    SCAN_OPERATOR_CASE(LessEqual)
+    SCAN_OPERATOR_CASE(GreaterThan)
+    SCAN_OPERATOR_CASE(GreaterEqual)
+    default:
+      return nullptr;
+  }
+
+#undef SCAN_OPERATOR_CASE
+}
+
+static ScanSpanFunction GetScanSpanFunction(MemoryAccessSize size, bool is_signed, MemoryScan::Operator op)
+{
+  switch (size)
+  {
+    case MemoryAccessSize::Byte:
+      return is_signed ? GetScanSpanFunction<s8>(op) : GetScanSpanFunction<u8>(op);
+    case MemoryAccessSize::HalfWord:
+      return is_signed ? GetScanSpanFunction<s16>(op) : GetScanSpanFunction<u16>(op);
+    case MemoryAccessSize::Word:
+      return is_signed ? GetScanSpanFunction<s32>(op) : GetScanSpanFunction<u32>(op);
+    default:
+      return nullptr;
+  }
+}
 
-    const u16 bvalue = DoMemoryRead<u16>(address);
+MemoryScan::MemoryScan() = default;
 
-    Result res;
-    res.address = address;
-    res.value = m_signed ? SignExtend32(bvalue) : ZeroExtend32(bvalue);
-    res.last_value = res.value;
-    res.value_changed = false;
+MemoryScan::~MemoryScan() = default;
+
+void MemoryScan::ResetSearch()
+{
+  m_spans.clear();
+  m_results.clear();
+  m_result_count = 0;
+}
+
+void MemoryScan::Search()
+{
+  ResetSearch();
+  m_scan_size = m_size;
+  m_scan_signed = m_signed;
+  BuildSpans();
+  ScanSpans(false);
+  UpdateListedResults();
+}
 
-    if (res.Filter(m_operator, m_value, m_signed))
-      m_results.push_back(res);
+void MemoryScan::SearchAgain()
+{
+  ScanSpans(true);
+  UpdateListedResults();
+}
+
+void MemoryScan::BuildSpans()
+{
+  // Elements are always naturally aligned, so they never straddle two regions.
+  const u32 element_size = 1u << static_cast<u32>(m_scan_size);
+  const u32 first_address = Common::AlignUpPow2(m_start_address, element_size);
+  if (first_address < m_start_address || first_address >= m_end_address)
+    return;
+
+  for (const ScanRegion& region : s_scan_regions)
+  {
+    const u32 region_end = region.start + region.size;
+    const u32 start = std::max(first_address, region.start);
+    const u32 end = std::min(m_end_address, region_end);
+    if (start >= end)
+      continue;
+
+    Span& span = m_spans.emplace_back();
+    span.start_address = start;
+    span.count = (end - start + (element_size - 1)) / element_size;
+    span.match_count = 0;
+    span.match_bits.resize((span.count + 63) / 64);
+    span.last_values.resize(span.count * element_size);
   }
 }
 
-void MemoryScan::SearchWords()
+void MemoryScan::ScanSpans(bool refine)
 {
-  for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address += 4)
+  const ScanSpanFunction scan_func = GetScanSpanFunction(m_scan_size, m_scan_signed, m_operator);
+  m_result_count = 0;
+
+  for (Span& span : m_spans)
   {
-    if (!IsValidScanAddress(address))
+    const u8* values = GetScanHostPointer(span.start_address);
+    if (!values || !scan_func)
+    {
+      span.match_count = 0;
       continue;
+    }
 
-    Result res;
-    res.address = address;
-    res.value = DoMemoryRead<u32>(address);
-    res.last_value = res.value;
-    res.value_changed = false;
+    // The first search compares against the current values, same as a result with last_value == value.
+    span.match_count = scan_func(values, refine ? span.last_values.data() : values, span.count, m_value,
+                                 span.match_bits.data(), refine);
+    if (span.match_count > 0)
+      std::memcpy(span.last_values.data(), values, span.last_values.size());
 
-    if (res.Filter(m_operator, m_value, m_signed))
-      m_results.push_back(res);
+    m_result_count += span.match_count;
   }
+
+  // Spans without any matches can never match again, so drop their snapshots.
+  m_spans.erase(std::remove_if(m_spans.begin(), m_spans.end(), [](const Span& span) { return span.match_count == 0; }),
+                m_spans.end());
 }
 
-void MemoryScan::SearchAgain()
+void MemoryScan::UpdateListedResults()
 {
-  ResultVector new_results;
-  new_results.reserve(m_results.size());
-  for (Result& res : m_results)
-  {
-    res.UpdateValue(m_size, m_signed);
+  const u32 element_size = 1u << static_cast<u32>(m_scan_size);
+  m_results.clear();
+  m_results.reserve(std::min(m_result_count, MAX_LISTED_RESULTS));
 
-    if (res.Filter(m_operator, m_value, m_signed))
+  for (const Span& span : m_spans)
+  {
+    for (u32 word = 0; word < static_cast<u32>(span.match_bits.size()); word++)
     {
-      res.last_value = res.value;
-      new_results.push_back(res);
+      u64 bits = span.match_bits[word];
+      while (bits != 0)
+      {
+        if (m_results.size() == MAX_LISTED_RESULTS)
+          return;
+
+        const u32 offset = (word * 64 + static_cast<u32>(std::countr_zero(bits))) * element_size;
+        bits &= bits - 1;
+
+        Result& res = m_results.emplace_back();
+        res.address = span.start_address + offset;
+        res.value = GetScanValue(&span.last_values[offset], m_scan_size, m_scan_signed);
+        res.last_value = res.value;
+        res.value_changed = false;
+      }
     }
   }
-
-  m_results.swap(new_results);
 }
 
 void MemoryScan::UpdateResultsValues()
 {
   for (Result& res : m_results)
-    res.UpdateValue(m_size, m_signed);
+    res.UpdateValue(m_scan_size, m_scan_signed);
 }
 
 void MemoryScan::SetResultValue(u32 index, u32 value)
@@ -2936,7 +3177,7 @@ void MemoryScan::SetResultValue(u32 index, u32 value)
   if (res.value == value)
     return;
 
-  switch (m_size)
+  switch (m_scan_size)
   {
     case MemoryAccessSize::Byte:
       DoMemoryWrite<u8>(res.address, Truncate8(value));
@@ -238,6 +238,9 @@ public:
 
   using ResultVector = std::vector<Result>;
 
+  /// Only the first matches are materialized as Result entries, the rest are kept in the per-span bitmaps.
+  static constexpr u32 MAX_LISTED_RESULTS = 5000;
+
   MemoryScan();
   ~MemoryScan();
 
@@ -249,7 +252,7 @@ public:
   PhysicalMemoryAddress GetEndAddress() const { return m_end_address; }
   const ResultVector& GetResults() const { return m_results; }
   const Result& GetResult(u32 index) const { return m_results[index]; }
-  u32 GetResultCount() const { return static_cast<u32>(m_results.size()); }
+  u32 GetResultCount() const { return m_result_count; }
 
   void SetValue(u32 value) { m_value = value; }
   void SetValueSigned(bool s) { m_signed = s; }
@@ -266,17 +269,35 @@ public:
   void SetResultValue(u32 index, u32 value);
 
 private:
-  void SearchBytes();
-  void SearchHalfwords();
-  void SearchWords();
+  /// Host-contiguous run of scanned elements. Bit N of match_bits corresponds to the element at
+  /// start_address + N * size, last_values holds the raw memory as of the previous search.
+  struct Span
+  {
+    PhysicalMemoryAddress start_address;
+    u32 count;
+    u32 match_count;
+    std::vector<u64> match_bits;
+    std::vector<u8> last_values;
+  };
+
+  void BuildSpans();
+  void ScanSpans(bool refine);
+  void UpdateListedResults();
 
   u32 m_value = 0;
   MemoryAccessSize m_size = MemoryAccessSize::HalfWord;
   Operator m_operator = Operator::Equal;
   PhysicalMemoryAddress m_start_address = 0;
   PhysicalMemoryAddress m_end_address = 0x200000;
+  std::vector<Span> m_spans;
   ResultVector m_results;
+  u32 m_result_count = 0;
   bool m_signed = false;
+
+  // Element size/signedness the spans and results were built with. SetSize()/SetValueSigned() only take effect on
+  // the next Search(), since the span snapshots are sized for these.
+  MemoryAccessSize m_scan_size = MemoryAccessSize::HalfWord;
+  bool m_scan_signed = false;
 };
 
 class MemoryWatchList
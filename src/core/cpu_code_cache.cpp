@@ -66,6 +66,7 @@ static void DeallocateLUTs();
 static void ResetCodeLUT();
 static void SetCodeLUT(u32 pc, const void* function);
 static void InvalidateBlock(Block* block, BlockState new_state);
+static void InvalidateBlocksInPage(u32 index, BlockState new_state);
 static void ClearBlocks();
 
 static Block* LookupBlock(u32 pc);
@@ -619,6 +620,19 @@ void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
     new_block_state = BlockState::NeedsRecompile;
   }
 
+  InvalidateBlocksInPage(index, new_block_state);
+}
+
+void CPU::CodeCache::InvalidateBlocksForStateLoad(u32 index)
+{
+  DebugAssert(index < Bus::RAM_8MB_CODE_PAGE_COUNT);
+  Bus::ClearRAMCodePage(index);
+  InvalidateBlocksInPage(index, BlockState::Invalidated);
+}
+
+void CPU::CodeCache::InvalidateBlocksInPage(u32 index, BlockState new_block_state)
+{
+  PageProtectionInfo& ppi = s_page_protection[index];
   if (!ppi.first_block_in_page)
     return;
 
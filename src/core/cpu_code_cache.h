@@ -31,6 +31,10 @@ void Reset();
 /// Invalidates all blocks which are in the range of the specified code page.
 void InvalidateBlocksWithPageIndex(u32 page_index);
 
+/// Invalidates all blocks in a code page whose contents are being replaced by a memory state. Unlike
+/// InvalidateBlocksWithPageIndex(), this doesn't count towards switching the page to manual protection.
+void InvalidateBlocksForStateLoad(u32 page_index);
+
 /// Invalidates all blocks in the cache.
 void InvalidateAllRAMBlocks();
 
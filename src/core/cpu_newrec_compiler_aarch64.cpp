@@ -2157,6 +2157,35 @@ void CPU::NewRec::AArch64Compiler::Compile_cop2(CompileFlags cf)
   TickCount func_ticks;
   GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks);
 
+  // NCLIP and AVSZ3/AVSZ4 only touch MAC0/OTZ and FLAG, so they are generated inline. Everything else is a call to the
+  // C++ implementation. Of the common commands, only RTPS/RTPT need the UNR division. MVMVA doesn't divide, but checks
+  // each partial sum of all three rows for 44-bit overflow and has the buggy FC and RGBC/IR0 variants, which is a lot
+  // of code to emit per instruction with scalar registers only, so it stays in C++ as well.
+  // PGXP culling needs the precise vertex cache, so NCLIP has to go through the C++ implementation in that case.
+  switch (GTE::Instruction{inst->bits}.command)
+  {
+    case 0x06:
+    {
+      if (g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling)
+        break;
+
+      Compile_gte_nclip();
+      AddGTETicks(func_ticks);
+      return;
+    }
+
+    case 0x2D:
+    case 0x2E:
+    {
+      Compile_gte_avsz(GTE::Instruction{inst->bits}.command == 0x2E);
+      AddGTETicks(func_ticks);
+      return;
+    }
+
+    default:
+      break;
+  }
+
   Flush(FLUSH_FOR_C_CALL);
   EmitMov(RWARG1, inst->bits & GTE::Instruction::REQUIRED_BITS_MASK);
   EmitCall(reinterpret_cast<const void*>(func));
@@ -2164,6 +2193,70 @@ void CPU::NewRec::AArch64Compiler::Compile_cop2(CompileFlags cf)
   AddGTETicks(func_ticks);
 }
 
+void CPU::NewRec::AArch64Compiler::Compile_gte_mac0_flags()
+{
+  // MAC0 = RXARG1, flags are left in RWARG2
+  armAsm->str(RWARG1, PTR(&g_state.gte_regs.MAC0));
+
+  EmitMov(RWARG2, GTE::FLAGS::ERROR_BIT | GTE::FLAGS::MAC0_OVERFLOW_BIT);
+  EmitMov(RWARG3, GTE::FLAGS::ERROR_BIT | GTE::FLAGS::MAC0_UNDERFLOW_BIT);
+  armAsm->cmp(RXARG1, 0);
+  armAsm->csel(RWARG2, RWARG3, RWARG2, lt);
+  armAsm->cmp(RXARG1, Operand(RWARG1, SXTW));
+  armAsm->csel(RWARG2, wzr, RWARG2, eq);
+}
+
+void CPU::NewRec::AArch64Compiler::Compile_gte_nclip()
+{
+  // MAC0 = SX0*(SY1-SY2) + SX1*(SY2-SY0) + SX2*(SY0-SY1)
+  armAsm->ldrsh(RWARG2, PTR(&g_state.gte_regs.SXY1[1]));
+  armAsm->ldrsh(RWARG3, PTR(&g_state.gte_regs.SXY2[1]));
+  armAsm->sub(RWSCRATCH, RWARG2, RWARG3);
+  armAsm->ldrsh(RWARG1, PTR(&g_state.gte_regs.SXY0[0]));
+  armAsm->smull(RXARG1, RWARG1, RWSCRATCH);
+  armAsm->ldrsh(RWSCRATCH, PTR(&g_state.gte_regs.SXY0[1]));
+  armAsm->sub(RWARG3, RWARG3, RWSCRATCH);
+  armAsm->sub(RWSCRATCH, RWSCRATCH, RWARG2);
+  armAsm->ldrsh(RWARG2, PTR(&g_state.gte_regs.SXY1[0]));
+  armAsm->smaddl(RXARG1, RWARG2, RWARG3, RXARG1);
+  armAsm->ldrsh(RWARG2, PTR(&g_state.gte_regs.SXY2[0]));
+  armAsm->smaddl(RXARG1, RWARG2, RWSCRATCH, RXARG1);
+
+  Compile_gte_mac0_flags();
+  armAsm->str(RWARG2, PTR(&g_state.gte_regs.FLAG.bits));
+}
+
+void CPU::NewRec::AArch64Compiler::Compile_gte_avsz(bool avsz4)
+{
+  // MAC0 = ZSF3 * (SZ1 + SZ2 + SZ3) or ZSF4 * (SZ0 + SZ1 + SZ2 + SZ3), OTZ = MAC0 >> 12
+  armAsm->ldrh(RWARG2, PTR(&g_state.gte_regs.SZ1));
+  armAsm->ldrh(RWARG3, PTR(&g_state.gte_regs.SZ2));
+  armAsm->add(RWARG2, RWARG2, RWARG3);
+  armAsm->ldrh(RWARG3, PTR(&g_state.gte_regs.SZ3));
+  armAsm->add(RWARG2, RWARG2, RWARG3);
+  if (avsz4)
+  {
+    armAsm->ldrh(RWARG3, PTR(&g_state.gte_regs.SZ0));
+    armAsm->add(RWARG2, RWARG2, RWARG3);
+  }
+  armAsm->ldrsh(RWARG3, PTR(avsz4 ? &g_state.gte_regs.ZSF4 : &g_state.gte_regs.ZSF3));
+  armAsm->smull(RXARG1, RWARG2, RWARG3);
+
+  Compile_gte_mac0_flags();
+
+  Label otz_in_range;
+  armAsm->asr(RXARG3, RXARG1, 12);
+  EmitMov(RWSCRATCH, 0xFFFF);
+  armAsm->cmp(RXARG3, RXSCRATCH);
+  armAsm->b(&otz_in_range, ls);
+  armAsm->cmp(RXARG3, 0);
+  armAsm->csel(RWARG3, wzr, RWSCRATCH, lt);
+  armAsm->orr(RWARG2, RWARG2, armCheckLogicalConstant(GTE::FLAGS::ERROR_BIT | GTE::FLAGS::SZ1_OTZ_SATURATED_BIT));
+  armAsm->bind(&otz_in_range);
+  armAsm->str(RWARG3, PTR(&g_state.gte_regs.dr32[7]));
+  armAsm->str(RWARG2, PTR(&g_state.gte_regs.FLAG.bits));
+}
+
 u32 CPU::NewRec::CompileLoadStoreThunk(void* thunk_code, u32 thunk_space, void* code_address, u32 code_size,
                                        TickCount cycles_to_add, TickCount cycles_to_remove, u32 gpr_bitmask,
                                        u8 address_register, u8 data_register, MemoryAccessSize size, bool is_signed,
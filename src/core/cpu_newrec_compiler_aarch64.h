@@ -125,6 +125,9 @@ protected:
   void Compile_mfc2(CompileFlags cf) override;
   void Compile_mtc2(CompileFlags cf) override;
   void Compile_cop2(CompileFlags cf) override;
+  void Compile_gte_mac0_flags();
+  void Compile_gte_nclip();
+  void Compile_gte_avsz(bool avsz4);
 
   void GeneratePGXPCallWithMIPSRegs(const void* func, u32 arg1val, Reg arg2reg = Reg::count,
                                     Reg arg3reg = Reg::count) override;
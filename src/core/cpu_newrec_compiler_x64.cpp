@@ -2142,6 +2142,35 @@ void CPU::NewRec::X64Compiler::Compile_cop2(CompileFlags cf)
   TickCount func_ticks;
   GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks);
 
+  // NCLIP and AVSZ3/AVSZ4 only touch MAC0/OTZ and FLAG, so they are generated inline. Everything else is a call to the
+  // C++ implementation. Of the common commands, only RTPS/RTPT need the UNR division. MVMVA doesn't divide, but checks
+  // each partial sum of all three rows for 44-bit overflow and has the buggy FC and RGBC/IR0 variants, which is a lot
+  // of code to emit per instruction with scalar registers only, so it stays in C++ as well.
+  // PGXP culling needs the precise vertex cache, so NCLIP has to go through the C++ implementation in that case.
+  switch (GTE::Instruction{inst->bits}.command)
+  {
+    case 0x06:
+    {
+      if (g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling)
+        break;
+
+      Compile_gte_nclip();
+      AddGTETicks(func_ticks);
+      return;
+    }
+
+    case 0x2D:
+    case 0x2E:
+    {
+      Compile_gte_avsz(GTE::Instruction{inst->bits}.command == 0x2E);
+      AddGTETicks(func_ticks);
+      return;
+    }
+
+    default:
+      break;
+  }
+
   Flush(FLUSH_FOR_C_CALL);
   cg->mov(RWARG1, inst->bits & GTE::Instruction::REQUIRED_BITS_MASK);
   cg->call(reinterpret_cast<const void*>(func));
@@ -2149,6 +2178,79 @@ void CPU::NewRec::X64Compiler::Compile_cop2(CompileFlags cf)
   AddGTETicks(func_ticks);
 }
 
+void CPU::NewRec::X64Compiler::Compile_gte_mac0_flags()
+{
+  // MAC0 = RXRET, flags are left in RWARG2
+  cg->mov(cg->dword[PTR(&g_state.gte_regs.MAC0)], RWRET);
+
+  Label mac0_in_range;
+  cg->movsxd(RXARG1, RWRET);
+  cg->xor_(RWARG2, RWARG2);
+  cg->cmp(RXARG1, RXRET);
+  cg->je(mac0_in_range, CodeGenerator::T_SHORT);
+  cg->mov(RWARG2, GTE::FLAGS::ERROR_BIT | GTE::FLAGS::MAC0_OVERFLOW_BIT);
+  cg->mov(RWARG3, GTE::FLAGS::ERROR_BIT | GTE::FLAGS::MAC0_UNDERFLOW_BIT);
+  cg->test(RXRET, RXRET);
+  cg->cmovs(RWARG2, RWARG3);
+  cg->L(mac0_in_range);
+}
+
+void CPU::NewRec::X64Compiler::Compile_gte_nclip()
+{
+  // MAC0 = SX0*(SY1-SY2) + SX1*(SY2-SY0) + SX2*(SY0-SY1)
+  cg->movsx(RXARG1, cg->word[PTR(&g_state.gte_regs.SXY1[1])]);
+  cg->movsx(RXARG2, cg->word[PTR(&g_state.gte_regs.SXY2[1])]);
+  cg->mov(RXARG3, RXARG1);
+  cg->sub(RXARG3, RXARG2);
+  cg->movsx(RXRET, cg->word[PTR(&g_state.gte_regs.SXY0[0])]);
+  cg->imul(RXRET, RXARG3);
+  cg->movsx(RXARG3, cg->word[PTR(&g_state.gte_regs.SXY0[1])]);
+  cg->sub(RXARG2, RXARG3);
+  cg->sub(RXARG3, RXARG1);
+  cg->movsx(RXARG1, cg->word[PTR(&g_state.gte_regs.SXY1[0])]);
+  cg->imul(RXARG1, RXARG2);
+  cg->add(RXRET, RXARG1);
+  cg->movsx(RXARG1, cg->word[PTR(&g_state.gte_regs.SXY2[0])]);
+  cg->imul(RXARG1, RXARG3);
+  cg->add(RXRET, RXARG1);
+
+  Compile_gte_mac0_flags();
+  cg->mov(cg->dword[PTR(&g_state.gte_regs.FLAG.bits)], RWARG2);
+}
+
+void CPU::NewRec::X64Compiler::Compile_gte_avsz(bool avsz4)
+{
+  // MAC0 = ZSF3 * (SZ1 + SZ2 + SZ3) or ZSF4 * (SZ0 + SZ1 + SZ2 + SZ3), OTZ = MAC0 >> 12
+  cg->movzx(RWRET, cg->word[PTR(&g_state.gte_regs.SZ1)]);
+  cg->movzx(RWARG1, cg->word[PTR(&g_state.gte_regs.SZ2)]);
+  cg->add(RWRET, RWARG1);
+  cg->movzx(RWARG1, cg->word[PTR(&g_state.gte_regs.SZ3)]);
+  cg->add(RWRET, RWARG1);
+  if (avsz4)
+  {
+    cg->movzx(RWARG1, cg->word[PTR(&g_state.gte_regs.SZ0)]);
+    cg->add(RWRET, RWARG1);
+  }
+  cg->movsx(RXARG1, cg->word[PTR(avsz4 ? &g_state.gte_regs.ZSF4 : &g_state.gte_regs.ZSF3)]);
+  cg->imul(RXRET, RXARG1);
+
+  Compile_gte_mac0_flags();
+
+  Label otz_in_range;
+  cg->mov(RXARG3, RXRET);
+  cg->sar(RXARG3, 12);
+  cg->cmp(RXARG3, 0xFFFF);
+  cg->jbe(otz_in_range, CodeGenerator::T_SHORT);
+  cg->or_(RWARG2, GTE::FLAGS::ERROR_BIT | GTE::FLAGS::SZ1_OTZ_SATURATED_BIT);
+  cg->xor_(RWARG1, RWARG1);
+  cg->test(RXARG3, RXARG3);
+  cg->mov(RWARG3, 0xFFFF);
+  cg->cmovs(RWARG3, RWARG1);
+  cg->L(otz_in_range);
+  cg->mov(cg->dword[PTR(&g_state.gte_regs.dr32[7])], RWARG3);
+  cg->mov(cg->dword[PTR(&g_state.gte_regs.FLAG.bits)], RWARG2);
+}
+
 u32 CPU::NewRec::CompileLoadStoreThunk(void* thunk_code, u32 thunk_space, void* code_address, u32 code_size,
                                        TickCount cycles_to_add, TickCount cycles_to_remove, u32 gpr_bitmask,
                                        u8 address_register, u8 data_register, MemoryAccessSize size, bool is_signed,
@@ -191,6 +191,7 @@ static TickCount TransferDeviceToMemory(u32 address, u32 increment, u32 word_cou
 // from memory -> device
 template<Channel channel>
 static TickCount TransferMemoryToDevice(u32 address, u32 increment, u32 word_count);
+static TickCount TransferLinkedListNodeToGPU(u32 address, u32 word_count);
 
 static TickCount GetMaxSliceTicks(TickCount max_slice_size);
 
@@ -622,7 +623,11 @@ bool DMA::TransferChannel()
             return true;
           }
 
-          const TickCount block_ticks = TransferMemoryToDevice<channel>(transfer_addr + sizeof(header), 4, word_count);
+          TickCount block_ticks;
+          if constexpr (channel == Channel::GPU)
+            block_ticks = TransferLinkedListNodeToGPU(transfer_addr + sizeof(header), word_count);
+          else
+            block_ticks = TransferMemoryToDevice<channel>(transfer_addr + sizeof(header), 4, word_count);
           CPU::AddPendingTicks(block_ticks);
           remaining_ticks -= block_ticks;
         }
@@ -803,12 +808,19 @@ TickCount DMA::TransferMemoryToDevice(u32 address, u32 increment, u32 word_count
       if (g_gpu->BeginDMAWrite()) [[likely]]
       {
         u8* ram_pointer = Bus::g_ram;
-        for (u32 i = 0; i < word_count; i++)
+        if (increment == sizeof(u32) && (address + word_count * sizeof(u32)) <= (mask + 1))
         {
-          u32 value;
-          std::memcpy(&value, &ram_pointer[address], sizeof(u32));
-          g_gpu->DMAWrite(address, value);
-          address = (address + increment) & mask;
+          g_gpu->DMAWrite(address, reinterpret_cast<const u32*>(&ram_pointer[address]), word_count);
+        }
+        else
+        {
+          for (u32 i = 0; i < word_count; i++)
+          {
+            u32 value;
+            std::memcpy(&value, &ram_pointer[address], sizeof(u32));
+            g_gpu->DMAWrite(address, value);
+            address = (address + increment) & mask;
+          }
         }
         g_gpu->EndDMAWrite();
       }
@@ -834,6 +846,21 @@ TickCount DMA::TransferMemoryToDevice(u32 address, u32 increment, u32 word_count
   return Bus::GetDMARAMTickCount(word_count);
 }
 
+TickCount DMA::TransferLinkedListNodeToGPU(u32 address, u32 word_count)
+{
+  const u32 mask = Bus::g_ram_mask;
+  address &= mask;
+
+  // Packets are decoded in place, so nodes which wrap around the end of RAM take the per-word path.
+  if ((address + word_count * sizeof(u32)) > (mask + 1)) [[unlikely]]
+    return TransferMemoryToDevice<Channel::GPU>(address, 4, word_count);
+
+  if (g_gpu->BeginDMAWrite()) [[likely]]
+    g_gpu->DMAWriteLinkedListNode(Bus::g_ram, address, word_count);
+
+  return Bus::GetDMARAMTickCount(word_count);
+}
+
 template<DMA::Channel channel>
 TickCount DMA::TransferDeviceToMemory(u32 address, u32 increment, u32 word_count)
 {
@@ -464,7 +464,7 @@ static void DrawGameListSettingsWindow();
 static void SwitchToGameList();
 static void PopulateGameListEntryList();
 static GPUTexture* GetTextureForGameListEntryType(GameList::EntryType type);
-static GPUTexture* GetGameListCover(const GameList::Entry* entry);
+static GPUTexture* GetGameListCover(const GameList::Entry* entry, u32 thumbnail_size = 0);
 static GPUTexture* GetCoverForCurrentGame();
 
 // Lazily populated cover images.
@@ -573,6 +573,7 @@ bool FullscreenUI::Initialize()
   ImGuiFullscreen::SetTheme(Host::GetBaseBoolSettingValue("Main", "UseLightFullscreenUITheme", false));
   ImGuiFullscreen::SetSmoothScrolling(Host::GetBaseBoolSettingValue("Main", "FullscreenUISmoothScrolling", true));
   ImGuiFullscreen::UpdateLayoutScale();
+  ImGuiFullscreen::SetThumbnailCacheDirectory(Path::Combine(EmuFolders::Cache, "thumbnails"));
 
   if (!ImGuiManager::AddFullscreenFontsIfMissing() || !ImGuiFullscreen::Initialize("images/placeholder.png") ||
       !LoadResources())
@@ -1266,8 +1267,8 @@ void FullscreenUI::DoToggleAnalogMode()
     {
       if (std::strcmp(bi.name, "Analog") == 0)
       {
-        ctrl->SetBindState(bi.bind_index, 1.0f);
-        ctrl->SetBindState(bi.bind_index, 0.0f);
+        System::SetControllerBindState(i, bi.bind_index, 1.0f);
+        System::SetControllerBindState(i, bi.bind_index, 0.0f);
         break;
       }
     }
@@ -3434,6 +3435,12 @@ void FullscreenUI::DrawEmulationSettingsPage()
     FSUI_CSTR("Sets the turbo speed. It is not guaranteed that this speed will be reached on all systems."), "Main",
     "TurboSpeed", 2.0f, emulation_speed_titles.data(), emulation_speed_values.data(), emulation_speed_titles.size(),
     true);
+  DrawIntRangeSetting(bsi, FSUI_ICONSTR(ICON_FA_FORWARD, "Fast Forward Frame Skip"),
+                      FSUI_CSTR("Skips drawing this many frames for each frame shown while fast forwarding. Increases "
+                                "speed when limited by the GPU. May cause graphical glitches in games which reuse the "
+                                "displayed image."),
+                      "Main", "FastForwardFrameSkip", 0, 0, Settings::MAX_FAST_FORWARD_FRAME_SKIP,
+                      FSUI_CSTR("%d Frames"));
 
   MenuHeading(FSUI_CSTR("Latency Control"));
   DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_TV, "Vertical Sync (VSync)"),
@@ -4466,6 +4473,17 @@ void FullscreenUI::DrawDisplaySettingsPage()
     break;
 #endif
 
+#ifdef ENABLE_VULKAN
+    case GPURenderer::HardwareVulkan:
+    {
+      DrawToggleSetting(bsi, FSUI_CSTR("Threaded Presentation"),
+                        FSUI_CSTR("Submits and presents frames from a separate thread. Experimental, may not improve "
+                                  "performance, and can worsen frame pacing on some drivers."),
+                        "GPU", "ThreadedPresentation", false);
+    }
+    break;
+#endif
+
     case GPURenderer::Software:
     {
       DrawToggleSetting(bsi, FSUI_CSTR("Threaded Rendering"),
@@ -5159,6 +5177,10 @@ void FullscreenUI::DrawAdvancedSettingsPage()
                     FSUI_CSTR("Logs messages to the debug console where supported."), "Logging", "LogToDebug", false);
   DrawToggleSetting(bsi, FSUI_CSTR("Log To File"), FSUI_CSTR("Logs messages to duckstation.log in the user directory."),
                     "Logging", "LogToFile", false);
+  DrawToggleSetting(bsi, FSUI_CSTR("Asynchronous Logging"),
+                    FSUI_CSTR("Writes log messages on a background thread, so verbose logging has less impact on "
+                              "performance. Messages may be dropped if they are logged faster than they can be written."),
+                    "Logging", "LogAsync", false);
 
   MenuHeading(FSUI_CSTR("Debugging Settings"));
 
@@ -6325,7 +6347,7 @@ void FullscreenUI::DrawGameList(const ImVec2& heading_size)
       if (!visible)
         continue;
 
-      GPUTexture* cover_texture = GetGameListCover(entry);
+      GPUTexture* cover_texture = GetGameListCover(entry, static_cast<u32>(image_size.x));
 
       if (entry->serial.empty())
         summary.format("{} - ", Settings::GetDiscRegionDisplayName(entry->region));
@@ -6383,8 +6405,9 @@ void FullscreenUI::DrawGameList(const ImVec2& heading_size)
 
   if (BeginFullscreenColumnWindow(-530.0f, 0.0f, "game_list_info", UIPrimaryDarkColor))
   {
-    const GPUTexture* cover_texture =
-      selected_entry ? GetGameListCover(selected_entry) : GetTextureForGameListEntryType(GameList::EntryType::Count);
+    const u32 cover_size = static_cast<u32>(LayoutScale(350.0f));
+    const GPUTexture* cover_texture = selected_entry ? GetGameListCover(selected_entry, cover_size) :
+                                                       GetTextureForGameListEntryType(GameList::EntryType::Count);
     if (cover_texture)
     {
       const ImRect image_rect(
@@ -6392,7 +6415,7 @@ void FullscreenUI::DrawGameList(const ImVec2& heading_size)
                                                                 static_cast<float>(cover_texture->GetHeight()))));
 
       ImGui::SetCursorPos(LayoutScale(ImVec2(90.0f, 0.0f)) + image_rect.Min);
-      ImGui::Image(selected_entry ? GetGameListCover(selected_entry) :
+      ImGui::Image(selected_entry ? GetGameListCover(selected_entry, cover_size) :
                                     GetTextureForGameListEntryType(GameList::EntryType::Count),
                    image_rect.GetSize());
     }
@@ -6570,7 +6593,7 @@ void FullscreenUI::DrawGameGrid(const ImVec2& heading_size)
       bb.Min += style.FramePadding;
       bb.Max -= style.FramePadding;
 
-      GPUTexture* const cover_texture = GetGameListCover(entry);
+      GPUTexture* const cover_texture = GetGameListCover(entry, static_cast<u32>(image_width));
       const ImRect image_rect(
         CenterImage(ImRect(bb.Min, bb.Min + image_size), ImVec2(static_cast<float>(cover_texture->GetWidth()),
                                                                 static_cast<float>(cover_texture->GetHeight()))));
@@ -6942,7 +6965,7 @@ void FullscreenUI::SwitchToGameList()
   QueueResetFocus(FocusResetType::ViewChanged);
 }
 
-GPUTexture* FullscreenUI::GetGameListCover(const GameList::Entry* entry)
+GPUTexture* FullscreenUI::GetGameListCover(const GameList::Entry* entry, u32 thumbnail_size)
 {
   // lookup and grab cover image
   auto cover_it = s_cover_image_map.find(entry->path);
@@ -6952,7 +6975,12 @@ GPUTexture* FullscreenUI::GetGameListCover(const GameList::Entry* entry)
     cover_it = s_cover_image_map.emplace(entry->path, std::move(cover_path)).first;
   }
 
-  GPUTexture* tex = (!cover_it->second.empty()) ? GetCachedTextureAsync(cover_it->second.c_str()) : nullptr;
+  GPUTexture* tex = nullptr;
+  if (!cover_it->second.empty())
+  {
+    tex = (thumbnail_size > 0) ? ImGuiFullscreen::GetCachedThumbnailAsync(cover_it->second, thumbnail_size) :
+                                 GetCachedTextureAsync(cover_it->second);
+  }
   return tex ? tex : GetTextureForGameListEntryType(entry->type);
 }
 
@@ -7240,6 +7268,7 @@ TRANSLATE_NOOP("FullscreenUI", "Applies modern dithering techniques to further s
 TRANSLATE_NOOP("FullscreenUI", "Apply Image Patches");
 TRANSLATE_NOOP("FullscreenUI", "Are you sure you want to clear the current post-processing chain? All configuration will be lost.");
 TRANSLATE_NOOP("FullscreenUI", "Aspect Ratio");
+TRANSLATE_NOOP("FullscreenUI", "Asynchronous Logging");
 TRANSLATE_NOOP("FullscreenUI", "Attempts to detect one pixel high/wide lines that rely on non-upscaled rasterization behavior, filling in gaps introduced by upscaling.");
 TRANSLATE_NOOP("FullscreenUI", "Attempts to map the selected port to a chosen controller.");
 TRANSLATE_NOOP("FullscreenUI", "Audio Backend");
@@ -7423,6 +7452,7 @@ TRANSLATE_NOOP("FullscreenUI", "Failed to load '{}'.");
 TRANSLATE_NOOP("FullscreenUI", "Failed to load shader {}. It may be invalid.\nError was:");
 TRANSLATE_NOOP("FullscreenUI", "Failed to save input profile '{}'.");
 TRANSLATE_NOOP("FullscreenUI", "Fast Boot");
+TRANSLATE_NOOP("FullscreenUI", "Fast Forward Frame Skip");
 TRANSLATE_NOOP("FullscreenUI", "Fast Forward Speed");
 TRANSLATE_NOOP("FullscreenUI", "Fast Forward Volume");
 TRANSLATE_NOOP("FullscreenUI", "File Size");
@@ -7723,6 +7753,7 @@ TRANSLATE_NOOP("FullscreenUI", "Simulates the CPU's instruction cache in the rec
 TRANSLATE_NOOP("FullscreenUI", "Simulates the region check present in original, unmodified consoles.");
 TRANSLATE_NOOP("FullscreenUI", "Simulates the system ahead of time and rolls back/replays to reduce input lag. Very high system requirements.");
 TRANSLATE_NOOP("FullscreenUI", "Skip Duplicate Frame Display");
+TRANSLATE_NOOP("FullscreenUI", "Skips drawing this many frames for each frame shown while fast forwarding. Increases speed when limited by the GPU. May cause graphical glitches in games which reuse the displayed image.");
 TRANSLATE_NOOP("FullscreenUI", "Skips the presentation/display of frames that are not unique. Can result in worse frame pacing.");
 TRANSLATE_NOOP("FullscreenUI", "Slow Boot");
 TRANSLATE_NOOP("FullscreenUI", "Smooth Scrolling");
@@ -7750,6 +7781,7 @@ TRANSLATE_NOOP("FullscreenUI", "Stores the current settings to an input profile.
 TRANSLATE_NOOP("FullscreenUI", "Stretch Display Vertically");
 TRANSLATE_NOOP("FullscreenUI", "Stretch Mode");
 TRANSLATE_NOOP("FullscreenUI", "Stretches the display to match the aspect ratio by multiplying vertically instead of horizontally.");
+TRANSLATE_NOOP("FullscreenUI", "Submits and presents frames from a separate thread. Experimental, may not improve performance, and can worsen frame pacing on some drivers.");
 TRANSLATE_NOOP("FullscreenUI", "Summary");
 TRANSLATE_NOOP("FullscreenUI", "Switches back to 4:3 display aspect ratio when displaying 24-bit content, usually FMVs.");
 TRANSLATE_NOOP("FullscreenUI", "Switches between full screen and windowed when the window is double-clicked.");
@@ -7765,6 +7797,7 @@ TRANSLATE_NOOP("FullscreenUI", "The audio backend determines how frames produced
 TRANSLATE_NOOP("FullscreenUI", "The selected memory card image will be used in shared mode for this slot.");
 TRANSLATE_NOOP("FullscreenUI", "This game has no achievements.");
 TRANSLATE_NOOP("FullscreenUI", "This game has no leaderboards.");
+TRANSLATE_NOOP("FullscreenUI", "Threaded Presentation");
 TRANSLATE_NOOP("FullscreenUI", "Threaded Rendering");
 TRANSLATE_NOOP("FullscreenUI", "Time Played");
 TRANSLATE_NOOP("FullscreenUI", "Time Played: %s");
@@ -7818,6 +7851,7 @@ TRANSLATE_NOOP("FullscreenUI", "When playing a multi-disc game and using per-gam
 TRANSLATE_NOOP("FullscreenUI", "When this option is chosen, the clock speed set below will be used.");
 TRANSLATE_NOOP("FullscreenUI", "Widescreen Rendering");
 TRANSLATE_NOOP("FullscreenUI", "Wireframe Rendering");
+TRANSLATE_NOOP("FullscreenUI", "Writes log messages on a background thread, so verbose logging has less impact on performance. Messages may be dropped if they are logged faster than they can be written.");
 TRANSLATE_NOOP("FullscreenUI", "Writes textures which can be replaced to the dump directory.");
 TRANSLATE_NOOP("FullscreenUI", "Yes, {} now and risk memory card corruption.");
 TRANSLATE_NOOP("FullscreenUI", "\"Challenge\" mode for achievements, including leaderboard tracking. Disables save state, cheats, and slowdown functions.");
@@ -9,8 +9,8 @@
 #include "util/cd_image.h"
 #include "util/imgui_manager.h"
 
+#include "common/align.h"
 #include "common/assert.h"
-#include "common/binary_reader_writer.h"
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/heterogeneous_containers.h"
@@ -20,9 +20,13 @@
 #include "common/timer.h"
 
 #include "ryml.hpp"
+#include "xxhash.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <type_traits>
@@ -40,19 +44,128 @@ namespace GameDatabase {
 enum : u32
 {
   GAME_DATABASE_CACHE_SIGNATURE = 0x45434C48,
-  GAME_DATABASE_CACHE_VERSION = 15,
+  GAME_DATABASE_CACHE_VERSION = 16,
 };
 
-static Entry* GetMutableEntry(std::string_view serial);
+namespace {
+
+// The cache is used in place once read, so everything in it is fixed-size and naturally aligned. Strings are
+// interned into a single pool, and serials/codes are looked up through perfect hash tables, so nothing needs to be
+// parsed until an entry is actually requested.
+struct CacheString
+{
+  u32 offset;
+  u32 length;
+};
+
+struct CacheIndex
+{
+  u32 num_buckets;
+  u32 num_slots;
+  u32 seeds_offset;
+  u32 slots_offset;
+};
+
+struct CacheIndexSlot
+{
+  CacheString key;
+  u32 entry_index;
+};
+
+struct CacheHeader
+{
+  u32 signature;
+  u32 version;
+  u64 gamedb_timestamp;
+  u32 file_size;
+  u32 num_entries;
+  u32 entries_offset;
+  u32 num_disc_set_serials;
+  u32 disc_set_serials_offset;
+  u32 strings_offset;
+  u32 strings_size;
+  CacheIndex serial_index;
+  CacheIndex code_index;
+};
+
+enum CacheEntryOptional : u16
+{
+  CACHE_HAS_DISPLAY_ACTIVE_START_OFFSET = (1 << 0),
+  CACHE_HAS_DISPLAY_ACTIVE_END_OFFSET = (1 << 1),
+  CACHE_HAS_DISPLAY_LINE_START_OFFSET = (1 << 2),
+  CACHE_HAS_DISPLAY_LINE_END_OFFSET = (1 << 3),
+  CACHE_HAS_DISPLAY_CROP_MODE = (1 << 4),
+  CACHE_HAS_DISPLAY_DEINTERLACING_MODE = (1 << 5),
+  CACHE_HAS_GPU_LINE_DETECT_MODE = (1 << 6),
+  CACHE_HAS_DMA_MAX_SLICE_TICKS = (1 << 7),
+  CACHE_HAS_DMA_HALT_TICKS = (1 << 8),
+  CACHE_HAS_GPU_FIFO_SIZE = (1 << 9),
+  CACHE_HAS_GPU_MAX_RUN_AHEAD = (1 << 10),
+  CACHE_HAS_GPU_PGXP_TOLERANCE = (1 << 11),
+  CACHE_HAS_GPU_PGXP_DEPTH_THRESHOLD = (1 << 12),
+};
+
+struct CacheEntry
+{
+  u64 release_date;
+  CacheString serial;
+  CacheString title;
+  CacheString genre;
+  CacheString developer;
+  CacheString publisher;
+  CacheString compatibility_version_tested;
+  CacheString compatibility_comments;
+  CacheString disc_set_name;
+  u32 disc_set_serials_start;
+  u32 disc_set_serials_count;
+  u32 traits;
+  u32 dma_max_slice_ticks;
+  u32 dma_halt_ticks;
+  u32 gpu_fifo_size;
+  u32 gpu_max_run_ahead;
+  float gpu_pgxp_tolerance;
+  float gpu_pgxp_depth_threshold;
+  s16 display_active_start_offset;
+  s16 display_active_end_offset;
+  u16 optional_mask;
+  u16 supported_controllers;
+  s8 display_line_start_offset;
+  s8 display_line_end_offset;
+  u8 display_crop_mode;
+  u8 display_deinterlacing_mode;
+  u8 gpu_line_detect_mode;
+  u8 min_players;
+  u8 max_players;
+  u8 min_blocks;
+  u8 max_blocks;
+  u8 compatibility;
+  u8 pad[6];
+};
+
+static_assert(sizeof(CacheHeader) % 8 == 0 && sizeof(CacheEntry) % 8 == 0);
+static_assert(static_cast<u32>(Trait::Count) <= 32);
+
+} // namespace
+
 static const Entry* GetEntryForId(std::string_view code);
+static const Entry* GetCachedEntry(u32 index);
+static std::string_view GetCacheString(const CacheString& str);
+static const CacheIndexSlot* LookupCacheIndex(const CacheIndex& index, std::string_view key);
+static u64 HashCacheKey(std::string_view key, u32 seed);
 
 static bool LoadFromCache();
 static bool SaveToCache();
+static bool SetCacheData(DynamicHeapArray<u8> data);
+static bool BuildCache(const std::vector<Entry>& entries, const PreferUnorderedStringMap<u32>& code_lookup,
+                       u64 gamedb_timestamp);
+static bool BuildCacheIndex(const std::vector<std::pair<std::string_view, u32>>& keys, std::vector<u32>* seeds,
+                            std::vector<std::pair<std::string_view, u32>>* slots);
 
 static void SetRymlCallbacks();
-static bool LoadGameDBYaml();
+static bool LoadGameDBYaml(std::vector<Entry>* entries, PreferUnorderedStringMap<u32>* code_lookup);
 static bool ParseYamlEntry(Entry* entry, const ryml::ConstNodeRef& value);
-static bool ParseYamlCodes(u32 index, const ryml::ConstNodeRef& value, std::string_view serial);
+static bool ParseYamlCodes(PreferUnorderedStringMap<u32>* code_lookup, u32 index, const ryml::ConstNodeRef& value,
+                           std::string_view serial);
 static bool LoadTrackHashes();
 
 static constexpr const std::array<const char*, static_cast<int>(CompatibilityRating::Count)>
@@ -139,8 +252,13 @@ static constexpr const char* DISCDB_YAML_FILENAME = "discdb.yaml";
 static bool s_loaded = false;
 static bool s_track_hashes_loaded = false;
 
-static std::vector<GameDatabase::Entry> s_entries;
-static PreferUnorderedStringMap<u32> s_code_lookup;
+static DynamicHeapArray<u8> s_cache_data;
+static const CacheHeader* s_cache_header = nullptr;
+static const CacheEntry* s_cache_entries = nullptr;
+
+// Entries are only expanded from the cache when they're looked up. The pointers handed out stay valid until unload.
+static std::mutex s_entries_mutex;
+static std::vector<std::unique_ptr<Entry>> s_entries;
 
 static TrackHashesMap s_track_hashes_map;
 } // namespace GameDatabase
@@ -156,20 +274,23 @@ void GameDatabase::EnsureLoaded()
 
   if (!LoadFromCache())
   {
-    s_entries = {};
-    s_code_lookup = {};
-
-    LoadGameDBYaml();
-    SaveToCache();
+    std::vector<Entry> entries;
+    PreferUnorderedStringMap<u32> code_lookup;
+    const u64 gamedb_ts = Host::GetResourceFileTimestamp(GAMEDB_YAML_FILENAME, false).value_or(0);
+    if (LoadGameDBYaml(&entries, &code_lookup) && BuildCache(entries, code_lookup, gamedb_ts))
+      SaveToCache();
   }
 
-  INFO_LOG("Database load of {} entries took {:.0f}ms.", s_entries.size(), timer.GetTimeMilliseconds());
+  INFO_LOG("Database load of {} entries took {:.0f}ms.", s_cache_header ? s_cache_header->num_entries : 0u,
+           timer.GetTimeMilliseconds());
 }
 
 void GameDatabase::Unload()
 {
-  s_entries = {};
-  s_code_lookup = {};
+  s_entries.clear();
+  s_cache_entries = nullptr;
+  s_cache_header = nullptr;
+  s_cache_data.deallocate();
   s_loaded = false;
 }
 
@@ -179,9 +300,11 @@ const GameDatabase::Entry* GameDatabase::GetEntryForId(std::string_view code)
     return nullptr;
 
   EnsureLoaded();
+  if (!s_cache_header)
+    return nullptr;
 
-  auto iter = s_code_lookup.find(code);
-  return (iter != s_code_lookup.end()) ? &s_entries[iter->second] : nullptr;
+  const CacheIndexSlot* slot = LookupCacheIndex(s_cache_header->code_index, code);
+  return slot ? GetCachedEntry(slot->entry_index) : nullptr;
 }
 
 std::string GameDatabase::GetSerialForDisc(CDImage* image)
@@ -243,20 +366,15 @@ const GameDatabase::Entry* GameDatabase::GetEntryForGameDetails(const std::strin
 
 const GameDatabase::Entry* GameDatabase::GetEntryForSerial(std::string_view serial)
 {
-  EnsureLoaded();
-
-  return GetMutableEntry(serial);
-}
+  if (serial.empty())
+    return nullptr;
 
-GameDatabase::Entry* GameDatabase::GetMutableEntry(std::string_view serial)
-{
-  for (Entry& entry : s_entries)
-  {
-    if (entry.serial == serial)
-      return &entry;
-  }
+  EnsureLoaded();
+  if (!s_cache_header)
+    return nullptr;
 
-  return nullptr;
+  const CacheIndexSlot* slot = LookupCacheIndex(s_cache_header->serial_index, serial);
+  return slot ? GetCachedEntry(slot->entry_index) : nullptr;
 }
 
 const char* GameDatabase::GetTraitName(Trait trait)
@@ -797,100 +915,199 @@ static std::string GetCacheFile()
   return Path::Combine(EmuFolders::Cache, "gamedb.cache");
 }
 
-bool GameDatabase::LoadFromCache()
+u64 GameDatabase::HashCacheKey(std::string_view key, u32 seed)
 {
-  auto fp = FileSystem::OpenManagedCFile(GetCacheFile().c_str(), "rb");
-  if (!fp)
-  {
-    DEV_LOG("Cache does not exist, loading full database.");
-    return false;
-  }
+  return XXH64(key.data(), key.size(), seed);
+}
 
-  BinaryFileReader reader(fp.get());
-  const u64 gamedb_ts = Host::GetResourceFileTimestamp("gamedb.yaml", false).value_or(0);
+std::string_view GameDatabase::GetCacheString(const CacheString& str)
+{
+  // bounds are checked when the cache is loaded
+  return std::string_view(reinterpret_cast<const char*>(s_cache_data.data() + s_cache_header->strings_offset) +
+                            str.offset,
+                          str.length);
+}
 
-  u32 signature, version, num_entries, num_codes;
-  u64 file_gamedb_ts;
-  if (!reader.ReadU32(&signature) || !reader.ReadU32(&version) || !reader.ReadU64(&file_gamedb_ts) ||
-      !reader.ReadU32(&num_entries) || !reader.ReadU32(&num_codes) || signature != GAME_DATABASE_CACHE_SIGNATURE ||
-      version != GAME_DATABASE_CACHE_VERSION)
-  {
-    DEV_LOG("Cache header is corrupted or version mismatch.");
+const GameDatabase::CacheIndexSlot* GameDatabase::LookupCacheIndex(const CacheIndex& index, std::string_view key)
+{
+  if (index.num_slots == 0)
+    return nullptr;
+
+  const u32* seeds = reinterpret_cast<const u32*>(s_cache_data.data() + index.seeds_offset);
+  const CacheIndexSlot* slots = reinterpret_cast<const CacheIndexSlot*>(s_cache_data.data() + index.slots_offset);
+  const u32 bucket = static_cast<u32>(HashCacheKey(key, 0) % index.num_buckets);
+  const CacheIndexSlot& slot = slots[HashCacheKey(key, seeds[bucket]) % index.num_slots];
+  return (slot.entry_index < s_cache_header->num_entries && GetCacheString(slot.key) == key) ? &slot : nullptr;
+}
+
+const GameDatabase::Entry* GameDatabase::GetCachedEntry(u32 index)
+{
+  std::unique_lock lock(s_entries_mutex);
+  std::unique_ptr<Entry>& entry = s_entries[index];
+  if (entry)
+    return entry.get();
+
+  const CacheEntry& ce = s_cache_entries[index];
+  entry = std::make_unique<Entry>();
+  entry->serial = GetCacheString(ce.serial);
+  entry->title = GetCacheString(ce.title);
+  entry->genre = GetCacheString(ce.genre);
+  entry->developer = GetCacheString(ce.developer);
+  entry->publisher = GetCacheString(ce.publisher);
+  entry->compatibility_version_tested = GetCacheString(ce.compatibility_version_tested);
+  entry->compatibility_comments = GetCacheString(ce.compatibility_comments);
+  entry->release_date = ce.release_date;
+  entry->min_players = ce.min_players;
+  entry->max_players = ce.max_players;
+  entry->min_blocks = ce.min_blocks;
+  entry->max_blocks = ce.max_blocks;
+  entry->supported_controllers = ce.supported_controllers;
+  entry->compatibility = static_cast<CompatibilityRating>(ce.compatibility);
+  entry->traits = ce.traits;
+
+#define GET_OPTIONAL(bit, field, type)                                                                                 \
+  if (ce.optional_mask & (bit))                                                                                        \
+    entry->field = static_cast<type>(ce.field);
+
+  GET_OPTIONAL(CACHE_HAS_DISPLAY_ACTIVE_START_OFFSET, display_active_start_offset, s16);
+  GET_OPTIONAL(CACHE_HAS_DISPLAY_ACTIVE_END_OFFSET, display_active_end_offset, s16);
+  GET_OPTIONAL(CACHE_HAS_DISPLAY_LINE_START_OFFSET, display_line_start_offset, s8);
+  GET_OPTIONAL(CACHE_HAS_DISPLAY_LINE_END_OFFSET, display_line_end_offset, s8);
+  GET_OPTIONAL(CACHE_HAS_DISPLAY_CROP_MODE, display_crop_mode, DisplayCropMode);
+  GET_OPTIONAL(CACHE_HAS_DISPLAY_DEINTERLACING_MODE, display_deinterlacing_mode, DisplayDeinterlacingMode);
+  GET_OPTIONAL(CACHE_HAS_GPU_LINE_DETECT_MODE, gpu_line_detect_mode, GPULineDetectMode);
+  GET_OPTIONAL(CACHE_HAS_DMA_MAX_SLICE_TICKS, dma_max_slice_ticks, u32);
+  GET_OPTIONAL(CACHE_HAS_DMA_HALT_TICKS, dma_halt_ticks, u32);
+  GET_OPTIONAL(CACHE_HAS_GPU_FIFO_SIZE, gpu_fifo_size, u32);
+  GET_OPTIONAL(CACHE_HAS_GPU_MAX_RUN_AHEAD, gpu_max_run_ahead, u32);
+  GET_OPTIONAL(CACHE_HAS_GPU_PGXP_TOLERANCE, gpu_pgxp_tolerance, float);
+  GET_OPTIONAL(CACHE_HAS_GPU_PGXP_DEPTH_THRESHOLD, gpu_pgxp_depth_threshold, float);
+
+#undef GET_OPTIONAL
+
+  entry->disc_set_name = GetCacheString(ce.disc_set_name);
+  if (ce.disc_set_serials_count > 0)
+  {
+    const CacheString* serials =
+      reinterpret_cast<const CacheString*>(s_cache_data.data() + s_cache_header->disc_set_serials_offset) +
+      ce.disc_set_serials_start;
+    entry->disc_set_serials.reserve(ce.disc_set_serials_count);
+    for (u32 i = 0; i < ce.disc_set_serials_count; i++)
+      entry->disc_set_serials.emplace_back(GetCacheString(serials[i]));
+  }
+
+  return entry.get();
+}
+
+bool GameDatabase::SetCacheData(DynamicHeapArray<u8> data)
+{
+  const auto is_valid_range = [&data](u32 offset, u32 count, size_t element_size, size_t alignment) {
+    return ((offset % alignment) == 0 && offset <= data.size() &&
+            (static_cast<size_t>(count) * element_size) <= (data.size() - offset));
+  };
+  const auto is_valid_string = [](const CacheString& str, u32 strings_size) {
+    return (str.offset <= strings_size && str.length <= (strings_size - str.offset));
+  };
+
+  if (data.size() < sizeof(CacheHeader))
     return false;
-  }
 
-  if (gamedb_ts != file_gamedb_ts)
+  const CacheHeader* header = reinterpret_cast<const CacheHeader*>(data.data());
+  if (header->file_size != data.size() ||
+      !is_valid_range(header->entries_offset, header->num_entries, sizeof(CacheEntry), alignof(CacheEntry)) ||
+      !is_valid_range(header->disc_set_serials_offset, header->num_disc_set_serials, sizeof(CacheString),
+                      alignof(CacheString)) ||
+      !is_valid_range(header->strings_offset, header->strings_size, sizeof(char), alignof(char)))
   {
-    DEV_LOG("Cache is out of date, recreating.");
     return false;
   }
 
-  s_entries.reserve(num_entries);
-
-  for (u32 i = 0; i < num_entries; i++)
-  {
-    Entry& entry = s_entries.emplace_back();
-
-    constexpr u32 num_bytes = (static_cast<u32>(Trait::Count) + 7) / 8;
-    std::array<u8, num_bytes> bits;
-    u8 compatibility;
-    u32 num_disc_set_serials;
-
-    if (!reader.ReadSizePrefixedString(&entry.serial) || !reader.ReadSizePrefixedString(&entry.title) ||
-        !reader.ReadSizePrefixedString(&entry.genre) || !reader.ReadSizePrefixedString(&entry.developer) ||
-        !reader.ReadSizePrefixedString(&entry.publisher) ||
-        !reader.ReadSizePrefixedString(&entry.compatibility_version_tested) ||
-        !reader.ReadSizePrefixedString(&entry.compatibility_comments) || !reader.ReadU64(&entry.release_date) ||
-        !reader.ReadU8(&entry.min_players) || !reader.ReadU8(&entry.max_players) || !reader.ReadU8(&entry.min_blocks) ||
-        !reader.ReadU8(&entry.max_blocks) || !reader.ReadU16(&entry.supported_controllers) ||
-        !reader.ReadU8(&compatibility) || compatibility >= static_cast<u8>(GameDatabase::CompatibilityRating::Count) ||
-        !reader.Read(bits.data(), num_bytes) || !reader.ReadOptionalT(&entry.display_active_start_offset) ||
-        !reader.ReadOptionalT(&entry.display_active_end_offset) ||
-        !reader.ReadOptionalT(&entry.display_line_start_offset) ||
-        !reader.ReadOptionalT(&entry.display_line_end_offset) || !reader.ReadOptionalT(&entry.display_crop_mode) ||
-        !reader.ReadOptionalT(&entry.display_deinterlacing_mode) || !reader.ReadOptionalT(&entry.dma_max_slice_ticks) ||
-        !reader.ReadOptionalT(&entry.dma_halt_ticks) || !reader.ReadOptionalT(&entry.gpu_fifo_size) ||
-        !reader.ReadOptionalT(&entry.gpu_max_run_ahead) || !reader.ReadOptionalT(&entry.gpu_pgxp_tolerance) ||
-        !reader.ReadOptionalT(&entry.gpu_pgxp_depth_threshold) || !reader.ReadOptionalT(&entry.gpu_line_detect_mode) ||
-        !reader.ReadSizePrefixedString(&entry.disc_set_name) || !reader.ReadU32(&num_disc_set_serials))
+  for (const CacheIndex* index : {&header->serial_index, &header->code_index})
+  {
+    if ((index->num_slots > 0 && index->num_buckets == 0) ||
+        !is_valid_range(index->seeds_offset, index->num_buckets, sizeof(u32), alignof(u32)) ||
+        !is_valid_range(index->slots_offset, index->num_slots, sizeof(CacheIndexSlot), alignof(CacheIndexSlot)))
     {
-      DEV_LOG("Cache entry is corrupted.");
       return false;
     }
 
-    if (num_disc_set_serials > 0)
+    const CacheIndexSlot* slots = reinterpret_cast<const CacheIndexSlot*>(data.data() + index->slots_offset);
+    for (u32 i = 0; i < index->num_slots; i++)
     {
-      entry.disc_set_serials.reserve(num_disc_set_serials);
-      for (u32 j = 0; j < num_disc_set_serials; j++)
-      {
-        if (!reader.ReadSizePrefixedString(&entry.disc_set_serials.emplace_back()))
-        {
-          DEV_LOG("Cache entry is corrupted.");
-          return false;
-        }
-      }
+      if (!is_valid_string(slots[i].key, header->strings_size))
+        return false;
     }
+  }
 
-    entry.compatibility = static_cast<GameDatabase::CompatibilityRating>(compatibility);
-    entry.traits.reset();
-    for (u32 j = 0; j < static_cast<int>(Trait::Count); j++)
-    {
-      if ((bits[j / 8] & (1u << (j % 8))) != 0)
-        entry.traits[j] = true;
-    }
+  // Check every string reference up front, so that lookups don't need to.
+  const CacheString* disc_set_serials =
+    reinterpret_cast<const CacheString*>(data.data() + header->disc_set_serials_offset);
+  for (u32 i = 0; i < header->num_disc_set_serials; i++)
+  {
+    if (!is_valid_string(disc_set_serials[i], header->strings_size))
+      return false;
   }
 
-  for (u32 i = 0; i < num_codes; i++)
+  const CacheEntry* entries = reinterpret_cast<const CacheEntry*>(data.data() + header->entries_offset);
+  for (u32 i = 0; i < header->num_entries; i++)
   {
-    std::string code;
-    u32 index;
-    if (!reader.ReadSizePrefixedString(&code) || !reader.ReadU32(&index) || index >= static_cast<u32>(s_entries.size()))
+    const CacheEntry& ce = entries[i];
+    if (!is_valid_string(ce.serial, header->strings_size) || !is_valid_string(ce.title, header->strings_size) ||
+        !is_valid_string(ce.genre, header->strings_size) || !is_valid_string(ce.developer, header->strings_size) ||
+        !is_valid_string(ce.publisher, header->strings_size) ||
+        !is_valid_string(ce.compatibility_version_tested, header->strings_size) ||
+        !is_valid_string(ce.compatibility_comments, header->strings_size) ||
+        !is_valid_string(ce.disc_set_name, header->strings_size) ||
+        ce.compatibility >= static_cast<u8>(CompatibilityRating::Count) ||
+        ce.disc_set_serials_start > header->num_disc_set_serials ||
+        ce.disc_set_serials_count > (header->num_disc_set_serials - ce.disc_set_serials_start))
     {
-      DEV_LOG("Cache code entry is corrupted.");
       return false;
     }
+  }
+
+  s_cache_data = std::move(data);
+  s_cache_header = reinterpret_cast<const CacheHeader*>(s_cache_data.data());
+  s_cache_entries = reinterpret_cast<const CacheEntry*>(s_cache_data.data() + s_cache_header->entries_offset);
+  s_entries.clear();
+  s_entries.resize(s_cache_header->num_entries);
+  return true;
+}
+
+bool GameDatabase::LoadFromCache()
+{
+  auto fp = FileSystem::OpenManagedCFile(GetCacheFile().c_str(), "rb");
+  if (!fp)
+  {
+    DEV_LOG("Cache does not exist, loading full database.");
+    return false;
+  }
+
+  std::optional<DynamicHeapArray<u8>> data = FileSystem::ReadBinaryFile(fp.get());
+  if (!data.has_value() || data->size() < sizeof(CacheHeader))
+  {
+    DEV_LOG("Failed to read cache.");
+    return false;
+  }
 
-    s_code_lookup.emplace(std::move(code), index);
+  const CacheHeader* header = reinterpret_cast<const CacheHeader*>(data->data());
+  if (header->signature != GAME_DATABASE_CACHE_SIGNATURE || header->version != GAME_DATABASE_CACHE_VERSION)
+  {
+    DEV_LOG("Cache header is corrupted or version mismatch.");
+    return false;
+  }
+
+  const u64 gamedb_ts = Host::GetResourceFileTimestamp(GAMEDB_YAML_FILENAME, false).value_or(0);
+  if (header->gamedb_timestamp != gamedb_ts)
+  {
+    DEV_LOG("Cache is out of date, recreating.");
+    return false;
+  }
+
+  if (!SetCacheData(std::move(data.value())))
+  {
+    DEV_LOG("Cache is corrupted.");
+    return false;
   }
 
   return true;
@@ -898,79 +1115,236 @@ bool GameDatabase::LoadFromCache()
 
 bool GameDatabase::SaveToCache()
 {
-  const u64 gamedb_ts = Host::GetResourceFileTimestamp("gamedb.yaml", false).value_or(0);
-
   Error error;
-  FileSystem::AtomicRenamedFile file = FileSystem::CreateAtomicRenamedFile(GetCacheFile(), &error);
-  if (!file)
+  if (!FileSystem::WriteAtomicRenamedFile(GetCacheFile(), s_cache_data.data(), s_cache_data.size(), &error))
   {
-    ERROR_LOG("Failed to open cache file for writing: {}", error.GetDescription());
+    ERROR_LOG("Failed to write cache file: {}", error.GetDescription());
     return false;
   }
 
-  BinaryFileWriter writer(file.get());
-  writer.WriteU32(GAME_DATABASE_CACHE_SIGNATURE);
-  writer.WriteU32(GAME_DATABASE_CACHE_VERSION);
-  writer.WriteU64(static_cast<u64>(gamedb_ts));
-
-  writer.WriteU32(static_cast<u32>(s_entries.size()));
-  writer.WriteU32(static_cast<u32>(s_code_lookup.size()));
-
-  for (const Entry& entry : s_entries)
-  {
-    writer.WriteSizePrefixedString(entry.serial);
-    writer.WriteSizePrefixedString(entry.title);
-    writer.WriteSizePrefixedString(entry.genre);
-    writer.WriteSizePrefixedString(entry.developer);
-    writer.WriteSizePrefixedString(entry.publisher);
-    writer.WriteSizePrefixedString(entry.compatibility_version_tested);
-    writer.WriteSizePrefixedString(entry.compatibility_comments);
-    writer.WriteU64(entry.release_date);
-    writer.WriteU8(entry.min_players);
-    writer.WriteU8(entry.max_players);
-    writer.WriteU8(entry.min_blocks);
-    writer.WriteU8(entry.max_blocks);
-    writer.WriteU16(entry.supported_controllers);
-    writer.WriteU8(static_cast<u8>(entry.compatibility));
-
-    constexpr u32 num_bytes = (static_cast<u32>(Trait::Count) + 7) / 8;
-    std::array<u8, num_bytes> bits;
-    bits.fill(0);
-    for (u32 j = 0; j < static_cast<int>(Trait::Count); j++)
+  return true;
+}
+
+bool GameDatabase::BuildCacheIndex(const std::vector<std::pair<std::string_view, u32>>& keys, std::vector<u32>* seeds,
+                                   std::vector<std::pair<std::string_view, u32>>* slots)
+{
+  // Hash and displace: keys are grouped into buckets, then each bucket searches for a seed which places all of its
+  // keys into free slots. Lookups then take exactly one probe.
+  static constexpr u32 AVERAGE_BUCKET_SIZE = 4;
+  static constexpr u32 MAX_SEED = 1u << 16;
+
+  const u32 num_keys = static_cast<u32>(keys.size());
+  const u32 num_buckets = std::max((num_keys + AVERAGE_BUCKET_SIZE - 1) / AVERAGE_BUCKET_SIZE, 1u);
+  std::vector<std::vector<u32>> buckets(num_buckets);
+  for (u32 i = 0; i < num_keys; i++)
+    buckets[HashCacheKey(keys[i].first, 0) % num_buckets].push_back(i);
+
+  std::vector<u32> bucket_order(num_buckets);
+  for (u32 i = 0; i < num_buckets; i++)
+    bucket_order[i] = i;
+  std::stable_sort(bucket_order.begin(), bucket_order.end(),
+                   [&buckets](u32 lhs, u32 rhs) { return buckets[lhs].size() > buckets[rhs].size(); });
+
+  // Start at 80% load, and loosen it if the seed search fails.
+  for (u32 num_slots = std::max(num_keys + num_keys / 4, 1u);; num_slots += std::max(num_slots / 4, 1u))
+  {
+    seeds->assign(num_buckets, 0);
+    slots->assign(num_slots, {});
+
+    std::vector<bool> used(num_slots);
+    std::vector<u32> bucket_slots;
+    bool failed = false;
+    for (const u32 bucket_index : bucket_order)
     {
-      if (entry.traits[j])
-        bits[j / 8] |= (1u << (j % 8));
+      const std::vector<u32>& bucket = buckets[bucket_index];
+      if (bucket.empty())
+        break;
+
+      u32 seed = 1;
+      for (; seed < MAX_SEED; seed++)
+      {
+        bucket_slots.clear();
+        for (const u32 key_index : bucket)
+        {
+          const u32 slot = static_cast<u32>(HashCacheKey(keys[key_index].first, seed) % num_slots);
+          if (used[slot] || std::find(bucket_slots.begin(), bucket_slots.end(), slot) != bucket_slots.end())
+            break;
+
+          bucket_slots.push_back(slot);
+        }
+
+        if (bucket_slots.size() == bucket.size())
+          break;
+      }
+
+      if (seed == MAX_SEED)
+      {
+        failed = true;
+        break;
+      }
+
+      (*seeds)[bucket_index] = seed;
+      for (size_t i = 0; i < bucket.size(); i++)
+      {
+        used[bucket_slots[i]] = true;
+        (*slots)[bucket_slots[i]] = keys[bucket[i]];
+      }
     }
 
-    writer.Write(bits.data(), num_bytes);
-
-    writer.WriteOptionalT(entry.display_active_start_offset);
-    writer.WriteOptionalT(entry.display_active_end_offset);
-    writer.WriteOptionalT(entry.display_line_start_offset);
-    writer.WriteOptionalT(entry.display_line_end_offset);
-    writer.WriteOptionalT(entry.display_crop_mode);
-    writer.WriteOptionalT(entry.display_deinterlacing_mode);
-    writer.WriteOptionalT(entry.dma_max_slice_ticks);
-    writer.WriteOptionalT(entry.dma_halt_ticks);
-    writer.WriteOptionalT(entry.gpu_fifo_size);
-    writer.WriteOptionalT(entry.gpu_max_run_ahead);
-    writer.WriteOptionalT(entry.gpu_pgxp_tolerance);
-    writer.WriteOptionalT(entry.gpu_pgxp_depth_threshold);
-    writer.WriteOptionalT(entry.gpu_line_detect_mode);
-
-    writer.WriteSizePrefixedString(entry.disc_set_name);
-    writer.WriteU32(static_cast<u32>(entry.disc_set_serials.size()));
+    if (!failed)
+      return true;
+
+    DEV_LOG("Failed to build index with {} slots for {} keys, retrying.", num_slots, num_keys);
+  }
+}
+
+bool GameDatabase::BuildCache(const std::vector<Entry>& entries, const PreferUnorderedStringMap<u32>& code_lookup,
+                              u64 gamedb_timestamp)
+{
+  // Genres, developers, publishers and disc set serials repeat a lot, so strings are interned.
+  std::string strings;
+  PreferUnorderedStringMap<CacheString> interned_strings;
+  const auto intern = [&strings, &interned_strings](std::string_view str) {
+    if (str.empty())
+      return CacheString{};
+
+    const auto iter = interned_strings.find(str);
+    if (iter != interned_strings.end())
+      return iter->second;
+
+    const CacheString ret = {static_cast<u32>(strings.size()), static_cast<u32>(str.size())};
+    strings.append(str);
+    interned_strings.emplace(str, ret);
+    return ret;
+  };
+
+  std::vector<CacheEntry> cache_entries;
+  std::vector<CacheString> disc_set_serials;
+  cache_entries.reserve(entries.size());
+  for (const Entry& entry : entries)
+  {
+    CacheEntry& ce = cache_entries.emplace_back();
+    std::memset(&ce, 0, sizeof(ce));
+    ce.serial = intern(entry.serial);
+    ce.title = intern(entry.title);
+    ce.genre = intern(entry.genre);
+    ce.developer = intern(entry.developer);
+    ce.publisher = intern(entry.publisher);
+    ce.compatibility_version_tested = intern(entry.compatibility_version_tested);
+    ce.compatibility_comments = intern(entry.compatibility_comments);
+    ce.release_date = entry.release_date;
+    ce.min_players = entry.min_players;
+    ce.max_players = entry.max_players;
+    ce.min_blocks = entry.min_blocks;
+    ce.max_blocks = entry.max_blocks;
+    ce.supported_controllers = entry.supported_controllers;
+    ce.compatibility = static_cast<u8>(entry.compatibility);
+    ce.traits = static_cast<u32>(entry.traits.to_ulong());
+
+#define SET_OPTIONAL(bit, field, type)                                                                                 \
+  if (entry.field.has_value())                                                                                         \
+  {                                                                                                                    \
+    ce.optional_mask |= (bit);                                                                                         \
+    ce.field = static_cast<type>(entry.field.value());                                                                 \
+  }
+
+    SET_OPTIONAL(CACHE_HAS_DISPLAY_ACTIVE_START_OFFSET, display_active_start_offset, s16);
+    SET_OPTIONAL(CACHE_HAS_DISPLAY_ACTIVE_END_OFFSET, display_active_end_offset, s16);
+    SET_OPTIONAL(CACHE_HAS_DISPLAY_LINE_START_OFFSET, display_line_start_offset, s8);
+    SET_OPTIONAL(CACHE_HAS_DISPLAY_LINE_END_OFFSET, display_line_end_offset, s8);
+    SET_OPTIONAL(CACHE_HAS_DISPLAY_CROP_MODE, display_crop_mode, u8);
+    SET_OPTIONAL(CACHE_HAS_DISPLAY_DEINTERLACING_MODE, display_deinterlacing_mode, u8);
+    SET_OPTIONAL(CACHE_HAS_GPU_LINE_DETECT_MODE, gpu_line_detect_mode, u8);
+    SET_OPTIONAL(CACHE_HAS_DMA_MAX_SLICE_TICKS, dma_max_slice_ticks, u32);
+    SET_OPTIONAL(CACHE_HAS_DMA_HALT_TICKS, dma_halt_ticks, u32);
+    SET_OPTIONAL(CACHE_HAS_GPU_FIFO_SIZE, gpu_fifo_size, u32);
+    SET_OPTIONAL(CACHE_HAS_GPU_MAX_RUN_AHEAD, gpu_max_run_ahead, u32);
+    SET_OPTIONAL(CACHE_HAS_GPU_PGXP_TOLERANCE, gpu_pgxp_tolerance, float);
+    SET_OPTIONAL(CACHE_HAS_GPU_PGXP_DEPTH_THRESHOLD, gpu_pgxp_depth_threshold, float);
+
+#undef SET_OPTIONAL
+
+    ce.disc_set_name = intern(entry.disc_set_name);
+    ce.disc_set_serials_start = static_cast<u32>(disc_set_serials.size());
+    ce.disc_set_serials_count = static_cast<u32>(entry.disc_set_serials.size());
     for (const std::string& serial : entry.disc_set_serials)
-      writer.WriteSizePrefixedString(serial);
+      disc_set_serials.push_back(intern(serial));
   }
 
-  for (const auto& it : s_code_lookup)
+  // Entries are only reachable through their own serial, the first entry wins if there's a duplicate.
+  std::vector<std::pair<std::string_view, u32>> serial_keys;
+  std::vector<std::pair<std::string_view, u32>> code_keys;
   {
-    writer.WriteSizePrefixedString(it.first);
-    writer.WriteU32(it.second);
+    PreferUnorderedStringMap<u32> serial_lookup;
+    for (u32 i = 0; i < static_cast<u32>(entries.size()); i++)
+    {
+      if (!entries[i].serial.empty() && serial_lookup.emplace(entries[i].serial, i).second)
+        serial_keys.emplace_back(entries[i].serial, i);
+    }
   }
+  code_keys.reserve(code_lookup.size());
+  for (const auto& [code, index] : code_lookup)
+    code_keys.emplace_back(code, index);
 
-  return true;
+  std::vector<u32> serial_seeds, code_seeds;
+  std::vector<std::pair<std::string_view, u32>> serial_slots, code_slots;
+  if (!BuildCacheIndex(serial_keys, &serial_seeds, &serial_slots) ||
+      !BuildCacheIndex(code_keys, &code_seeds, &code_slots))
+  {
+    return false;
+  }
+
+  const auto get_slots = [&intern](const std::vector<std::pair<std::string_view, u32>>& slots) {
+    std::vector<CacheIndexSlot> ret;
+    ret.reserve(slots.size());
+    for (const auto& [key, index] : slots)
+      ret.push_back(key.empty() ? CacheIndexSlot{{}, UINT32_MAX} : CacheIndexSlot{intern(key), index});
+    return ret;
+  };
+  const std::vector<CacheIndexSlot> serial_index_slots = get_slots(serial_slots);
+  const std::vector<CacheIndexSlot> code_index_slots = get_slots(code_slots);
+
+  CacheHeader header = {};
+  header.signature = GAME_DATABASE_CACHE_SIGNATURE;
+  header.version = GAME_DATABASE_CACHE_VERSION;
+  header.gamedb_timestamp = gamedb_timestamp;
+
+  size_t size = sizeof(CacheHeader);
+  const auto allocate = [&size](size_t bytes) {
+    const u32 offset = static_cast<u32>(size);
+    size = Common::AlignUpPow2(size + bytes, 8);
+    return offset;
+  };
+
+  header.num_entries = static_cast<u32>(cache_entries.size());
+  header.entries_offset = allocate(cache_entries.size() * sizeof(CacheEntry));
+  header.num_disc_set_serials = static_cast<u32>(disc_set_serials.size());
+  header.disc_set_serials_offset = allocate(disc_set_serials.size() * sizeof(CacheString));
+  header.serial_index = {static_cast<u32>(serial_seeds.size()), static_cast<u32>(serial_index_slots.size()),
+                         allocate(serial_seeds.size() * sizeof(u32)),
+                         allocate(serial_index_slots.size() * sizeof(CacheIndexSlot))};
+  header.code_index = {static_cast<u32>(code_seeds.size()), static_cast<u32>(code_index_slots.size()),
+                       allocate(code_seeds.size() * sizeof(u32)),
+                       allocate(code_index_slots.size() * sizeof(CacheIndexSlot))};
+  header.strings_size = static_cast<u32>(strings.size());
+  header.strings_offset = allocate(strings.size());
+  header.file_size = static_cast<u32>(size);
+
+  DynamicHeapArray<u8> data(size);
+  std::memset(data.data(), 0, size);
+  std::memcpy(data.data(), &header, sizeof(header));
+  std::memcpy(data.data() + header.entries_offset, cache_entries.data(), cache_entries.size() * sizeof(CacheEntry));
+  std::memcpy(data.data() + header.disc_set_serials_offset, disc_set_serials.data(),
+              disc_set_serials.size() * sizeof(CacheString));
+  std::memcpy(data.data() + header.serial_index.seeds_offset, serial_seeds.data(), serial_seeds.size() * sizeof(u32));
+  std::memcpy(data.data() + header.serial_index.slots_offset, serial_index_slots.data(),
+              serial_index_slots.size() * sizeof(CacheIndexSlot));
+  std::memcpy(data.data() + header.code_index.seeds_offset, code_seeds.data(), code_seeds.size() * sizeof(u32));
+  std::memcpy(data.data() + header.code_index.slots_offset, code_index_slots.data(),
+              code_index_slots.size() * sizeof(CacheIndexSlot));
+  std::memcpy(data.data() + header.strings_offset, strings.data(), strings.size());
+
+  return SetCacheData(std::move(data));
 }
 
 void GameDatabase::SetRymlCallbacks()
@@ -984,7 +1358,7 @@ void GameDatabase::SetRymlCallbacks()
     [](const char* msg, size_t msg_size) { ERROR_LOG("C4 error: {}", std::string_view(msg, msg_size)); });
 }
 
-bool GameDatabase::LoadGameDBYaml()
+bool GameDatabase::LoadGameDBYaml(std::vector<Entry>* entries, PreferUnorderedStringMap<u32>* code_lookup)
 {
   const std::optional<std::string> gamedb_data = Host::ReadResourceFileToString(GAMEDB_YAML_FILENAME, false);
   if (!gamedb_data.has_value())
@@ -997,24 +1371,23 @@ bool GameDatabase::LoadGameDBYaml()
 
   const ryml::Tree tree = ryml::parse_in_arena(to_csubstr(GAMEDB_YAML_FILENAME), to_csubstr(gamedb_data.value()));
   const ryml::ConstNodeRef root = tree.rootref();
-  s_entries.reserve(root.num_children());
+  entries->reserve(root.num_children());
 
   for (const ryml::ConstNodeRef& current : root.cchildren())
   {
-    // TODO: binary sort
-    const u32 index = static_cast<u32>(s_entries.size());
-    Entry& entry = s_entries.emplace_back();
+    const u32 index = static_cast<u32>(entries->size());
+    Entry& entry = entries->emplace_back();
     if (!ParseYamlEntry(&entry, current))
     {
-      s_entries.pop_back();
+      entries->pop_back();
       continue;
     }
 
-    ParseYamlCodes(index, current, entry.serial);
+    ParseYamlCodes(code_lookup, index, current, entry.serial);
   }
 
   ryml::reset_callbacks();
-  return !s_entries.empty();
+  return !entries->empty();
 }
 
 bool GameDatabase::ParseYamlEntry(Entry* entry, const ryml::ConstNodeRef& value)
@@ -1207,20 +1580,21 @@ bool GameDatabase::ParseYamlEntry(Entry* entry, const ryml::ConstNodeRef& value)
   return true;
 }
 
-bool GameDatabase::ParseYamlCodes(u32 index, const ryml::ConstNodeRef& value, std::string_view serial)
+bool GameDatabase::ParseYamlCodes(PreferUnorderedStringMap<u32>* code_lookup, u32 index,
+                                  const ryml::ConstNodeRef& value, std::string_view serial)
 {
   const ryml::ConstNodeRef& codes = value.find_child(to_csubstr("codes"));
   if (!codes.valid() || !codes.has_children())
   {
     // use serial instead
-    auto iter = s_code_lookup.find(serial);
-    if (iter != s_code_lookup.end())
+    auto iter = code_lookup->find(serial);
+    if (iter != code_lookup->end())
     {
       WARNING_LOG("Duplicate code '{}'", serial);
       return false;
     }
 
-    s_code_lookup.emplace(serial, index);
+    code_lookup->emplace(serial, index);
     return true;
   }
 
@@ -1234,14 +1608,14 @@ bool GameDatabase::ParseYamlCodes(u32 index, const ryml::ConstNodeRef& value, st
       continue;
     }
 
-    auto iter = s_code_lookup.find(current_code_str);
-    if (iter != s_code_lookup.end())
+    auto iter = code_lookup->find(current_code_str);
+    if (iter != code_lookup->end())
     {
       WARNING_LOG("Duplicate code '{}' in {}", current_code_str, serial);
       continue;
     }
 
-    s_code_lookup.emplace(current_code_str, index);
+    code_lookup->emplace(current_code_str, index);
     added++;
   }
 
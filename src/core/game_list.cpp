@@ -29,8 +29,12 @@
 
 #include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <ctime>
+#include <deque>
+#include <mutex>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -56,6 +60,12 @@ enum : u32
     PLAYED_TIME_SERIAL_LENGTH + 1 + PLAYED_TIME_LAST_TIME_LENGTH + 1 + PLAYED_TIME_TOTAL_TIME_LENGTH,
 };
 
+enum : u32
+{
+  MAX_COVER_VALIDATION_THREADS = 4,
+  COVER_DOWNLOAD_POLL_INTERVAL_MS = 100,
+};
+
 struct PlayedTimeEntry
 {
   std::time_t last_played_time;
@@ -76,6 +86,22 @@ struct MemcardTimestampCacheEntry
 };
 #pragma pack(pop)
 
+struct CoverDownload
+{
+  std::string entry_path;
+  std::string title;
+  std::vector<std::string> urls;
+  u32 next_url = 0;
+};
+
+struct CoverValidationJob
+{
+  u32 index;
+  std::string filename;
+  std::string content_type;
+  HTTPDownloader::Request::Data data;
+};
+
 } // namespace
 
 using CacheMap = PreferUnorderedStringMap<Entry>;
@@ -115,6 +141,9 @@ static PlayedTimeMap LoadPlayedTimeMap(const std::string& path);
 static PlayedTimeEntry UpdatePlayedTimeFile(const std::string& path, const std::string& serial, std::time_t last_time,
                                             std::time_t add_time);
 
+static bool EntryNeedsCover(const std::string& path);
+static std::string SaveDownloadedCover(const CoverDownload& download, const CoverValidationJob& job, bool use_serial);
+
 static std::string GetCustomPropertiesFile();
 
 static FileSystem::ManagedCFilePtr OpenMemoryCardTimestampCache(bool for_write);
@@ -1376,8 +1405,65 @@ GameList::GetMatchingEntriesForSerial(const std::span<const std::string> serials
   return ret;
 }
 
+bool GameList::EntryNeedsCover(const std::string& path)
+{
+  std::unique_lock lock(s_mutex);
+  const GameList::Entry* entry = GetEntryForPath(path);
+  return (entry && GetCoverImagePathForEntry(entry).empty());
+}
+
+std::string GameList::SaveDownloadedCover(const CoverDownload& download, const CoverValidationJob& job,
+                                          bool use_serial)
+{
+  // prefer the content type from the response for the extension
+  // otherwise, if it's missing, and the request didn't have an extension.. fall back to jpegs.
+  std::string template_filename;
+  std::string content_type_extension(HTTPDownloader::GetExtensionForContentType(job.content_type));
+
+  // don't treat the domain name as an extension..
+  const std::string::size_type last_slash = job.filename.find('/');
+  const std::string::size_type last_dot = job.filename.find('.');
+  if (!content_type_extension.empty())
+    template_filename = fmt::format("cover.{}", content_type_extension);
+  else if (last_slash != std::string::npos && last_dot != std::string::npos && last_dot > last_slash)
+    template_filename = Path::GetFileName(job.filename);
+  else
+    template_filename = "cover.jpg";
+
+  // Some servers return an error page with a 200 status, so make sure it's an image we can actually display.
+  RGBA8Image image;
+  if (!image.LoadFromBuffer(template_filename, job.data.data(), job.data.size()))
+  {
+    WARNING_LOG("Cover for '{}' from '{}' is not a valid image.", download.title, job.filename);
+    return {};
+  }
+
+  std::string write_path;
+  {
+    std::unique_lock lock(s_mutex);
+    const GameList::Entry* entry = GetEntryForPath(download.entry_path);
+    if (!entry || !GetCoverImagePathForEntry(entry).empty())
+      return {};
+
+    write_path = GetNewCoverImagePathForEntry(entry, template_filename.c_str(), use_serial);
+    if (write_path.empty())
+      return {};
+  }
+
+  // Written through a temporary file, so cancelling never leaves a truncated cover which would be skipped next time.
+  Error error;
+  if (!FileSystem::WriteAtomicRenamedFile(write_path, job.data.data(), job.data.size(), &error))
+  {
+    ERROR_LOG("Failed to write cover to '{}': {}", write_path, error.GetDescription());
+    return {};
+  }
+
+  return write_path;
+}
+
 bool GameList::DownloadCovers(const std::vector<std::string>& url_templates, bool use_serial,
-                              ProgressCallback* progress, std::function<void(const Entry*, std::string)> save_callback)
+                              u32 max_concurrent_downloads, ProgressCallback* progress,
+                              std::function<void(const Entry*, std::string)> save_callback)
 {
   if (!progress)
     progress = ProgressCallback::NullProgressCallback;
@@ -1400,7 +1486,8 @@ bool GameList::DownloadCovers(const std::vector<std::string>& url_templates, boo
     return false;
   }
 
-  std::vector<std::pair<std::string, std::string>> download_urls;
+  // Entries which already have a cover are skipped, which is what makes an interrupted download resumable.
+  std::vector<CoverDownload> downloads;
   {
     std::unique_lock lock(s_mutex);
     for (const GameList::Entry& entry : s_entries)
@@ -1409,6 +1496,9 @@ bool GameList::DownloadCovers(const std::vector<std::string>& url_templates, boo
       if (!existing_path.empty())
         continue;
 
+      CoverDownload& download = downloads.emplace_back();
+      download.entry_path = entry.path;
+      download.title = entry.title;
       for (const std::string& url_template : url_templates)
       {
         std::string url(url_template);
@@ -1422,11 +1512,11 @@ bool GameList::DownloadCovers(const std::vector<std::string>& url_templates, boo
         if (has_serial)
           StringUtil::ReplaceAll(&url, "${serial}", Path::URLEncode(entry.serial));
 
-        download_urls.emplace_back(entry.path, std::move(url));
+        download.urls.push_back(std::move(url));
       }
     }
   }
-  if (download_urls.empty())
+  if (downloads.empty())
   {
     progress->DisplayError("No URLs to download enumerated.");
     return false;
@@ -1439,64 +1529,154 @@ bool GameList::DownloadCovers(const std::vector<std::string>& url_templates, boo
     return false;
   }
 
+  max_concurrent_downloads = std::clamp(max_concurrent_downloads, 1u, MAX_CONCURRENT_COVER_DOWNLOADS);
+  downloader->SetMaxActiveRequests(max_concurrent_downloads);
+
   progress->SetCancellable(true);
-  progress->SetProgressRange(static_cast<u32>(download_urls.size()));
+  progress->SetProgressRange(static_cast<u32>(downloads.size()));
+  progress->SetProgressValue(0);
+  progress->FormatStatusText("Downloading covers for {} games...", downloads.size());
+
+  // Responses are decoded and written by a pool of workers, so validating one image doesn't hold up the network.
+  // Results come back as (download index, saved path), with an empty path if the request failed or was invalid.
+  std::mutex worker_mutex;
+  std::condition_variable worker_cv;
+  std::condition_variable result_cv;
+  std::deque<CoverValidationJob> jobs;
+  std::vector<std::pair<u32, std::string>> results;
+  bool workers_shutdown = false;
+
+  const u32 num_workers = std::clamp(std::thread::hardware_concurrency(), 1u,
+                                     std::min<u32>(MAX_COVER_VALIDATION_THREADS, max_concurrent_downloads));
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers);
+  for (u32 i = 0; i < num_workers; i++)
+  {
+    workers.emplace_back([&downloads, &worker_mutex, &worker_cv, &result_cv, &jobs, &results, &workers_shutdown,
+                          use_serial]() {
+      std::unique_lock lock(worker_mutex);
+      for (;;)
+      {
+        worker_cv.wait(lock, [&jobs, &workers_shutdown]() { return workers_shutdown || !jobs.empty(); });
+        if (jobs.empty())
+          break;
 
-  for (auto& [entry_path, url] : download_urls)
-  {
-    if (progress->IsCancelled())
-      break;
+        CoverValidationJob job = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+
+        std::string path = SaveDownloadedCover(downloads[job.index], job, use_serial);
+
+        lock.lock();
+        results.emplace_back(job.index, std::move(path));
+        result_cv.notify_one();
+      }
+    });
+  }
+
+  // Only a few requests are queued ahead of the active ones, rather than every URL up front.
+  const u32 max_queued_downloads = max_concurrent_downloads * 2;
+  u32 next_download = 0;
+  u32 active_downloads = 0;
+
+  const auto finish_download = [&downloads, &active_downloads, &progress, &save_callback](u32 index,
+                                                                                         std::string path) {
+    active_downloads--;
+    progress->IncrementProgressValue();
+    if (path.empty())
+      return;
 
-    // make sure it didn't get done already
+    progress->FormatStatusText("Downloaded cover for {}.", downloads[index].title);
+    if (save_callback)
     {
       std::unique_lock lock(s_mutex);
-      const GameList::Entry* entry = GetEntryForPath(entry_path);
-      if (!entry || !GetCoverImagePathForEntry(entry).empty())
-      {
-        progress->IncrementProgressValue();
-        continue;
-      }
+      if (const GameList::Entry* entry = GetEntryForPath(downloads[index].entry_path))
+        save_callback(entry, std::move(path));
+    }
+  };
 
-      progress->FormatStatusText("Downloading cover for {}...", entry->title);
+  // Tries the next URL template for an entry, or gives up on it if there are none left.
+  const auto start_next_request = [&downloads, &downloader, &worker_mutex, &worker_cv, &jobs, &results,
+                                   &finish_download](u32 index) {
+    CoverDownload& download = downloads[index];
+    if (download.next_url == download.urls.size() || !EntryNeedsCover(download.entry_path))
+    {
+      finish_download(index, {});
+      return;
     }
 
-    // we could actually do a few in parallel here...
+    std::string url = std::move(download.urls[download.next_url++]);
     std::string filename = Path::URLDecode(url);
     downloader->CreateRequest(
-      std::move(url), [use_serial, &save_callback, entry_path = std::move(entry_path), filename = std::move(filename)](
+      std::move(url), [index, filename = std::move(filename), &worker_mutex, &worker_cv, &jobs, &results](
                         s32 status_code, const std::string& content_type, HTTPDownloader::Request::Data data) {
-        if (status_code != HTTPDownloader::HTTP_STATUS_OK || data.empty())
-          return;
-
-        std::unique_lock lock(s_mutex);
-        const GameList::Entry* entry = GetEntryForPath(entry_path);
-        if (!entry || !GetCoverImagePathForEntry(entry).empty())
+        if (status_code == HTTPDownloader::HTTP_STATUS_CANCELLED)
           return;
 
-        // prefer the content type from the response for the extension
-        // otherwise, if it's missing, and the request didn't have an extension.. fall back to jpegs.
-        std::string template_filename;
-        std::string content_type_extension(HTTPDownloader::GetExtensionForContentType(content_type));
-
-        // don't treat the domain name as an extension..
-        const std::string::size_type last_slash = filename.find('/');
-        const std::string::size_type last_dot = filename.find('.');
-        if (!content_type_extension.empty())
-          template_filename = fmt::format("cover.{}", content_type_extension);
-        else if (last_slash != std::string::npos && last_dot != std::string::npos && last_dot > last_slash)
-          template_filename = Path::GetFileName(filename);
-        else
-          template_filename = "cover.jpg";
-
-        std::string write_path(GetNewCoverImagePathForEntry(entry, template_filename.c_str(), use_serial));
-        if (write_path.empty())
+        std::unique_lock lock(worker_mutex);
+        if (status_code != HTTPDownloader::HTTP_STATUS_OK || data.empty())
+        {
+          results.emplace_back(index, std::string());
           return;
+        }
 
-        if (FileSystem::WriteBinaryFile(write_path.c_str(), data.data(), data.size()) && save_callback)
-          save_callback(entry, std::move(write_path));
+        jobs.push_back(CoverValidationJob{index, std::move(filename), content_type, std::move(data)});
+        worker_cv.notify_one();
       });
-    downloader->WaitForAllRequests();
-    progress->IncrementProgressValue();
+  };
+
+  std::vector<std::pair<u32, std::string>> ready_results;
+  while (!progress->IsCancelled())
+  {
+    while (next_download < downloads.size() && active_downloads < max_queued_downloads)
+    {
+      active_downloads++;
+      start_next_request(next_download++);
+    }
+    if (active_downloads == 0)
+      break;
+
+    if (downloader->HasAnyRequests())
+    {
+      downloader->PollRequests(COVER_DOWNLOAD_POLL_INTERVAL_MS);
+    }
+    else
+    {
+      // Everything left is being validated, wait for the workers instead of spinning.
+      std::unique_lock lock(worker_mutex);
+      result_cv.wait_for(lock, std::chrono::milliseconds(COVER_DOWNLOAD_POLL_INTERVAL_MS),
+                         [&results]() { return !results.empty(); });
+    }
+
+    {
+      std::unique_lock lock(worker_mutex);
+      ready_results.swap(results);
+    }
+    for (auto& [index, path] : ready_results)
+    {
+      if (!path.empty())
+        finish_download(index, std::move(path));
+      else
+        start_next_request(index);
+    }
+    ready_results.clear();
+  }
+
+  downloader->CancelAllRequests();
+  {
+    std::unique_lock lock(worker_mutex);
+    jobs.clear();
+    workers_shutdown = true;
+  }
+  worker_cv.notify_all();
+  for (std::thread& thread : workers)
+    thread.join();
+
+  // Covers which finished writing after cancellation still need to be reported.
+  for (auto& [index, path] : results)
+  {
+    if (!path.empty())
+      finish_download(index, std::move(path));
   }
 
   return true;
@@ -125,9 +125,16 @@ std::string GetNewCoverImagePathForEntry(const Entry* entry, const char* new_fil
 std::vector<std::pair<std::string, const Entry*>>
 GetMatchingEntriesForSerial(const std::span<const std::string> serials);
 
+static constexpr u32 DEFAULT_CONCURRENT_COVER_DOWNLOADS = 8;
+static constexpr u32 MAX_CONCURRENT_COVER_DOWNLOADS = 32;
+
 /// Downloads covers using the specified URL templates. By default, covers are saved by title, but this can be changed
-/// with the use_serial parameter. save_callback optionall takes the entry and the path the new cover is saved to.
+/// with the use_serial parameter. Up to max_concurrent_downloads requests are in flight at once, and each template is
+/// tried in order until one returns a valid image. Entries which already have a cover are skipped, so a cancelled
+/// download can be resumed by calling this again. save_callback optionally takes the entry and the path the new cover
+/// is saved to, and is called on the calling thread.
 bool DownloadCovers(const std::vector<std::string>& url_templates, bool use_serial = false,
+                    u32 max_concurrent_downloads = DEFAULT_CONCURRENT_COVER_DOWNLOADS,
                     ProgressCallback* progress = nullptr,
                     std::function<void(const Entry*, std::string)> save_callback = {});
 
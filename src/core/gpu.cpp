@@ -30,6 +30,7 @@
 #include "IconsEmoji.h"
 #include "fmt/format.h"
 #include "imgui.h"
+#include "xxhash.h"
 
 #include <cmath>
 #include <numbers>
@@ -78,11 +79,14 @@ GPU::~GPU()
   s_crtc_tick_event.Deactivate();
 
   JoinScreenshotThreads();
-  DestroyDeinterlaceTextures();
-  g_gpu_device->RecycleTexture(std::move(m_chroma_smoothing_texture));
 
   if (g_gpu_device)
+  {
+    DestroyDeinterlaceTextures();
+    g_gpu_device->RecycleTexture(std::move(m_chroma_smoothing_texture));
     g_gpu_device->SetGPUTimingEnabled(false);
+    g_gpu_device->SetThreadedSubmission(false);
+  }
 }
 
 bool GPU::Initialize()
@@ -92,6 +96,7 @@ bool GPU::Initialize()
   s_crtc_tick_event.Activate();
   m_fifo_size = g_settings.gpu_fifo_size;
   m_max_run_ahead = g_settings.gpu_max_run_ahead;
+  UpdateFifoAddressTracking();
   m_console_is_pal = System::IsPALRegion();
   UpdateCRTCConfig();
 
@@ -102,6 +107,7 @@ bool GPU::Initialize()
   }
 
   g_gpu_device->SetGPUTimingEnabled(g_settings.display_show_gpu_usage);
+  UpdateThreadedSubmission();
 
 #ifdef PSX_GPU_STATS
   s_active_gpu_cycles = 0;
@@ -118,6 +124,7 @@ void GPU::UpdateSettings(const Settings& old_settings)
   m_force_progressive_scan = (g_settings.display_deinterlacing_mode == DisplayDeinterlacingMode::Progressive);
   m_fifo_size = g_settings.gpu_fifo_size;
   m_max_run_ahead = g_settings.gpu_max_run_ahead;
+  UpdateFifoAddressTracking();
 
   if (m_force_frame_timings != g_settings.gpu_force_video_timing)
   {
@@ -147,6 +154,7 @@ void GPU::UpdateSettings(const Settings& old_settings)
   }
 
   g_gpu_device->SetGPUTimingEnabled(g_settings.display_show_gpu_usage);
+  UpdateThreadedSubmission();
 }
 
 void GPU::CPUClockChanged()
@@ -344,7 +352,34 @@ bool GPU::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_displ
   sw.Do(&m_vram_transfer.col);
   sw.Do(&m_vram_transfer.row);
 
-  sw.Do(&m_fifo);
+  if (sw.GetVersion() < 72) [[unlikely]]
+  {
+    // FIFO used to hold the address in the upper 32 bits of each word.
+    HeapFIFOQueue<u64, MAX_FIFO_SIZE> old_fifo;
+    sw.Do(&old_fifo);
+    m_fifo.Clear();
+    while (!old_fifo.IsEmpty())
+    {
+      const u64 word = old_fifo.Pop();
+      FifoPush(Truncate32(word >> 32), Truncate32(word));
+    }
+  }
+  else
+  {
+    sw.Do(&m_fifo);
+
+    // Addresses are stored in FIFO order, since loading moves the queue back to the start of the ring.
+    const u32 read_index = FifoIndex(m_fifo.GetReadPointer());
+    for (u32 i = 0; i < m_fifo.GetSize(); i++)
+    {
+      const u32 index = (read_index + i) % MAX_FIFO_SIZE;
+      u32 address = m_fifo_track_addresses ? m_fifo_addresses[index] : 0;
+      sw.Do(&address);
+      if (m_fifo_track_addresses)
+        m_fifo_addresses[index] = address;
+    }
+  }
+
   sw.Do(&m_blit_buffer);
   sw.Do(&m_blit_remaining_words);
   sw.Do(&m_render_command.bits);
@@ -476,7 +511,7 @@ void GPU::WriteRegister(u32 offset, u32 value)
   switch (offset)
   {
     case 0x00:
-      m_fifo.Push(value);
+      FifoPush(0, value);
       ExecuteCommands();
       return;
 
@@ -542,6 +577,37 @@ TickCount GPU::SystemTicksToCRTCTicks(TickCount sysclk_ticks, TickCount* fractio
   return ticks;
 }
 
+void GPU::FifoPushRange(u32 address, const u32* values, u32 count)
+{
+  if (m_fifo_track_addresses) [[unlikely]]
+  {
+    u32 index = FifoIndex(m_fifo.GetWritePointer());
+    for (u32 i = 0; i < count; i++)
+    {
+      m_fifo_addresses[index] = address;
+      index = (index + 1) % MAX_FIFO_SIZE;
+      address += sizeof(u32);
+    }
+  }
+
+  m_fifo.PushRange(values, count);
+}
+
+void GPU::UpdateFifoAddressTracking()
+{
+  // Addresses are only consumed by PGXP's vertex lookup. Words already queued when this is switched on will miss
+  // their address, which just means PGXP falls back to the native position for them.
+  m_fifo_track_addresses = g_settings.gpu_pgxp_enable;
+  if (m_fifo_track_addresses && !m_fifo_addresses)
+    m_fifo_addresses = std::make_unique<u32[]>(MAX_FIFO_SIZE);
+}
+
+void GPU::UpdateThreadedSubmission()
+{
+  // The software renderer already has its own worker thread, only offload submission for the hardware renderers.
+  g_gpu_device->SetThreadedSubmission(g_settings.gpu_threaded_presentation && IsHardwareRenderer());
+}
+
 void GPU::AddCommandTicks(TickCount ticks)
 {
   m_pending_command_ticks += ticks;
@@ -1022,10 +1088,11 @@ void GPU::CRTCTickEvent(TickCount ticks)
       {
         DEBUG_LOG("Now in v-blank");
 
-        // flush any pending draws and "scan out" the image
+        // flush any pending draws and "scan out" the image, unless it's a runahead replay frame which won't be shown
         // TODO: move present in here I guess
         FlushRender();
-        UpdateDisplay();
+        if (!System::IsReplayingHiddenRunaheadFrame() || IsScanoutNeededForFieldHistory())
+          UpdateDisplay();
         frame_done = true;
 
         // switch fields early. this is needed so we draw to the correct one.
@@ -1510,6 +1577,10 @@ void GPU::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
 }
 
+void GPU::OnCPUReadVRAM(u32 x, u32 y, u32 width, u32 height)
+{
+}
+
 void GPU::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
 {
   const u16 color16 = VRAMRGBA8888ToRGBA5551(color);
@@ -2215,6 +2286,13 @@ void GPU::DestroyDeinterlaceTextures()
   m_current_deinterlace_buffer = 0;
 }
 
+bool GPU::IsScanoutNeededForFieldHistory() const
+{
+  return (IsInterlacedDisplayEnabled() &&
+          (g_settings.display_deinterlacing_mode == DisplayDeinterlacingMode::Blend ||
+           g_settings.display_deinterlacing_mode == DisplayDeinterlacingMode::Adaptive));
+}
+
 bool GPU::Deinterlace(u32 field, u32 line_skip)
 {
   GPUTexture* src = m_display_texture;
@@ -2883,6 +2961,38 @@ bool GPU::DumpVRAMToFile(const char* filename)
   }
 }
 
+u64 GPU::GetDisplayVRAMHash()
+{
+  if (IsDisplayDisabled())
+    return 0;
+
+  ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+
+  // 24-bit scanout starts at the unskipped X, and reads three bytes per pixel.
+  const bool is_24bit = m_GPUSTAT.display_area_color_depth_24;
+  const u32 left = is_24bit ? m_crtc_state.regs.X : m_crtc_state.display_vram_left;
+  const u32 skip_x = is_24bit ? (m_crtc_state.display_vram_left - m_crtc_state.regs.X) : 0;
+  const u32 width = std::min<u32>(
+    is_24bit ? ((skip_x + m_crtc_state.display_vram_width) * 3 + 1) / 2 : m_crtc_state.display_vram_width, VRAM_WIDTH);
+  const u32 height = std::min<u32>(m_crtc_state.display_vram_height, VRAM_HEIGHT);
+
+  // The display area can wrap around both edges of VRAM.
+  XXH64_state_t* state = XXH64_createState();
+  XXH64_reset(state, 0);
+  for (u32 row = 0; row < height; row++)
+  {
+    const u16* row_ptr = &g_vram[((m_crtc_state.display_vram_top + row) % VRAM_HEIGHT) * VRAM_WIDTH];
+    const u32 first_width = std::min(width, VRAM_WIDTH - left);
+    XXH64_update(state, &row_ptr[left], first_width * sizeof(u16));
+    if (first_width < width)
+      XXH64_update(state, row_ptr, (width - first_width) * sizeof(u16));
+  }
+
+  const u64 hash = XXH64_digest(state);
+  XXH64_freeState(state);
+  return hash;
+}
+
 bool GPU::DumpVRAMToFile(const char* filename, u32 width, u32 height, u32 stride, const void* buffer, bool remove_alpha)
 {
   RGBA8Image image(width, height);
@@ -2976,6 +3086,10 @@ void GPU::DrawDebugStateWindow()
   ImGui::End();
 }
 
+void GPU::SetDrawsSkipped(bool skipped)
+{
+}
+
 void GPU::DrawRendererStats()
 {
 }
@@ -3012,7 +3126,8 @@ void GPU::GetMemoryStatsString(SmallStringBase& str)
 void GPU::ResetStatistics()
 {
   m_counters = {};
-  g_gpu_device->ResetStatistics();
+  if (g_gpu_device)
+    g_gpu_device->ResetStatistics();
 }
 
 void GPU::UpdateStatistics(u32 frame_count)
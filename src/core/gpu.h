@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <deque>
 #include <memory>
 #include <string>
@@ -122,12 +123,17 @@ public:
   {
     return (m_GPUSTAT.dma_direction == DMADirection::CPUtoGP0 || m_GPUSTAT.dma_direction == DMADirection::FIFO);
   }
-  ALWAYS_INLINE void DMAWrite(u32 address, u32 value)
+  ALWAYS_INLINE void DMAWrite(u32 address, u32 value) { FifoPush(address, value); }
+  ALWAYS_INLINE void DMAWrite(u32 address, const u32* values, u32 word_count)
   {
-    m_fifo.Push((ZeroExtend64(address) << 32) | ZeroExtend64(value));
+    FifoPushRange(address, values, word_count);
   }
   void EndDMAWrite();
 
+  /// DMA linked-list fast path. Executes the packets in a node straight from RAM, handing anything which can't be
+  /// decoded in place (partial packets, VRAM transfers, poly-lines) to the FIFO. The node must not wrap around RAM.
+  void DMAWriteLinkedListNode(const u8* ram_ptr, u32 address, u32 word_count);
+
   /// Returns true if no data is being sent from VRAM to the DAC or that no portion of VRAM would be visible on screen.
   ALWAYS_INLINE bool IsDisplayDisabled() const
   {
@@ -140,6 +146,10 @@ public:
     return (!m_force_progressive_scan && m_GPUSTAT.vertical_interlace);
   }
 
+  /// Returns true if every field has to be scanned out, even when it won't be presented, because the deinterlacer
+  /// blends it with the fields which follow.
+  bool IsScanoutNeededForFieldHistory() const;
+
   /// Returns true if interlaced rendering is enabled and force progressive scan is disabled.
   ALWAYS_INLINE bool IsInterlacedRenderingEnabled() const
   {
@@ -168,6 +178,11 @@ public:
   /// Updates the resolution scale when it's set to automatic.
   virtual void UpdateResolutionScale();
 
+  /// Discards the rendering of primitives into the displayed area of VRAM until re-enabled, used for frame skipping.
+  /// Draws elsewhere in VRAM, transfers, fills and copies are still executed, since games can read them back. If the
+  /// game reads from the displayed area, skipping stops. Renderers which can't skip drawing ignore this.
+  virtual void SetDrawsSkipped(bool skipped);
+
   /// Returns the effective display resolution of the GPU.
   virtual std::tuple<u32, u32> GetEffectiveDisplayResolution(bool scaled = true);
 
@@ -210,6 +225,9 @@ public:
   // Dumps raw VRAM to a file.
   bool DumpVRAMToFile(const char* filename);
 
+  /// Returns a digest of the VRAM area which is currently scanned out, or zero if the display is disabled.
+  u64 GetDisplayVRAMHash();
+
   // Ensures all buffered vertices are drawn.
   virtual void FlushRender() = 0;
 
@@ -310,6 +328,8 @@ protected:
   }
 
   void AddCommandTicks(TickCount ticks);
+  void UpdateFifoAddressTracking();
+  void UpdateThreadedSubmission();
 
   void WriteGP1(u32 value);
   void EndCommand();
@@ -322,6 +342,7 @@ protected:
 
   // Rendering in the backend
   virtual void ReadVRAM(u32 x, u32 y, u32 width, u32 height);
+  virtual void OnCPUReadVRAM(u32 x, u32 y, u32 width, u32 height);
   virtual void FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color);
   virtual void UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask, bool check_mask);
   virtual void CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height);
@@ -615,14 +636,81 @@ protected:
     u16 row;
   } m_vram_transfer = {};
 
-  HeapFIFOQueue<u64, MAX_FIFO_SIZE> m_fifo;
+  HeapFIFOQueue<u32, MAX_FIFO_SIZE> m_fifo;
+
+  // RAM address of each word in the FIFO, indexed by its position in the ring. Only PGXP needs these, so they are
+  // not written unless m_fifo_track_addresses is set, and the common path stays a plain 32-bit queue.
+  std::unique_ptr<u32[]> m_fifo_addresses;
+  bool m_fifo_track_addresses = false;
+
   std::vector<u32> m_blit_buffer;
   u32 m_blit_remaining_words;
   GPURenderCommand m_render_command{};
 
-  ALWAYS_INLINE u32 FifoPop() { return Truncate32(m_fifo.Pop()); }
-  ALWAYS_INLINE u32 FifoPeek() { return Truncate32(m_fifo.Peek()); }
-  ALWAYS_INLINE u32 FifoPeek(u32 i) { return Truncate32(m_fifo.Peek(i)); }
+  // Packet currently being decoded in place by the DMA linked-list fast path. The FIFO is always empty while
+  // m_packet_remaining is non-zero, so the accessors below read from RAM instead.
+  const u8* m_packet_ptr = nullptr;
+  u32 m_packet_address = 0;
+  u32 m_packet_remaining = 0;
+
+  ALWAYS_INLINE u32 FifoIndex(const u32* ptr) const { return static_cast<u32>(ptr - m_fifo.GetDataPointer()); }
+  ALWAYS_INLINE void FifoPush(u32 address, u32 value)
+  {
+    if (m_fifo_track_addresses) [[unlikely]]
+      m_fifo_addresses[FifoIndex(m_fifo.GetWritePointer())] = address;
+
+    m_fifo.Push(value);
+  }
+  void FifoPushRange(u32 address, const u32* values, u32 count);
+  ALWAYS_INLINE void FifoPopRange(u32* values, u32 count) { m_fifo.PopRange(values, count); }
+
+  ALWAYS_INLINE u32 FifoSize() const { return m_fifo.GetSize() + m_packet_remaining; }
+  ALWAYS_INLINE u32 FifoPop()
+  {
+    if (m_packet_remaining > 0)
+    {
+      u32 value;
+      std::memcpy(&value, m_packet_ptr, sizeof(value));
+      m_packet_ptr += sizeof(value);
+      m_packet_address += sizeof(value);
+      m_packet_remaining--;
+      return value;
+    }
+
+    return m_fifo.Pop();
+  }
+  ALWAYS_INLINE u32 FifoPopWithAddress(u32* address)
+  {
+    if (m_packet_remaining > 0)
+      *address = m_packet_address;
+    else
+      *address = m_fifo_track_addresses ? m_fifo_addresses[FifoIndex(m_fifo.GetReadPointer())] : 0;
+
+    return FifoPop();
+  }
+  ALWAYS_INLINE u32 FifoPeek(u32 i = 0)
+  {
+    if (m_packet_remaining > 0)
+    {
+      u32 value;
+      std::memcpy(&value, m_packet_ptr + i * sizeof(value), sizeof(value));
+      return value;
+    }
+
+    return m_fifo.Peek(i);
+  }
+  ALWAYS_INLINE void FifoRemoveOne()
+  {
+    if (m_packet_remaining > 0)
+    {
+      m_packet_ptr += sizeof(u32);
+      m_packet_address += sizeof(u32);
+      m_packet_remaining--;
+      return;
+    }
+
+    m_fifo.RemoveOne();
+  }
 
   TickCount m_max_run_ahead = 128;
   u32 m_fifo_size = 128;
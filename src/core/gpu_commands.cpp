@@ -13,7 +13,7 @@
 Log_SetChannel(GPU);
 
 #define CHECK_COMMAND_SIZE(num_words)                                                                                  \
-  if (m_fifo.GetSize() < num_words)                                                                                    \
+  if (FifoSize() < num_words)                                                                                          \
   {                                                                                                                    \
     m_command_total_words = num_words;                                                                                 \
     return false;                                                                                                      \
@@ -46,9 +46,9 @@ void GPU::TryExecuteCommands()
       {
         DebugAssert(m_blit_remaining_words > 0);
         const u32 words_to_copy = std::min(m_blit_remaining_words, m_fifo.GetSize());
-        m_blit_buffer.reserve(m_blit_buffer.size() + words_to_copy);
-        for (u32 i = 0; i < words_to_copy; i++)
-          m_blit_buffer.push_back(FifoPop());
+        const size_t blit_buffer_pos = m_blit_buffer.size();
+        m_blit_buffer.resize(blit_buffer_pos + words_to_copy);
+        FifoPopRange(&m_blit_buffer[blit_buffer_pos], words_to_copy);
         m_blit_remaining_words -= words_to_copy;
 
         DEBUG_LOG("VRAM write burst of {} words, {} words remaining", words_to_copy, m_blit_remaining_words);
@@ -81,16 +81,16 @@ void GPU::TryExecuteCommands()
         const u32 words_to_copy = std::min(terminator_index, m_fifo.GetSize());
         if (words_to_copy > 0)
         {
-          m_blit_buffer.reserve(m_blit_buffer.size() + words_to_copy);
-          for (u32 i = 0; i < words_to_copy; i++)
-            m_blit_buffer.push_back(FifoPop());
+          const size_t blit_buffer_pos = m_blit_buffer.size();
+          m_blit_buffer.resize(blit_buffer_pos + words_to_copy);
+          FifoPopRange(&m_blit_buffer[blit_buffer_pos], words_to_copy);
         }
 
         DEBUG_LOG("Added {} words to polyline", words_to_copy);
         if (found_terminator)
         {
           // drop terminator
-          m_fifo.RemoveOne();
+          FifoRemoveOne();
           DEBUG_LOG("Drawing poly-line with {} vertices", GetPolyLineVertexCount());
           DispatchRenderCommand();
           m_blit_buffer.clear();
@@ -116,6 +116,69 @@ void GPU::ExecuteCommands()
     UpdateCommandTickEvent();
 }
 
+/// Returns the number of words in a GP0 packet which the linked-list fast path can execute in place, or zero if the
+/// command has to go through the FIFO.
+static u32 GetInPlacePacketWordCount(u32 command_word)
+{
+  const u32 command = command_word >> 24;
+  if (command < 0x20)
+    return (command == 0x02) ? 0 : 1;
+  else if (command >= 0xE0 && command <= 0xEF)
+    return 1;
+  else if (command >= 0x80)
+    return 0;
+
+  const GPURenderCommand rc{command_word};
+  switch (rc.primitive)
+  {
+    case GPUPrimitive::Polygon:
+    {
+      const u32 words_per_vertex = 1 + BoolToUInt32(rc.texture_enable) + BoolToUInt32(rc.shading_enable);
+      return words_per_vertex * (rc.quad_polygon ? 4 : 3) + BoolToUInt32(!rc.shading_enable);
+    }
+
+    case GPUPrimitive::Line:
+      return rc.polyline ? 0 : (rc.shading_enable ? 4 : 3);
+
+    case GPUPrimitive::Rectangle:
+      return 2 + BoolToUInt32(rc.texture_enable) + BoolToUInt32(rc.rectangle_size == GPUDrawRectangleSize::Variable);
+
+    default:
+      return 0;
+  }
+}
+
+void GPU::DMAWriteLinkedListNode(const u8* ram_ptr, u32 address, u32 word_count)
+{
+  const bool was_executing_from_event = std::exchange(m_executing_commands, true);
+
+  // Packets can only bypass the FIFO when nothing is queued ahead of them, otherwise ordering would change.
+  while (word_count > 0 && m_fifo.IsEmpty() && m_blitter_state == BlitterState::Idle &&
+         m_pending_command_ticks <= m_max_run_ahead)
+  {
+    u32 command_word;
+    std::memcpy(&command_word, &ram_ptr[address], sizeof(command_word));
+    const u32 packet_words = GetInPlacePacketWordCount(command_word);
+    if (packet_words == 0 || packet_words > word_count)
+      break;
+
+    m_packet_ptr = &ram_ptr[address];
+    m_packet_address = address;
+    m_packet_remaining = packet_words;
+    (this->*s_GP0_command_handler_table[command_word >> 24])();
+    DebugAssert(m_packet_remaining == 0);
+
+    address += packet_words * sizeof(u32);
+    word_count -= packet_words;
+  }
+
+  if (word_count > 0)
+    FifoPushRange(address, reinterpret_cast<const u32*>(&ram_ptr[address]), word_count);
+
+  m_executing_commands = was_executing_from_event;
+  ExecuteCommands();
+}
+
 void GPU::EndCommand()
 {
   m_blitter_state = BlitterState::Idle;
@@ -184,14 +247,14 @@ bool GPU::HandleUnknownGP0Command()
     dump.append_format("{}{:08X}", (i > 0) ? " " : "", FifoPeek(i));
   ERROR_LOG("FIFO: {}", dump);
 
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
   EndCommand();
   return true;
 }
 
 bool GPU::HandleNOPCommand()
 {
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
   EndCommand();
   return true;
 }
@@ -201,7 +264,7 @@ bool GPU::HandleClearCacheCommand()
   DEBUG_LOG("GP0 clear cache");
   m_draw_mode.SetTexturePageChanged();
   InvalidateCLUT();
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
   AddCommandTicks(1);
   EndCommand();
   return true;
@@ -214,7 +277,7 @@ bool GPU::HandleInterruptRequestCommand()
   m_GPUSTAT.interrupt_request = true;
   InterruptController::SetLineState(InterruptController::IRQ::GPU, true);
 
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
   AddCommandTicks(1);
   EndCommand();
   return true;
@@ -357,7 +420,7 @@ bool GPU::HandleRenderPolygonCommand()
   m_counters.num_vertices += num_vertices;
   m_counters.num_primitives++;
   m_render_command.bits = rc.bits;
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   DispatchRenderCommand();
   EndCommand();
@@ -391,7 +454,7 @@ bool GPU::HandleRenderRectangleCommand()
   m_counters.num_vertices++;
   m_counters.num_primitives++;
   m_render_command.bits = rc.bits;
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   DispatchRenderCommand();
   EndCommand();
@@ -413,7 +476,7 @@ bool GPU::HandleRenderLineCommand()
   m_counters.num_vertices += 2;
   m_counters.num_primitives++;
   m_render_command.bits = rc.bits;
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   DispatchRenderCommand();
   EndCommand();
@@ -437,7 +500,7 @@ bool GPU::HandleRenderPolyLineCommand()
             rc.shading_enable ? "shaded" : "monochrome", setup_ticks);
 
   m_render_command.bits = rc.bits;
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   const u32 words_to_pop = min_words - 1;
   // m_blit_buffer.resize(words_to_pop);
@@ -481,7 +544,7 @@ bool GPU::HandleFillRectangleCommand()
 bool GPU::HandleCopyRectangleCPUToVRAMCommand()
 {
   CHECK_COMMAND_SIZE(3);
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   const u32 coords = FifoPop();
   const u32 size = FifoPop();
@@ -576,7 +639,7 @@ void GPU::FinishVRAMWrite()
 bool GPU::HandleCopyRectangleVRAMToCPUCommand()
 {
   CHECK_COMMAND_SIZE(3);
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   m_vram_transfer.x = Truncate16(FifoPeek() & VRAM_WIDTH_MASK);
   m_vram_transfer.y = Truncate16((FifoPop() >> 16) & VRAM_HEIGHT_MASK);
@@ -588,6 +651,7 @@ bool GPU::HandleCopyRectangleVRAMToCPUCommand()
   DebugAssert(m_vram_transfer.col == 0 && m_vram_transfer.row == 0);
 
   // all rendering should be done first...
+  OnCPUReadVRAM(m_vram_transfer.x, m_vram_transfer.y, m_vram_transfer.width, m_vram_transfer.height);
   FlushRender();
 
   // ensure VRAM shadow is up to date
@@ -610,7 +674,7 @@ bool GPU::HandleCopyRectangleVRAMToCPUCommand()
 bool GPU::HandleCopyRectangleVRAMToVRAMCommand()
 {
   CHECK_COMMAND_SIZE(4);
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   const u32 src_x = FifoPeek() & VRAM_WIDTH_MASK;
   const u32 src_y = (FifoPop() >> 16) & VRAM_HEIGHT_MASK;
@@ -19,18 +19,26 @@
 #include "common/error.h"
 #include "common/gsvector_formatter.h"
 #include "common/log.h"
-#include "common/scoped_guard.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 #include "common/timer.h"
 
 #include "IconsFontAwesome5.h"
 #include "IconsEmoji.h"
 #include "imgui.h"
+#include "xxhash.h"
 
+#include <bit>
 #include <cmath>
+#include <condition_variable>
+#include <functional>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <tuple>
+#include <utility>
 
 Log_SetChannel(GPU_HW);
 
@@ -177,6 +185,170 @@ private:
   u32 m_progress;
   u32 m_total;
 };
+
+/// Generates shader sources on worker threads, and creates each unique source only once, since many permutations
+/// produce identical code. Backends which allow shaders to be created from several threads compile on the workers as
+/// well, otherwise compilation stays on the calling thread.
+class ShaderCompileQueue
+{
+public:
+  using GenerateFunction = std::function<std::string(GPU_HW_ShaderGen&)>;
+
+  explicit ShaderCompileQueue(const GPU_HW_ShaderGen& shadergen) : m_shadergen(shadergen) {}
+  ~ShaderCompileQueue() = default;
+
+  /// Queues a shader to be generated. The pointer stored in out_shader is owned by the queue.
+  void Add(GPUShaderStage stage, GPUShader** out_shader, GenerateFunction generate)
+  {
+    m_jobs.push_back(Job{stage, out_shader, std::move(generate), {}, {}, {}, 0, false});
+  }
+
+  bool Compile(ShaderCompileProgressTracker& progress, Error* error);
+
+  /// Destroys all compiled shaders. Pointers returned through Add() are no longer valid.
+  void ReleaseShaders() { m_jobs.clear(); }
+
+private:
+  static constexpr u32 MAX_WORKER_THREADS = 8;
+
+  // Bounds memory usage, since generation is much faster than compilation.
+  static constexpr u32 MAX_JOBS_AHEAD = 64;
+
+  struct Job
+  {
+    GPUShaderStage stage;
+    GPUShader** out_shader;
+    GenerateFunction generate;
+    std::string source;
+    std::unique_ptr<GPUShader> shader;
+    Error error;
+
+    // Index of the first job with the same source, which owns the shader.
+    u32 source_job;
+    bool ready;
+  };
+
+  void WorkerThread();
+
+  const GPU_HW_ShaderGen& m_shadergen;
+  std::vector<Job> m_jobs;
+  std::map<std::pair<u64, u64>, u32> m_unique_sources;
+  bool m_threaded_compile = false;
+
+  std::mutex m_mutex;
+  std::condition_variable m_generate_cv;
+  std::condition_variable m_ready_cv;
+  u32 m_next_generate = 0;
+  u32 m_next_compile = 0;
+  bool m_shutdown = false;
+};
+
+bool ShaderCompileQueue::Compile(ShaderCompileProgressTracker& progress, Error* error)
+{
+  m_threaded_compile = g_gpu_device->GetFeatures().threaded_shader_creation;
+
+  const u32 num_jobs = static_cast<u32>(m_jobs.size());
+  const u32 num_threads = std::clamp(std::thread::hardware_concurrency(), 1u, std::min(MAX_WORKER_THREADS, num_jobs));
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (u32 i = 0; i < num_threads; i++)
+    threads.emplace_back(&ShaderCompileQueue::WorkerThread, this);
+
+  u32 num_unique_shaders = 0;
+  bool result = true;
+  for (u32 i = 0; i < num_jobs; i++)
+  {
+    // The first job with this source can come later in the queue, if a worker hashed it first.
+    Job& job = m_jobs[i];
+    {
+      std::unique_lock lock(m_mutex);
+      m_ready_cv.wait(lock, [this, &job]() { return job.ready && m_jobs[job.source_job].ready; });
+    }
+
+    Job& source_job = m_jobs[job.source_job];
+    if (!m_threaded_compile && !source_job.shader && !source_job.source.empty())
+    {
+      source_job.shader =
+        g_gpu_device->CreateShader(source_job.stage, m_shadergen.GetLanguage(), source_job.source, &source_job.error);
+      std::string().swap(source_job.source);
+    }
+
+    if (!source_job.shader)
+    {
+      if (error)
+        *error = source_job.error;
+      result = false;
+      break;
+    }
+
+    *job.out_shader = source_job.shader.get();
+    num_unique_shaders += BoolToUInt32(job.source_job == i);
+    progress.Increment();
+
+    {
+      std::unique_lock lock(m_mutex);
+      m_next_compile = i + 1;
+    }
+    m_generate_cv.notify_all();
+  }
+
+  {
+    std::unique_lock lock(m_mutex);
+    m_shutdown = true;
+  }
+  m_generate_cv.notify_all();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  DEV_LOG("Compiled {} unique shaders for {} permutations{}.", num_unique_shaders, num_jobs,
+          m_threaded_compile ? " on worker threads" : "");
+  return result;
+}
+
+void ShaderCompileQueue::WorkerThread()
+{
+  Threading::SetNameOfCurrentThread("Shader Compiler");
+
+  // Generation modifies state in the generator, so each thread needs its own copy.
+  GPU_HW_ShaderGen shadergen(m_shadergen);
+
+  std::unique_lock lock(m_mutex);
+  for (;;)
+  {
+    m_generate_cv.wait(lock, [this]() {
+      return (m_shutdown || m_next_generate == m_jobs.size() || (m_next_generate - m_next_compile) < MAX_JOBS_AHEAD);
+    });
+    if (m_shutdown || m_next_generate == m_jobs.size())
+      break;
+
+    const u32 index = m_next_generate++;
+    Job& job = m_jobs[index];
+    lock.unlock();
+
+    job.source = job.generate(shadergen);
+    const XXH128_hash_t hash =
+      XXH3_128bits_withSeed(job.source.data(), job.source.length(), static_cast<XXH64_hash_t>(job.stage));
+
+    lock.lock();
+    const auto [it, inserted] = m_unique_sources.emplace(std::make_pair(hash.low64, hash.high64), index);
+    job.source_job = it->second;
+    if (!inserted)
+    {
+      std::string().swap(job.source);
+    }
+    else if (m_threaded_compile)
+    {
+      lock.unlock();
+      job.shader = g_gpu_device->CreateShader(job.stage, shadergen.GetLanguage(), job.source, &job.error);
+      std::string().swap(job.source);
+      lock.lock();
+    }
+
+    job.ready = true;
+    m_ready_cv.notify_all();
+  }
+}
+
 } // namespace
 
 GPU_HW::GPU_HW() : GPU()
@@ -295,6 +467,7 @@ void GPU_HW::Reset(bool clear_vram)
   m_batch_ubo_data = {};
   m_batch_ubo_dirty = true;
   m_current_depth = 1;
+  m_skip_draws_unsafe = false;
   SetClampedDrawingArea();
 
   if (clear_vram)
@@ -709,6 +882,7 @@ bool GPU_HW::IsUsingDownsampling() const
 void GPU_HW::SetFullVRAMDirtyRectangle()
 {
   m_vram_dirty_draw_rect = VRAM_SIZE_RECT;
+  m_vram_dirty_draw_tiles.fill(static_cast<u16>((1u << VRAM_DIRTY_TILES_X) - 1));
   m_draw_mode.SetTexturePageChanged();
 }
 
@@ -716,12 +890,19 @@ void GPU_HW::ClearVRAMDirtyRectangle()
 {
   m_vram_dirty_draw_rect = INVALID_RECT;
   m_vram_dirty_write_rect = INVALID_RECT;
+  m_vram_dirty_draw_tiles = {};
+  m_vram_dirty_write_tiles = {};
+  m_skippable_draw_rect = INVALID_RECT;
+  m_previous_skippable_draw_rect = INVALID_RECT;
+  m_skippable_draw_tiles = {};
+  m_previous_skippable_draw_tiles = {};
 }
 
 void GPU_HW::AddWrittenRectangle(const GSVector4i rect)
 {
   m_vram_dirty_write_rect = m_vram_dirty_write_rect.runion(rect);
-  SetTexPageChangedOnOverlap(m_vram_dirty_write_rect);
+  AddDirtyTiles(m_vram_dirty_write_tiles, rect);
+  SetTexPageChangedOnOverlap(m_vram_dirty_write_rect, m_vram_dirty_write_tiles);
 }
 
 void GPU_HW::AddDrawnRectangle(const GSVector4i rect)
@@ -730,25 +911,106 @@ void GPU_HW::AddDrawnRectangle(const GSVector4i rect)
   // changes, or it samples a larger region, so we can get away without doing so. This reduces copies considerably in
   // games like Mega Man Legends 2.
   m_vram_dirty_draw_rect = m_vram_dirty_draw_rect.runion(rect);
+  AddDirtyTiles(m_vram_dirty_draw_tiles, rect);
+  m_batch_draw_rect = m_batch_draw_rect.runion(rect);
 }
 
 void GPU_HW::AddUnclampedDrawnRectangle(const GSVector4i rect)
 {
   m_vram_dirty_draw_rect = m_vram_dirty_draw_rect.runion(rect);
-  SetTexPageChangedOnOverlap(m_vram_dirty_draw_rect);
+  AddDirtyTiles(m_vram_dirty_draw_tiles, rect);
+  SetTexPageChangedOnOverlap(m_vram_dirty_draw_rect, m_vram_dirty_draw_tiles);
 }
 
-void GPU_HW::SetTexPageChangedOnOverlap(const GSVector4i update_rect)
+void GPU_HW::SetTexPageChangedOnOverlap(const GSVector4i update_rect, const VRAMDirtyTiles& update_tiles)
 {
   // the vram area can include the texture page, but the game can leave it as-is. in this case, set it as dirty so the
   // shadow texture is updated
-  if (!m_draw_mode.IsTexturePageChanged() && m_batch.texture_mode != BatchTextureMode::Disabled &&
-      (m_draw_mode.mode_reg.GetTexturePageRectangle().rintersects(update_rect) ||
-       (m_draw_mode.mode_reg.IsUsingPalette() &&
-        m_draw_mode.palette_reg.GetRectangle(m_draw_mode.mode_reg.texture_mode).rintersects(update_rect))))
+  if (m_draw_mode.IsTexturePageChanged() || m_batch.texture_mode == BatchTextureMode::Disabled)
+    return;
+
+  const GSVector4i page_rect = m_draw_mode.mode_reg.GetTexturePageRectangle();
+  if (page_rect.rintersects(update_rect) && IntersectsDirtyTiles(update_tiles, page_rect))
   {
     m_draw_mode.SetTexturePageChanged();
+    return;
+  }
+
+  if (m_draw_mode.mode_reg.IsUsingPalette())
+  {
+    const GSVector4i palette_rect = m_draw_mode.palette_reg.GetRectangle(m_draw_mode.mode_reg.texture_mode);
+    if (palette_rect.rintersects(update_rect) && IntersectsDirtyTiles(update_tiles, palette_rect))
+      m_draw_mode.SetTexturePageChanged();
+  }
+}
+
+ALWAYS_INLINE_RELEASE std::tuple<u32, u32, u32> GPU_HW::GetDirtyTileRange(const GSVector4i rect)
+{
+  const u32 x0 = static_cast<u32>(rect.left) >> VRAM_DIRTY_TILE_SHIFT;
+  const u32 x1 = static_cast<u32>(rect.right - 1) >> VRAM_DIRTY_TILE_SHIFT;
+  const u32 y0 = static_cast<u32>(rect.top) >> VRAM_DIRTY_TILE_SHIFT;
+  const u32 y1 = static_cast<u32>(rect.bottom - 1) >> VRAM_DIRTY_TILE_SHIFT;
+  const u32 mask = ((2u << x1) - 1u) & ~((1u << x0) - 1u);
+  return std::make_tuple(mask, y0, y1);
+}
+
+void GPU_HW::AddDirtyTiles(VRAMDirtyTiles& tiles, const GSVector4i rect)
+{
+  const GSVector4i clamped_rect = rect.rintersect(VRAM_SIZE_RECT);
+  if (clamped_rect.rempty())
+    return;
+
+  const auto [mask, y0, y1] = GetDirtyTileRange(clamped_rect);
+  for (u32 y = y0; y <= y1; y++)
+    tiles[y] |= static_cast<u16>(mask);
+}
+
+bool GPU_HW::IntersectsDirtyTiles(const VRAMDirtyTiles& tiles, const GSVector4i rect)
+{
+  const GSVector4i clamped_rect = rect.rintersect(VRAM_SIZE_RECT);
+  if (clamped_rect.rempty())
+    return false;
+
+  const auto [mask, y0, y1] = GetDirtyTileRange(clamped_rect);
+  for (u32 y = y0; y <= y1; y++)
+  {
+    if (tiles[y] & mask)
+      return true;
+  }
+
+  return false;
+}
+
+ALWAYS_INLINE_RELEASE bool GPU_HW::IntersectsDirtyDrawArea(const GSVector4i rect) const
+{
+  return (m_vram_dirty_draw_rect.rintersects(rect) && IntersectsDirtyTiles(m_vram_dirty_draw_tiles, rect));
+}
+
+ALWAYS_INLINE_RELEASE bool GPU_HW::IntersectsDirtyWriteArea(const GSVector4i rect) const
+{
+  return (m_vram_dirty_write_rect.rintersects(rect) && IntersectsDirtyTiles(m_vram_dirty_write_tiles, rect));
+}
+
+void GPU_HW::CheckForSkippableDrawRead(const GSVector4i rect)
+{
+  if (m_skip_draws_unsafe)
+    return;
+
+  // The batch which hasn't been flushed yet could be skipped too.
+  const bool batch_skippable =
+    (m_displayed_vram_rect.rcontains(m_batch_draw_rect) || m_previous_displayed_vram_rect.rcontains(m_batch_draw_rect));
+  if (!(m_skippable_draw_rect.rintersects(rect) && IntersectsDirtyTiles(m_skippable_draw_tiles, rect)) &&
+      !(m_previous_skippable_draw_rect.rintersects(rect) &&
+        IntersectsDirtyTiles(m_previous_skippable_draw_tiles, rect)) &&
+      !(batch_skippable && m_batch_draw_rect.rintersects(rect)))
+  {
+    return;
   }
+
+  // Whatever was skipped before this point is already stale, but everything from here on is drawn.
+  INFO_LOG("Game reads from displayed VRAM area {}, disabling draw skipping.", rect);
+  m_skip_draws_unsafe = true;
+  m_skip_draws = false;
 }
 
 std::tuple<u32, u32> GPU_HW::GetEffectiveDisplayResolution(bool scaled /* = true */)
@@ -1008,13 +1270,10 @@ bool GPU_HW::CompilePipelines(Error* error)
 
   // vertex shaders - [textured/palette/sprite]
   // fragment shaders - [depth_test][render_mode][transparency_mode][texture_mode][check_mask][dithering][interlacing]
-  static constexpr auto destroy_shader = [](std::unique_ptr<GPUShader>& s) { s.reset(); };
-  DimensionalArray<std::unique_ptr<GPUShader>, 2, 2, 2> batch_vertex_shaders{};
-  DimensionalArray<std::unique_ptr<GPUShader>, 2, 2, 2, NUM_TEXTURE_MODES, 5, 5, 2> batch_fragment_shaders{};
-  ScopedGuard batch_shader_guard([&batch_vertex_shaders, &batch_fragment_shaders]() {
-    batch_vertex_shaders.enumerate(destroy_shader);
-    batch_fragment_shaders.enumerate(destroy_shader);
-  });
+  // Shaders are owned by the queue, and released once the pipelines have been created.
+  ShaderCompileQueue batch_shader_queue(shadergen);
+  DimensionalArray<GPUShader*, 2, 2, 2> batch_vertex_shaders{};
+  DimensionalArray<GPUShader*, 2, 2, 2, NUM_TEXTURE_MODES, 5, 5, 2> batch_fragment_shaders{};
 
   for (u8 textured = 0; textured < 2; textured++)
   {
@@ -1023,15 +1282,13 @@ bool GPU_HW::CompilePipelines(Error* error)
       for (u8 sprite = 0; sprite < (textured ? 2 : 1); sprite++)
       {
         const bool uv_limits = ShouldClampUVs(sprite ? m_sprite_texture_filtering : m_texture_filtering);
-        const std::string vs = shadergen.GenerateBatchVertexShader(
-          textured != 0, palette != 0, uv_limits, !sprite && force_round_texcoords, m_pgxp_depth_buffer);
-        if (!(batch_vertex_shaders[textured][palette][sprite] =
-                g_gpu_device->CreateShader(GPUShaderStage::Vertex, shadergen.GetLanguage(), vs, error)))
-        {
-          return false;
-        }
-
-        progress.Increment();
+        const bool round_texcoords = (!sprite && force_round_texcoords);
+        batch_shader_queue.Add(GPUShaderStage::Vertex, &batch_vertex_shaders[textured][palette][sprite],
+                               [textured, palette, uv_limits, round_texcoords,
+                                pgxp_depth = m_pgxp_depth_buffer](GPU_HW_ShaderGen& sg) {
+                                 return sg.GenerateBatchVertexShader(textured != 0, palette != 0, uv_limits,
+                                                                     round_texcoords, pgxp_depth);
+                               });
       }
     }
   }
@@ -1085,21 +1342,20 @@ bool GPU_HW::CompilePipelines(Error* error)
                   texture_mode - (sprite ? static_cast<u8>(BatchTextureMode::SpriteStart) : 0));
                 const bool use_rov =
                   (render_mode == static_cast<u8>(BatchRenderMode::ShaderBlend) && m_use_rov_for_shader_blend);
-                const std::string fs = shadergen.GenerateBatchFragmentShader(
-                  static_cast<BatchRenderMode>(render_mode), static_cast<GPUTransparencyMode>(transparency_mode),
-                  shader_texmode, sprite ? m_sprite_texture_filtering : m_texture_filtering, uv_limits,
-                  !sprite && force_round_texcoords, ConvertToBoolUnchecked(dithering),
-                  ConvertToBoolUnchecked(interlacing), ConvertToBoolUnchecked(check_mask), use_rov, needs_rov_depth,
-                  (depth_test != 0));
-
-                if (!(batch_fragment_shaders[depth_test][render_mode][transparency_mode][texture_mode][check_mask]
-                                            [dithering][interlacing] = g_gpu_device->CreateShader(
-                                              GPUShaderStage::Fragment, shadergen.GetLanguage(), fs, error)))
-                {
-                  return false;
-                }
-
-                progress.Increment();
+                const GPUTextureFilter texture_filtering = sprite ? m_sprite_texture_filtering : m_texture_filtering;
+                const bool round_texcoords = (!sprite && force_round_texcoords);
+                batch_shader_queue.Add(
+                  GPUShaderStage::Fragment,
+                  &batch_fragment_shaders[depth_test][render_mode][transparency_mode][texture_mode][check_mask]
+                                         [dithering][interlacing],
+                  [render_mode, transparency_mode, shader_texmode, texture_filtering, uv_limits, round_texcoords,
+                   dithering, interlacing, check_mask, use_rov, needs_rov_depth, depth_test](GPU_HW_ShaderGen& sg) {
+                    return sg.GenerateBatchFragmentShader(
+                      static_cast<BatchRenderMode>(render_mode), static_cast<GPUTransparencyMode>(transparency_mode),
+                      shader_texmode, texture_filtering, uv_limits, round_texcoords,
+                      ConvertToBoolUnchecked(dithering), ConvertToBoolUnchecked(interlacing),
+                      ConvertToBoolUnchecked(check_mask), use_rov, needs_rov_depth, (depth_test != 0));
+                  });
               }
             }
           }
@@ -1108,6 +1364,9 @@ bool GPU_HW::CompilePipelines(Error* error)
     }
   }
 
+  if (!batch_shader_queue.Compile(progress, error))
+    return false;
+
   static constexpr GPUPipeline::VertexAttribute vertex_attributes[] = {
     GPUPipeline::VertexAttribute::Make(0, GPUPipeline::VertexAttribute::Semantic::Position, 0,
                                        GPUPipeline::VertexAttribute::Type::Float, 4, OFFSETOF(BatchVertex, x)),
@@ -1188,13 +1447,12 @@ bool GPU_HW::CompilePipelines(Error* error)
                     std::span<const GPUPipeline::VertexAttribute>(vertex_attributes, NUM_BATCH_VERTEX_ATTRIBUTES);
 
                 plconfig.vertex_shader =
-                  batch_vertex_shaders[BoolToUInt8(textured)][BoolToUInt8(palette)][BoolToUInt8(sprite)].get();
+                  batch_vertex_shaders[BoolToUInt8(textured)][BoolToUInt8(palette)][BoolToUInt8(sprite)];
                 plconfig.fragment_shader =
                   batch_fragment_shaders[BoolToUInt8(depth_test && needs_rov_depth)][render_mode]
                                         [use_shader_blending ? transparency_mode :
                                                                static_cast<u8>(GPUTransparencyMode::Disabled)]
-                                        [texture_mode][use_shader_blending ? check_mask : 0][dithering][interlacing]
-                                          .get();
+                                        [texture_mode][use_shader_blending ? check_mask : 0][dithering][interlacing];
                 Assert(plconfig.vertex_shader && plconfig.fragment_shader);
 
                 if (needs_real_depth_buffer)
@@ -1308,7 +1566,7 @@ bool GPU_HW::CompilePipelines(Error* error)
                        GPUPipeline::BlendState::GetNoBlendingState();
     plconfig.blend.write_mask = 0x7;
     plconfig.depth = GPUPipeline::DepthState::GetNoTestsState();
-    plconfig.vertex_shader = batch_vertex_shaders[0][0][0].get();
+    plconfig.vertex_shader = batch_vertex_shaders[0][0][0];
     plconfig.geometry_shader = gs.get();
     plconfig.fragment_shader = fs.get();
 
@@ -1324,7 +1582,7 @@ bool GPU_HW::CompilePipelines(Error* error)
     progress.Increment();
   }
 
-  batch_shader_guard.Run();
+  batch_shader_queue.ReleaseShaders();
 
   // use a depth of 1, that way writes will reset the depth
   std::unique_ptr<GPUShader> fullscreen_quad_vertex_shader = g_gpu_device->CreateShader(
@@ -1665,28 +1923,50 @@ void GPU_HW::UpdateVRAMReadTexture(bool drawn, bool written)
 {
   GL_SCOPE("UpdateVRAMReadTexture()");
 
-  const auto update = [this](GSVector4i& rect, u8 dbit) {
-    if (m_texpage_dirty & dbit)
-    {
-      m_texpage_dirty &= ~dbit;
-      if (!m_texpage_dirty)
-        GL_INS_FMT("{} texpage is no longer dirty", (dbit & TEXPAGE_DIRTY_DRAWN_RECT) ? "DRAW" : "WRITE");
-    }
+  // Both areas are copied in the same pass, overlapping tiles are only copied once.
+  GSVector4i bounds = INVALID_RECT;
+  VRAMDirtyTiles tiles = {};
+  u8 dbits = 0;
+  if (drawn)
+  {
+    DebugAssert(!m_vram_dirty_draw_rect.eq(INVALID_RECT));
+    GL_INS_FMT("Updating draw rect {}", m_vram_dirty_draw_rect);
+    bounds = bounds.runion(m_vram_dirty_draw_rect);
+    for (u32 i = 0; i < VRAM_DIRTY_TILES_Y; i++)
+      tiles[i] |= m_vram_dirty_draw_tiles[i];
+    m_vram_dirty_draw_rect = INVALID_RECT;
+    m_vram_dirty_draw_tiles = {};
+    dbits |= TEXPAGE_DIRTY_DRAWN_RECT;
+  }
+  if (written)
+  {
+    GL_INS_FMT("Updating write rect {}", m_vram_dirty_write_rect);
+    bounds = bounds.runion(m_vram_dirty_write_rect);
+    for (u32 i = 0; i < VRAM_DIRTY_TILES_Y; i++)
+      tiles[i] |= m_vram_dirty_write_tiles[i];
+    m_vram_dirty_write_rect = INVALID_RECT;
+    m_vram_dirty_write_tiles = {};
+    dbits |= TEXPAGE_DIRTY_WRITTEN_RECT;
+  }
+
+  if (m_texpage_dirty & dbits)
+  {
+    m_texpage_dirty &= ~dbits;
+    if (!m_texpage_dirty)
+      GL_INS("Texpage is no longer dirty");
+  }
 
+  bounds = bounds.rintersect(VRAM_SIZE_RECT);
+  if (bounds.rempty())
+    return;
+
+  const auto copy_rect = [this](const GSVector4i rect) {
     const GSVector4i scaled_rect = rect.mul32l(GSVector4i(m_resolution_scale));
     if (m_vram_texture->IsMultisampled())
     {
-      if (g_gpu_device->GetFeatures().partial_msaa_resolve)
-      {
-        g_gpu_device->ResolveTextureRegion(m_vram_read_texture.get(), scaled_rect.left, scaled_rect.top, 0, 0,
-                                           m_vram_texture.get(), scaled_rect.left, scaled_rect.top, scaled_rect.width(),
-                                           scaled_rect.height());
-      }
-      else
-      {
-        g_gpu_device->ResolveTextureRegion(m_vram_read_texture.get(), 0, 0, 0, 0, m_vram_texture.get(), 0, 0,
-                                           m_vram_texture->GetWidth(), m_vram_texture->GetHeight());
-      }
+      g_gpu_device->ResolveTextureRegion(m_vram_read_texture.get(), scaled_rect.left, scaled_rect.top, 0, 0,
+                                         m_vram_texture.get(), scaled_rect.left, scaled_rect.top, scaled_rect.width(),
+                                         scaled_rect.height());
     }
     else
     {
@@ -1696,31 +1976,70 @@ void GPU_HW::UpdateVRAMReadTexture(bool drawn, bool written)
     }
 
     // m_counters.num_read_texture_updates++;
-    rect = INVALID_RECT;
   };
 
-  if (drawn)
+  if (m_vram_texture->IsMultisampled() && !g_gpu_device->GetFeatures().partial_msaa_resolve)
   {
-    DebugAssert(!m_vram_dirty_draw_rect.eq(INVALID_RECT));
-    GL_INS_FMT("Updating draw rect {}", m_vram_dirty_draw_rect);
+    g_gpu_device->ResolveTextureRegion(m_vram_read_texture.get(), 0, 0, 0, 0, m_vram_texture.get(), 0, 0,
+                                       m_vram_texture->GetWidth(), m_vram_texture->GetHeight());
+    return;
+  }
+
+  // If most of the bounding box is dirty anyway, a single copy is cheaper than several smaller ones.
+  const auto [bounds_mask, bounds_y0, bounds_y1] = GetDirtyTileRange(bounds);
+  u32 dirty_tile_count = 0;
+  for (u32 y = bounds_y0; y <= bounds_y1; y++)
+    dirty_tile_count += static_cast<u32>(std::popcount(static_cast<u32>(tiles[y]) & bounds_mask));
+  const u32 bounds_tile_count = static_cast<u32>(std::popcount(bounds_mask)) * (bounds_y1 - bounds_y0 + 1);
+  if ((dirty_tile_count * 4) >= (bounds_tile_count * 3))
+  {
+    copy_rect(bounds);
+    return;
+  }
 
-    u8 dbits = TEXPAGE_DIRTY_DRAWN_RECT;
-    if (written && m_vram_dirty_draw_rect.rintersects(m_vram_dirty_write_rect))
+  // Copy each horizontal run of dirty tiles, merging runs with the same extents in consecutive rows.
+  std::array<GSVector4i, VRAM_DIRTY_TILES_X> pending_rects;
+  u32 num_pending_rects = 0;
+  for (u32 y = bounds_y0; y <= bounds_y1 + 1; y++)
+  {
+    std::array<GSVector4i, VRAM_DIRTY_TILES_X> row_rects;
+    u32 num_row_rects = 0;
+    u32 row_mask = (y <= bounds_y1) ? (static_cast<u32>(tiles[y]) & bounds_mask) : 0;
+    while (row_mask != 0)
     {
-      DebugAssert(!m_vram_dirty_write_rect.eq(INVALID_RECT));
-      GL_INS_FMT("Including write rect {}", m_vram_dirty_write_rect);
-      m_vram_dirty_draw_rect = m_vram_dirty_draw_rect.runion(m_vram_dirty_write_rect);
-      m_vram_dirty_write_rect = INVALID_RECT;
-      dbits = TEXPAGE_DIRTY_DRAWN_RECT | TEXPAGE_DIRTY_WRITTEN_RECT;
-      written = false;
+      const u32 start = static_cast<u32>(std::countr_zero(row_mask));
+      const u32 count = static_cast<u32>(std::countr_one(row_mask >> start));
+      row_mask &= ~(((1u << count) - 1u) << start);
+
+      const GSVector4i run_rect =
+        GSVector4i(static_cast<s32>(start << VRAM_DIRTY_TILE_SHIFT), static_cast<s32>(y << VRAM_DIRTY_TILE_SHIFT),
+                   static_cast<s32>((start + count) << VRAM_DIRTY_TILE_SHIFT),
+                   static_cast<s32>((y + 1) << VRAM_DIRTY_TILE_SHIFT));
+
+      // Extend a matching run from the previous row, otherwise start a new one.
+      GSVector4i rect = run_rect;
+      for (u32 i = 0; i < num_pending_rects; i++)
+      {
+        if (pending_rects[i].left == run_rect.left && pending_rects[i].right == run_rect.right)
+        {
+          rect = pending_rects[i].runion(run_rect);
+          pending_rects[i] = INVALID_RECT;
+          break;
+        }
+      }
+
+      row_rects[num_row_rects++] = rect;
     }
 
-    update(m_vram_dirty_draw_rect, dbits);
-  }
-  if (written)
-  {
-    GL_INS_FMT("Updating write rect {}", m_vram_dirty_write_rect);
-    update(m_vram_dirty_write_rect, TEXPAGE_DIRTY_WRITTEN_RECT);
+    // Anything which wasn't extended is finished.
+    for (u32 i = 0; i < num_pending_rects; i++)
+    {
+      if (!pending_rects[i].eq(INVALID_RECT))
+        copy_rect(pending_rects[i].rintersect(bounds));
+    }
+
+    pending_rects = row_rects;
+    num_pending_rects = num_row_rects;
   }
 }
 
@@ -2359,8 +2678,8 @@ void GPU_HW::LoadVertices()
       {
         const u32 vert_color = (shaded && i > 0) ? (FifoPop() & UINT32_C(0x00FFFFFF)) : first_color;
         const u32 color = raw_texture ? UINT32_C(0x00808080) : vert_color;
-        const u64 maddr_and_pos = m_fifo.Pop();
-        const GPUVertexPosition vp{Truncate32(maddr_and_pos)};
+        u32 maddr;
+        const GPUVertexPosition vp{FifoPopWithAddress(&maddr)};
         const u16 texcoord = textured ? Truncate16(FifoPop()) : 0;
         const s32 native_x = native_vertex_positions[i].x = m_drawing_offset.x + vp.x;
         const s32 native_y = native_vertex_positions[i].y = m_drawing_offset.y + vp.y;
@@ -2370,9 +2689,8 @@ void GPU_HW::LoadVertices()
 
         if (pgxp)
         {
-          valid_w &= CPU::PGXP::GetPreciseVertex(Truncate32(maddr_and_pos >> 32), vp.bits, native_x, native_y,
-                                                 m_drawing_offset.x, m_drawing_offset.y, &vertices[i].x, &vertices[i].y,
-                                                 &vertices[i].w);
+          valid_w &= CPU::PGXP::GetPreciseVertex(maddr, vp.bits, native_x, native_y, m_drawing_offset.x,
+                                                 m_drawing_offset.y, &vertices[i].x, &vertices[i].y, &vertices[i].w);
         }
       }
       if (pgxp)
@@ -2855,7 +3173,7 @@ ALWAYS_INLINE_RELEASE void GPU_HW::CheckForTexPageOverlap(GSVector4i uv_rect)
     if (m_texpage_dirty & TEXPAGE_DIRTY_DRAWN_RECT)
     {
       DebugAssert(!m_vram_dirty_draw_rect.eq(INVALID_RECT));
-      update_drawn = m_current_uv_rect.rintersects(m_vram_dirty_draw_rect);
+      update_drawn = IntersectsDirtyDrawArea(m_current_uv_rect);
       if (update_drawn)
       {
         GL_INS_FMT("Updating VRAM cache due to UV {} intersection with dirty DRAW {}", m_current_uv_rect,
@@ -2865,7 +3183,7 @@ ALWAYS_INLINE_RELEASE void GPU_HW::CheckForTexPageOverlap(GSVector4i uv_rect)
     if (m_texpage_dirty & TEXPAGE_DIRTY_WRITTEN_RECT)
     {
       DebugAssert(!m_vram_dirty_write_rect.eq(INVALID_RECT));
-      update_written = m_current_uv_rect.rintersects(m_vram_dirty_write_rect);
+      update_written = IntersectsDirtyWriteArea(m_current_uv_rect);
       if (update_written)
       {
         GL_INS_FMT("Updating VRAM cache due to UV {} intersection with dirty WRITE {}", m_current_uv_rect,
@@ -3096,6 +3414,12 @@ void GPU_HW::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
   RestoreDeviceContext();
 }
 
+void GPU_HW::OnCPUReadVRAM(u32 x, u32 y, u32 width, u32 height)
+{
+  // Internal readbacks (save states, renderer switches) don't count, only what the game sees.
+  CheckForSkippableDrawRead(GetVRAMTransferBounds(x, y, width, height));
+}
+
 void GPU_HW::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
   GL_PUSH_FMT("ReadVRAM({},{} => {},{} ({}x{})", x, y, x + width, y + height, width, height);
@@ -3284,8 +3608,10 @@ void GPU_HW::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32
      ((dst_y % VRAM_HEIGHT) + height) > VRAM_HEIGHT);
   const GSVector4i src_bounds = GetVRAMTransferBounds(src_x, src_y, width, height);
   const GSVector4i dst_bounds = GetVRAMTransferBounds(dst_x, dst_y, width, height);
-  const bool intersect_with_draw = m_vram_dirty_draw_rect.rintersects(src_bounds);
-  const bool intersect_with_write = m_vram_dirty_write_rect.rintersects(src_bounds);
+  CheckForSkippableDrawRead(src_bounds);
+
+  const bool intersect_with_draw = IntersectsDirtyDrawArea(src_bounds);
+  const bool intersect_with_write = IntersectsDirtyWriteArea(src_bounds);
 
   if (use_shader || IsUsingMultisampling())
   {
@@ -3400,8 +3726,10 @@ void GPU_HW::DispatchRenderCommand()
       if (m_draw_mode.mode_reg.IsUsingPalette())
       {
         const GSVector4i palette_rect = m_draw_mode.palette_reg.GetRectangle(m_draw_mode.mode_reg.texture_mode);
-        const bool update_drawn = palette_rect.rintersects(m_vram_dirty_draw_rect);
-        const bool update_written = palette_rect.rintersects(m_vram_dirty_write_rect);
+        CheckForSkippableDrawRead(palette_rect);
+
+        const bool update_drawn = IntersectsDirtyDrawArea(palette_rect);
+        const bool update_written = IntersectsDirtyWriteArea(palette_rect);
         if (update_drawn || update_written)
         {
           GL_INS("Palette in VRAM dirty area, flushing cache");
@@ -3414,9 +3742,10 @@ void GPU_HW::DispatchRenderCommand()
 
       const GSVector4i page_rect = m_draw_mode.mode_reg.GetTexturePageRectangle();
       GSVector4i::storel(m_current_texture_page_offset, page_rect);
+      CheckForSkippableDrawRead(page_rect);
 
-      u8 new_texpage_dirty = m_vram_dirty_draw_rect.rintersects(page_rect) ? TEXPAGE_DIRTY_DRAWN_RECT : 0;
-      new_texpage_dirty |= m_vram_dirty_write_rect.rintersects(page_rect) ? TEXPAGE_DIRTY_WRITTEN_RECT : 0;
+      u8 new_texpage_dirty = IntersectsDirtyDrawArea(page_rect) ? TEXPAGE_DIRTY_DRAWN_RECT : 0;
+      new_texpage_dirty |= IntersectsDirtyWriteArea(page_rect) ? TEXPAGE_DIRTY_WRITTEN_RECT : 0;
 
       if (new_texpage_dirty != 0)
       {
@@ -3554,9 +3883,25 @@ void GPU_HW::FlushRender()
   DebugAssert((m_batch_vertex_ptr != nullptr) == (m_batch_index_ptr != nullptr));
   if (m_batch_vertex_ptr)
     UnmapGPUBuffer(m_batch_vertex_count, index_count);
+
+  const GSVector4i batch_rect = std::exchange(m_batch_draw_rect, INVALID_RECT);
   if (index_count == 0)
     return;
 
+  // Draws outside the displayed areas may be render targets which later frames sample from, so they always execute.
+  // The rest are tracked in drawn frames too, so a game which reads them back stops skipping as early as possible.
+  if (g_settings.fast_forward_frame_skip > 0 &&
+      (m_displayed_vram_rect.rcontains(batch_rect) || m_previous_displayed_vram_rect.rcontains(batch_rect)))
+  {
+    m_skippable_draw_rect = m_skippable_draw_rect.runion(batch_rect);
+    AddDirtyTiles(m_skippable_draw_tiles, batch_rect);
+    if (m_skip_draws)
+    {
+      GL_INS_FMT("Skipping draw to {}", batch_rect);
+      return;
+    }
+  }
+
 #ifdef _DEBUG
   GL_SCOPE_FMT("Hardware Draw {}", ++s_draw_number);
 #endif
@@ -3597,11 +3942,42 @@ void GPU_HW::FlushRender()
   }
 }
 
+void GPU_HW::SetDrawsSkipped(bool skipped)
+{
+  skipped &= !m_skip_draws_unsafe;
+  if (m_skip_draws == skipped)
+    return;
+
+  // Anything batched belongs to the previous frame, so draw or discard it with the old setting.
+  FlushRender();
+  m_skip_draws = skipped;
+}
+
 void GPU_HW::UpdateDisplay()
 {
   FlushRender();
   DeactivateROV();
 
+  // Double buffered games draw the next frame into the previously displayed area, so remember it for draw skipping.
+  const GSVector4i display_rect =
+    GSVector4i(static_cast<s32>(m_crtc_state.display_vram_left), static_cast<s32>(m_crtc_state.display_vram_top),
+               static_cast<s32>(m_crtc_state.display_vram_left + m_crtc_state.display_vram_width),
+               static_cast<s32>(m_crtc_state.display_vram_top + m_crtc_state.display_vram_height))
+      .rintersect(VRAM_SIZE_RECT);
+  if (!display_rect.eq(m_displayed_vram_rect))
+  {
+    m_previous_displayed_vram_rect = m_displayed_vram_rect;
+    m_displayed_vram_rect = display_rect;
+  }
+
+  // Areas skipped last frame are only redrawn in the next drawn frame, so keep checking reads against them.
+  m_previous_skippable_draw_rect = std::exchange(m_skippable_draw_rect, INVALID_RECT);
+  m_previous_skippable_draw_tiles = std::exchange(m_skippable_draw_tiles, {});
+
+  // Nothing was drawn this frame, so keep showing the last one. It won't be presented anyway.
+  if (m_skip_draws)
+    return;
+
   GL_SCOPE("UpdateDisplay()");
 
   if (g_settings.debugging.show_vram)
@@ -11,6 +11,7 @@
 #include "common/dimensional_array.h"
 #include "common/gsvector.h"
 
+#include <array>
 #include <limits>
 #include <tuple>
 #include <utility>
@@ -66,6 +67,7 @@ public:
 
   void UpdateSettings(const Settings& old_settings) override;
   void UpdateResolutionScale() override final;
+  void SetDrawsSkipped(bool skipped) override;
   std::tuple<u32, u32> GetEffectiveDisplayResolution(bool scaled = true) override;
   std::tuple<u32, u32> GetFullDisplayResolution(bool scaled = true) override;
 
@@ -141,6 +143,15 @@ private:
     GSVector4i::cxpr(std::numeric_limits<s32>::max(), std::numeric_limits<s32>::max(), std::numeric_limits<s32>::min(),
                      std::numeric_limits<s32>::min());
 
+  // Dirty areas are also tracked in 64x64 tiles, one bit per tile, so that small areas far apart don't cause the
+  // whole bounding box to be treated as dirty.
+  static constexpr u32 VRAM_DIRTY_TILE_SHIFT = 6;
+  static constexpr u32 VRAM_DIRTY_TILE_SIZE = 1u << VRAM_DIRTY_TILE_SHIFT;
+  static constexpr u32 VRAM_DIRTY_TILES_X = VRAM_WIDTH >> VRAM_DIRTY_TILE_SHIFT;
+  static constexpr u32 VRAM_DIRTY_TILES_Y = VRAM_HEIGHT >> VRAM_DIRTY_TILE_SHIFT;
+  using VRAMDirtyTiles = std::array<u16, VRAM_DIRTY_TILES_Y>;
+  static_assert(VRAM_DIRTY_TILES_X <= 16, "Tile row fits in a u16");
+
   /// Returns true if a depth buffer should be created.
   GPUTexture::Format GetDepthBufferFormat() const;
 
@@ -179,7 +190,15 @@ private:
   void AddWrittenRectangle(const GSVector4i rect);
   void AddDrawnRectangle(const GSVector4i rect);
   void AddUnclampedDrawnRectangle(const GSVector4i rect);
-  void SetTexPageChangedOnOverlap(const GSVector4i update_rect);
+  void SetTexPageChangedOnOverlap(const GSVector4i update_rect, const VRAMDirtyTiles& update_tiles);
+
+  /// Returns the tile column mask, and the first/last tile row covered by an exclusive rectangle.
+  static std::tuple<u32, u32, u32> GetDirtyTileRange(const GSVector4i rect);
+  static void AddDirtyTiles(VRAMDirtyTiles& tiles, const GSVector4i rect);
+  static bool IntersectsDirtyTiles(const VRAMDirtyTiles& tiles, const GSVector4i rect);
+  bool IntersectsDirtyDrawArea(const GSVector4i rect) const;
+  bool IntersectsDirtyWriteArea(const GSVector4i rect) const;
+  void CheckForSkippableDrawRead(const GSVector4i rect);
 
   void CheckForTexPageOverlap(GSVector4i uv_rect);
 
@@ -203,6 +222,7 @@ private:
 
   void FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color) override;
   void ReadVRAM(u32 x, u32 y, u32 width, u32 height) override;
+  void OnCPUReadVRAM(u32 x, u32 y, u32 width, u32 height) override;
   void UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask, bool check_mask) override;
   void CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height) override;
   void DispatchRenderCommand() override;
@@ -285,6 +305,8 @@ private:
   bool m_depth_was_copied : 1 = false;
   bool m_texture_window_active : 1 = false;
   bool m_rov_active : 1 = false;
+  bool m_skip_draws : 1 = false;
+  bool m_skip_draws_unsafe : 1 = false;
 
   u8 m_texpage_dirty = 0;
 
@@ -297,7 +319,22 @@ private:
   // Bounding box of VRAM area that the GPU has drawn into.
   GSVector4i m_vram_dirty_draw_rect = INVALID_RECT;
   GSVector4i m_vram_dirty_write_rect = INVALID_RECT;
+  VRAMDirtyTiles m_vram_dirty_draw_tiles = {};
+  VRAMDirtyTiles m_vram_dirty_write_tiles = {};
   GSVector4i m_current_uv_rect = INVALID_RECT;
+
+  // Bounding box of the primitives in the current batch, and the last two VRAM areas scanned out. With draws skipped,
+  // a batch is only discarded when it lies entirely within one of the displayed areas.
+  GSVector4i m_batch_draw_rect = INVALID_RECT;
+  GSVector4i m_displayed_vram_rect = INVALID_RECT;
+  GSVector4i m_previous_displayed_vram_rect = INVALID_RECT;
+
+  // Batches which were, or could have been, skipped this frame and last frame. The contents of these areas are stale
+  // in a skipped frame, so reading them back, copying from them or sampling them stops skipping until the next reset.
+  GSVector4i m_skippable_draw_rect = INVALID_RECT;
+  GSVector4i m_previous_skippable_draw_rect = INVALID_RECT;
+  VRAMDirtyTiles m_skippable_draw_tiles = {};
+  VRAMDirtyTiles m_previous_skippable_draw_tiles = {};
   s32 m_current_texture_page_offset[2] = {};
 
   std::unique_ptr<GPUPipeline> m_wireframe_pipeline;
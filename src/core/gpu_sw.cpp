@@ -524,8 +524,7 @@ void GPU_SW::DispatchRenderCommand()
       {
         GPUBackendDrawPolygonCommand::Vertex* vert = &cmd->vertices[i];
         vert->color = (shaded && i > 0) ? (FifoPop() & UINT32_C(0x00FFFFFF)) : first_color;
-        const u64 maddr_and_pos = m_fifo.Pop();
-        const GPUVertexPosition vp{Truncate32(maddr_and_pos)};
+        const GPUVertexPosition vp{FifoPop()};
         vert->x = m_drawing_offset.x + vp.x;
         vert->y = m_drawing_offset.y + vp.y;
         vert->texcoord = textured ? Truncate16(FifoPop()) : 0;
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: CC-BY-NC-ND-4.0
 
 #include "gte.h"
+#include "gte_simd.h"
 
 #include "cpu_core.h"
 #include "cpu_core_private.h"
@@ -81,13 +82,6 @@ ALWAYS_INLINE static void CheckMACOverflow(s64 value)
   }
 }
 
-template<u32 index>
-ALWAYS_INLINE static s64 SignExtendMACResult(s64 value)
-{
-  CheckMACOverflow<index>(value);
-  return SignExtendN < index == 0 ? 31 : 44 > (value);
-}
-
 template<u32 index>
 ALWAYS_INLINE static void TruncateAndSetMAC(s64 value, u8 shift)
 {
@@ -174,16 +168,7 @@ static void PushSZ(s32 value);
 static void PushRGBFromMAC();
 static u32 UNRDivide(u32 lhs, u32 rhs);
 
-static void MulMatVec(const s16* M_, const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm);
-static void MulMatVec(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm);
-static void MulMatVecBuggy(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm);
-
-static void InterpolateColor(s64 in_MAC1, s64 in_MAC2, s64 in_MAC3, u8 shift, bool lm);
-static void RTPS(const s16 V[3], u8 shift, bool lm, bool last);
-static void NCS(const s16 V[3], u8 shift, bool lm);
-static void NCCS(const s16 V[3], u8 shift, bool lm);
-static void NCDS(const s16 V[3], u8 shift, bool lm);
-static void DPCS(const u8 color[3], u8 shift, bool lm);
+static void RTPS(const SIMD::MACVector& sum, u8 shift, bool lm, bool last);
 
 static void Execute_MVMVA(Instruction inst);
 static void Execute_SQR(Instruction inst);
@@ -525,103 +510,13 @@ ALWAYS_INLINE u32 GTE::UNRDivide(u32 lhs, u32 rhs)
   return std::min<u32>(0x1FFFF, result);
 }
 
-void GTE::MulMatVec(const s16* M_, const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
-{
-#define M(i, j) M_[((i) * 3) + (j)]
-#define dot3(i)                                                                                                        \
-  TruncateAndSetMACAndIR<i + 1>(SignExtendMACResult<i + 1>((s64(M(i, 0)) * s64(Vx)) + (s64(M(i, 1)) * s64(Vy))) +      \
-                                  (s64(M(i, 2)) * s64(Vz)),                                                            \
-                                shift, lm)
-
-  dot3(0);
-  dot3(1);
-  dot3(2);
-
-#undef dot3
-#undef M
-}
-
-void GTE::MulMatVec(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
-{
-#define M(i, j) M_[((i) * 3) + (j)]
-#define dot3(i)                                                                                                        \
-  TruncateAndSetMACAndIR<i + 1>(                                                                                       \
-    SignExtendMACResult<i + 1>(SignExtendMACResult<i + 1>((s64(T[i]) << 12) + (s64(M(i, 0)) * s64(Vx))) +              \
-                               (s64(M(i, 1)) * s64(Vy))) +                                                             \
-      (s64(M(i, 2)) * s64(Vz)),                                                                                        \
-    shift, lm)
-
-  dot3(0);
-  dot3(1);
-  dot3(2);
-
-#undef dot3
-#undef M
-}
-
-void GTE::MulMatVecBuggy(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
-{
-#define M(i, j) M_[((i) * 3) + (j)]
-#define dot3(i)                                                                                                        \
-  do                                                                                                                   \
-  {                                                                                                                    \
-    TruncateAndSetIR<i + 1>(static_cast<s32>(SignExtendMACResult<i + 1>(SignExtendMACResult<i + 1>(                    \
-                                               (s64(T[i]) << 12) + (s64(M(i, 0)) * s64(Vx)))) >>                       \
-                                             shift),                                                                   \
-                            false);                                                                                    \
-    TruncateAndSetMACAndIR<i + 1>(SignExtendMACResult<i + 1>((s64(M(i, 1)) * s64(Vy))) + (s64(M(i, 2)) * s64(Vz)),     \
-                                  shift, lm);                                                                          \
-  } while (0)
-
-  dot3(0);
-  dot3(1);
-  dot3(2);
-
-#undef dot3
-#undef M
-}
-
 void GTE::Execute_MVMVA(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  static constexpr const s16* M_lookup[4] = {&REGS.RT[0][0], &REGS.LLM[0][0], &REGS.LCM[0][0], nullptr};
-  static constexpr const s16* V_lookup[4][3] = {
-    {&REGS.V0[0], &REGS.V0[1], &REGS.V0[2]},
-    {&REGS.V1[0], &REGS.V1[1], &REGS.V1[2]},
-    {&REGS.V2[0], &REGS.V2[1], &REGS.V2[2]},
-    {&REGS.IR1, &REGS.IR2, &REGS.IR3},
-  };
-  static constexpr const s32 zero_T[3] = {};
-  static constexpr const s32* T_lookup[4] = {REGS.TR, REGS.BK, REGS.FC, zero_T};
-
-  const s16* M = M_lookup[inst.mvmva_multiply_matrix];
-  const s16* const* const V = V_lookup[inst.mvmva_multiply_vector];
-  const s32* const T = T_lookup[inst.mvmva_translation_vector];
-  s16 buggy_M[3][3];
-
-  if (!M)
-  {
-    // buggy
-    buggy_M[0][0] = -static_cast<s16>(ZeroExtend16(REGS.RGBC[0]) << 4);
-    buggy_M[0][1] = static_cast<s16>(ZeroExtend16(REGS.RGBC[0]) << 4);
-    buggy_M[0][2] = REGS.IR0;
-    buggy_M[1][0] = REGS.RT[0][2];
-    buggy_M[1][1] = REGS.RT[0][2];
-    buggy_M[1][2] = REGS.RT[0][2];
-    buggy_M[2][0] = REGS.RT[1][1];
-    buggy_M[2][1] = REGS.RT[1][1];
-    buggy_M[2][2] = REGS.RT[1][1];
-    M = &buggy_M[0][0];
-  }
-
-  const s16 Vx = *V[0];
-  const s16 Vy = *V[1];
-  const s16 Vz = *V[2];
-  if (inst.mvmva_translation_vector != 2)
-    MulMatVec(M, T, Vx, Vy, Vz, inst.GetShift(), inst.lm);
-  else
-    MulMatVecBuggy(M, T, Vx, Vy, Vz, inst.GetShift(), inst.lm);
+  u32 flags = 0;
+  SIMD::MVMVA(REGS, inst, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -667,31 +562,14 @@ void GTE::Execute_OP(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
-void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
+void GTE::RTPS(const SIMD::MACVector& sum, u8 shift, bool lm, bool last)
 {
-#define dot3(i)                                                                                                        \
-  SignExtendMACResult<i + 1>(SignExtendMACResult<i + 1>((s64(REGS.TR[i]) << 12) + (s64(REGS.RT[i][0]) * s64(V[0]))) +  \
-                             (s64(REGS.RT[i][1]) * s64(V[1]))) +                                                       \
-    (s64(REGS.RT[i][2]) * s64(V[2]))
-
-  // IR1 = MAC1 = (TRX*1000h + RT11*VX0 + RT12*VY0 + RT13*VZ0) SAR (sf*12)
-  // IR2 = MAC2 = (TRY*1000h + RT21*VX0 + RT22*VY0 + RT23*VZ0) SAR (sf*12)
-  // IR3 = MAC3 = (TRZ*1000h + RT31*VX0 + RT32*VY0 + RT33*VZ0) SAR (sf*12)
-  const s64 x = dot3(0);
-  const s64 y = dot3(1);
-  const s64 z = dot3(2);
-  TruncateAndSetMAC<1>(x, shift);
-  TruncateAndSetMAC<2>(y, shift);
-  TruncateAndSetMAC<3>(z, shift);
-  TruncateAndSetIR<1>(REGS.MAC1, lm);
-  TruncateAndSetIR<2>(REGS.MAC2, lm);
+  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (TR*1000h + RT*V) SAR (sf*12)
+  u32 flags = 0;
+  SIMD::RTPSTransform(REGS, sum, shift, lm, flags);
+  REGS.FLAG.bits |= flags;
 
-  // The command does saturate IR1,IR2,IR3 to -8000h..+7FFFh (regardless of lm bit). When using RTP with sf=0, then the
-  // IR3 saturation flag (FLAG.22) gets set <only> if "MAC3 SAR 12" exceeds -8000h..+7FFFh (although IR3 is saturated
-  // when "MAC3" exceeds -8000h..+7FFFh).
-  TruncateAndSetIR<3>(s32(z >> 12), false);
-  REGS.dr32[11] = std::clamp(REGS.MAC3, lm ? 0 : IR123_MIN_VALUE, IR123_MAX_VALUE);
-#undef dot3
+  const s64 z = static_cast<s64>(sum.z.extract64<0>());
 
   // SZ3 = MAC3 SAR ((1-sf)*12)                           ;ScreenZ FIFO 0..+FFFFh
   PushSZ(s32(z >> 12));
@@ -742,6 +620,8 @@ void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
     if (g_settings.gpu_pgxp_preserve_proj_fp)
     {
       precise_sz3 = float(z) / 4096.0f;
+      const s64 x = static_cast<s64>(sum.xy.extract64<0>());
+      const s64 y = static_cast<s64>(sum.xy.extract64<1>());
       precise_ir1 = float(x) / (static_cast<float>(1 << shift));
       precise_ir2 = float(y) / (static_cast<float>(1 << shift));
       if (lm)
@@ -816,7 +696,12 @@ void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
 void GTE::Execute_RTPS(Instruction inst)
 {
   REGS.FLAG.Clear();
-  RTPS(REGS.V0, inst.GetShift(), inst.lm, true);
+
+  u32 flags = 0;
+  const SIMD::MACVector sum = SIMD::MulMatVec(&REGS.RT[0][0], REGS.TR, REGS.V0[0], REGS.V0[1], REGS.V0[2], flags);
+  REGS.FLAG.bits |= flags;
+  RTPS(sum, inst.GetShift(), inst.lm, true);
+
   REGS.FLAG.UpdateError();
 }
 
@@ -827,9 +712,16 @@ void GTE::Execute_RTPT(Instruction inst)
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
-  RTPS(REGS.V0, shift, lm, false);
-  RTPS(REGS.V1, shift, lm, false);
-  RTPS(REGS.V2, shift, lm, true);
+  // The transforms only depend on V0-V2 and the rotation/translation, so they can all be computed up-front.
+  u32 flags = 0;
+  const SIMD::MACVector sum0 = SIMD::MulMatVec(&REGS.RT[0][0], REGS.TR, REGS.V0[0], REGS.V0[1], REGS.V0[2], flags);
+  const SIMD::MACVector sum1 = SIMD::MulMatVec(&REGS.RT[0][0], REGS.TR, REGS.V1[0], REGS.V1[1], REGS.V1[2], flags);
+  const SIMD::MACVector sum2 = SIMD::MulMatVec(&REGS.RT[0][0], REGS.TR, REGS.V2[0], REGS.V2[1], REGS.V2[2], flags);
+  REGS.FLAG.bits |= flags;
+
+  RTPS(sum0, shift, lm, false);
+  RTPS(sum1, shift, lm, false);
+  RTPS(sum2, shift, lm, true);
 
   REGS.FLAG.UpdateError();
 }
@@ -882,38 +774,13 @@ void GTE::Execute_AVSZ4(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
-ALWAYS_INLINE void GTE::InterpolateColor(s64 in_MAC1, s64 in_MAC2, s64 in_MAC3, u8 shift, bool lm)
-{
-  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
-  //   [IR1,IR2,IR3] = (([RFC,GFC,BFC] SHL 12) - [MAC1,MAC2,MAC3]) SAR (sf*12)
-  TruncateAndSetMACAndIR<1>((s64(REGS.FC[0]) << 12) - in_MAC1, shift, false);
-  TruncateAndSetMACAndIR<2>((s64(REGS.FC[1]) << 12) - in_MAC2, shift, false);
-  TruncateAndSetMACAndIR<3>((s64(REGS.FC[2]) << 12) - in_MAC3, shift, false);
-
-  //   [MAC1,MAC2,MAC3] = (([IR1,IR2,IR3] * IR0) + [MAC1,MAC2,MAC3])
-  // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)
-  TruncateAndSetMACAndIR<1>(s64(s32(REGS.IR1) * s32(REGS.IR0)) + in_MAC1, shift, lm);
-  TruncateAndSetMACAndIR<2>(s64(s32(REGS.IR2) * s32(REGS.IR0)) + in_MAC2, shift, lm);
-  TruncateAndSetMACAndIR<3>(s64(s32(REGS.IR3) * s32(REGS.IR0)) + in_MAC3, shift, lm);
-}
-
-void GTE::NCS(const s16 V[3], u8 shift, bool lm)
-{
-  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V0) SAR (sf*12)
-  MulMatVec(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
-
-  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
-
-  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
-}
-
 void GTE::Execute_NCS(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  NCS(REGS.V0, inst.GetShift(), inst.lm);
+  u32 flags = 0;
+  SIMD::NCS<1>(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -922,39 +789,20 @@ void GTE::Execute_NCT(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  NCS(REGS.V0, shift, lm);
-  NCS(REGS.V1, shift, lm);
-  NCS(REGS.V2, shift, lm);
+  u32 flags = 0;
+  SIMD::NCS<3>(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
 
-void GTE::NCCS(const s16 V[3], u8 shift, bool lm)
-{
-  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V0) SAR (sf*12)
-  MulMatVec(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
-
-  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
-
-  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4          ;<--- for NCDx/NCCx
-  // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)       ;<--- for NCDx/NCCx
-  TruncateAndSetMACAndIR<1>(s64(s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4, shift, lm);
-  TruncateAndSetMACAndIR<2>(s64(s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4, shift, lm);
-  TruncateAndSetMACAndIR<3>(s64(s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4, shift, lm);
-
-  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
-}
-
 void GTE::Execute_NCCS(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  NCCS(REGS.V0, inst.GetShift(), inst.lm);
+  u32 flags = 0;
+  SIMD::NCCS<1>(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -963,42 +811,20 @@ void GTE::Execute_NCCT(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  NCCS(REGS.V0, shift, lm);
-  NCCS(REGS.V1, shift, lm);
-  NCCS(REGS.V2, shift, lm);
+  u32 flags = 0;
+  SIMD::NCCS<3>(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
 
-void GTE::NCDS(const s16 V[3], u8 shift, bool lm)
-{
-  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V0) SAR (sf*12)
-  MulMatVec(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
-
-  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
-
-  // No need to assign these to MAC[1-3], as it'll never overflow.
-  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4          ;<--- for NCDx/NCCx
-  const s32 in_MAC1 = (s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4;
-  const s32 in_MAC2 = (s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4;
-  const s32 in_MAC3 = (s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4;
-
-  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0                   ;<--- for NCDx only
-  InterpolateColor(in_MAC1, in_MAC2, in_MAC3, shift, lm);
-
-  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
-}
-
 void GTE::Execute_NCDS(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  NCDS(REGS.V0, inst.GetShift(), inst.lm);
+  u32 flags = 0;
+  SIMD::NCDS<1>(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -1007,12 +833,9 @@ void GTE::Execute_NCDT(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  NCDS(REGS.V0, shift, lm);
-  NCDS(REGS.V1, shift, lm);
-  NCDS(REGS.V2, shift, lm);
+  u32 flags = 0;
+  SIMD::NCDS<3>(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -1021,20 +844,9 @@ void GTE::Execute_CC(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
-
-  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
-  // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)
-  TruncateAndSetMACAndIR<1>(s64(s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4, shift, lm);
-  TruncateAndSetMACAndIR<2>(s64(s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4, shift, lm);
-  TruncateAndSetMACAndIR<3>(s64(s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4, shift, lm);
-
-  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  u32 flags = 0;
+  SIMD::CC(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -1043,48 +855,20 @@ void GTE::Execute_CDP(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
-
-  // No need to assign these to MAC[1-3], as it'll never overflow.
-  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
-  const s32 in_MAC1 = (s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4;
-  const s32 in_MAC2 = (s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4;
-  const s32 in_MAC3 = (s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4;
-
-  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0                   ;<--- for CDP only
-  // [MAC1, MAC2, MAC3] = [MAC1, MAC2, MAC3] SAR(sf * 12)
-  InterpolateColor(in_MAC1, in_MAC2, in_MAC3, shift, lm);
-
-  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  u32 flags = 0;
+  SIMD::CDP(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
 
-void GTE::DPCS(const u8 color[3], u8 shift, bool lm)
-{
-  // In: [IR1,IR2,IR3]=Vector, FC=Far Color, IR0=Interpolation value, CODE=MSB of RGBC
-  // [MAC1,MAC2,MAC3] = [R,G,B] SHL 16                     ;<--- for DPCS/DPCT
-  TruncateAndSetMAC<1>((s64(ZeroExtend64(color[0])) << 16), 0);
-  TruncateAndSetMAC<2>((s64(ZeroExtend64(color[1])) << 16), 0);
-  TruncateAndSetMAC<3>((s64(ZeroExtend64(color[2])) << 16), 0);
-
-  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
-  InterpolateColor(REGS.MAC1, REGS.MAC2, REGS.MAC3, shift, lm);
-
-  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
-}
-
 void GTE::Execute_DPCS(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  DPCS(REGS.RGBC, inst.GetShift(), inst.lm);
+  u32 flags = 0;
+  SIMD::DPCS<1>(REGS, REGS.RGBC, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -1093,11 +877,9 @@ void GTE::Execute_DPCT(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  for (u32 i = 0; i < 3; i++)
-    DPCS(REGS.RGB0, shift, lm);
+  u32 flags = 0;
+  SIMD::DPCS<3>(REGS, REGS.RGB0, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -1106,20 +888,9 @@ void GTE::Execute_DCPL(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  // No need to assign these to MAC[1-3], as it'll never overflow.
-  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4          ;<--- for DCPL only
-  const s32 in_MAC1 = (s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4;
-  const s32 in_MAC2 = (s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4;
-  const s32 in_MAC3 = (s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4;
-
-  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
-  InterpolateColor(in_MAC1, in_MAC2, in_MAC3, shift, lm);
-
-  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  u32 flags = 0;
+  SIMD::DCPL(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -1128,16 +899,9 @@ void GTE::Execute_INTPL(Instruction inst)
 {
   REGS.FLAG.Clear();
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  // No need to assign these to MAC[1-3], as it'll never overflow.
-  // [MAC1,MAC2,MAC3] = [IR1,IR2,IR3] SHL 12               ;<--- for INTPL only
-  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
-  InterpolateColor(s32(REGS.IR1) << 12, s32(REGS.IR2) << 12, s32(REGS.IR3) << 12, shift, lm);
-
-  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  u32 flags = 0;
+  SIMD::INTPL(REGS, inst.GetShift(), inst.lm, flags);
+  REGS.FLAG.bits |= flags;
 
   REGS.FLAG.UpdateError();
 }
@@ -0,0 +1,440 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+// Vectorized GTE arithmetic. The three rows of a matrix-vector product, or the three color channels, are evaluated in
+// parallel lanes. The 44-bit MAC accumulators are carried in double-precision lanes: every intermediate value in these
+// paths is an integer with a magnitude below 2^53, so the arithmetic is exact and the MAC/IR/FLAG results match the
+// s64 implementation bit-for-bit. Stages which provably fit in 32 bits use integer lanes instead.
+//
+// Register writes are deferred until the end of a command, so the three-vertex variants keep their intermediate
+// results in vector registers. Callers are responsible for clearing FLAG and updating the error bit.
+
+#pragma once
+
+#include "gte_types.h"
+
+#include "common/bitutils.h"
+#include "common/gsvector.h"
+
+namespace GTE::SIMD {
+
+static constexpr double MAC123_MIN_VALUE_F64 = -8796093022208.0; // -(1 << 43)
+static constexpr double MAC123_MAX_VALUE_F64 = 8796093022207.0;  // (1 << 43) - 1
+static constexpr double MAC123_WRAP_F64 = 17592186044416.0;      // (1 << 44)
+static constexpr s32 IR123_MIN_VALUE = -0x8000;
+static constexpr s32 IR123_MAX_VALUE = 0x7FFF;
+
+/// MAC1-3 accumulators. MAC1/MAC2 are held in the first vector, MAC3 in the low lane of the second.
+struct MACVector
+{
+  GSVector4 xy;
+  GSVector4 z;
+};
+
+/// MAC1-3 and IR1-3 after truncation/saturation, in lanes x/y/z. Lane w is unused.
+struct MACIRVector
+{
+  GSVector4i mac;
+  GSVector4i ir;
+};
+
+ALWAYS_INLINE GSVector4 F64(s64 x, s64 y)
+{
+  return GSVector4::f64(static_cast<double>(x), static_cast<double>(y));
+}
+
+ALWAYS_INLINE MACVector ToMACVector(const GSVector4i& v)
+{
+  return {F64(v.extract32<0>(), v.extract32<1>()), F64(v.extract32<2>(), 0)};
+}
+
+ALWAYS_INLINE MACVector LoadTranslation(const s32* T)
+{
+  if (!T)
+    return {GSVector4::f64(0.0), GSVector4::f64(0.0)};
+
+  return {F64(s64(T[0]) << 12, s64(T[1]) << 12), F64(s64(T[2]) << 12, 0)};
+}
+
+/// Maps per-lane comparison results to FLAG bits: x -> bit, y -> bit - 1, z -> bit - 2.
+ALWAYS_INLINE u32 MACLaneFlags(const GSVector4& xy_mask, const GSVector4& z_mask, u32 bit)
+{
+  const u32 xy = static_cast<u32>(xy_mask.mask());
+  const u32 z = static_cast<u32>(z_mask.mask());
+  return ((xy & 1u) << bit) | (((xy >> 2) & 1u) << (bit - 1)) | ((z & 1u) << (bit - 2));
+}
+
+/// Same as MACLaneFlags(), but for 32-bit integer lanes.
+ALWAYS_INLINE u32 IntLaneFlags(const GSVector4i& mask, u32 bit)
+{
+  const u32 bits = static_cast<u32>(mask.mask());
+  return ((bits & 1u) << bit) | (((bits >> 4) & 1u) << (bit - 1)) | (((bits >> 8) & 1u) << (bit - 2));
+}
+
+ALWAYS_INLINE u32 CheckMACOverflow(const MACVector& v)
+{
+  const GSVector4 max = GSVector4::cxpr64(MAC123_MAX_VALUE_F64);
+  const GSVector4 min = GSVector4::cxpr64(MAC123_MIN_VALUE_F64);
+  return MACLaneFlags(v.xy.gt64(max), v.z.gt64(max), 30) | MACLaneFlags(v.xy.lt64(min), v.z.lt64(min), 27);
+}
+
+/// SignExtendN<44>() for values within one wrap of the 44-bit range.
+ALWAYS_INLINE GSVector4 SignExtendMAC(const GSVector4& v)
+{
+  const GSVector4 max = GSVector4::cxpr64(MAC123_MAX_VALUE_F64);
+  const GSVector4 min = GSVector4::cxpr64(MAC123_MIN_VALUE_F64);
+  const GSVector4 wrap = GSVector4::cxpr64(MAC123_WRAP_F64);
+  return v.sub64(v.gt64(max) & wrap).add64(v.lt64(min) & wrap);
+}
+
+ALWAYS_INLINE MACVector SignExtendMAC(const MACVector& v, u32& flags)
+{
+  flags |= CheckMACOverflow(v);
+  return {SignExtendMAC(v.xy), SignExtendMAC(v.z)};
+}
+
+/// Arithmetic shift right, i.e. floor(x / 2^shift). Exact, since the divisor is a power of two.
+ALWAYS_INLINE GSVector4 ShiftRight(const GSVector4& v, u8 shift)
+{
+  return v.mul64(GSVector4::f64(1.0 / static_cast<double>(1u << shift))).floor64();
+}
+
+ALWAYS_INLINE MACVector ShiftRight(const MACVector& v, u8 shift)
+{
+  return {ShiftRight(v.xy, shift), ShiftRight(v.z, shift)};
+}
+
+/// Wraps integer-valued lanes to 32 bits, i.e. Truncate32(), returning them in integer lanes 0/1.
+ALWAYS_INLINE GSVector4i Truncate32(const GSVector4& v)
+{
+  const GSVector4 wraps =
+    v.add64(GSVector4::cxpr64(2147483648.0)).mul64(GSVector4::cxpr64(1.0 / 4294967296.0)).floor64();
+  return v.sub64(wraps.mul64(GSVector4::cxpr64(4294967296.0))).f64toi32();
+}
+
+ALWAYS_INLINE GSVector4i Truncate32(const MACVector& v)
+{
+  return Truncate32(v.xy).upl64(Truncate32(v.z));
+}
+
+ALWAYS_INLINE GSVector4i IRMinValue(bool lm)
+{
+  return GSVector4i::cxpr(lm ? 0 : IR123_MIN_VALUE);
+}
+
+ALWAYS_INLINE GSVector4i SaturateIR(const GSVector4i& value, const GSVector4i& min_value, u32& flags)
+{
+  const GSVector4i result = value.max_i32(min_value).min_i32(GSVector4i::cxpr(IR123_MAX_VALUE));
+  flags |= IntLaneFlags(~result.eq32(value), 24);
+  return result;
+}
+
+/// Checks the final sum for overflow, shifts, and sets MAC/IR, i.e. TruncateAndSetMACAndIR().
+ALWAYS_INLINE MACIRVector TruncateMACAndIR(const MACVector& v, u8 shift, bool lm, u32& flags)
+{
+  flags |= CheckMACOverflow(v);
+  const GSVector4i mac = Truncate32(ShiftRight(v, shift));
+  return {mac, SaturateIR(mac, IRMinValue(lm), flags)};
+}
+
+/// Same as TruncateMACAndIR(), for values which are known to fit in 32 bits and thus cannot overflow MAC.
+ALWAYS_INLINE MACIRVector TruncateMACAndIR(const GSVector4i& v, u8 shift, bool lm, u32& flags)
+{
+  const GSVector4i mac = v.sra32(shift);
+  return {mac, SaturateIR(mac, IRMinValue(lm), flags)};
+}
+
+/// Computes (T * 1000h) + (M * V) for all three rows, applying the 44-bit checks to the intermediate sums.
+/// The final sum is returned as-is, it still needs to be checked and truncated.
+ALWAYS_INLINE MACVector MulMatVec(const s16* M, const s32* T, s16 Vx, s16 Vy, s16 Vz, u32& flags)
+{
+  const GSVector4 vx = GSVector4::f64(static_cast<double>(Vx));
+  const GSVector4 vy = GSVector4::f64(static_cast<double>(Vy));
+  const GSVector4 vz = GSVector4::f64(static_cast<double>(Vz));
+
+  MACVector acc = LoadTranslation(T);
+  acc = SignExtendMAC({acc.xy.add64(F64(M[0], M[3]).mul64(vx)), acc.z.add64(F64(M[6], 0).mul64(vx))}, flags);
+  acc = SignExtendMAC({acc.xy.add64(F64(M[1], M[4]).mul64(vy)), acc.z.add64(F64(M[7], 0).mul64(vy))}, flags);
+  return {acc.xy.add64(F64(M[2], M[5]).mul64(vz)), acc.z.add64(F64(M[8], 0).mul64(vz))};
+}
+
+ALWAYS_INLINE MACVector MulMatVec(const s16* M, const s32* T, const GSVector4i& V, u32& flags)
+{
+  return MulMatVec(M, T, static_cast<s16>(V.extract32<0>()), static_cast<s16>(V.extract32<1>()),
+                   static_cast<s16>(V.extract32<2>()), flags);
+}
+
+/// MVMVA with the far color translation vector. The first column is added to the translation, but only affects the
+/// IR flags, and the result is computed from the remaining two columns.
+ALWAYS_INLINE MACIRVector MulMatVecBuggy(const s16* M, const s32* T, s16 Vx, s16 Vy, s16 Vz, u8 shift, bool lm,
+                                         u32& flags)
+{
+  const GSVector4 vx = GSVector4::f64(static_cast<double>(Vx));
+  const GSVector4 vy = GSVector4::f64(static_cast<double>(Vy));
+  const GSVector4 vz = GSVector4::f64(static_cast<double>(Vz));
+
+  const MACVector tr = LoadTranslation(T);
+  const MACVector first =
+    SignExtendMAC({tr.xy.add64(F64(M[0], M[3]).mul64(vx)), tr.z.add64(F64(M[6], 0).mul64(vx))}, flags);
+  SaturateIR(Truncate32(ShiftRight(first, shift)), IRMinValue(false), flags);
+
+  return TruncateMACAndIR(
+    {F64(M[1], M[4]).mul64(vy).add64(F64(M[2], M[5]).mul64(vz)), F64(M[7], 0).mul64(vy).add64(F64(M[8], 0).mul64(vz))},
+    shift, lm, flags);
+}
+
+/// [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4. At most 28 bits, so 32-bit lanes suffice.
+ALWAYS_INLINE GSVector4i MulColorIR(const Regs& regs, const GSVector4i& ir)
+{
+  return GSVector4i::load32(regs.RGBC).u8to32().mul32l(ir).sll32<4>();
+}
+
+/// [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
+ALWAYS_INLINE MACIRVector InterpolateColor(const Regs& regs, const GSVector4i& in_mac, u8 shift, bool lm, u32& flags)
+{
+  // [IR1,IR2,IR3] = (([RFC,GFC,BFC] SHL 12) - [MAC1,MAC2,MAC3]) SAR (sf*12)
+  const MACVector fc = LoadTranslation(regs.FC);
+  const MACVector in = ToMACVector(in_mac);
+  const GSVector4i ir = TruncateMACAndIR(MACVector{fc.xy.sub64(in.xy), fc.z.sub64(in.z)}, shift, false, flags).ir;
+
+  // [MAC1,MAC2,MAC3] = (([IR1,IR2,IR3] * IR0) + [MAC1,MAC2,MAC3]) SAR (sf*12)
+  // Both terms are at most 30 bits, so the sum fits in 32 bits.
+  return TruncateMACAndIR(ir.mul32l(GSVector4i::cxpr(static_cast<s32>(regs.IR0))).add32(in_mac), shift, lm, flags);
+}
+
+/// Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE]
+ALWAYS_INLINE void PushRGBFromMAC(Regs& regs, const GSVector4i& mac, u32& flags)
+{
+  // Note: SHR 4 used instead of /16 as the results are different.
+  const GSVector4i value = mac.sra32<4>();
+  const GSVector4i rgb = value.max_i32(GSVector4i::cxpr(0)).min_i32(GSVector4i::cxpr(0xFF));
+  flags |= IntLaneFlags(~rgb.eq32(value), 21);
+
+  regs.dr32[20] = regs.dr32[21]; // RGB0 <- RGB1
+  regs.dr32[21] = regs.dr32[22]; // RGB1 <- RGB2
+  regs.dr32[22] = (static_cast<u32>(rgb.ps32().pu16().extract32<0>()) & 0x00FFFFFFu) |
+                  (ZeroExtend32(regs.RGBC[3]) << 24); // RGB2 <- Value
+}
+
+ALWAYS_INLINE void StoreMACAndIR(Regs& regs, const MACIRVector& v)
+{
+  GSVector4i::storel(&regs.dr32[25], v.mac);
+  regs.dr32[27] = static_cast<u32>(v.mac.extract32<2>());
+  GSVector4i::storel(&regs.dr32[9], v.ir);
+  regs.dr32[11] = static_cast<u32>(v.ir.extract32<2>());
+}
+
+/// RTPS/RTPT perspective transformation, up to and including setting MAC1-3 and IR1-3.
+/// Returns the untruncated sums, which are needed for SZ3 and precise projection.
+ALWAYS_INLINE MACVector RTPSTransform(Regs& regs, const MACVector& sum, u8 shift, bool lm, u32& flags)
+{
+  // IR1 = MAC1 = (TRX*1000h + RT11*VX0 + RT12*VY0 + RT13*VZ0) SAR (sf*12)
+  // IR2 = MAC2 = (TRY*1000h + RT21*VX0 + RT22*VY0 + RT23*VZ0) SAR (sf*12)
+  // IR3 = MAC3 = (TRZ*1000h + RT31*VX0 + RT32*VY0 + RT33*VZ0) SAR (sf*12)
+  flags |= CheckMACOverflow(sum);
+  const GSVector4i mac = Truncate32(ShiftRight(sum, shift));
+
+  // The command does saturate IR1,IR2,IR3 to -8000h..+7FFFh (regardless of lm bit). When using RTP with sf=0, then the
+  // IR3 saturation flag (FLAG.22) gets set <only> if "MAC3 SAR 12" exceeds -8000h..+7FFFh (although IR3 is saturated
+  // when "MAC3" exceeds -8000h..+7FFFh).
+  const s32 ir_min = lm ? 0 : IR123_MIN_VALUE;
+  const GSVector4i z12 = Truncate32(ShiftRight(sum.z, 12));
+  const GSVector4i ir =
+    SaturateIR(mac.blend32<0x4>(z12.xxxx()), GSVector4i::cxpr(ir_min, ir_min, IR123_MIN_VALUE, 0), flags)
+      .blend32<0x4>(mac.max_i32(GSVector4i::cxpr(ir_min)).min_i32(GSVector4i::cxpr(IR123_MAX_VALUE)));
+
+  StoreMACAndIR(regs, {mac, ir});
+  return sum;
+}
+
+ALWAYS_INLINE void MVMVA(Regs& regs, Instruction inst, u32& flags)
+{
+  const s16* M;
+  s16 buggy_M[3][3];
+  switch (inst.mvmva_multiply_matrix)
+  {
+    case 0:
+      M = &regs.RT[0][0];
+      break;
+
+    case 1:
+      M = &regs.LLM[0][0];
+      break;
+
+    case 2:
+      M = &regs.LCM[0][0];
+      break;
+
+    default:
+    {
+      // buggy
+      buggy_M[0][0] = -static_cast<s16>(ZeroExtend16(regs.RGBC[0]) << 4);
+      buggy_M[0][1] = static_cast<s16>(ZeroExtend16(regs.RGBC[0]) << 4);
+      buggy_M[0][2] = regs.IR0;
+      buggy_M[1][0] = regs.RT[0][2];
+      buggy_M[1][1] = regs.RT[0][2];
+      buggy_M[1][2] = regs.RT[0][2];
+      buggy_M[2][0] = regs.RT[1][1];
+      buggy_M[2][1] = regs.RT[1][1];
+      buggy_M[2][2] = regs.RT[1][1];
+      M = &buggy_M[0][0];
+    }
+    break;
+  }
+
+  s16 Vx, Vy, Vz;
+  if (inst.mvmva_multiply_vector < 3)
+  {
+    const s16* V =
+      (inst.mvmva_multiply_vector == 0) ? regs.V0 : ((inst.mvmva_multiply_vector == 1) ? regs.V1 : regs.V2);
+    Vx = V[0];
+    Vy = V[1];
+    Vz = V[2];
+  }
+  else
+  {
+    Vx = regs.IR1;
+    Vy = regs.IR2;
+    Vz = regs.IR3;
+  }
+
+  const u8 shift = inst.GetShift();
+  const bool lm = inst.lm;
+  switch (inst.mvmva_translation_vector)
+  {
+    case 0:
+      StoreMACAndIR(regs, TruncateMACAndIR(MulMatVec(M, regs.TR, Vx, Vy, Vz, flags), shift, lm, flags));
+      break;
+
+    case 1:
+      StoreMACAndIR(regs, TruncateMACAndIR(MulMatVec(M, regs.BK, Vx, Vy, Vz, flags), shift, lm, flags));
+      break;
+
+    case 2:
+      StoreMACAndIR(regs, MulMatVecBuggy(M, regs.FC, Vx, Vy, Vz, shift, lm, flags));
+      break;
+
+    default:
+      StoreMACAndIR(regs, TruncateMACAndIR(MulMatVec(M, nullptr, Vx, Vy, Vz, flags), shift, lm, flags));
+      break;
+  }
+}
+
+/// [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V) SAR (sf*12)
+/// [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
+ALWAYS_INLINE MACIRVector NormalColor(const Regs& regs, const s16 V[3], u8 shift, bool lm, u32& flags)
+{
+  const MACIRVector light =
+    TruncateMACAndIR(MulMatVec(&regs.LLM[0][0], nullptr, V[0], V[1], V[2], flags), shift, lm, flags);
+  return TruncateMACAndIR(MulMatVec(&regs.LCM[0][0], regs.BK, light.ir, flags), shift, lm, flags);
+}
+
+/// Executes NCS for each vertex, the [IR1,IR2,IR3] inputs of each step are carried in registers.
+template<u32 count>
+ALWAYS_INLINE void NCS(Regs& regs, u8 shift, bool lm, u32& flags)
+{
+  const s16* const vertices[3] = {regs.V0, regs.V1, regs.V2};
+  MACIRVector res;
+  for (u32 i = 0; i < count; i++)
+  {
+    res = NormalColor(regs, vertices[i], shift, lm, flags);
+    PushRGBFromMAC(regs, res.mac, flags);
+  }
+  StoreMACAndIR(regs, res);
+}
+
+template<u32 count>
+ALWAYS_INLINE void NCCS(Regs& regs, u8 shift, bool lm, u32& flags)
+{
+  const s16* const vertices[3] = {regs.V0, regs.V1, regs.V2};
+  MACIRVector res;
+  for (u32 i = 0; i < count; i++)
+  {
+    // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
+    // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)
+    res = NormalColor(regs, vertices[i], shift, lm, flags);
+    res = TruncateMACAndIR(MulColorIR(regs, res.ir), shift, lm, flags);
+    PushRGBFromMAC(regs, res.mac, flags);
+  }
+  StoreMACAndIR(regs, res);
+}
+
+template<u32 count>
+ALWAYS_INLINE void NCDS(Regs& regs, u8 shift, bool lm, u32& flags)
+{
+  const s16* const vertices[3] = {regs.V0, regs.V1, regs.V2};
+  MACIRVector res;
+  for (u32 i = 0; i < count; i++)
+  {
+    // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
+    // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
+    res = NormalColor(regs, vertices[i], shift, lm, flags);
+    res = InterpolateColor(regs, MulColorIR(regs, res.ir), shift, lm, flags);
+    PushRGBFromMAC(regs, res.mac, flags);
+  }
+  StoreMACAndIR(regs, res);
+}
+
+ALWAYS_INLINE void CC(Regs& regs, u8 shift, bool lm, u32& flags)
+{
+  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
+  MACIRVector res = TruncateMACAndIR(MulMatVec(&regs.LCM[0][0], regs.BK, regs.IR1, regs.IR2, regs.IR3, flags),
+                                     shift, lm, flags);
+
+  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
+  // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)
+  res = TruncateMACAndIR(MulColorIR(regs, res.ir), shift, lm, flags);
+  PushRGBFromMAC(regs, res.mac, flags);
+  StoreMACAndIR(regs, res);
+}
+
+ALWAYS_INLINE void CDP(Regs& regs, u8 shift, bool lm, u32& flags)
+{
+  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
+  MACIRVector res = TruncateMACAndIR(MulMatVec(&regs.LCM[0][0], regs.BK, regs.IR1, regs.IR2, regs.IR3, flags),
+                                     shift, lm, flags);
+
+  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
+  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
+  res = InterpolateColor(regs, MulColorIR(regs, res.ir), shift, lm, flags);
+  PushRGBFromMAC(regs, res.mac, flags);
+  StoreMACAndIR(regs, res);
+}
+
+/// DPCS uses RGBC, DPCT uses RGB0 for each step, which is shifted by each push.
+template<u32 count>
+ALWAYS_INLINE void DPCS(Regs& regs, const u8* color, u8 shift, bool lm, u32& flags)
+{
+  MACIRVector res;
+  for (u32 i = 0; i < count; i++)
+  {
+    // [MAC1,MAC2,MAC3] = [R,G,B] SHL 16
+    // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
+    res = InterpolateColor(regs, GSVector4i::load32(color).u8to32().sll32<16>(),
+                           shift, lm, flags);
+    PushRGBFromMAC(regs, res.mac, flags);
+  }
+  StoreMACAndIR(regs, res);
+}
+
+ALWAYS_INLINE void DCPL(Regs& regs, u8 shift, bool lm, u32& flags)
+{
+  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
+  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
+  const GSVector4i ir = GSVector4i(regs.IR1, regs.IR2, regs.IR3, 0);
+  const MACIRVector res = InterpolateColor(regs, MulColorIR(regs, ir), shift, lm, flags);
+  PushRGBFromMAC(regs, res.mac, flags);
+  StoreMACAndIR(regs, res);
+}
+
+ALWAYS_INLINE void INTPL(Regs& regs, u8 shift, bool lm, u32& flags)
+{
+  // [MAC1,MAC2,MAC3] = [IR1,IR2,IR3] SHL 12
+  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
+  const GSVector4i ir = GSVector4i(regs.IR1, regs.IR2, regs.IR3, 0);
+  const MACIRVector res = InterpolateColor(regs, ir.sll32<12>(), shift, lm, flags);
+  PushRGBFromMAC(regs, res.mac, flags);
+  StoreMACAndIR(regs, res);
+}
+
+} // namespace GTE::SIMD
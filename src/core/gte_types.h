@@ -41,6 +41,12 @@ union FLAGS
 
   static constexpr u32 WRITE_MASK = UINT32_C(0xFFFFF000);
 
+  // Raw bit values, used by the recompilers when generating flag updates inline.
+  static constexpr u32 ERROR_BIT = UINT32_C(1) << 31;
+  static constexpr u32 SZ1_OTZ_SATURATED_BIT = UINT32_C(1) << 18;
+  static constexpr u32 MAC0_OVERFLOW_BIT = UINT32_C(1) << 16;
+  static constexpr u32 MAC0_UNDERFLOW_BIT = UINT32_C(1) << 15;
+
   ALWAYS_INLINE void Clear() { bits = 0; }
 
   // Bits 30..23, 18..13 OR'ed
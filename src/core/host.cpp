@@ -298,9 +298,10 @@ bool Host::CreateGPUDevice(RenderAPI api, Error* error)
   if (!g_gpu_device || !g_gpu_device->Create(
                          g_settings.gpu_adapter,
                          g_settings.gpu_disable_shader_cache ? std::string_view() : std::string_view(EmuFolders::Cache),
-                         SHADER_CACHE_VERSION, g_settings.gpu_use_debug_device, System::GetEffectiveVSyncMode(),
-                         System::ShouldAllowPresentThrottle(), exclusive_fullscreen_control,
-                         static_cast<GPUDevice::FeatureMask>(disabled_features), &create_error))
+                         SHADER_CACHE_VERSION, g_settings.gpu_preload_shader_cache, g_settings.gpu_use_debug_device,
+                         System::GetEffectiveVSyncMode(), System::ShouldAllowPresentThrottle(),
+                         exclusive_fullscreen_control, static_cast<GPUDevice::FeatureMask>(disabled_features),
+                         &create_error))
   {
     ERROR_LOG("Failed to create GPU device: {}", create_error.GetDescription());
     if (g_gpu_device)
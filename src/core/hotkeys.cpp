@@ -9,6 +9,7 @@
 #include "gpu.h"
 #include "host.h"
 #include "imgui_overlays.h"
+#include "input_movie.h"
 #include "settings.h"
 #include "spu.h"
 #include "system.h"
@@ -236,6 +237,27 @@ DEFINE_HOTKEY("ToggleMediaCapture", TRANSLATE_NOOP("Hotkeys", "General"),
                 }
               })
 
+DEFINE_HOTKEY("ToggleInputMovieRecording", TRANSLATE_NOOP("Hotkeys", "General"),
+              TRANSLATE_NOOP("Hotkeys", "Toggle Input Movie Recording"), [](s32 pressed) {
+                if (pressed || !System::IsValid())
+                  return;
+
+                if (InputMovie::IsRecording())
+                {
+                  InputMovie::Stop();
+                  return;
+                }
+
+                Error error;
+                if (!InputMovie::StartRecording(System::GetNewMediaCapturePath(System::GetGameTitle(), "dsm"), &error))
+                {
+                  Host::AddIconOSDMessage("InputMovie", ICON_FA_FILM,
+                                          fmt::format(TRANSLATE_FS("OSDMessage", "Failed to start input movie: {}"),
+                                                      error.GetDescription()),
+                                          Host::OSD_ERROR_DURATION);
+                }
+              })
+
 DEFINE_HOTKEY("OpenAchievements", TRANSLATE_NOOP("Hotkeys", "General"),
               TRANSLATE_NOOP("Hotkeys", "Open Achievement List"), [](s32 pressed) {
                 if (!pressed && CanPause())
@@ -0,0 +1,496 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "input_movie.h"
+#include "controller.h"
+#include "host.h"
+#include "pad.h"
+#include "save_state_version.h"
+#include "settings.h"
+#include "system.h"
+
+#include "util/imgui_manager.h"
+#include "util/ini_settings_interface.h"
+#include "util/state_wrapper.h"
+
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/heap_array.h"
+#include "common/log.h"
+#include "common/path.h"
+
+#include "IconsFontAwesome5.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+Log_SetChannel(InputMovie);
+
+namespace InputMovie {
+namespace {
+
+enum class Mode : u8
+{
+  None,
+  Recording,
+  Playback,
+};
+
+#pragma pack(push, 1)
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 start_frame;
+  u32 frame_count;
+  u32 event_count;
+};
+#pragma pack(pop)
+static_assert(sizeof(FileHeader) == 20 && sizeof(FileEvent) == 12);
+
+} // namespace
+
+static constexpr u32 MOVIE_MAGIC = 0x564F4D44;       // DMOV
+static constexpr u32 MOVIE_VERSION = 1;
+static constexpr u32 INPUT_STATE_MAGIC = 0x44415044; // DPAD
+static constexpr u32 INPUT_STATE_HEADER_SIZE = sizeof(u32) * 2;
+static constexpr u32 MAX_INPUT_STATE_SIZE = 64 * 1024;
+
+static std::string GetInputStatePath(std::string_view state_path);
+static bool SaveInputState(std::string_view state_path, Error* error);
+static bool LoadInputState(std::string_view state_path, Error* error);
+static bool SaveSettings(std::string_view path, Error* error);
+static void SaveKeyframe(u32 frame);
+static void ApplyEvents(u32 frame);
+
+static Mode s_mode = Mode::None;
+static std::string s_path;
+static FileSystem::ManagedCFilePtr s_fp;
+static std::vector<FileEvent> s_events;
+static size_t s_next_event = 0;
+static u32 s_start_frame = 0;
+static u32 s_frame_count = 0;
+static u32 s_event_count = 0;
+static u32 s_playback_start_frame = 0;
+static u32 s_keyframe_interval = 0;
+
+} // namespace InputMovie
+
+std::string InputMovie::GetSettingsPath(std::string_view path)
+{
+  return Path::ReplaceExtension(path, "ini");
+}
+
+std::string InputMovie::GetStatePath(std::string_view path, u32 frame)
+{
+  return (frame == 0) ? Path::ReplaceExtension(path, "sav") :
+                        Path::ReplaceExtension(path, TinyString::from_format("{:08d}.sav", frame));
+}
+
+std::string InputMovie::GetInputStatePath(std::string_view state_path)
+{
+  return Path::ReplaceExtension(state_path, "pad");
+}
+
+bool InputMovie::SaveInputState(std::string_view state_path, Error* error)
+{
+  // Input state isn't part of save state files, since loading a state shouldn't override the user's controller.
+  // For a movie it has to be restored exactly, otherwise held buttons/sticks are lost at the start of playback.
+  DynamicHeapArray<u8> data(MAX_INPUT_STATE_SIZE);
+  StateWrapper sw(data.span(INPUT_STATE_HEADER_SIZE), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
+  for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+  {
+    Controller* const controller = Pad::GetController(i);
+    ControllerType type = controller ? controller->GetType() : ControllerType::None;
+    sw.Do(&type);
+    if (controller && !controller->DoState(sw, true))
+      break;
+  }
+  if (sw.HasError())
+  {
+    Error::SetStringView(error, "Failed to serialize controller state.");
+    return false;
+  }
+
+  const u32 header[2] = {INPUT_STATE_MAGIC, SAVE_STATE_VERSION};
+  std::memcpy(data.data(), header, sizeof(header));
+  return FileSystem::WriteBinaryFile(GetInputStatePath(state_path).c_str(), data.data(),
+                                     INPUT_STATE_HEADER_SIZE + sw.GetPosition(), error);
+}
+
+bool InputMovie::LoadInputState(std::string_view state_path, Error* error)
+{
+  const std::string path = GetInputStatePath(state_path);
+  std::optional<DynamicHeapArray<u8>> data = FileSystem::ReadBinaryFile(path.c_str(), error);
+  if (!data.has_value())
+  {
+    Error::AddPrefixFmt(error, "Failed to read '{}': ", Path::GetFileName(path));
+    return false;
+  }
+
+  u32 header[2] = {};
+  if (data->size() >= INPUT_STATE_HEADER_SIZE)
+    std::memcpy(header, data->data(), sizeof(header));
+  if (header[0] != INPUT_STATE_MAGIC || header[1] < SAVE_STATE_MINIMUM_VERSION || header[1] > SAVE_STATE_VERSION)
+  {
+    Error::SetStringFmt(error, "Controller state '{}' is invalid.", Path::GetFileName(path));
+    return false;
+  }
+
+  StateWrapper sw(data->cspan(INPUT_STATE_HEADER_SIZE), StateWrapper::Mode::Read, header[1]);
+  for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+  {
+    Controller* const controller = Pad::GetController(i);
+    ControllerType type = ControllerType::None;
+    sw.Do(&type);
+    if (type != (controller ? controller->GetType() : ControllerType::None))
+    {
+      Error::SetStringFmt(error, "Controller {} does not match the movie.", i + 1u);
+      return false;
+    }
+
+    if (controller && !controller->DoState(sw, true))
+      break;
+  }
+  if (sw.HasError())
+  {
+    Error::SetStringFmt(error, "Failed to deserialize controller state from '{}'.", Path::GetFileName(path));
+    return false;
+  }
+
+  return true;
+}
+
+bool InputMovie::SaveSettings(std::string_view path, Error* error)
+{
+  INISettingsInterface si(GetSettingsPath(path));
+
+  // Controller settings such as sensitivity and deadzone affect how binding values are applied.
+  {
+    const auto lock = Host::GetSettingsLock();
+    const SettingsInterface* const host_si = Host::GetSettingsInterface();
+    for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+    {
+      const std::string section = Controller::GetSettingsSection(i);
+      si.SetKeyValueList(section.c_str(), host_si->GetKeyValueList(section.c_str()));
+    }
+  }
+
+  g_settings.Save(si, false);
+  return si.Save(error);
+}
+
+bool InputMovie::WriteFileHeader(std::FILE* fp, u32 start_frame, u32 frame_count, u32 event_count, Error* error)
+{
+  const FileHeader header = {MOVIE_MAGIC, MOVIE_VERSION, start_frame, frame_count, event_count};
+  if (!FileSystem::FSeek64(fp, 0, SEEK_SET, error))
+    return false;
+
+  if (std::fwrite(&header, sizeof(header), 1, fp) != 1)
+  {
+    Error::SetErrno(error, "fwrite() failed: ", errno);
+    return false;
+  }
+
+  return FileSystem::FSeek64(fp, 0, SEEK_END, error);
+}
+
+bool InputMovie::WriteFileEvent(std::FILE* fp, const FileEvent& ev, Error* error)
+{
+  if (std::fwrite(&ev, sizeof(ev), 1, fp) != 1)
+  {
+    Error::SetErrno(error, "fwrite() failed: ", errno);
+    return false;
+  }
+
+  return true;
+}
+
+bool InputMovie::ReadFile(const char* path, u32* start_frame, u32* frame_count, std::vector<FileEvent>* events,
+                          Error* error)
+{
+  FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(path, "rb", error);
+  if (!fp)
+  {
+    Error::AddPrefixFmt(error, "Failed to open '{}': ", Path::GetFileName(path));
+    return false;
+  }
+
+  FileHeader header;
+  if (std::fread(&header, sizeof(header), 1, fp.get()) != 1 || header.magic != MOVIE_MAGIC)
+  {
+    Error::SetStringFmt(error, "'{}' is not an input movie.", Path::GetFileName(path));
+    return false;
+  }
+  else if (header.version != MOVIE_VERSION)
+  {
+    Error::SetStringFmt(error, "Unsupported input movie version {}.", header.version);
+    return false;
+  }
+
+  // Check the count before allocating, a corrupted header shouldn't be able to request gigabytes.
+  const s64 file_size = FileSystem::FSize64(fp.get(), error);
+  if (file_size < 0)
+    return false;
+  const u64 events_size = static_cast<u64>(file_size) - sizeof(FileHeader);
+  if (events_size / sizeof(FileEvent) < header.event_count)
+  {
+    Error::SetStringFmt(error, "'{}' is truncated, {} events are missing.", Path::GetFileName(path),
+                        header.event_count - (events_size / sizeof(FileEvent)));
+    return false;
+  }
+
+  events->resize(header.event_count);
+  if (std::fread(events->data(), sizeof(FileEvent), events->size(), fp.get()) != events->size())
+  {
+    Error::SetStringFmt(error, "Failed to read events from '{}'.", Path::GetFileName(path));
+    return false;
+  }
+
+  // Playback looks up its starting event with a binary search, so the order matters.
+  for (size_t i = 0; i < events->size(); i++)
+  {
+    const FileEvent& ev = (*events)[i];
+    if (ev.frame > header.frame_count || (i > 0 && ev.frame < (*events)[i - 1].frame))
+    {
+      Error::SetStringFmt(error, "Event {} in '{}' is out of order.", i, Path::GetFileName(path));
+      return false;
+    }
+  }
+
+  *start_frame = header.start_frame;
+  *frame_count = header.frame_count;
+  return true;
+}
+
+bool InputMovie::StartRecording(std::string path, Error* error)
+{
+  if (!System::IsValid())
+  {
+    Error::SetStringView(error, "System is not running.");
+    return false;
+  }
+
+  // Runahead replays frames with inputs from the future, and a rewind would not be in the movie.
+  if (g_settings.runahead_frames > 0)
+  {
+    Error::SetStringView(error, TRANSLATE_SV("InputMovie", "Input movies cannot be recorded with runahead enabled."));
+    return false;
+  }
+
+  Stop();
+
+  const std::string state_path = GetStatePath(path, 0);
+  if (!System::SaveState(state_path.c_str(), error, false) || !SaveInputState(state_path, error) ||
+      !SaveSettings(path, error))
+  {
+    return false;
+  }
+
+  s_fp = FileSystem::OpenManagedCFile(path.c_str(), "wb", error);
+  if (!s_fp)
+  {
+    Error::AddPrefixFmt(error, "Failed to open '{}': ", Path::GetFileName(path));
+    return false;
+  }
+
+  s_start_frame = System::GetFrameNumber();
+  s_frame_count = 0;
+  s_event_count = 0;
+  if (!WriteFileHeader(s_fp.get(), s_start_frame, s_frame_count, s_event_count, error))
+  {
+    s_fp.reset();
+    return false;
+  }
+
+  INFO_LOG("Recording input movie to '{}' from frame {}.", path, s_start_frame);
+  Host::AddIconOSDMessage("InputMovie", ICON_FA_FILM,
+                          fmt::format(TRANSLATE_FS("InputMovie", "Recording input movie to '{}'."),
+                                      Path::GetFileName(path)),
+                          Host::OSD_INFO_DURATION);
+
+  s_path = std::move(path);
+  s_mode = Mode::Recording;
+  return true;
+}
+
+bool InputMovie::StartPlayback(std::string path, u32 start_frame, u32 keyframe_interval, Error* error)
+{
+  if (!System::IsValid())
+  {
+    Error::SetStringView(error, "System is not running.");
+    return false;
+  }
+
+  if (g_settings.runahead_frames > 0)
+  {
+    Error::SetStringView(error,
+                         TRANSLATE_SV("InputMovie", "Input movies cannot be played back with runahead enabled."));
+    return false;
+  }
+
+  Stop();
+
+  u32 movie_start_frame, movie_frame_count;
+  std::vector<FileEvent> events;
+  if (!ReadFile(path.c_str(), &movie_start_frame, &movie_frame_count, &events, error))
+    return false;
+
+  if (start_frame > movie_frame_count || System::GetFrameNumber() != (movie_start_frame + start_frame))
+  {
+    Error::SetStringFmt(error, "System is at frame {}, expected frame {} for movie frame {} of {}.",
+                        System::GetFrameNumber(), movie_start_frame + start_frame, start_frame, movie_frame_count);
+    return false;
+  }
+
+  if (!LoadInputState(GetStatePath(path, start_frame), error))
+    return false;
+
+  s_events = std::move(events);
+  s_next_event = static_cast<size_t>(
+    std::lower_bound(s_events.begin(), s_events.end(), start_frame,
+                     [](const FileEvent& ev, u32 frame) { return ev.frame < frame; }) -
+    s_events.begin());
+  s_start_frame = movie_start_frame;
+  s_frame_count = movie_frame_count;
+  s_event_count = static_cast<u32>(s_events.size());
+  s_playback_start_frame = start_frame;
+  s_keyframe_interval = keyframe_interval;
+  s_path = std::move(path);
+  s_mode = Mode::Playback;
+
+  INFO_LOG("Playing back input movie '{}' from frame {} of {}.", s_path, start_frame, s_frame_count);
+
+  ApplyEvents(start_frame);
+  return true;
+}
+
+void InputMovie::Stop()
+{
+  if (s_mode == Mode::Recording)
+  {
+    Error error;
+    if (!WriteFileHeader(s_fp.get(), s_start_frame, s_frame_count, s_event_count, &error) ||
+        std::fflush(s_fp.get()) != 0)
+      ERROR_LOG("Failed to finalize input movie '{}': {}", Path::GetFileName(s_path), error.GetDescription());
+
+    s_fp.reset();
+
+    INFO_LOG("Recorded {} frames with {} input changes to '{}'.", s_frame_count, s_event_count, s_path);
+    Host::AddIconOSDMessage("InputMovie", ICON_FA_FILM,
+                            fmt::format(TRANSLATE_FS("InputMovie", "Input movie of {} frames saved to '{}'."),
+                                        s_frame_count, Path::GetFileName(s_path)),
+                            Host::OSD_INFO_DURATION);
+  }
+  else if (s_mode == Mode::Playback)
+  {
+    INFO_LOG("Stopped playing back input movie '{}'.", s_path);
+    s_events = {};
+    s_next_event = 0;
+  }
+
+  s_mode = Mode::None;
+  s_path = {};
+  s_keyframe_interval = 0;
+}
+
+bool InputMovie::IsActive()
+{
+  return (s_mode != Mode::None);
+}
+
+bool InputMovie::IsRecording()
+{
+  return (s_mode == Mode::Recording);
+}
+
+bool InputMovie::IsPlaying()
+{
+  return (s_mode == Mode::Playback);
+}
+
+u32 InputMovie::GetFrameCount()
+{
+  return s_frame_count;
+}
+
+u32 InputMovie::GetCurrentFrame()
+{
+  return IsActive() ? (System::GetFrameNumber() - s_start_frame) : 0;
+}
+
+bool InputMovie::OnBindStateChanged(u32 slot, u32 bind_index, float value)
+{
+  // Host input doesn't get through during playback, the movie owns the controllers.
+  if (s_mode != Mode::Recording)
+    return (s_mode == Mode::None);
+
+  // Changes are keyed by the frame they were made on. Everything the host does happens between frames, so applying
+  // them at the end of the same frame during playback reproduces the session, pauses and frame steps included.
+  const u32 frame = System::GetFrameNumber() - s_start_frame;
+  const FileEvent ev = {frame, static_cast<u8>(slot), 0, static_cast<u16>(bind_index), value};
+  Error error;
+  if (!WriteFileEvent(s_fp.get(), ev, &error)) [[unlikely]]
+  {
+    ERROR_LOG("Failed to write to input movie '{}', stopping recording: {}", Path::GetFileName(s_path),
+              error.GetDescription());
+    Stop();
+    return true;
+  }
+
+  s_event_count++;
+  s_frame_count = std::max(s_frame_count, frame);
+  return true;
+}
+
+void InputMovie::FrameDone()
+{
+  const u32 frame = System::GetFrameNumber() - s_start_frame;
+  if (s_mode == Mode::Recording)
+  {
+    s_frame_count = std::max(s_frame_count, frame);
+    return;
+  }
+
+  // Keyframes are written before this frame's changes are applied, matching where playback resumes from them.
+  if (s_keyframe_interval > 0 && frame != s_playback_start_frame && frame < s_frame_count &&
+      (frame % s_keyframe_interval) == 0)
+  {
+    SaveKeyframe(frame);
+  }
+
+  ApplyEvents(frame);
+
+  if (frame >= s_frame_count)
+  {
+    INFO_LOG("Input movie playback finished after {} frames.", s_frame_count);
+    Host::AddIconOSDMessage("InputMovie", ICON_FA_FILM, TRANSLATE_STR("InputMovie", "Input movie playback finished."),
+                            Host::OSD_INFO_DURATION);
+    Stop();
+  }
+}
+
+void InputMovie::SaveKeyframe(u32 frame)
+{
+  const std::string state_path = GetStatePath(s_path, frame);
+  Error error;
+  if (!System::SaveState(state_path.c_str(), &error, false) || !SaveInputState(state_path, &error))
+  {
+    ERROR_LOG("Failed to save keyframe for frame {}: {}", frame, error.GetDescription());
+    return;
+  }
+
+  DEV_LOG("Saved keyframe for frame {} to '{}'.", frame, Path::GetFileName(state_path));
+}
+
+void InputMovie::ApplyEvents(u32 frame)
+{
+  for (; s_next_event < s_events.size() && s_events[s_next_event].frame <= frame; s_next_event++)
+  {
+    const FileEvent& ev = s_events[s_next_event];
+    if (Controller* const controller = Pad::GetController(ev.slot))
+      controller->SetBindState(ev.bind_index, ev.value);
+  }
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include "types.h"
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Error;
+
+/// Deterministic input movies. A movie is the list of controller binding changes made by the host, keyed by frame,
+/// plus the save state and settings the recording started from. Replaying it from the same state reproduces the
+/// session exactly, which lets the regression test runner re-render it offline, in parallel chunks.
+namespace InputMovie {
+
+/// Starts recording to the specified file. The current state and settings are written next to the movie.
+bool StartRecording(std::string path, Error* error);
+
+/// Starts playing back a movie. The system must already be running from GetStatePath(path, start_frame).
+/// If keyframe_interval is non-zero, a keyframe state is written every keyframe_interval frames.
+bool StartPlayback(std::string path, u32 start_frame, u32 keyframe_interval, Error* error);
+
+/// Stops recording or playback, finalizing the movie file if recording.
+void Stop();
+
+bool IsActive();
+bool IsRecording();
+bool IsPlaying();
+
+/// Returns the length of the movie in frames, or the number of frames recorded so far.
+u32 GetFrameCount();
+
+/// Returns the current frame, relative to the start of the movie.
+u32 GetCurrentFrame();
+
+/// Returns the path of the settings file for a movie.
+std::string GetSettingsPath(std::string_view path);
+
+/// Returns the path of the state which playback starting at the specified frame boots from.
+/// Frame zero is the state the recording started from, other frames are keyframes written during playback.
+std::string GetStatePath(std::string_view path, u32 frame);
+
+/// Called when the host changes a controller binding. Returns false if the change should be ignored.
+bool OnBindStateChanged(u32 slot, u32 bind_index, float value);
+
+/// Called at the end of each frame, after input has been polled.
+void FrameDone();
+
+/// A controller binding change, as stored in the movie file.
+#pragma pack(push, 1)
+struct FileEvent
+{
+  u32 frame;
+  u8 slot;
+  u8 reserved;
+  u16 bind_index;
+  float value;
+};
+#pragma pack(pop)
+
+/// Writes the file header, leaving the file positioned at the end so that events can be appended after it.
+bool WriteFileHeader(std::FILE* fp, u32 start_frame, u32 frame_count, u32 event_count, Error* error);
+
+/// Appends an event to a movie file.
+bool WriteFileEvent(std::FILE* fp, const FileEvent& ev, Error* error);
+
+/// Reads a whole movie file. Fails if the file does not hold as many events as its header claims, or if the events
+/// are not in frame order within the movie.
+bool ReadFile(const char* path, u32* start_frame, u32* frame_count, std::vector<FileEvent>* events, Error* error);
+
+} // namespace InputMovie
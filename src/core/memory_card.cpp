@@ -8,18 +8,187 @@
 #include "util/imgui_manager.h"
 #include "util/state_wrapper.h"
 
+#include "common/assert.h"
 #include "common/bitutils.h"
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include "IconsFontAwesome5.h"
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 Log_SetChannel(MemoryCard);
 
+namespace {
+
+/// Writes memory card images on a background thread, so that saves don't stall the CPU thread. The thread lives
+/// from construction until destruction, any saves still queued at that point are written before it exits.
+class MemoryCardWriter
+{
+public:
+  MemoryCardWriter();
+  ~MemoryCardWriter();
+
+  /// Snapshots the card data and queues it for writing. If a save for the same file is still waiting in the queue,
+  /// it is replaced with the new data instead of writing the file twice.
+  void QueueSave(const std::string& filename, const MemoryCardImage::DataArray& data, bool display_osd_message);
+
+  /// Blocks until any queued or in-progress save for the file has completed.
+  void WaitForFile(const std::string& filename);
+
+  bool IsSaving(const std::string& filename);
+
+private:
+  struct Request
+  {
+    std::string filename;
+    std::unique_ptr<MemoryCardImage::DataArray> data;
+    bool display_osd_message;
+  };
+
+  bool IsQueuedOrActive(const std::string& filename) const;
+
+  void WorkerThread();
+  void WriteRequest(Request& req);
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  std::deque<Request> m_queue;
+  std::string m_active_filename;
+  std::thread m_thread;
+  bool m_shutdown = false;
+};
+
+} // namespace
+
+/// Shows the outcome of a save on screen.
+static void DisplaySaveResult(const std::string& filename, bool result, const Error& error);
+
+static std::unique_ptr<MemoryCardWriter> s_writer;
+
+MemoryCardWriter::MemoryCardWriter()
+{
+  m_thread = std::thread(&MemoryCardWriter::WorkerThread, this);
+}
+
+MemoryCardWriter::~MemoryCardWriter()
+{
+  // Anything still queued gets written before the thread exits.
+  std::unique_lock lock(m_mutex);
+  m_shutdown = true;
+  m_work_cv.notify_one();
+  lock.unlock();
+  m_thread.join();
+}
+
+void MemoryCardWriter::QueueSave(const std::string& filename, const MemoryCardImage::DataArray& data,
+                                 bool display_osd_message)
+{
+  std::unique_lock lock(m_mutex);
+
+  for (Request& req : m_queue)
+  {
+    if (req.filename == filename)
+    {
+      DEV_LOG("Coalescing memory card save to {}", Path::GetFileName(filename));
+      std::memcpy(req.data->data(), data.data(), data.size());
+      req.display_osd_message |= display_osd_message;
+      return;
+    }
+  }
+
+  Request& req = m_queue.emplace_back();
+  req.filename = filename;
+  req.data = std::make_unique<MemoryCardImage::DataArray>(data);
+  req.display_osd_message = display_osd_message;
+  m_work_cv.notify_one();
+}
+
+bool MemoryCardWriter::IsQueuedOrActive(const std::string& filename) const
+{
+  return (m_active_filename == filename ||
+          std::any_of(m_queue.begin(), m_queue.end(), [&filename](const Request& req) { return req.filename == filename; }));
+}
+
+void MemoryCardWriter::WaitForFile(const std::string& filename)
+{
+  std::unique_lock lock(m_mutex);
+  m_done_cv.wait(lock, [this, &filename]() { return !IsQueuedOrActive(filename); });
+}
+
+bool MemoryCardWriter::IsSaving(const std::string& filename)
+{
+  std::unique_lock lock(m_mutex);
+  return IsQueuedOrActive(filename);
+}
+
+void MemoryCardWriter::WorkerThread()
+{
+  Threading::SetNameOfCurrentThread("Memory Card Writer");
+
+  std::unique_lock lock(m_mutex);
+  for (;;)
+  {
+    m_work_cv.wait(lock, [this]() { return (!m_queue.empty() || m_shutdown); });
+    if (m_queue.empty())
+      break;
+
+    Request req = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_active_filename = req.filename;
+    lock.unlock();
+
+    WriteRequest(req);
+
+    lock.lock();
+    m_active_filename = {};
+    m_done_cv.notify_all();
+  }
+}
+
+void MemoryCardWriter::WriteRequest(Request& req)
+{
+  INFO_LOG("Saving memory card to {}...", Path::GetFileTitle(req.filename));
+
+  // Always rewrite the whole card through the atomic path, so a crash or power loss mid-save can't leave a card
+  // that is half old and half new.
+  Error error;
+  const bool result = MemoryCardImage::SaveToFile(*req.data, req.filename.c_str(), &error);
+  if (req.display_osd_message)
+    DisplaySaveResult(req.filename, result, error);
+}
+
+static void DisplaySaveResult(const std::string& filename, bool result, const Error& error)
+{
+  std::string osd_key = fmt::format("memory_card_save_{}", filename);
+  const std::string display_name = FileSystem::GetDisplayNameFromPath(filename);
+  if (!result)
+  {
+    Host::AddIconOSDMessage(std::move(osd_key), ICON_FA_SD_CARD,
+                            fmt::format(TRANSLATE_FS("MemoryCard", "Failed to save memory card to '{}': {}"),
+                                        Path::GetFileName(display_name), error.GetDescription()),
+                            Host::OSD_ERROR_DURATION);
+  }
+  else
+  {
+    Host::AddIconOSDMessage(
+      std::move(osd_key), ICON_FA_SD_CARD,
+      fmt::format(TRANSLATE_FS("MemoryCard", "Saved memory card to '{}'."), Path::GetFileName(display_name)),
+      Host::OSD_QUICK_DURATION);
+  }
+}
+
 MemoryCard::MemoryCard()
   : m_save_event(
       "Memory Card Host Flush", GetSaveDelayInTicks(), GetSaveDelayInTicks(),
@@ -32,6 +201,10 @@ MemoryCard::MemoryCard()
 MemoryCard::~MemoryCard()
 {
   SaveIfChanged(false);
+
+  // Make sure the file is complete before anything else tries to open it.
+  if (!m_filename.empty() && s_writer)
+    s_writer->WaitForFile(m_filename);
 }
 
 TickCount MemoryCard::GetSaveDelayInTicks()
@@ -283,7 +456,20 @@ bool MemoryCard::Transfer(const u8 data_in, u8* data_out)
 
 bool MemoryCard::IsOrWasRecentlyWriting() const
 {
-  return (m_state == State::WriteData || m_save_event.IsActive());
+  return (m_state == State::WriteData || m_save_event.IsActive() ||
+          (!m_filename.empty() && s_writer && s_writer->IsSaving(m_filename)));
+}
+
+void MemoryCard::StartWriterThread()
+{
+  DebugAssert(!s_writer);
+  s_writer = std::make_unique<MemoryCardWriter>();
+}
+
+void MemoryCard::StopWriterThread()
+{
+  // Flushes any saves which are still queued.
+  s_writer.reset();
 }
 
 std::unique_ptr<MemoryCard> MemoryCard::Create()
@@ -298,6 +484,10 @@ std::unique_ptr<MemoryCard> MemoryCard::Open(std::string_view filename)
   std::unique_ptr<MemoryCard> mc = std::make_unique<MemoryCard>();
   mc->m_filename = filename;
 
+  // Another card instance may still be flushing this file.
+  if (s_writer)
+    s_writer->WaitForFile(mc->m_filename);
+
   Error error;
   if (!FileSystem::FileExists(mc->m_filename.c_str())) [[unlikely]]
   {
@@ -326,51 +516,30 @@ void MemoryCard::Format()
   m_changed = true;
 }
 
-bool MemoryCard::SaveIfChanged(bool display_osd_message)
+void MemoryCard::SaveIfChanged(bool display_osd_message)
 {
   m_save_event.Deactivate();
 
   if (!m_changed)
-    return true;
+    return;
 
   m_changed = false;
 
   if (m_filename.empty())
-    return false;
-
-  std::string osd_key;
-  std::string display_name;
-  if (display_osd_message)
-  {
-    osd_key = fmt::format("memory_card_save_{}", m_filename);
-    display_name = FileSystem::GetDisplayNameFromPath(m_filename);
-  }
-
-  INFO_LOG("Saving memory card to {}...", Path::GetFileTitle(m_filename));
+    return;
 
-  Error error;
-  if (!MemoryCardImage::SaveToFile(m_data, m_filename.c_str(), &error))
+  if (!s_writer) [[unlikely]]
   {
+    // No system to run the writer for, so there's nothing to stall either.
+    WARNING_LOG("Memory card writer is not running, saving {} synchronously.", Path::GetFileName(m_filename));
+    Error error;
+    const bool result = MemoryCardImage::SaveToFile(m_data, m_filename.c_str(), &error);
     if (display_osd_message)
-    {
-      Host::AddIconOSDMessage(std::move(osd_key), ICON_FA_SD_CARD,
-                              fmt::format(TRANSLATE_FS("MemoryCard", "Failed to save memory card to '{}': {}"),
-                                          Path::GetFileName(display_name), error.GetDescription()),
-                              Host::OSD_ERROR_DURATION);
-    }
-
-    return false;
-  }
-
-  if (display_osd_message)
-  {
-    Host::AddIconOSDMessage(
-      std::move(osd_key), ICON_FA_SD_CARD,
-      fmt::format(TRANSLATE_FS("MemoryCard", "Saved memory card to '{}'."), Path::GetFileName(display_name)),
-      Host::OSD_QUICK_DURATION);
+      DisplaySaveResult(m_filename, result, error);
+    return;
   }
 
-  return true;
+  s_writer->QueueSave(m_filename, m_data, display_osd_message);
 }
 
 void MemoryCard::QueueFileSave()
@@ -22,6 +22,10 @@ public:
 
   static constexpr u32 STATE_SIZE = 1 + 1 + 2 + 1 + 1 + 1 + MemoryCardImage::DATA_SIZE + 1;
 
+  /// Starts/stops the thread which writes card images to disk. Stopping waits for all queued saves to complete.
+  static void StartWriterThread();
+  static void StopWriterThread();
+
   static std::unique_ptr<MemoryCard> Create();
   static std::unique_ptr<MemoryCard> Open(std::string_view filename);
 
@@ -95,7 +99,7 @@ private:
 
   static TickCount GetSaveDelayInTicks();
 
-  bool SaveIfChanged(bool display_osd_message);
+  void SaveIfChanged(bool display_osd_message);
   void QueueFileSave();
 
   State m_state = State::Idle;
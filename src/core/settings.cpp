@@ -147,6 +147,8 @@ void Settings::Load(SettingsInterface& si, SettingsInterface& controller_si)
   emulation_speed = si.GetFloatValue("Main", "EmulationSpeed", 1.0f);
   fast_forward_speed = si.GetFloatValue("Main", "FastForwardSpeed", 0.0f);
   turbo_speed = si.GetFloatValue("Main", "TurboSpeed", 0.0f);
+  fast_forward_frame_skip = static_cast<u8>(
+    std::min<u32>(si.GetUIntValue("Main", "FastForwardFrameSkip", 0u), MAX_FAST_FORWARD_FRAME_SKIP));
   sync_to_host_refresh_rate = si.GetBoolValue("Main", "SyncToHostRefreshRate", false);
   increase_timer_resolution = si.GetBoolValue("Main", "IncreaseTimerResolution", true);
   inhibit_screensaver = si.GetBoolValue("Main", "InhibitScreensaver", true);
@@ -194,6 +196,7 @@ void Settings::Load(SettingsInterface& si, SettingsInterface& controller_si)
   gpu_multisamples = static_cast<u8>(si.GetIntValue("GPU", "Multisamples", 1));
   gpu_use_debug_device = si.GetBoolValue("GPU", "UseDebugDevice", false);
   gpu_disable_shader_cache = si.GetBoolValue("GPU", "DisableShaderCache", false);
+  gpu_preload_shader_cache = si.GetBoolValue("GPU", "PreloadShaderCache", false);
   gpu_disable_dual_source_blend = si.GetBoolValue("GPU", "DisableDualSourceBlend", false);
   gpu_disable_framebuffer_fetch = si.GetBoolValue("GPU", "DisableFramebufferFetch", false);
   gpu_disable_texture_buffers = si.GetBoolValue("GPU", "DisableTextureBuffers", false);
@@ -202,6 +205,7 @@ void Settings::Load(SettingsInterface& si, SettingsInterface& controller_si)
   gpu_disable_raster_order_views = si.GetBoolValue("GPU", "DisableRasterOrderViews", false);
   gpu_per_sample_shading = si.GetBoolValue("GPU", "PerSampleShading", false);
   gpu_use_thread = si.GetBoolValue("GPU", "UseThread", true);
+  gpu_threaded_presentation = si.GetBoolValue("GPU", "ThreadedPresentation", false);
   gpu_use_software_renderer_for_readbacks = si.GetBoolValue("GPU", "UseSoftwareRendererForReadbacks", false);
   gpu_true_color = si.GetBoolValue("GPU", "TrueColor", true);
   gpu_debanding = si.GetBoolValue("GPU", "Debanding", false);
@@ -425,6 +429,7 @@ void Settings::Load(SettingsInterface& si, SettingsInterface& controller_si)
   log_to_debug = si.GetBoolValue("Logging", "LogToDebug", false);
   log_to_window = si.GetBoolValue("Logging", "LogToWindow", false);
   log_to_file = si.GetBoolValue("Logging", "LogToFile", false);
+  log_async = si.GetBoolValue("Logging", "LogAsync", false);
 
   debugging.show_vram = si.GetBoolValue("Debug", "ShowVRAM");
   debugging.dump_cpu_to_vram_copies = si.GetBoolValue("Debug", "DumpCPUToVRAMCopies");
@@ -464,6 +469,7 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetFloatValue("Main", "EmulationSpeed", emulation_speed);
   si.SetFloatValue("Main", "FastForwardSpeed", fast_forward_speed);
   si.SetFloatValue("Main", "TurboSpeed", turbo_speed);
+  si.SetUIntValue("Main", "FastForwardFrameSkip", fast_forward_frame_skip);
 
   if (!ignore_base)
   {
@@ -510,6 +516,7 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   {
     si.SetBoolValue("GPU", "UseDebugDevice", gpu_use_debug_device);
     si.SetBoolValue("GPU", "DisableShaderCache", gpu_disable_shader_cache);
+    si.SetBoolValue("GPU", "PreloadShaderCache", gpu_preload_shader_cache);
     si.SetBoolValue("GPU", "DisableDualSourceBlend", gpu_disable_dual_source_blend);
     si.SetBoolValue("GPU", "DisableFramebufferFetch", gpu_disable_framebuffer_fetch);
     si.SetBoolValue("GPU", "DisableTextureBuffers", gpu_disable_texture_buffers);
@@ -520,6 +527,7 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
 
   si.SetBoolValue("GPU", "PerSampleShading", gpu_per_sample_shading);
   si.SetBoolValue("GPU", "UseThread", gpu_use_thread);
+  si.SetBoolValue("GPU", "ThreadedPresentation", gpu_threaded_presentation);
   si.SetBoolValue("GPU", "UseSoftwareRendererForReadbacks", gpu_use_software_renderer_for_readbacks);
   si.SetBoolValue("GPU", "TrueColor", gpu_true_color);
   si.SetBoolValue("GPU", "Debanding", gpu_debanding);
@@ -674,6 +682,7 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
     si.SetBoolValue("Logging", "LogToDebug", log_to_debug);
     si.SetBoolValue("Logging", "LogToWindow", log_to_window);
     si.SetBoolValue("Logging", "LogToFile", log_to_file);
+    si.SetBoolValue("Logging", "LogAsync", log_async);
 
     si.SetBoolValue("Debug", "ShowVRAM", debugging.show_vram);
     si.SetBoolValue("Debug", "DumpCPUToVRAMCopies", debugging.dump_cpu_to_vram_copies);
@@ -867,6 +876,7 @@ void Settings::UpdateLogSettings()
   Log::SetLogFilter(log_filter);
   Log::SetConsoleOutputParams(log_to_console, log_timestamps);
   Log::SetDebugOutputParams(log_to_debug);
+  Log::SetAsyncLogging(log_async);
 
   if (log_to_file)
   {
@@ -76,6 +76,7 @@ struct Settings
   float emulation_speed = 1.0f;
   float fast_forward_speed = 0.0f;
   float turbo_speed = 0.0f;
+  u8 fast_forward_frame_skip = 0;
   bool sync_to_host_refresh_rate : 1 = false;
   bool increase_timer_resolution : 1 = true;
   bool inhibit_screensaver : 1 = true;
@@ -105,9 +106,11 @@ struct Settings
   u8 gpu_resolution_scale = 1;
   u8 gpu_multisamples = 1;
   bool gpu_use_thread : 1 = true;
+  bool gpu_threaded_presentation : 1 = false;
   bool gpu_use_software_renderer_for_readbacks : 1 = false;
   bool gpu_use_debug_device : 1 = false;
   bool gpu_disable_shader_cache : 1 = false;
+  bool gpu_preload_shader_cache : 1 = false;
   bool gpu_disable_dual_source_blend : 1 = false;
   bool gpu_disable_framebuffer_fetch : 1 = false;
   bool gpu_disable_texture_buffers : 1 = false;
@@ -280,6 +283,7 @@ struct Settings
   bool log_to_debug : 1 = false;
   bool log_to_window : 1 = false;
   bool log_to_file : 1 = false;
+  bool log_async : 1 = false;
 
   ALWAYS_INLINE bool IsUsingSoftwareRenderer() const { return (gpu_renderer == GPURenderer::Software); }
   ALWAYS_INLINE bool IsUsingAccurateBlending() const { return (gpu_accurate_blending && !gpu_true_color); }
@@ -501,6 +505,7 @@ struct Settings
   static constexpr DisplayScreenshotFormat DEFAULT_DISPLAY_SCREENSHOT_FORMAT = DisplayScreenshotFormat::PNG;
   static constexpr u8 DEFAULT_DISPLAY_SCREENSHOT_QUALITY = 85;
   static constexpr float DEFAULT_DISPLAY_PRE_FRAME_SLEEP_BUFFER = 2.0f;
+  static constexpr u8 MAX_FAST_FORWARD_FRAME_SKIP = 9;
   static constexpr float DEFAULT_OSD_SCALE = 100.0f;
 
   static constexpr u8 DEFAULT_CDROM_READAHEAD_SECTORS = 8;
@@ -24,6 +24,7 @@
 #include "common/path.h"
 
 #include "fmt/format.h"
+#include "xxhash.h"
 
 #include <memory>
 
@@ -420,6 +421,8 @@ struct SPUState
   s32 last_reverb_output[2];
   bool audio_output_muted = false;
 
+  XXH64_state_t* output_hash_state = nullptr;
+
 #ifdef SPU_DUMP_ALL_VOICES
   // +1 for reverb output
   std::array<std::unique_ptr<WAVWriter>, NUM_VOICES + 1> s_voice_dump_writers;
@@ -522,6 +525,7 @@ void SPU::Shutdown()
   s_state.tick_event.Deactivate();
   s_state.transfer_event.Deactivate();
   s_state.audio_stream.reset();
+  SetOutputHashEnabled(false);
 }
 
 void SPU::Reset()
@@ -1646,6 +1650,28 @@ AudioStream* SPU::GetOutputStream()
   return s_state.audio_stream.get();
 }
 
+void SPU::SetOutputHashEnabled(bool enabled)
+{
+  if (enabled == (s_state.output_hash_state != nullptr))
+    return;
+
+  if (enabled)
+  {
+    s_state.output_hash_state = XXH64_createState();
+    XXH64_reset(s_state.output_hash_state, 0);
+  }
+  else
+  {
+    XXH64_freeState(s_state.output_hash_state);
+    s_state.output_hash_state = nullptr;
+  }
+}
+
+u64 SPU::GetOutputHash()
+{
+  return s_state.output_hash_state ? XXH64_digest(s_state.output_hash_state) : 0;
+}
+
 void SPU::Voice::KeyOn()
 {
   current_address = regs.adpcm_start_address & ~u16(1);
@@ -2476,6 +2502,10 @@ void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
     }
 #endif
 
+    // Frames which are replayed for runahead go to the muted stream, and are not part of the output.
+    if (s_state.output_hash_state && !s_state.audio_output_muted) [[unlikely]]
+      XXH64_update(s_state.output_hash_state, output_frame_start, frames_in_this_batch * 2 * sizeof(s16));
+
     output_stream->EndWrite(frames_in_this_batch);
     remaining_frames -= frames_in_this_batch;
   }
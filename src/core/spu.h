@@ -50,4 +50,8 @@ void SetAudioOutputMuted(bool muted);
 AudioStream* GetOutputStream();
 void RecreateOutputStream();
 
+/// Keeps a running digest of every sample sent to the output stream, for comparing audio between runs.
+void SetOutputHashEnabled(bool enabled);
+u64 GetOutputHash();
+
 }; // namespace SPU
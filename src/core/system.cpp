@@ -20,6 +20,7 @@
 #include "host.h"
 #include "host_interface_progress_callback.h"
 #include "imgui_overlays.h"
+#include "input_movie.h"
 #include "interrupt_controller.h"
 #include "mdec.h"
 #include "memory_card.h"
@@ -270,7 +271,10 @@ static bool s_can_sync_to_host = false;
 static bool s_syncing_to_host = false;
 static bool s_syncing_to_host_with_vsync = false;
 static bool s_skip_presenting_duplicate_frames = false;
+static bool s_skipping_frame_draws = false;
 static u32 s_skipped_frame_count = 0;
+static u32 s_frame_skip_interval = 0;
+static u32 s_frame_skip_counter = 0;
 static u32 s_last_presented_internal_frame_number = 0;
 
 static float s_throttle_frequency = 0.0f;
@@ -329,6 +333,7 @@ static s32 s_rewind_save_counter = -1;
 static bool s_rewinding_first_save = false;
 
 static std::deque<System::MemorySaveState> s_runahead_states;
+static std::vector<System::MemorySaveState> s_runahead_spare_states;
 static bool s_runahead_replay_pending = false;
 static u32 s_runahead_frames = 0;
 static u32 s_runahead_replay_frames = 0;
@@ -1362,6 +1367,8 @@ void System::SetDefaultSettings(SettingsInterface& si)
   si.SetStringValue("MediaCapture", "VideoCodec", "");
   si.SetBoolValue("MediaCapture", "VideoCodecUseArgs", false);
   si.SetStringValue("MediaCapture", "AudioCodecArgs", "");
+  si.SetBoolValue("MediaCapture", "VideoGPUConversion", false);
+  si.SetUIntValue("MediaCapture", "VideoFramesInFlight", MediaCapture::DEFAULT_VIDEO_FRAMES_IN_FLIGHT);
   si.SetBoolValue("MediaCapture", "AudioCapture", true);
   si.SetUIntValue("MediaCapture", "AudioBitrate", Settings::DEFAULT_MEDIA_CAPTURE_AUDIO_BITRATE);
   si.SetStringValue("MediaCapture", "AudioCodec", "");
@@ -1476,6 +1483,8 @@ void System::ResetSystem()
   if (!Achievements::ConfirmSystemReset())
     return;
 
+  InputMovie::Stop();
+
   if (Achievements::ResetHardcoreMode(false))
   {
     // Make sure a pre-existing cheat file hasn't been loaded when resetting
@@ -1842,6 +1851,9 @@ bool System::Initialize(bool force_software_renderer, Error* error)
   s_next_frame_time = 0;
   s_turbo_enabled = false;
   s_fast_forward_enabled = false;
+  s_skipping_frame_draws = false;
+  s_frame_skip_interval = 0;
+  s_frame_skip_counter = 0;
 
   s_rewind_load_frequency = -1;
   s_rewind_load_counter = -1;
@@ -1909,6 +1921,7 @@ bool System::Initialize(bool force_software_renderer, Error* error)
 
   DMA::Initialize();
   CDROM::Initialize();
+  MemoryCard::StartWriterThread();
   Pad::Initialize();
   Timers::Initialize();
   SPU::Initialize();
@@ -1933,6 +1946,8 @@ void System::DestroySystem()
   if (s_media_capture)
     StopMediaCapture();
 
+  InputMovie::Stop();
+
   s_undo_load_state.reset();
 
 #ifdef ENABLE_GDB_SERVER
@@ -1967,6 +1982,7 @@ void System::DestroySystem()
   SPU::Shutdown();
   Timers::Shutdown();
   Pad::Shutdown();
+  MemoryCard::StopWriterThread();
   CDROM::Shutdown();
   g_gpu.reset();
   DMA::Shutdown();
@@ -2161,7 +2177,7 @@ void System::FrameDone()
                                   s_skipped_frame_count < MAX_SKIPPED_DUPLICATE_FRAME_COUNT) ||
                                  (!s_optimal_frame_pacing && current_time > s_next_frame_time &&
                                   s_skipped_frame_count < MAX_SKIPPED_TIMEOUT_FRAME_COUNT) ||
-                                 g_gpu_device->ShouldSkipPresentingFrame()) &&
+                                 s_skipping_frame_draws || g_gpu_device->ShouldSkipPresentingFrame()) &&
                                 !s_syncing_to_host_with_vsync && !IsExecutionInterrupted());
   if (!skip_this_frame)
   {
@@ -2200,6 +2216,14 @@ void System::FrameDone()
       Throttle(current_time);
   }
 
+  // Fast forward frame skip, only the last of every (interval + 1) frames is drawn. Media capture needs every frame.
+  if (s_frame_skip_interval > 0)
+  {
+    s_frame_skip_counter = (s_frame_skip_counter + 1) % (s_frame_skip_interval + 1);
+    s_skipping_frame_draws = (s_frame_skip_counter != s_frame_skip_interval && !s_media_capture);
+    g_gpu->SetDrawsSkipped(s_skipping_frame_draws);
+  }
+
   // pre-frame sleep (input lag reduction)
   current_time = Common::Timer::GetCurrentValue();
   if (s_pre_frame_sleep)
@@ -2220,6 +2244,10 @@ void System::FrameDone()
   {
     Host::PumpMessagesOnCPUThread();
     InputManager::PollSources();
+
+    if (InputMovie::IsActive()) [[unlikely]]
+      InputMovie::FrameDone();
+
     CheckForAndExitExecution();
   }
 
@@ -2413,20 +2441,16 @@ bool System::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_di
   if (!sw.DoMarker("CPU") || !CPU::DoState(sw))
     return false;
 
-  if (sw.IsReading())
-  {
-    if (is_memory_state)
-      CPU::CodeCache::InvalidateAllRAMBlocks();
-    else
-      CPU::CodeCache::Reset();
-  }
+  // Memory states only invalidate the blocks in RAM pages which change, in Bus::DoState().
+  if (sw.IsReading() && !is_memory_state)
+    CPU::CodeCache::Reset();
 
   // only reset pgxp if we're not runahead-rollbacking. the value checks will save us from broken rendering, and it
   // saves using imprecise values for a frame in 30fps games.
   if (sw.IsReading() && g_settings.gpu_pgxp_enable && !is_memory_state)
     CPU::PGXP::Reset();
 
-  if (!sw.DoMarker("Bus") || !Bus::DoState(sw))
+  if (!sw.DoMarker("Bus") || !Bus::DoState(sw, is_memory_state))
     return false;
 
   if (!sw.DoMarker("DMA") || !DMA::DoState(sw))
@@ -2621,6 +2645,9 @@ bool System::LoadState(const char* path, Error* error, bool save_undo_state)
     return true;
   }
 
+  // Inputs in the movie only make sense from the state it was recorded from.
+  InputMovie::Stop();
+
   Common::Timer load_timer;
 
   auto fp = FileSystem::OpenManagedCFile(path, "rb", error);
@@ -3056,6 +3083,28 @@ bool System::SaveStateToBuffer(SaveStateBuffer* buffer, Error* error, u32 screen
   return true;
 }
 
+bool System::SaveStateToMemory(DynamicHeapArray<u8>* data, Error* error)
+{
+  if (IsShutdown()) [[unlikely]]
+  {
+    Error::SetStringView(error, "System is invalid.");
+    return false;
+  }
+
+  data->resize(GetMaxSaveStateSize());
+
+  g_gpu->RestoreDeviceContext();
+  StateWrapper sw(data->span(), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
+  if (!DoState(sw, nullptr, false, false))
+  {
+    Error::SetStringView(error, "DoState() failed");
+    return false;
+  }
+
+  data->resize(sw.GetPosition());
+  return true;
+}
+
 bool System::SaveStateBufferToFile(const SaveStateBuffer& buffer, std::FILE* fp, Error* error,
                                    SaveStateCompressionMode compression)
 {
@@ -3367,6 +3416,15 @@ void System::UpdateSpeedLimiterState()
   s_throttler_enabled = (s_target_speed != 0.0f);
   s_optimal_frame_pacing = (s_throttler_enabled && g_settings.display_optimal_frame_pacing);
   s_skip_presenting_duplicate_frames = s_throttler_enabled && g_settings.display_skip_presenting_duplicate_frames;
+
+  // Only skip drawing frames while fast forwarding, where the GPU could otherwise be the bottleneck.
+  s_frame_skip_interval = (s_fast_forward_enabled || s_turbo_enabled) ? g_settings.fast_forward_frame_skip : 0;
+  s_frame_skip_counter = 0;
+  if (s_frame_skip_interval == 0 && s_skipping_frame_draws)
+  {
+    s_skipping_frame_draws = false;
+    g_gpu->SetDrawsSkipped(false);
+  }
   s_pre_frame_sleep = s_optimal_frame_pacing && g_settings.display_pre_frame_sleep;
   s_can_sync_to_host = false;
   s_syncing_to_host = false;
@@ -3612,6 +3670,18 @@ Controller* System::GetController(u32 slot)
   return Pad::GetController(slot);
 }
 
+void System::SetControllerBindState(u32 slot, u32 bind_index, float value)
+{
+  Controller* const controller = Pad::GetController(slot);
+  if (!controller)
+    return;
+
+  if (InputMovie::IsActive() && !InputMovie::OnBindStateChanged(slot, bind_index, value)) [[unlikely]]
+    return;
+
+  controller->SetBindState(bind_index, value);
+}
+
 void System::UpdateControllers()
 {
   auto lock = Host::GetSettingsLock();
@@ -4353,6 +4423,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         g_settings.gpu_multisamples != old_settings.gpu_multisamples ||
         g_settings.gpu_per_sample_shading != old_settings.gpu_per_sample_shading ||
         g_settings.gpu_use_thread != old_settings.gpu_use_thread ||
+        g_settings.gpu_threaded_presentation != old_settings.gpu_threaded_presentation ||
         g_settings.gpu_use_software_renderer_for_readbacks != old_settings.gpu_use_software_renderer_for_readbacks ||
         g_settings.gpu_fifo_size != old_settings.gpu_fifo_size ||
         g_settings.gpu_max_run_ahead != old_settings.gpu_max_run_ahead ||
@@ -4445,6 +4516,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         g_settings.increase_timer_resolution != old_settings.increase_timer_resolution ||
         g_settings.emulation_speed != old_settings.emulation_speed ||
         g_settings.fast_forward_speed != old_settings.fast_forward_speed ||
+        g_settings.fast_forward_frame_skip != old_settings.fast_forward_frame_skip ||
         g_settings.display_optimal_frame_pacing != old_settings.display_optimal_frame_pacing ||
         g_settings.display_skip_presenting_duplicate_frames != old_settings.display_skip_presenting_duplicate_frames ||
         g_settings.display_pre_frame_sleep != old_settings.display_pre_frame_sleep ||
@@ -4553,7 +4625,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
       g_settings.log_timestamps != old_settings.log_timestamps ||
       g_settings.log_to_console != old_settings.log_to_console ||
       g_settings.log_to_debug != old_settings.log_to_debug || g_settings.log_to_window != old_settings.log_to_window ||
-      g_settings.log_to_file != old_settings.log_to_file)
+      g_settings.log_to_file != old_settings.log_to_file || g_settings.log_async != old_settings.log_async)
   {
     g_settings.UpdateLogSettings();
   }
@@ -4726,6 +4798,7 @@ void System::ClearMemorySaveStates()
 {
   s_rewind_states.clear();
   s_runahead_states.clear();
+  s_runahead_spare_states.clear();
 }
 
 void System::UpdateMemorySaveStateSettings()
@@ -4757,7 +4830,10 @@ void System::UpdateMemorySaveStateSettings()
   s_runahead_frames = g_settings.runahead_frames;
   s_runahead_replay_pending = false;
   if (s_runahead_frames > 0)
+  {
     INFO_LOG("Runahead is active with {} frames", s_runahead_frames);
+    InputMovie::Stop();
+  }
 }
 
 bool System::LoadMemoryState(const MemorySaveState& mss)
@@ -4862,6 +4938,8 @@ void System::SetRewinding(bool enabled)
 {
   if (enabled)
   {
+    InputMovie::Stop();
+
     const bool was_enabled = IsRewinding();
 
     // Try to rewind at the replay speed, or one per second maximum.
@@ -4904,12 +4982,20 @@ void System::DoRewind()
 
 void System::SaveRunaheadState()
 {
-  // try to reuse the frontmost slot
+  // try to reuse the frontmost slot, or one left over from the last replay, so the buffers aren't reallocated
   MemorySaveState mss;
-  while (s_runahead_states.size() >= s_runahead_frames)
+  if (s_runahead_states.size() >= s_runahead_frames)
+  {
+    while (s_runahead_states.size() >= s_runahead_frames)
+    {
+      mss = std::move(s_runahead_states.front());
+      s_runahead_states.pop_front();
+    }
+  }
+  else if (!s_runahead_spare_states.empty())
   {
-    mss = std::move(s_runahead_states.front());
-    s_runahead_states.pop_front();
+    mss = std::move(s_runahead_spare_states.back());
+    s_runahead_spare_states.pop_back();
   }
 
   if (!SaveMemoryState(&mss))
@@ -4945,7 +5031,10 @@ bool System::DoRunahead()
     // figure out how many frames we need to run to catch up
     s_runahead_replay_frames = static_cast<u32>(s_runahead_states.size());
 
-    // and throw away all the states, forcing us to catch up below
+    // and throw away all the states, forcing us to catch up below. keep the buffers and textures for the new saves,
+    // since reallocating them on every input change causes hitches, especially with large VRAM textures.
+    for (MemorySaveState& mss : s_runahead_states)
+      s_runahead_spare_states.push_back(std::move(mss));
     s_runahead_states.clear();
 
     // run the frames with no audio
@@ -4988,6 +5077,12 @@ bool System::DoRunahead()
   return false;
 }
 
+bool System::IsReplayingHiddenRunaheadFrame()
+{
+  // The last frame of the replay is the one which gets presented.
+  return (s_runahead_replay_frames > 1);
+}
+
 void System::SetRunaheadReplayFlag()
 {
   if (s_runahead_frames == 0 || s_runahead_states.empty())
@@ -5230,6 +5325,8 @@ bool System::StartMediaCapture(std::string path, bool capture_video, bool captur
         Host::GetBoolSettingValue("MediaCapture", "VideoCodecUseArgs", false) ?
           Host::GetStringSettingValue("MediaCapture", "AudioCodecArgs") :
           std::string(),
+        Host::GetBoolSettingValue("MediaCapture", "VideoGPUConversion", false),
+        Host::GetUIntSettingValue("MediaCapture", "VideoFramesInFlight", MediaCapture::DEFAULT_VIDEO_FRAMES_IN_FLIGHT),
         capture_audio, Host::GetSmallStringSettingValue("MediaCapture", "AudioCodec"),
         Host::GetUIntSettingValue("MediaCapture", "AudioBitrate", Settings::DEFAULT_MEDIA_CAPTURE_AUDIO_BITRATE),
         Host::GetBoolSettingValue("MediaCapture", "AudioCodecUseArgs", false) ?
@@ -8,6 +8,8 @@
 
 #include "util/image.h"
 
+#include "common/heap_array.h"
+
 #include <memory>
 #include <optional>
 #include <string>
@@ -259,6 +261,10 @@ bool LoadState(const char* path, Error* error, bool save_undo_state);
 bool SaveState(const char* path, Error* error, bool backup_existing_save);
 bool SaveResumeState(Error* error);
 
+/// Serializes the machine state to a buffer, without compression or a screenshot. The renderer's VRAM is always read
+/// back, so the result only depends on the emulated state, and is suitable for comparing runs.
+bool SaveStateToMemory(DynamicHeapArray<u8>* data, Error* error);
+
 /// Runs the VM until the CPU execution is canceled.
 void Execute();
 
@@ -273,6 +279,11 @@ void SetThrottleFrequency(float frequency);
 
 // Access controllers for simulating input.
 Controller* GetController(u32 slot);
+
+/// Updates a binding on the controller in the specified slot on behalf of the host.
+/// Changes are recorded to, or suppressed by, an active input movie.
+void SetControllerBindState(u32 slot, u32 bind_index, float value);
+
 void UpdateMemoryCardTypes();
 bool HasMemoryCard(u32 slot);
 bool IsSavingMemoryCards();
@@ -458,6 +469,9 @@ void CalculateRewindMemoryUsage(u32 num_saves, u32 resolution_scale, u64* ram_us
 void ClearMemorySaveStates();
 void SetRunaheadReplayFlag();
 
+/// Returns true if the current frame is being replayed by runahead, and won't be displayed.
+bool IsReplayingHiddenRunaheadFrame();
+
 /// Shared socket multiplexer, used by PINE/GDB/etc.
 SocketMultiplexer* GetSocketMultiplexer();
 void ReleaseSocketMultiplexer();
@@ -172,6 +172,7 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(SettingsWindow* dialog, QWidget*
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.logToDebug, "Logging", "LogToDebug", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.logToWindow, "Logging", "LogToWindow", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.logToFile, "Logging", "LogToFile", false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.logAsync, "Logging", "LogAsync", false);
 
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.showDebugMenu, "Main", "ShowDebugMenu", false);
 
@@ -196,6 +197,10 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(SettingsWindow* dialog, QWidget*
                              tr("Logs messages to the window."));
   dialog->registerWidgetHelp(m_ui.logToFile, tr("Log To File"), tr("User Preference"),
                              tr("Logs messages to duckstation.log in the user directory."));
+  dialog->registerWidgetHelp(
+    m_ui.logAsync, tr("Asynchronous Logging"), tr("Unchecked"),
+    tr("Writes log messages on a background thread, so verbose logging has less impact on performance. Messages may "
+       "be dropped if they are logged faster than they can be written."));
   dialog->registerWidgetHelp(m_ui.showDebugMenu, tr("Show Debug Menu"), tr("Unchecked"),
                              tr("Shows a debug menu bar with additional statistics and quick settings."));
 }
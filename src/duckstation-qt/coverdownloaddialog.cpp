@@ -13,6 +13,8 @@ CoverDownloadDialog::CoverDownloadDialog(QWidget* parent /*= nullptr*/) : QDialo
   m_ui.setupUi(this);
   setWindowIcon(QtHost::GetAppIcon());
   m_ui.coverIcon->setPixmap(QIcon::fromTheme("artboard-2-line").pixmap(32));
+  m_ui.concurrentDownloads->setMaximum(static_cast<int>(GameList::MAX_CONCURRENT_COVER_DOWNLOADS));
+  m_ui.concurrentDownloads->setValue(static_cast<int>(GameList::DEFAULT_CONCURRENT_COVER_DOWNLOADS));
   updateEnabled();
 
   connect(m_ui.start, &QPushButton::clicked, this, &CoverDownloadDialog::onStartClicked);
@@ -88,11 +90,13 @@ void CoverDownloadDialog::updateEnabled()
   m_ui.start->setEnabled(running || !m_ui.urls->toPlainText().isEmpty());
   m_ui.close->setEnabled(!running);
   m_ui.urls->setEnabled(!running);
+  m_ui.concurrentDownloads->setEnabled(!running);
 }
 
 void CoverDownloadDialog::startThread()
 {
-  m_thread = std::make_unique<CoverDownloadThread>(this, m_ui.urls->toPlainText(), m_ui.useSerialFileNames->isChecked());
+  m_thread = std::make_unique<CoverDownloadThread>(this, m_ui.urls->toPlainText(), m_ui.useSerialFileNames->isChecked(),
+                                                   static_cast<u32>(m_ui.concurrentDownloads->value()));
   m_last_refresh_time.Reset();
   connect(m_thread.get(), &CoverDownloadThread::statusUpdated, this, &CoverDownloadDialog::onDownloadStatus);
   connect(m_thread.get(), &CoverDownloadThread::progressUpdated, this, &CoverDownloadDialog::onDownloadProgress);
@@ -111,8 +115,9 @@ void CoverDownloadDialog::cancelThread()
   m_thread.reset();
 }
 
-CoverDownloadDialog::CoverDownloadThread::CoverDownloadThread(QWidget* parent, const QString& urls, bool use_serials)
-  : QtAsyncProgressThread(parent), m_use_serials(use_serials)
+CoverDownloadDialog::CoverDownloadThread::CoverDownloadThread(QWidget* parent, const QString& urls, bool use_serials,
+                                                              u32 max_concurrent_downloads)
+  : QtAsyncProgressThread(parent), m_use_serials(use_serials), m_max_concurrent_downloads(max_concurrent_downloads)
 {
   for (const QString& str : urls.split(QChar('\n')))
     m_urls.push_back(str.toStdString());
@@ -122,5 +127,5 @@ CoverDownloadDialog::CoverDownloadThread::~CoverDownloadThread() = default;
 
 void CoverDownloadDialog::CoverDownloadThread::runAsync()
 {
-  GameList::DownloadCovers(m_urls, m_use_serials, this);
+  GameList::DownloadCovers(m_urls, m_use_serials, m_max_concurrent_downloads, this);
 }
\ No newline at end of file
@@ -37,7 +37,7 @@ private:
   class CoverDownloadThread : public QtAsyncProgressThread
   {
   public:
-    CoverDownloadThread(QWidget* parent, const QString& urls, bool use_serials);
+    CoverDownloadThread(QWidget* parent, const QString& urls, bool use_serials, u32 max_concurrent_downloads);
     ~CoverDownloadThread();
 
   protected:
@@ -46,6 +46,7 @@ private:
   private:
     std::vector<std::string> m_urls;
     bool m_use_serials;
+    u32 m_max_concurrent_downloads;
   };
 
   void startThread();
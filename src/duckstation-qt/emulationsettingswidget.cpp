@@ -28,6 +28,7 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
   SettingWidgetBinder::BindWidgetToFloatSetting(sif, m_ui.rewindSaveFrequency, "Main", "RewindFrequency", 10.0f);
   SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.rewindSaveSlots, "Main", "RewindSaveSlots", 10);
   SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.runaheadFrames, "Main", "RunaheadFrameCount", 0);
+  SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.fastForwardFrameSkip, "Main", "FastForwardFrameSkip", 0);
 
   const float effective_emulation_speed = m_dialog->getEffectiveFloatValue("Main", "EmulationSpeed", 1.0f);
   fillComboBoxWithEmulationSpeeds(m_ui.emulationSpeed, effective_emulation_speed);
@@ -99,6 +100,13 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
     m_ui.turboSpeed, tr("Turbo Speed"), tr("User Preference"),
     tr("Sets the turbo speed. This speed will be used when the turbo hotkey is pressed/toggled. Turboing will take "
        "priority over fast forwarding if both hotkeys are pressed/toggled."));
+  dialog->registerWidgetHelp(
+    m_ui.fastForwardFrameSkip, tr("Fast Forward Frame Skip"), tr("0 Frames"),
+    tr("Skips drawing this many frames for each frame displayed while fast forwarding or turboing. Only drawing to "
+       "the displayed area of VRAM is skipped. Off-screen drawing and VRAM transfers are still performed, so the "
+       "maximum speed is less limited by the GPU. Games which copy or read back the displayed image, e.g. for motion "
+       "blur or screen transitions, may show graphical glitches while skipping. Only applies to the hardware "
+       "renderers."));
   dialog->registerWidgetHelp(
     m_ui.vsync, tr("Vertical Sync (VSync)"), tr("Unchecked"),
     tr("Synchronizes presentation of the console's frames to the host. Enabling may result in smoother animations, at "
@@ -396,31 +396,16 @@ void GameSummaryWidget::onComputeHashClicked()
   }
 
   QtModalProgressCallback progress_callback(this);
-  progress_callback.SetProgressRange(image->GetTrackCount());
 
+  // Calculate hashes
   std::vector<CDImageHasher::Hash> track_hashes;
-  track_hashes.reserve(image->GetTrackCount());
+  const bool calculate_hash_success = CDImageHasher::GetTrackHashes(image.get(), &track_hashes, &progress_callback);
 
-  // Calculate hashes
-  bool calculate_hash_success = true;
-  for (u8 track = 1; track <= image->GetTrackCount(); track++)
+  // Show whichever tracks were hashed, even if a later track failed.
+  for (u32 i = 0; i < static_cast<u32>(track_hashes.size()); i++)
   {
-    progress_callback.SetProgressValue(track - 1);
-    progress_callback.PushState();
-
-    CDImageHasher::Hash hash;
-    if (!CDImageHasher::GetTrackHash(image.get(), track, &hash, &progress_callback))
-    {
-      progress_callback.PopState();
-      calculate_hash_success = false;
-      break;
-    }
-    track_hashes.emplace_back(hash);
-
-    QTableWidgetItem* item = m_ui.tracks->item(track - 1, 4);
-    item->setText(QString::fromStdString(CDImageHasher::HashToString(hash)));
-
-    progress_callback.PopState();
+    QTableWidgetItem* item = m_ui.tracks->item(static_cast<int>(i), 4);
+    item->setText(QString::fromStdString(CDImageHasher::HashToString(track_hashes[i])));
   }
 
   // Verify hashes against gamedb
@@ -119,6 +119,7 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
                                                &Settings::ParseDisplayRotation, &Settings::GetDisplayRotationName,
                                                Settings::DEFAULT_DISPLAY_ROTATION);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.gpuThread, "GPU", "UseThread", true);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.threadedPresentation, "GPU", "ThreadedPresentation", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.disableMailboxPresentation, "Display",
                                                "DisableMailboxPresentation", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.stretchDisplayVertically, "Display", "StretchVertically",
@@ -216,6 +217,8 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.enableVideoCaptureArguments, "MediaCapture",
                                                "VideoCodecUseArgs", false);
   SettingWidgetBinder::BindWidgetToStringSetting(sif, m_ui.videoCaptureArguments, "MediaCapture", "AudioCodecArgs");
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.videoCaptureGPUConversion, "MediaCapture",
+                                               "VideoGPUConversion", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.enableAudioCapture, "MediaCapture", "AudioCapture", true);
   SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.audioCaptureBitrate, "MediaCapture", "AudioBitrate",
                                               Settings::DEFAULT_MEDIA_CAPTURE_AUDIO_BITRATE);
@@ -259,6 +262,7 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
 
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.useDebugDevice, "GPU", "UseDebugDevice", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.disableShaderCache, "GPU", "DisableShaderCache", false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.preloadShaderCache, "GPU", "PreloadShaderCache", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.disableDualSource, "GPU", "DisableDualSourceBlend", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.disableFramebufferFetch, "GPU", "DisableFramebufferFetch",
                                                false);
@@ -376,6 +380,12 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
   dialog->registerWidgetHelp(m_ui.gpuThread, tr("Threaded Rendering"), tr("Checked"),
                              tr("Uses a second thread for drawing graphics. Currently only available for the software "
                                 "renderer, but can provide a significant speed improvement, and is safe to use."));
+  dialog->registerWidgetHelp(
+    m_ui.threadedPresentation, tr("Threaded Presentation"), tr("Unchecked"),
+    tr("Moves command buffer submission and presentation to a separate thread, so the CPU thread does not wait on the "
+       "driver at the end of each frame. Only available for the Vulkan renderer. This is experimental: whether it helps "
+       "depends on how long the driver blocks in present, it may not improve performance, and it can worsen frame "
+       "pacing on some drivers."));
   dialog->registerWidgetHelp(
     m_ui.disableMailboxPresentation, tr("Disable Mailbox Presentation"), tr("Unchecked"),
     tr("Forces the use of FIFO over Mailbox presentation, i.e. double buffering instead of triple buffering. "
@@ -533,6 +543,10 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
     m_ui.videoCaptureArguments, tr("Extra Video Arguments"), tr("Empty"),
     tr("Parameters passed to the selected video codec.<br><b>You must use '=' to separate key from value and ':' to "
        "separate two pairs from each other.</b><br>For example: \"crf = 21 : preset = veryfast\""));
+  dialog->registerWidgetHelp(
+    m_ui.videoCaptureGPUConversion, tr("Convert Colors on GPU"), tr("Unchecked"),
+    tr("Converts captured frames to YUV on the GPU before they are read back, reducing the amount of data "
+       "transferred and the CPU time spent encoding. Only used when the selected codec accepts 4:2:0 input."));
   dialog->registerWidgetHelp(
     m_ui.audioCaptureCodec, tr("Audio Codec"), tr("Default"),
     tr("Selects which Audio Codec to be used for Video Capture. <b>If unsure, leave it on default.<b>"));
@@ -576,6 +590,11 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
   dialog->registerWidgetHelp(
     m_ui.disableShaderCache, tr("Disable Shader Cache"), tr("Unchecked"),
     tr("Forces shaders to be compiled for every run of the program. <strong>Only for developer use.</strong>"));
+  dialog->registerWidgetHelp(
+    m_ui.preloadShaderCache, tr("Preload Shader Cache"), tr("Unchecked"),
+    tr("Reads and decompresses up to 32MB of cached shaders on a background thread while the renderer starts, so "
+       "compiling pipelines doesn't wait on the disk. Can shorten startup with a large cache on slow storage, at the "
+       "cost of extra memory until the shaders are used."));
   dialog->registerWidgetHelp(m_ui.disableDualSource, tr("Disable Dual-Source Blending"), tr("Unchecked"),
                              tr("Prevents dual-source blending from being used. Useful for testing broken graphics "
                                 "drivers. <strong>Only for developer use.</strong>"));
@@ -772,6 +791,7 @@ void GraphicsSettingsWidget::updateRendererDependentOptions()
 #endif
 
   m_ui.gpuThread->setEnabled(!is_hardware);
+  m_ui.threadedPresentation->setEnabled(render_api == RenderAPI::Vulkan);
 
   m_ui.exclusiveFullscreenLabel->setEnabled(render_api == RenderAPI::D3D11 || render_api == RenderAPI::D3D12 ||
                                             render_api == RenderAPI::Vulkan);
@@ -1085,6 +1105,7 @@ void GraphicsSettingsWidget::onMediaCaptureVideoEnabledChanged()
   m_ui.videoCaptureResolutionAuto->setEnabled(enabled);
   m_ui.enableVideoCaptureArguments->setEnabled(enabled);
   m_ui.videoCaptureArguments->setEnabled(enabled);
+  m_ui.videoCaptureGPUConversion->setEnabled(enabled);
   onMediaCaptureVideoAutoResolutionChanged();
 }
 
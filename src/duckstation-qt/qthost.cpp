@@ -22,6 +22,7 @@
 #include "core/host.h"
 #include "core/imgui_overlays.h"
 #include "core/memory_card.h"
+#include "core/shader_cache_version.h"
 #include "core/spu.h"
 #include "core/system.h"
 
@@ -36,6 +37,7 @@
 #include "common/string_util.h"
 
 #include "util/audio_stream.h"
+#include "util/gpu_shader_cache.h"
 #include "util/http_downloader.h"
 #include "util/imgui_fullscreen.h"
 #include "util/imgui_manager.h"
@@ -2289,6 +2291,10 @@ void QtHost::PrintCommandLineHelp(const char* progname)
   std::fprintf(stderr, "  -portable: Forces \"portable mode\", data in same directory.\n");
   std::fprintf(stderr, "  -settings <filename>: Loads a custom settings configuration from the\n"
                        "    specified filename. Default settings applied if file not found.\n");
+  std::fprintf(stderr, "  -importshadercache <filename>: Merges a shader cache bundle exported by\n"
+                       "    duckstation-regtest into the shader cache.\n");
+  std::fprintf(stderr, "  -exportshadercache <filename>: Exports the shader cache for the configured\n"
+                       "    renderer to a bundle, which can be imported on another machine.\n");
   std::fprintf(stderr, "  -earlyconsole: Creates console as early as possible, for logging.\n");
 #ifdef ENABLE_RAINTEGRATION
   std::fprintf(stderr, "  -raintegration: Use RAIntegration instead of built-in achievement support.\n");
@@ -2313,6 +2319,8 @@ bool QtHost::ParseCommandLineParametersAndInitializeConfig(QApplication& app,
   const QStringList args(app.arguments());
   std::optional<s32> state_index;
   std::string settings_filename;
+  std::string import_shader_cache_filename;
+  std::string export_shader_cache_filename;
   bool starting_bios = false;
 
   bool no_more_args = false;
@@ -2415,6 +2423,18 @@ bool QtHost::ParseCommandLineParametersAndInitializeConfig(QApplication& app,
         INFO_LOG("Command Line: Overriding settings filename: {}", settings_filename);
         continue;
       }
+      else if (CHECK_ARG_PARAM("-importshadercache"))
+      {
+        import_shader_cache_filename = args[++i].toStdString();
+        INFO_LOG("Command Line: Importing shader cache from: {}", import_shader_cache_filename);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-exportshadercache"))
+      {
+        export_shader_cache_filename = args[++i].toStdString();
+        INFO_LOG("Command Line: Exporting shader cache to: {}", export_shader_cache_filename);
+        continue;
+      }
       else if (CHECK_ARG("-bigpicture"))
       {
         INFO_LOG("Command Line: Starting big picture mode.");
@@ -2471,6 +2491,38 @@ bool QtHost::ParseCommandLineParametersAndInitializeConfig(QApplication& app,
     return false;
   }
 
+  // Import into the cache directory before any device is created, so the first boot uses it.
+  if (!import_shader_cache_filename.empty())
+  {
+    Error error;
+    if (!GPUShaderCache::ImportBundle(EmuFolders::Cache, import_shader_cache_filename.c_str(), SHADER_CACHE_VERSION,
+                                      &error))
+    {
+      ERROR_LOG("Failed to import shader cache: {}", error.GetDescription());
+    }
+  }
+
+  // Settings haven't been applied yet, so pick the cache from the base layer.
+  if (!export_shader_cache_filename.empty())
+  {
+    const GPURenderer renderer =
+      Settings::ParseRendererName(
+        Host::GetBaseStringSettingValue("GPU", "Renderer", Settings::GetRendererName(Settings::DEFAULT_GPU_RENDERER))
+          .c_str())
+        .value_or(Settings::DEFAULT_GPU_RENDERER);
+    const std::string base_filename = Path::Combine(
+      EmuFolders::Cache,
+      GPUDevice::GetShaderCacheBaseName(Settings::GetRenderAPIForRenderer(renderer),
+                                        Host::GetBaseBoolSettingValue("GPU", "UseDebugDevice", false), "shaders"));
+
+    Error error;
+    if (!GPUShaderCache::ExportBundle(base_filename, SHADER_CACHE_VERSION, export_shader_cache_filename.c_str(),
+                                      &error))
+    {
+      ERROR_LOG("Failed to export shader cache: {}", error.GetDescription());
+    }
+  }
+
   // Check the file we're starting actually exists.
 
   if (autoboot && !autoboot->filename.empty() && !FileSystem::FileExists(autoboot->filename.c_str()))
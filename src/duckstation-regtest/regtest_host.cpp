@@ -2,19 +2,25 @@
 // SPDX-License-Identifier: CC-BY-NC-ND-4.0
 
 #include "core/achievements.h"
+#include "core/bus.h"
 #include "core/controller.h"
 #include "core/fullscreen_ui.h"
 #include "core/game_list.h"
 #include "core/gpu.h"
 #include "core/host.h"
+#include "core/input_movie.h"
+#include "core/shader_cache_version.h"
+#include "core/spu.h"
 #include "core/system.h"
 
 #include "scmversion/scmversion.h"
 
 #include "util/cd_image.h"
 #include "util/gpu_device.h"
+#include "util/gpu_shader_cache.h"
 #include "util/imgui_fullscreen.h"
 #include "util/imgui_manager.h"
+#include "util/ini_settings_interface.h"
 #include "util/input_manager.h"
 #include "util/platform_misc.h"
 
@@ -29,6 +35,7 @@
 #include "common/timer.h"
 
 #include "fmt/format.h"
+#include "xxhash.h"
 
 #include <csignal>
 #include <cstdio>
@@ -40,19 +47,34 @@ static bool ParseCommandLineParameters(int argc, char* argv[], std::optional<Sys
 static void PrintCommandLineVersion();
 static void PrintCommandLineHelp(const char* progname);
 static bool InitializeConfig();
+static bool LoadMovieSettings(const std::string& path);
 static void InitializeEarlyConsole();
 static void HookSignals();
 static bool SetFolders();
 static bool SetNewDataRoot(const std::string& filename);
 static std::string GetFrameDumpFilename(u32 frame);
+static bool OpenHashLog();
+static void WriteFrameHashes(u32 frame);
 } // namespace RegTestHost
 
 static std::unique_ptr<MemorySettingsInterface> s_base_settings_interface;
 
-static u32 s_frames_to_run = 60 * 60;
+static constexpr u32 DEFAULT_FRAMES_TO_RUN = 60 * 60;
+
+static u32 s_frames_to_run = 0;
 static u32 s_frames_remaining = 0;
 static u32 s_frame_dump_interval = 0;
+static u32 s_frame_hash_interval = 0;
+static FileSystem::ManagedCFilePtr s_hash_log;
+static DynamicHeapArray<u8> s_hash_state_buffer;
 static std::string s_dump_base_directory;
+static std::string s_import_shader_cache_path;
+static std::string s_export_shader_cache_path;
+static std::string s_movie_path;
+static u32 s_movie_start_frame = 0;
+static u32 s_movie_keyframe_interval = 0;
+static std::string s_capture_path;
+static bool s_frame_skip = false;
 
 bool RegTestHost::SetFolders()
 {
@@ -127,6 +149,39 @@ bool RegTestHost::InitializeConfig()
   return true;
 }
 
+bool RegTestHost::LoadMovieSettings(const std::string& path)
+{
+  Error error;
+  INISettingsInterface movie_si(InputMovie::GetSettingsPath(path));
+  if (!movie_si.Load(&error))
+  {
+    ERROR_LOG("Failed to load settings for movie '{}': {}", Path::GetFileName(path), error.GetDescription());
+    return false;
+  }
+
+  SettingsInterface& si = *s_base_settings_interface.get();
+  Settings movie_settings;
+  movie_settings.Load(movie_si, movie_si);
+  movie_settings.Save(si, false);
+  for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
+  {
+    const std::string section = Controller::GetSettingsSection(i);
+    si.SetKeyValueList(section.c_str(), movie_si.GetKeyValueList(section.c_str()));
+  }
+
+  // Stay headless and unthrottled, and take the devices from the movie's states.
+  si.SetStringValue("Audio", "Backend", AudioStream::GetBackendName(AudioBackend::Null));
+  si.SetBoolValue("Logging", "LogToConsole", false);
+  si.SetBoolValue("Logging", "LogToFile", false);
+  si.SetBoolValue("Main", "ApplyGameSettings", false);
+  si.SetBoolValue("Main", "StartPaused", false);
+  si.SetBoolValue("Main", "LoadDevicesFromSaveStates", true);
+  si.SetBoolValue("Main", "RewindEnable", false);
+  si.SetIntValue("Main", "RunaheadFrameCount", 0);
+  si.SetFloatValue("Main", "EmulationSpeed", 0.0f);
+  return true;
+}
+
 void Host::ReportFatalError(std::string_view title, std::string_view message)
 {
   ERROR_LOG("ReportFatalError: {}", message);
@@ -368,6 +423,9 @@ void Host::FrameDone()
     std::string dump_filename(RegTestHost::GetFrameDumpFilename(frame));
     g_gpu->WriteDisplayTextureToFile(std::move(dump_filename));
   }
+
+  if (s_frame_hash_interval > 0 && (s_frame_hash_interval == 1 || (frame % s_frame_hash_interval) == 0))
+    RegTestHost::WriteFrameHashes(frame);
 }
 
 void Host::OpenURL(std::string_view url)
@@ -513,9 +571,20 @@ void RegTestHost::PrintCommandLineHelp(const char* progname)
   std::fprintf(stderr, "  -version: Displays version information and exits.\n");
   std::fprintf(stderr, "  -dumpdir: Set frame dump base directory (will be dumped to basedir/gametitle).\n");
   std::fprintf(stderr, "  -dumpinterval: Dumps every N frames.\n");
+  std::fprintf(stderr, "  -hashinterval: Writes hashes of the display, audio, RAM and save state every N frames\n"
+                       "    to hashes.txt in the dump directory.\n");
   std::fprintf(stderr, "  -frames: Sets the number of frames to execute.\n");
   std::fprintf(stderr, "  -log <level>: Sets the log level. Defaults to verbose.\n");
   std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Default to software.\n");
+  std::fprintf(stderr, "  -importshadercache <filename>: Imports a shader cache bundle before booting.\n");
+  std::fprintf(stderr, "  -exportshadercache <filename>: Exports the shader cache to a bundle after running.\n");
+  std::fprintf(stderr, "  -movie <filename>: Plays back an input movie, using the settings it was recorded with.\n"
+                       "    Options after it override the recorded settings.\n");
+  std::fprintf(stderr, "  -moviestart <frame>: Starts movie playback from the keyframe at the specified frame.\n");
+  std::fprintf(stderr, "  -moviekeyframes <interval>: Saves a keyframe every N frames during movie playback.\n");
+  std::fprintf(stderr, "  -capture <filename>: Captures video and audio to the specified file.\n");
+  std::fprintf(stderr, "  -frameskip <interval>: Fast forwards with the specified frame skip interval, for checking\n"
+                       "    that skipped draws don't change what the game reads back. Hardware renderers only.\n");
   std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
                        "    parameters make up the filename. Use when the filename contains\n"
                        "    spaces or starts with a dash.\n");
@@ -572,6 +641,17 @@ bool RegTestHost::ParseCommandLineParameters(int argc, char* argv[], std::option
 
         continue;
       }
+      else if (CHECK_ARG_PARAM("-hashinterval"))
+      {
+        s_frame_hash_interval = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_frame_hash_interval <= 0)
+        {
+          ERROR_LOG("Invalid hash interval specified: {}", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
       else if (CHECK_ARG_PARAM("-frames"))
       {
         s_frames_to_run = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
@@ -614,6 +694,61 @@ bool RegTestHost::ParseCommandLineParameters(int argc, char* argv[], std::option
         s_base_settings_interface->SetStringValue("GPU", "Renderer", Settings::GetRendererName(renderer.value()));
         continue;
       }
+      else if (CHECK_ARG_PARAM("-importshadercache"))
+      {
+        s_import_shader_cache_path = argv[++i];
+        s_base_settings_interface->SetBoolValue("GPU", "DisableShaderCache", false);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-exportshadercache"))
+      {
+        s_export_shader_cache_path = argv[++i];
+        s_base_settings_interface->SetBoolValue("GPU", "DisableShaderCache", false);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-movie"))
+      {
+        s_movie_path = argv[++i];
+        if (!LoadMovieSettings(s_movie_path))
+          return false;
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-moviestart"))
+      {
+        s_movie_start_frame = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-moviekeyframes"))
+      {
+        s_movie_keyframe_interval = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_movie_keyframe_interval == 0)
+        {
+          ERROR_LOG("Invalid keyframe interval specified: {}", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-capture"))
+      {
+        s_capture_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-frameskip"))
+      {
+        const u32 interval = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (interval == 0 || interval > Settings::MAX_FAST_FORWARD_FRAME_SKIP)
+        {
+          ERROR_LOG("Invalid frame skip interval.");
+          return false;
+        }
+
+        INFO_LOG("Setting frame skip interval to {}.", interval);
+        s_base_settings_interface->SetUIntValue("Main", "FastForwardFrameSkip", interval);
+        s_frame_skip = true;
+        continue;
+      }
       else if (CHECK_ARG_PARAM("-upscale"))
       {
         const u32 upscale = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
@@ -727,6 +862,41 @@ std::string RegTestHost::GetFrameDumpFilename(u32 frame)
   return Path::Combine(EmuFolders::DataRoot, fmt::format("frame_{:05d}.png", frame));
 }
 
+bool RegTestHost::OpenHashLog()
+{
+  Error error;
+  const std::string path = Path::Combine(EmuFolders::DataRoot, "hashes.txt");
+  s_hash_log = FileSystem::OpenManagedCFile(path.c_str(), "wb", &error);
+  if (!s_hash_log)
+  {
+    ERROR_LOG("Failed to open hash log '{}': {}", path, error.GetDescription());
+    return false;
+  }
+
+  std::fprintf(s_hash_log.get(), "# frame display audio ram state\n");
+  SPU::SetOutputHashEnabled(true);
+  return true;
+}
+
+void RegTestHost::WriteFrameHashes(u32 frame)
+{
+  // Serializing the state reads VRAM back from the renderer, so do it before hashing the display.
+  Error error;
+  u64 state_hash = 0;
+  if (System::SaveStateToMemory(&s_hash_state_buffer, &error))
+    state_hash = XXH64(s_hash_state_buffer.data(), s_hash_state_buffer.size(), 0);
+  else
+    ERROR_LOG("Failed to save state for hashing: {}", error.GetDescription());
+
+  const u64 display_hash = g_gpu->GetDisplayVRAMHash();
+  const u64 audio_hash = SPU::GetOutputHash();
+  const u64 ram_hash = XXH64(Bus::g_ram, Bus::g_ram_size, 0);
+
+  std::fprintf(s_hash_log.get(), "%u %016llX %016llX %016llX %016llX\n", frame,
+               static_cast<unsigned long long>(display_hash), static_cast<unsigned long long>(audio_hash),
+               static_cast<unsigned long long>(ram_hash), static_cast<unsigned long long>(state_hash));
+}
+
 int main(int argc, char* argv[])
 {
   RegTestHost::InitializeEarlyConsole();
@@ -747,6 +917,9 @@ int main(int argc, char* argv[])
   if (!RegTestHost::SetNewDataRoot(autoboot->filename))
     return EXIT_FAILURE;
 
+  if (!s_movie_path.empty())
+    autoboot->save_state = InputMovie::GetStatePath(s_movie_path, s_movie_start_frame);
+
   {
     Error startup_error;
     if (!System::Internal::PerformEarlyHardwareChecks(&startup_error) ||
@@ -761,6 +934,15 @@ int main(int argc, char* argv[])
 
   Error error;
   int result = -1;
+
+  if (!s_import_shader_cache_path.empty() &&
+      !GPUShaderCache::ImportBundle(EmuFolders::Cache, s_import_shader_cache_path.c_str(), SHADER_CACHE_VERSION,
+                                    &error))
+  {
+    ERROR_LOG("Failed to import shader cache: {}", error.GetDescription());
+    goto cleanup;
+  }
+
   INFO_LOG("Trying to boot '{}'...", autoboot->filename);
   if (!System::BootSystem(std::move(autoboot.value()), &error))
   {
@@ -779,6 +961,53 @@ int main(int argc, char* argv[])
     INFO_LOG("Dumping every {}th frame to '{}'.", s_frame_dump_interval, s_dump_base_directory);
   }
 
+  if (s_frame_hash_interval > 0)
+  {
+    if (s_dump_base_directory.empty())
+    {
+      ERROR_LOG("Dump directory not specified.");
+      goto cleanup;
+    }
+
+    if (!RegTestHost::OpenHashLog())
+      goto cleanup;
+
+    INFO_LOG("Hashing every {}th frame to '{}'.", s_frame_hash_interval, s_dump_base_directory);
+  }
+
+  if (!s_movie_path.empty())
+  {
+    if (!InputMovie::StartPlayback(s_movie_path, s_movie_start_frame, s_movie_keyframe_interval, &error))
+    {
+      ERROR_LOG("Failed to start movie playback: {}", error.GetDescription());
+      goto cleanup;
+    }
+
+    // Run to the end of the movie, unless asked to stop earlier.
+    const u32 movie_frames_remaining = InputMovie::GetFrameCount() - s_movie_start_frame;
+    if (movie_frames_remaining == 0)
+    {
+      ERROR_LOG("No frames left to play back in movie.");
+      goto cleanup;
+    }
+
+    s_frames_to_run =
+      (s_frames_to_run == 0) ? movie_frames_remaining : std::min(s_frames_to_run, movie_frames_remaining);
+  }
+
+  // Frames are only skipped while fast forwarding. The runner isn't throttled anyway.
+  if (s_frame_skip)
+    System::SetFastForwardEnabled(true);
+
+  if (!s_capture_path.empty() && !System::StartMediaCapture(s_capture_path, true, true))
+  {
+    ERROR_LOG("Failed to start media capture to '{}'.", s_capture_path);
+    goto cleanup;
+  }
+
+  if (s_frames_to_run == 0)
+    s_frames_to_run = DEFAULT_FRAMES_TO_RUN;
+
   INFO_LOG("Running for {} frames...", s_frames_to_run);
   s_frames_remaining = s_frames_to_run;
 
@@ -794,10 +1023,18 @@ int main(int argc, char* argv[])
              static_cast<double>(s_frames_to_run) / elapsed_time_ms * 1000.0);
   }
 
+  if (!s_export_shader_cache_path.empty() &&
+      (!g_gpu_device || !g_gpu_device->ExportShaderCache(s_export_shader_cache_path.c_str(), &error)))
+  {
+    ERROR_LOG("Failed to export shader cache: {}", error.GetDescription());
+    goto cleanup;
+  }
+
   INFO_LOG("Exiting with success.");
   result = 0;
 
 cleanup:
+  s_hash_log.reset();
   System::Internal::CPUThreadShutdown();
   System::Internal::ProcessShutdown();
   return result;
@@ -170,6 +170,7 @@ AudioStream::AudioStream(u32 sample_rate, const AudioStreamParameters& parameter
 
 AudioStream::~AudioStream()
 {
+  StopWorkerThread();
   StretchDestroy();
   DestroyBuffer();
 }
@@ -581,6 +582,7 @@ void AudioStream::BaseInitialize(SampleReader sample_reader)
   AllocateBuffer();
   ExpandAllocate();
   StretchAllocate();
+  StartWorkerThread();
 }
 
 void AudioStream::AllocateBuffer()
@@ -594,7 +596,10 @@ void AudioStream::AllocateBuffer()
   m_target_buffer_size = GetAlignedBufferSize((m_sample_rate * m_parameters.buffer_ms) / 1000u);
 
   m_buffer = Common::make_unique_aligned_for_overwrite<s16[]>(VECTOR_ALIGNMENT, m_buffer_size * m_output_channels);
-  m_staging_buffer = Common::make_unique_aligned_for_overwrite<s16[]>(VECTOR_ALIGNMENT, CHUNK_SIZE * m_output_channels);
+  m_staging_buffer =
+    Common::make_unique_aligned_for_overwrite<s16[]>(VECTOR_ALIGNMENT, CHUNK_SIZE * NUM_INPUT_CHANNELS);
+  m_output_staging_buffer =
+    Common::make_unique_aligned_for_overwrite<s16[]>(VECTOR_ALIGNMENT, CHUNK_SIZE * m_output_channels);
   m_float_buffer = Common::make_unique_aligned_for_overwrite<float[]>(VECTOR_ALIGNMENT, CHUNK_SIZE * m_output_channels);
 
   DEV_LOG(
@@ -606,6 +611,7 @@ void AudioStream::AllocateBuffer()
 void AudioStream::DestroyBuffer()
 {
   m_staging_buffer.reset();
+  m_output_staging_buffer.reset();
   m_float_buffer.reset();
   m_buffer.reset();
   m_buffer_size = 0;
@@ -615,12 +621,18 @@ void AudioStream::DestroyBuffer()
 
 void AudioStream::EmptyBuffer()
 {
+  std::unique_lock lock(m_worker_mutex);
+
+  // drop anything the worker hasn't got to yet, the read position belongs to us while we hold the lock
+  m_worker_queue_rpos.store(m_worker_queue_wpos.load(std::memory_order_relaxed), std::memory_order_release);
+
   if (IsExpansionEnabled())
     ExpandFlush();
 
   if (IsStretchEnabled())
   {
     soundtouch_clear(m_soundtouch);
+    ApplyPendingNominalRate();
     if (m_parameters.stretch_mode == AudioStretchMode::TimeStretch)
       soundtouch_setTempo(m_soundtouch, m_nominal_rate);
   }
@@ -630,6 +642,17 @@ void AudioStream::EmptyBuffer()
 
 void AudioStream::SetNominalRate(float tempo)
 {
+  // Called from the CPU thread, which shouldn't wait for the worker to finish a chunk. Whoever holds the worker mutex
+  // picks the new rate up before processing the next chunk.
+  m_pending_nominal_rate.store(tempo, std::memory_order_relaxed);
+}
+
+void AudioStream::ApplyPendingNominalRate()
+{
+  const float tempo = m_pending_nominal_rate.load(std::memory_order_relaxed);
+  if (m_nominal_rate == tempo)
+    return;
+
   m_nominal_rate = tempo;
   if (m_parameters.stretch_mode == AudioStretchMode::Resample)
     soundtouch_setRate(m_soundtouch, tempo);
@@ -647,6 +670,7 @@ void AudioStream::SetStretchMode(AudioStretchMode mode)
   if (!paused)
     SetPaused(true);
 
+  StopWorkerThread();
   DestroyBuffer();
   StretchDestroy();
   m_parameters.stretch_mode = mode;
@@ -654,6 +678,7 @@ void AudioStream::SetStretchMode(AudioStretchMode mode)
   AllocateBuffer();
   if (m_parameters.stretch_mode != AudioStretchMode::Off)
     StretchAllocate();
+  StartWorkerThread();
 
   if (!paused)
     SetPaused(false);
@@ -742,11 +767,82 @@ void AudioStream::EndWrite(u32 num_frames)
     return;
   }
 
+  // Hand the chunk off to the worker thread.
+  const u32 wpos = m_worker_queue_wpos.load(std::memory_order_relaxed);
+  if ((wpos - m_worker_queue_rpos.load(std::memory_order_acquire)) == WORKER_QUEUE_CHUNKS)
+  {
+    // Worker has fallen behind. Catch up on this thread instead of dropping audio, the queued chunks have to go
+    // first to keep everything in order.
+    DEBUG_LOG("Worker queue overrun, processing inline");
+    std::unique_lock lock(m_worker_mutex);
+    DrainWorkerQueue();
+    ApplyPendingNominalRate();
+    ProcessChunk(m_staging_buffer.get());
+    return;
+  }
+
+  std::memcpy(&m_worker_queue[(wpos % WORKER_QUEUE_CHUNKS) * (CHUNK_SIZE * NUM_INPUT_CHANNELS)],
+              m_staging_buffer.get(), sizeof(SampleType) * CHUNK_SIZE * NUM_INPUT_CHANNELS);
+  m_worker_queue_wpos.store(wpos + 1, std::memory_order_release);
+  m_worker_sema.Post();
+}
+
+void AudioStream::StartWorkerThread()
+{
+  if (!IsExpansionEnabled() && !IsStretchEnabled())
+    return;
+
+  m_worker_queue = Common::make_unique_aligned_for_overwrite<s16[]>(
+    VECTOR_ALIGNMENT, WORKER_QUEUE_CHUNKS * CHUNK_SIZE * NUM_INPUT_CHANNELS);
+  m_worker_queue_rpos.store(0, std::memory_order_relaxed);
+  m_worker_queue_wpos.store(0, std::memory_order_relaxed);
+  m_worker_shutdown.store(false, std::memory_order_relaxed);
+  m_worker_thread.Start([this]() { WorkerThreadEntryPoint(); });
+}
+
+void AudioStream::StopWorkerThread()
+{
+  if (!m_worker_thread.Joinable())
+    return;
+
+  m_worker_shutdown.store(true, std::memory_order_release);
+  m_worker_sema.Post();
+  m_worker_thread.Join();
+  m_worker_queue.reset();
+}
+
+void AudioStream::WorkerThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Audio Stream Worker");
+
+  for (;;)
+  {
+    m_worker_sema.Wait();
+    if (m_worker_shutdown.load(std::memory_order_acquire))
+      break;
+
+    std::unique_lock lock(m_worker_mutex);
+    DrainWorkerQueue();
+  }
+}
+
+void AudioStream::DrainWorkerQueue()
+{
+  u32 rpos = m_worker_queue_rpos.load(std::memory_order_relaxed);
+  while (rpos != m_worker_queue_wpos.load(std::memory_order_acquire))
+  {
+    ApplyPendingNominalRate();
+    ProcessChunk(&m_worker_queue[(rpos % WORKER_QUEUE_CHUNKS) * (CHUNK_SIZE * NUM_INPUT_CHANNELS)]);
+    rpos++;
+    m_worker_queue_rpos.store(rpos, std::memory_order_release);
+  }
+}
+
+void AudioStream::ProcessChunk(const SampleType* chunk)
+{
   if (IsExpansionEnabled())
   {
-    // StretchWriteBlock() overwrites the staging buffer on output, so we need to copy into the expand buffer first.
-    S16ChunkToFloat(m_staging_buffer.get(),
-                    &m_expand_inbuf[m_parameters.expand_block_size + (m_expand_buffer_pos * NUM_INPUT_CHANNELS)],
+    S16ChunkToFloat(chunk, &m_expand_inbuf[m_parameters.expand_block_size + (m_expand_buffer_pos * NUM_INPUT_CHANNELS)],
                     CHUNK_SIZE * NUM_INPUT_CHANNELS);
 
     // Output the corresponding block.
@@ -764,7 +860,7 @@ void AudioStream::EndWrite(u32 num_frames)
   }
   else
   {
-    S16ChunkToFloat(m_staging_buffer.get(), m_float_buffer.get(), CHUNK_SIZE * NUM_INPUT_CHANNELS);
+    S16ChunkToFloat(chunk, m_float_buffer.get(), CHUNK_SIZE * NUM_INPUT_CHANNELS);
     StretchWriteBlock(m_float_buffer.get());
   }
 }
@@ -793,6 +889,7 @@ void AudioStream::StretchAllocate()
   soundtouch_setSetting(m_soundtouch, SETTING_SEEKWINDOW_MS, m_parameters.stretch_seekwindow_ms);
   soundtouch_setSetting(m_soundtouch, SETTING_OVERLAP_MS, m_parameters.stretch_overlap_ms);
 
+  m_nominal_rate = m_pending_nominal_rate.load(std::memory_order_relaxed);
   if (m_parameters.stretch_mode == AudioStretchMode::Resample)
     soundtouch_setRate(m_soundtouch, m_nominal_rate);
   else
@@ -826,8 +923,8 @@ void AudioStream::StretchWriteBlock(const float* block)
     u32 tempProgress;
     while (tempProgress = soundtouch_receiveSamples(m_soundtouch, m_float_buffer.get(), CHUNK_SIZE), tempProgress != 0)
     {
-      FloatChunkToS16(m_staging_buffer.get(), m_float_buffer.get(), tempProgress * m_output_channels);
-      InternalWriteFrames(m_staging_buffer.get(), tempProgress);
+      FloatChunkToS16(m_output_staging_buffer.get(), m_float_buffer.get(), tempProgress * m_output_channels);
+      InternalWriteFrames(m_output_staging_buffer.get(), tempProgress);
     }
 
     if (m_parameters.stretch_mode == AudioStretchMode::TimeStretch)
@@ -835,8 +932,8 @@ void AudioStream::StretchWriteBlock(const float* block)
   }
   else
   {
-    FloatChunkToS16(m_staging_buffer.get(), block, CHUNK_SIZE * m_output_channels);
-    InternalWriteFrames(m_staging_buffer.get(), CHUNK_SIZE);
+    FloatChunkToS16(m_output_staging_buffer.get(), block, CHUNK_SIZE * m_output_channels);
+    InternalWriteFrames(m_output_staging_buffer.get(), CHUNK_SIZE);
   }
 }
 
@@ -4,12 +4,14 @@
 #pragma once
 
 #include "common/align.h"
+#include "common/threading.h"
 #include "common/types.h"
 
 #include <array>
 #include <atomic>
 #include <complex>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -170,7 +172,7 @@ public:
   ALWAYS_INLINE u32 GetBufferSize() const { return m_buffer_size; }
   ALWAYS_INLINE u32 GetTargetBufferSize() const { return m_target_buffer_size; }
   ALWAYS_INLINE u32 GetOutputVolume() const { return m_volume; }
-  ALWAYS_INLINE float GetNominalTempo() const { return m_nominal_rate; }
+  ALWAYS_INLINE float GetNominalTempo() const { return m_pending_nominal_rate.load(std::memory_order_relaxed); }
   ALWAYS_INLINE bool IsPaused() const { return m_paused; }
 
   u32 GetBufferedFramesRelaxed() const;
@@ -186,7 +188,7 @@ public:
   void EmptyBuffer();
 
   /// Nominal rate is used for both resampling and timestretching, input samples are assumed to be this amount faster
-  /// than the sample rate.
+  /// than the sample rate. Takes effect from the next chunk that the worker processes.
   void SetNominalRate(float tempo);
 
   void SetStretchMode(AudioStretchMode mode);
@@ -239,6 +241,11 @@ private:
   static constexpr u32 STRETCH_RESET_THRESHOLD = 5;
   static constexpr u32 TARGET_IPS = 691;
 
+  // The worker can fall up to WORKER_QUEUE_CHUNKS * CHUNK_SIZE (2048) frames behind the producer when stretching or
+  // expansion is enabled, about 46ms at 44.1KHz, on top of the output buffer. Nominal rate changes wait in the queue
+  // for the same time, since they're applied as the worker picks up each chunk.
+  static constexpr u32 WORKER_QUEUE_CHUNKS = 32;
+
 #ifndef __ANDROID__
   static std::vector<std::pair<std::string, std::string>> GetCubebDriverNames();
   static std::vector<DeviceInfo> GetCubebOutputDevices(const char* driver, u32 sample_rate);
@@ -262,6 +269,13 @@ private:
 
   void InternalWriteFrames(SampleType* samples, u32 num_frames);
 
+  void StartWorkerThread();
+  void StopWorkerThread();
+  void WorkerThreadEntryPoint();
+  void DrainWorkerQueue();
+  void ProcessChunk(const SampleType* chunk);
+  void ApplyPendingNominalRate();
+
   void ExpandAllocate();
   void ExpandDestroy();
   void ExpandDecode();
@@ -280,10 +294,12 @@ private:
   Common::unique_aligned_ptr<s16[]> m_buffer;
   SampleReader m_sample_reader = nullptr;
 
-  std::atomic<u32> m_rpos{0};
-  std::atomic<u32> m_wpos{0};
+  // Read/write positions are only written by the audio callback and producer respectively, keep them on separate
+  // cache lines so that they don't bounce between the two threads.
+  ALIGN_TO_CACHE_LINE std::atomic<u32> m_rpos{0};
+  ALIGN_TO_CACHE_LINE std::atomic<u32> m_wpos{0};
 
-  void* m_soundtouch = nullptr;
+  ALIGN_TO_CACHE_LINE void* m_soundtouch = nullptr;
 
   u32 m_target_buffer_size = 0;
   u32 m_stretch_reset = STRETCH_RESET_THRESHOLD;
@@ -298,12 +314,28 @@ private:
 
   std::array<float, AVERAGING_BUFFER_SIZE> m_average_fullness = {};
 
-  // temporary staging buffer, used for timestretching
+  // temporary staging buffer, filled by the producer
   Common::unique_aligned_ptr<s16[]> m_staging_buffer;
 
+  // output of timestretching/expansion, before it is written to the ring buffer
+  Common::unique_aligned_ptr<s16[]> m_output_staging_buffer;
+
   // float buffer, soundtouch only accepts float samples as input
   Common::unique_aligned_ptr<float[]> m_float_buffer;
 
+  // Timestretching and expansion run on a worker thread, chunks are passed to it through a single-producer
+  // single-consumer queue. The write position is only touched by the producer. The consumer side, meaning the read
+  // position and the stretch/expansion state, belongs to whichever thread holds the mutex: normally the worker, but
+  // the producer takes it to drop the queue in EmptyBuffer(), or to catch up in EndWrite() when the queue is full.
+  Common::unique_aligned_ptr<s16[]> m_worker_queue;
+  Threading::Thread m_worker_thread;
+  Threading::KernelSemaphore m_worker_sema;
+  std::mutex m_worker_mutex;
+  std::atomic_bool m_worker_shutdown{false};
+  std::atomic<float> m_pending_nominal_rate{1.0f};
+  ALIGN_TO_CACHE_LINE std::atomic<u32> m_worker_queue_rpos{0};
+  ALIGN_TO_CACHE_LINE std::atomic<u32> m_worker_queue_wpos{0};
+
   // expansion data
   u32 m_expand_buffer_pos = 0;
   bool m_expand_has_block = false;
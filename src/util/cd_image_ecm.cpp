@@ -7,18 +7,156 @@
 #include "common/assert.h"
 #include "common/error.h"
 #include "common/file_system.h"
+#include "common/gsvector.h"
 #include "common/log.h"
+#include "common/lru_cache.h"
 #include "common/path.h"
+#include "common/progress_callback.h"
 
-#include "libchdr/cdrom.h"
+#include "fmt/format.h"
 
+#include <algorithm>
 #include <array>
-#include <map>
+#include <atomic>
+#include <thread>
 
 Log_SetChannel(CDImageEcm);
 
 namespace {
 
+// EDC/ECC regeneration. These produce the same output as libchdr's edc_compute()/ecc_generate(), but the EDC is
+// computed eight bytes at a time, and the P parity for all 86 columns is computed in parallel.
+namespace SectorReconstruction {
+
+static constexpr u32 EDC_POLYNOMIAL = 0xD8018001u;
+
+static constexpr std::array<std::array<u32, 256>, 8> GenerateEDCTables()
+{
+  std::array<std::array<u32, 256>, 8> tables = {};
+  for (u32 i = 0; i < 256; i++)
+  {
+    u32 edc = i;
+    for (u32 bit = 0; bit < 8; bit++)
+      edc = (edc >> 1) ^ ((edc & 1) ? EDC_POLYNOMIAL : 0);
+    tables[0][i] = edc;
+  }
+  for (u32 slice = 1; slice < 8; slice++)
+  {
+    for (u32 i = 0; i < 256; i++)
+      tables[slice][i] = (tables[slice - 1][i] >> 8) ^ tables[0][tables[slice - 1][i] & 0xFF];
+  }
+  return tables;
+}
+
+static constexpr std::array<std::array<u8, 256>, 2> GenerateECCTables()
+{
+  std::array<std::array<u8, 256>, 2> tables = {};
+  for (u32 i = 0; i < 256; i++)
+  {
+    const u32 forward = (i << 1) ^ ((i & 0x80) ? 0x11D : 0);
+    tables[0][i] = static_cast<u8>(forward);
+    tables[1][i ^ forward] = static_cast<u8>(i);
+  }
+  return tables;
+}
+
+static constexpr std::array<std::array<u32, 256>, 8> s_edc_tables = GenerateEDCTables();
+static constexpr std::array<std::array<u8, 256>, 2> s_ecc_tables = GenerateECCTables();
+
+static u32 ComputeEDC(const u8* data, u32 length)
+{
+  u32 edc = 0;
+  for (; length >= 8; length -= 8, data += 8)
+  {
+    u32 lo, hi;
+    std::memcpy(&lo, data, sizeof(lo));
+    std::memcpy(&hi, data + 4, sizeof(hi));
+    lo ^= edc;
+    edc = s_edc_tables[7][lo & 0xFF] ^ s_edc_tables[6][(lo >> 8) & 0xFF] ^ s_edc_tables[5][(lo >> 16) & 0xFF] ^
+          s_edc_tables[4][lo >> 24] ^ s_edc_tables[3][hi & 0xFF] ^ s_edc_tables[2][(hi >> 8) & 0xFF] ^
+          s_edc_tables[1][(hi >> 16) & 0xFF] ^ s_edc_tables[0][hi >> 24];
+  }
+  for (; length > 0; length--)
+    edc = (edc >> 8) ^ s_edc_tables[0][(edc ^ *(data++)) & 0xFF];
+  return edc;
+}
+
+static void GenerateECC(u8* sector)
+{
+  static constexpr u32 P_COLUMNS = 86;
+  static constexpr u32 P_ROWS = 24;
+  static constexpr u32 P_OFFSET = 0x810;
+  static constexpr u32 Q_DIAGONALS = 52;
+  static constexpr u32 Q_LENGTH = 43;
+  static constexpr u32 Q_OFFSET = P_OFFSET + P_COLUMNS * 2;
+  static constexpr u32 Q_SIZE = Q_OFFSET;
+  static constexpr u32 P_VECTORS = (P_COLUMNS + 15) / 16;
+
+  // Parity covers everything after the sync pattern. Mode 2 sectors are protected with the header zeroed.
+  u8* const data = sector + 0x0C;
+  const bool mode2 = (sector[0x0F] == 0x02);
+  u32 header;
+  std::memcpy(&header, data, sizeof(header));
+  if (mode2)
+    std::memset(data, 0, sizeof(header));
+
+  // P parity runs down each of the 86 columns, so all columns are computed at once, one byte lane each.
+  // The last load of each row reads past the 86th column, those lanes are discarded.
+  const GSVector4i poly = GSVector4i::cxpr(0x1D1D1D1D);
+  std::array<GSVector4i, P_VECTORS> ecc_a, ecc_b;
+  ecc_a.fill(GSVector4i::zero());
+  ecc_b.fill(GSVector4i::zero());
+  for (u32 row = 0; row < P_ROWS; row++)
+  {
+    const u8* row_ptr = data + row * P_COLUMNS;
+    for (u32 i = 0; i < P_VECTORS; i++)
+    {
+      const GSVector4i value = GSVector4i::load<false>(row_ptr + i * 16);
+      const GSVector4i a = ecc_a[i] ^ value;
+      ecc_b[i] ^= value;
+
+      // Multiply by two in GF(2^8).
+      ecc_a[i] = a.add8(a) ^ (a.lt8(GSVector4i::zero()) & poly);
+    }
+  }
+
+  alignas(16) std::array<u8, P_VECTORS * 16> p_a, p_b;
+  for (u32 i = 0; i < P_VECTORS; i++)
+  {
+    GSVector4i::store<true>(&p_a[i * 16], ecc_a[i]);
+    GSVector4i::store<true>(&p_b[i * 16], ecc_b[i]);
+  }
+  for (u32 i = 0; i < P_COLUMNS; i++)
+  {
+    const u8 a = s_ecc_tables[1][s_ecc_tables[0][p_a[i]] ^ p_b[i]];
+    data[P_OFFSET + i] = a;
+    data[P_OFFSET + P_COLUMNS + i] = a ^ p_b[i];
+  }
+
+  // Q parity runs along diagonals which wrap around, including the P parity.
+  for (u32 i = 0; i < Q_DIAGONALS; i++)
+  {
+    u32 index = (i >> 1) * P_COLUMNS + (i & 1);
+    u8 a = 0, b = 0;
+    for (u32 j = 0; j < Q_LENGTH; j++)
+    {
+      const u8 value = data[index];
+      index += P_COLUMNS + 2;
+      index = (index >= Q_SIZE) ? (index - Q_SIZE) : index;
+      a = s_ecc_tables[0][a ^ value];
+      b ^= value;
+    }
+    a = s_ecc_tables[1][s_ecc_tables[0][a] ^ b];
+    data[Q_OFFSET + i] = a;
+    data[Q_OFFSET + Q_DIAGONALS + i] = a ^ b;
+  }
+
+  if (mode2)
+    std::memcpy(data, &header, sizeof(header));
+}
+
+} // namespace SectorReconstruction
+
 class CDImageEcm : public CDImage
 {
 public:
@@ -31,10 +169,17 @@ public:
   bool HasNonStandardSubchannel() const override;
   s64 GetSizeOnDisk() const override;
 
+  PrecacheResult Precache(ProgressCallback* progress) override;
+  bool IsPrecached() const override;
+
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
 
 private:
+  static constexpr u32 SECTOR_CACHE_SIZE = 64;
+  static constexpr u32 MAX_PRECACHE_THREADS = 8;
+  static constexpr u32 PRECACHE_READ_SIZE = 4 * 1024 * 1024;
+
   bool ReadChunks(u32 disc_offset, u32 size);
 
   std::FILE* m_fp = nullptr;
@@ -64,17 +209,26 @@ private:
 
   struct SectorEntry
   {
+    u32 disc_offset;
     u32 file_offset;
     u32 chunk_size;
     SectorType type;
   };
 
-  using DataMap = std::map<u32, SectorEntry>;
+  using SectorBuffer = std::array<u8, RAW_SECTOR_SIZE>;
 
-  DataMap m_data_map;
+  static u32 GetStoredSize(const SectorEntry& entry);
+  static void DecodeChunk(const SectorEntry& entry, const u8* stored, u8* out);
+
+  // Chunks are stored in disc order, m_lba_chunks holds the index of the chunk containing the start of each LBA.
+  std::vector<SectorEntry> m_chunks;
+  std::vector<u32> m_lba_chunks;
   std::vector<u8> m_chunk_buffer;
   u32 m_chunk_start = 0;
 
+  LRUCache<LBA, SectorBuffer> m_sector_cache{SECTOR_CACHE_SIZE};
+  std::vector<u8> m_precache_data;
+
   CDSubChannelReplacement m_sbi;
 };
 
@@ -127,8 +281,8 @@ bool CDImageEcm::Open(const char* filename, Error* error)
     int bits = std::fgetc(m_fp);
     if (bits == EOF)
     {
-      ERROR_LOG("Unexpected EOF after {} chunks", m_data_map.size());
-      Error::SetStringFmt(error, "Unexpected EOF after {} chunks", m_data_map.size());
+      ERROR_LOG("Unexpected EOF after {} chunks", m_chunks.size());
+      Error::SetStringFmt(error, "Unexpected EOF after {} chunks", m_chunks.size());
       return false;
     }
 
@@ -141,8 +295,8 @@ bool CDImageEcm::Open(const char* filename, Error* error)
       bits = std::fgetc(m_fp);
       if (bits == EOF)
       {
-        ERROR_LOG("Unexpected EOF after {} chunks", m_data_map.size());
-        Error::SetStringFmt(error, "Unexpected EOF after {} chunks", m_data_map.size());
+        ERROR_LOG("Unexpected EOF after {} chunks", m_chunks.size());
+        Error::SetStringFmt(error, "Unexpected EOF after {} chunks", m_chunks.size());
         return false;
       }
 
@@ -159,8 +313,8 @@ bool CDImageEcm::Open(const char* filename, Error* error)
 
     if (count >= 0x80000000u)
     {
-      ERROR_LOG("Corrupted header after {} chunks", m_data_map.size());
-      Error::SetStringFmt(error, "Corrupted header after {} chunks", m_data_map.size());
+      ERROR_LOG("Corrupted header after {} chunks", m_chunks.size());
+      Error::SetStringFmt(error, "Corrupted header after {} chunks", m_chunks.size());
       return false;
     }
 
@@ -169,15 +323,15 @@ bool CDImageEcm::Open(const char* filename, Error* error)
       while (count > 0)
       {
         const u32 size = std::min<u32>(count, 2352);
-        m_data_map.emplace(disc_offset, SectorEntry{file_offset, size, type});
+        m_chunks.push_back(SectorEntry{disc_offset, file_offset, size, type});
         disc_offset += size;
         file_offset += size;
         count -= size;
 
         if (static_cast<s64>(file_offset) > file_size)
         {
-          ERROR_LOG("Out of file bounds after {} chunks", m_data_map.size());
-          Error::SetStringFmt(error, "Out of file bounds after {} chunks", m_data_map.size());
+          ERROR_LOG("Out of file bounds after {} chunks", m_chunks.size());
+          Error::SetStringFmt(error, "Out of file bounds after {} chunks", m_chunks.size());
         }
       }
     }
@@ -187,27 +341,27 @@ bool CDImageEcm::Open(const char* filename, Error* error)
       const u32 chunk_size = s_chunk_sizes[static_cast<u32>(type)];
       for (u32 i = 0; i < count; i++)
       {
-        m_data_map.emplace(disc_offset, SectorEntry{file_offset, chunk_size, type});
+        m_chunks.push_back(SectorEntry{disc_offset, file_offset, chunk_size, type});
         disc_offset += chunk_size;
         file_offset += size;
 
         if (static_cast<s64>(file_offset) > file_size)
         {
-          ERROR_LOG("Out of file bounds after {} chunks", m_data_map.size());
-          Error::SetStringFmt(error, "Out of file bounds after {} chunks", m_data_map.size());
+          ERROR_LOG("Out of file bounds after {} chunks", m_chunks.size());
+          Error::SetStringFmt(error, "Out of file bounds after {} chunks", m_chunks.size());
         }
       }
     }
 
     if (std::fseek(m_fp, file_offset, SEEK_SET) != 0)
     {
-      ERROR_LOG("Failed to seek to offset {} after {} chunks", file_offset, m_data_map.size());
-      Error::SetStringFmt(error, "Failed to seek to offset {} after {} chunks", file_offset, m_data_map.size());
+      ERROR_LOG("Failed to seek to offset {} after {} chunks", file_offset, m_chunks.size());
+      Error::SetStringFmt(error, "Failed to seek to offset {} after {} chunks", file_offset, m_chunks.size());
       return false;
     }
   }
 
-  if (m_data_map.empty())
+  if (m_chunks.empty())
   {
     ERROR_LOG("No data in image '{}'", filename);
     Error::SetStringFmt(error, "No data in image '{}'", filename);
@@ -220,6 +374,16 @@ bool CDImageEcm::Open(const char* filename, Error* error)
   if (m_lba_count == 0)
     return false;
 
+  m_lba_chunks.resize(m_lba_count);
+  u32 chunk_index = 0;
+  for (LBA lba = 0; lba < m_lba_count; lba++)
+  {
+    const u32 lba_offset = lba * RAW_SECTOR_SIZE;
+    while ((m_chunks[chunk_index].disc_offset + m_chunks[chunk_index].chunk_size) <= lba_offset)
+      chunk_index++;
+    m_lba_chunks[lba] = chunk_index;
+  }
+
   SubChannelQ::Control control = {};
   TrackMode mode = TrackMode::Mode2Raw;
   control.data = mode != TrackMode::Audio;
@@ -266,104 +430,102 @@ bool CDImageEcm::Open(const char* filename, Error* error)
   return Seek(1, Position{0, 0, 0});
 }
 
-bool CDImageEcm::ReadChunks(u32 disc_offset, u32 size)
+u32 CDImageEcm::GetStoredSize(const SectorEntry& entry)
 {
-  DataMap::iterator next =
-    m_data_map.lower_bound((disc_offset > RAW_SECTOR_SIZE) ? (disc_offset - RAW_SECTOR_SIZE) : 0);
-  DataMap::iterator current = m_data_map.begin();
-  while (next != m_data_map.end() && next->first <= disc_offset)
-    current = next++;
-
-  // extra bytes if we need to buffer some at the start
-  m_chunk_start = current->first;
-  m_chunk_buffer.clear();
-  if (m_chunk_start < disc_offset)
-    size += (disc_offset - current->first);
+  return (entry.type == SectorType::Raw) ? entry.chunk_size : s_sector_sizes[static_cast<u32>(entry.type)];
+}
 
-  u32 total_bytes_read = 0;
-  while (total_bytes_read < size)
+void CDImageEcm::DecodeChunk(const SectorEntry& entry, const u8* stored, u8* out)
+{
+  if (entry.type == SectorType::Raw)
   {
-    if (current == m_data_map.end() || std::fseek(m_fp, current->second.file_offset, SEEK_SET) != 0)
-      return false;
+    std::memcpy(out, stored, entry.chunk_size);
+    return;
+  }
 
-    const u32 chunk_size = current->second.chunk_size;
-    const u32 chunk_start = static_cast<u32>(m_chunk_buffer.size());
-    m_chunk_buffer.resize(chunk_start + chunk_size);
+  u8 sector[RAW_SECTOR_SIZE];
+  std::memset(sector, 0, RAW_SECTOR_SIZE);
+  std::memset(sector + 1, 0xFF, 10);
 
-    if (current->second.type == SectorType::Raw)
+  u32 skip;
+  switch (entry.type)
+  {
+    case SectorType::Mode1:
     {
-      if (std::fread(&m_chunk_buffer[chunk_start], chunk_size, 1, m_fp) != 1)
-        return false;
-
-      total_bytes_read += chunk_size;
+      sector[0x0F] = 0x01;
+      std::memcpy(sector + 0x00C, stored, 0x003);
+      std::memcpy(sector + 0x010, stored + 0x003, 0x800);
+
+      const u32 edc = SectorReconstruction::ComputeEDC(sector, 2064);
+      std::memcpy(&sector[2064], &edc, sizeof(edc));
+      SectorReconstruction::GenerateECC(sector);
+      skip = 0;
     }
-    else
+    break;
+
+    case SectorType::Mode2Form1:
     {
-      // u8* sector = &m_chunk_buffer[chunk_start];
-      u8 sector[RAW_SECTOR_SIZE];
+      sector[0x0F] = 0x02;
+      std::memcpy(sector + 0x014, stored, 0x804);
+      std::memcpy(sector + 0x010, sector + 0x014, 4);
+
+      const u32 edc = SectorReconstruction::ComputeEDC(&sector[16], 2056);
+      std::memcpy(&sector[2072], &edc, sizeof(edc));
+      SectorReconstruction::GenerateECC(sector);
+      skip = 0x10;
+    }
+    break;
 
-      // TODO: needed?
-      std::memset(sector, 0, RAW_SECTOR_SIZE);
-      std::memset(sector + 1, 0xFF, 10);
+    case SectorType::Mode2Form2:
+    {
+      sector[0x0F] = 0x02;
+      std::memcpy(sector + 0x014, stored, 0x918);
+      std::memcpy(sector + 0x010, sector + 0x014, 4);
 
-      u32 skip;
-      switch (current->second.type)
-      {
-        case SectorType::Mode1:
-        {
-          sector[0x0F] = 0x01;
-          if (std::fread(sector + 0x00C, 0x003, 1, m_fp) != 1 || std::fread(sector + 0x010, 0x800, 1, m_fp) != 1)
-            return false;
+      const u32 edc = SectorReconstruction::ComputeEDC(&sector[16], 2332);
+      std::memcpy(&sector[2348], &edc, sizeof(edc));
+      skip = 0x10;
+    }
+    break;
 
-          edc_set(&sector[2064], edc_compute(sector, 2064));
-          ecc_generate(sector);
-          skip = 0;
-        }
-        break;
+      DefaultCaseIsUnreachable()
+  }
 
-        case SectorType::Mode2Form1:
-        {
-          sector[0x0F] = 0x02;
-          if (std::fread(sector + 0x014, 0x804, 1, m_fp) != 1)
-            return false;
-
-          sector[0x10] = sector[0x14];
-          sector[0x11] = sector[0x15];
-          sector[0x12] = sector[0x16];
-          sector[0x13] = sector[0x17];
-
-          edc_set(&sector[2072], edc_compute(&sector[16], 2056));
-          ecc_generate(sector);
-          skip = 0x10;
-        }
-        break;
+  std::memcpy(out, sector + skip, entry.chunk_size);
+}
 
-        case SectorType::Mode2Form2:
-        {
-          sector[0x0F] = 0x02;
-          if (std::fread(sector + 0x014, 0x918, 1, m_fp) != 1)
-            return false;
+bool CDImageEcm::ReadChunks(u32 disc_offset, u32 size)
+{
+  const LBA lba = disc_offset / RAW_SECTOR_SIZE;
+  if (lba >= m_lba_count)
+    return false;
 
-          sector[0x10] = sector[0x14];
-          sector[0x11] = sector[0x15];
-          sector[0x12] = sector[0x16];
-          sector[0x13] = sector[0x17];
+  u32 current = m_lba_chunks[lba];
+  while ((m_chunks[current].disc_offset + m_chunks[current].chunk_size) <= disc_offset)
+    current++;
 
-          edc_set(&sector[2348], edc_compute(&sector[16], 2332));
-          skip = 0x10;
-        }
-        break;
+  // extra bytes if we need to buffer some at the start
+  m_chunk_start = m_chunks[current].disc_offset;
+  m_chunk_buffer.clear();
+  if (m_chunk_start < disc_offset)
+    size += (disc_offset - m_chunk_start);
 
-        default:
-          UnreachableCode();
-          return false;
-      }
+  u8 stored[RAW_SECTOR_SIZE];
+  u32 total_bytes_read = 0;
+  while (total_bytes_read < size)
+  {
+    if (current == m_chunks.size())
+      return false;
 
-      std::memcpy(&m_chunk_buffer[chunk_start], sector + skip, chunk_size);
-      total_bytes_read += chunk_size;
-    }
+    const SectorEntry& entry = m_chunks[current];
+    if (std::fseek(m_fp, entry.file_offset, SEEK_SET) != 0 || std::fread(stored, GetStoredSize(entry), 1, m_fp) != 1)
+      return false;
 
-    ++current;
+    const u32 chunk_start = static_cast<u32>(m_chunk_buffer.size());
+    m_chunk_buffer.resize(chunk_start + entry.chunk_size);
+    DecodeChunk(entry, stored, &m_chunk_buffer[chunk_start]);
+    total_bytes_read += entry.chunk_size;
+    current++;
   }
 
   return true;
@@ -387,6 +549,22 @@ bool CDImageEcm::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
   const u32 file_start = static_cast<u32>(index.file_offset) + (lba_in_index * index.file_sector_size);
   const u32 file_end = file_start + RAW_SECTOR_SIZE;
 
+  if (!m_precache_data.empty())
+  {
+    if (file_end > m_precache_data.size())
+      return false;
+
+    std::memcpy(buffer, &m_precache_data[file_start], RAW_SECTOR_SIZE);
+    return true;
+  }
+
+  const LBA disc_lba = file_start / RAW_SECTOR_SIZE;
+  if (const SectorBuffer* cached = m_sector_cache.Lookup(disc_lba))
+  {
+    std::memcpy(buffer, cached->data(), RAW_SECTOR_SIZE);
+    return true;
+  }
+
   if (file_start < m_chunk_start || file_end > (m_chunk_start + m_chunk_buffer.size()))
   {
     if (!ReadChunks(file_start, RAW_SECTOR_SIZE))
@@ -396,10 +574,97 @@ bool CDImageEcm::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
   DebugAssert(file_start >= m_chunk_start && file_end <= (m_chunk_start + m_chunk_buffer.size()));
 
   const size_t chunk_offset = static_cast<size_t>(file_start - m_chunk_start);
-  std::memcpy(buffer, &m_chunk_buffer[chunk_offset], RAW_SECTOR_SIZE);
+  SectorBuffer* sector = m_sector_cache.Insert(disc_lba, SectorBuffer());
+  std::memcpy(sector->data(), &m_chunk_buffer[chunk_offset], RAW_SECTOR_SIZE);
+  std::memcpy(buffer, sector->data(), RAW_SECTOR_SIZE);
   return true;
 }
 
+CDImage::PrecacheResult CDImageEcm::Precache(ProgressCallback* progress)
+{
+  if (!m_precache_data.empty())
+    return CDImage::PrecacheResult::Success;
+
+  progress->SetStatusText(fmt::format("Precaching {}...", FileSystem::GetDisplayNameFromPath(m_filename)).c_str());
+
+  const SectorEntry& last_chunk = m_chunks.back();
+  std::vector<u8> data(last_chunk.disc_offset + last_chunk.chunk_size);
+
+  const u32 num_chunks = static_cast<u32>(m_chunks.size());
+  const u32 num_threads = std::clamp(std::thread::hardware_concurrency(), 1u, MAX_PRECACHE_THREADS);
+  progress->SetProgressRange(num_threads);
+  progress->SetProgressValue(0);
+
+  // Each thread decodes a contiguous run of chunks, reading the stored data through its own file handle in windows
+  // of PRECACHE_READ_SIZE, so the ECM file is never held in memory alongside the decoded image.
+  std::atomic_bool failed{false};
+  const auto worker = [this, &data, &failed](u32 start, u32 end) {
+    if (start == end)
+      return;
+
+    auto fp = FileSystem::OpenManagedSharedCFile(m_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite,
+                                                 nullptr);
+    if (!fp)
+    {
+      failed.store(true, std::memory_order_relaxed);
+      return;
+    }
+
+    const u32 slice_end = m_chunks[end - 1].file_offset + GetStoredSize(m_chunks[end - 1]);
+    std::vector<u8> buffer;
+    u32 buffer_start = 0;
+    for (u32 i = start; i < end && !failed.load(std::memory_order_relaxed); i++)
+    {
+      const SectorEntry& entry = m_chunks[i];
+      const u32 stored_size = GetStoredSize(entry);
+      if (entry.file_offset < buffer_start || (entry.file_offset + stored_size) > (buffer_start + buffer.size()))
+      {
+        buffer_start = entry.file_offset;
+        buffer.resize(std::max(std::min(PRECACHE_READ_SIZE, slice_end - buffer_start), stored_size));
+        if (FileSystem::FSeek64(fp.get(), buffer_start, SEEK_SET) != 0 ||
+            std::fread(buffer.data(), buffer.size(), 1, fp.get()) != 1) [[unlikely]]
+        {
+          failed.store(true, std::memory_order_relaxed);
+          return;
+        }
+      }
+
+      DecodeChunk(entry, &buffer[entry.file_offset - buffer_start], &data[entry.disc_offset]);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (u32 i = 0; i < num_threads; i++)
+  {
+    const u32 start = static_cast<u32>((static_cast<u64>(num_chunks) * i) / num_threads);
+    const u32 end = static_cast<u32>((static_cast<u64>(num_chunks) * (i + 1)) / num_threads);
+    threads.emplace_back(worker, start, end);
+  }
+  for (u32 i = 0; i < num_threads; i++)
+  {
+    threads[i].join();
+    progress->SetProgressValue(i + 1);
+  }
+
+  if (failed.load(std::memory_order_relaxed))
+  {
+    ERROR_LOG("Failed to read chunks while precaching");
+    return CDImage::PrecacheResult::ReadError;
+  }
+
+  m_precache_data = std::move(data);
+  m_sector_cache.Clear();
+  m_chunk_buffer = {};
+  m_chunk_start = 0;
+  return CDImage::PrecacheResult::Success;
+}
+
+bool CDImageEcm::IsPrecached() const
+{
+  return !m_precache_data.empty();
+}
+
 s64 CDImageEcm::GetSizeOnDisk() const
 {
   return FileSystem::FSize64(m_fp);
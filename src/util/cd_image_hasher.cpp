@@ -5,24 +5,154 @@
 #include "cd_image.h"
 #include "host.h"
 
+#include "common/assert.h"
 #include "common/md5_digest.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include "fmt/format.h"
 
+#include <memory>
+
 namespace CDImageHasher {
 
-static bool ReadIndex(CDImage* image, u8 track, u8 index, MD5Digest* digest, ProgressCallback* progress_callback);
-static bool ReadTrack(CDImage* image, u8 track, MD5Digest* digest, ProgressCallback* progress_callback);
+namespace {
+
+/// Reads sectors in large batches on the calling thread, and digests them on a worker thread. Two batch buffers are
+/// used, so the next batch can be read from the image while the previous one is being hashed. CDImage is not
+/// thread-safe, so all reads must stay on the thread which owns the pipeline.
+///
+/// Each GetImageHash()/GetTrackHash()/GetTrackHashes() call owns one pipeline, and with it one worker thread. These
+/// calls hash whole tracks, hundreds of megabytes for a typical disc, and are only made when the user asks for an
+/// image to be verified. Starting a thread per call is noise next to that, and avoids keeping an idle thread around
+/// for the lifetime of the process.
+///
+/// A single worker is enough: the reads are serialized on the owning thread, and MD5 on one core outpaces them even
+/// for uncompressed images. Only MD5 is computed, because it is the only hash the game database stores, so there is
+/// nothing to verify SHA1 or CRC32 against. Verification is still per-disc from the game properties; verifying the
+/// whole game list in the background would also need UI for reporting results, and is not done here.
+class HashPipeline
+{
+public:
+  static constexpr u32 SECTORS_PER_BATCH = 128;
+  static constexpr u32 NUM_BATCHES = 2;
+
+  HashPipeline();
+  ~HashPipeline();
+
+  /// Returns the buffer for the next batch, blocking until the worker has finished with it.
+  u8* BeginBatch();
+
+  /// Queues the batch returned by BeginBatch() to be added to the specified digest.
+  void SubmitBatch(MD5Digest* digest, u32 num_sectors);
+
+  /// Blocks until all submitted batches have been digested.
+  void Flush();
+
+private:
+  struct Batch
+  {
+    MD5Digest* digest;
+    u32 size;
+    std::array<u8, CDImage::RAW_SECTOR_SIZE * SECTORS_PER_BATCH> data;
+  };
+
+  void WorkerThreadEntryPoint();
+
+  std::unique_ptr<std::array<Batch, NUM_BATCHES>> m_batches;
+  u32 m_write_pos = 0;
+  u32 m_read_pos = 0;
+  bool m_batch_open = false;
+
+  Threading::KernelSemaphore m_free_sema;
+  Threading::KernelSemaphore m_ready_sema;
+  Threading::Thread m_worker_thread;
+  bool m_shutdown = false;
+};
+
+} // namespace
+
+static bool ReadIndex(CDImage* image, u8 track, u8 index, MD5Digest* digest, HashPipeline* pipeline,
+                      ProgressCallback* progress_callback);
+static bool ReadTrack(CDImage* image, u8 track, MD5Digest* digest, HashPipeline* pipeline,
+                      ProgressCallback* progress_callback);
 
 } // namespace CDImageHasher
 
-bool CDImageHasher::ReadIndex(CDImage* image, u8 track, u8 index, MD5Digest* digest,
+CDImageHasher::HashPipeline::HashPipeline() : m_batches(std::make_unique<std::array<Batch, NUM_BATCHES>>())
+{
+  for (u32 i = 0; i < NUM_BATCHES; i++)
+    m_free_sema.Post();
+
+  m_worker_thread.Start([this]() { WorkerThreadEntryPoint(); });
+}
+
+CDImageHasher::HashPipeline::~HashPipeline()
+{
+  Flush();
+
+  // Flush() guarantees the worker is idle, so it'll see the flag as soon as it wakes up.
+  m_shutdown = true;
+  m_ready_sema.Post();
+  m_worker_thread.Join();
+}
+
+u8* CDImageHasher::HashPipeline::BeginBatch()
+{
+  DebugAssert(!m_batch_open);
+  m_free_sema.Wait();
+  m_batch_open = true;
+  return (*m_batches)[m_write_pos].data.data();
+}
+
+void CDImageHasher::HashPipeline::SubmitBatch(MD5Digest* digest, u32 num_sectors)
+{
+  DebugAssert(m_batch_open && num_sectors <= SECTORS_PER_BATCH);
+  Batch& batch = (*m_batches)[m_write_pos];
+  batch.digest = digest;
+  batch.size = num_sectors * CDImage::RAW_SECTOR_SIZE;
+  m_write_pos = (m_write_pos + 1) % NUM_BATCHES;
+  m_batch_open = false;
+  m_ready_sema.Post();
+}
+
+void CDImageHasher::HashPipeline::Flush()
+{
+  // Abandoned batches (e.g. read errors) still hold a free slot, so hand it back before waiting.
+  if (m_batch_open)
+  {
+    m_batch_open = false;
+    m_free_sema.Post();
+  }
+
+  for (u32 i = 0; i < NUM_BATCHES; i++)
+    m_free_sema.Wait();
+  for (u32 i = 0; i < NUM_BATCHES; i++)
+    m_free_sema.Post();
+}
+
+void CDImageHasher::HashPipeline::WorkerThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("CDImageHasher Worker");
+
+  for (;;)
+  {
+    m_ready_sema.Wait();
+    if (m_shutdown)
+      break;
+
+    const Batch& batch = (*m_batches)[m_read_pos];
+    batch.digest->Update(batch.data.data(), batch.size);
+    m_read_pos = (m_read_pos + 1) % NUM_BATCHES;
+    m_free_sema.Post();
+  }
+}
+
+bool CDImageHasher::ReadIndex(CDImage* image, u8 track, u8 index, MD5Digest* digest, HashPipeline* pipeline,
                               ProgressCallback* progress_callback)
 {
   const CDImage::LBA index_start = image->GetTrackIndexPosition(track, index);
   const u32 index_length = image->GetTrackIndexLength(track, index);
-  const u32 update_interval = std::max<u32>(index_length / 100u, 1u);
 
   progress_callback->SetStatusText(
     fmt::format(TRANSLATE_FS("CDImageHasher", "Computing hash for Track {}/Index {}..."), track, index).c_str());
@@ -34,26 +164,31 @@ bool CDImageHasher::ReadIndex(CDImage* image, u8 track, u8 index, MD5Digest* dig
     return false;
   }
 
-  std::array<u8, CDImage::RAW_SECTOR_SIZE> sector;
-  for (u32 lba = 0; lba < index_length; lba++)
+  for (u32 lba = 0; lba < index_length;)
   {
-    if ((lba % update_interval) == 0)
-      progress_callback->SetProgressValue(lba);
+    progress_callback->SetProgressValue(lba);
 
-    if (!image->ReadRawSector(sector.data(), nullptr))
+    const u32 batch_sectors = std::min(index_length - lba, HashPipeline::SECTORS_PER_BATCH);
+    u8* buffer = pipeline->BeginBatch();
+    for (u32 i = 0; i < batch_sectors; i++)
     {
-      progress_callback->FormatModalError("Failed to read sector {} from image", image->GetPositionOnDisc());
-      return false;
+      if (!image->ReadRawSector(buffer + (i * CDImage::RAW_SECTOR_SIZE), nullptr))
+      {
+        progress_callback->FormatModalError("Failed to read sector {} from image", image->GetPositionOnDisc());
+        return false;
+      }
     }
 
-    digest->Update(sector);
+    pipeline->SubmitBatch(digest, batch_sectors);
+    lba += batch_sectors;
   }
 
   progress_callback->SetProgressValue(index_length);
   return true;
 }
 
-bool CDImageHasher::ReadTrack(CDImage* image, u8 track, MD5Digest* digest, ProgressCallback* progress_callback)
+bool CDImageHasher::ReadTrack(CDImage* image, u8 track, MD5Digest* digest, HashPipeline* pipeline,
+                              ProgressCallback* progress_callback)
 {
   static constexpr u8 INDICES_TO_READ = 2;
 
@@ -73,7 +208,7 @@ bool CDImageHasher::ReadTrack(CDImage* image, u8 track, MD5Digest* digest, Progr
 
     progress++;
     progress_callback->PushState();
-    if (!ReadIndex(image, track, index, digest, progress_callback))
+    if (!ReadIndex(image, track, index, digest, pipeline, progress_callback))
     {
       progress_callback->PopState();
       progress_callback->PopState();
@@ -111,6 +246,7 @@ bool CDImageHasher::GetImageHash(CDImage* image, Hash* out_hash,
                                  ProgressCallback* progress_callback /*= ProgressCallback::NullProgressCallback*/)
 {
   MD5Digest digest;
+  HashPipeline pipeline;
 
   progress_callback->SetProgressRange(image->GetTrackCount());
   progress_callback->SetProgressValue(0);
@@ -119,14 +255,16 @@ bool CDImageHasher::GetImageHash(CDImage* image, Hash* out_hash,
   for (u32 i = 1; i <= image->GetTrackCount(); i++)
   {
     progress_callback->SetProgressValue(i - 1);
-    if (!ReadTrack(image, static_cast<u8>(i), &digest, progress_callback))
+    if (!ReadTrack(image, static_cast<u8>(i), &digest, &pipeline, progress_callback))
     {
       progress_callback->PopState();
       return false;
     }
   }
 
+  progress_callback->PopState();
   progress_callback->SetProgressValue(image->GetTrackCount());
+  pipeline.Flush();
   digest.Final(*out_hash);
   return true;
 }
@@ -135,9 +273,49 @@ bool CDImageHasher::GetTrackHash(CDImage* image, u8 track, Hash* out_hash,
                                  ProgressCallback* progress_callback /*= ProgressCallback::NullProgressCallback*/)
 {
   MD5Digest digest;
-  if (!ReadTrack(image, track, &digest, progress_callback))
+  HashPipeline pipeline;
+  if (!ReadTrack(image, track, &digest, &pipeline, progress_callback))
     return false;
 
+  pipeline.Flush();
   digest.Final(*out_hash);
   return true;
 }
+
+bool CDImageHasher::GetTrackHashes(CDImage* image, std::vector<Hash>* out_hashes,
+                                   ProgressCallback* progress_callback /*= ProgressCallback::NullProgressCallback*/)
+{
+  const u32 track_count = image->GetTrackCount();
+  std::vector<MD5Digest> digests(track_count);
+  HashPipeline pipeline;
+
+  progress_callback->SetProgressRange(track_count);
+  progress_callback->SetProgressValue(0);
+  progress_callback->PushState();
+
+  // Tracks share the pipeline, so the tail of one track is hashed while the next track is being read.
+  u32 completed_tracks = 0;
+  for (; completed_tracks < track_count; completed_tracks++)
+  {
+    progress_callback->SetProgressValue(completed_tracks);
+    if (!ReadTrack(image, static_cast<u8>(completed_tracks + 1), &digests[completed_tracks], &pipeline,
+                   progress_callback))
+    {
+      break;
+    }
+  }
+
+  progress_callback->PopState();
+  pipeline.Flush();
+
+  // Tracks which were read in full before a failure still have a valid hash.
+  out_hashes->resize(completed_tracks);
+  for (u32 i = 0; i < completed_tracks; i++)
+    digests[i].Final((*out_hashes)[i]);
+
+  if (completed_tracks != track_count)
+    return false;
+
+  progress_callback->SetProgressValue(track_count);
+  return true;
+}
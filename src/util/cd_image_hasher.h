@@ -7,6 +7,7 @@
 #include <array>
 #include <optional>
 #include <string>
+#include <vector>
 
 class CDImage;
 
@@ -21,4 +22,9 @@ bool GetImageHash(CDImage* image, Hash* out_hash,
 bool GetTrackHash(CDImage* image, u8 track, Hash* out_hash,
                   ProgressCallback* progress_callback = ProgressCallback::NullProgressCallback);
 
+/// Computes the hash of every track in a single pass over the image, ordered by track number. On failure, out_hashes
+/// holds the hashes of the tracks which were read in full before the error.
+bool GetTrackHashes(CDImage* image, std::vector<Hash>* out_hashes,
+                    ProgressCallback* progress_callback = ProgressCallback::NullProgressCallback);
+
 } // namespace CDImageHasher
\ No newline at end of file
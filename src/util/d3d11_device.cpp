@@ -192,6 +192,7 @@ void D3D11Device::SetFeatures(FeatureMask disabled_features)
   m_features.shader_cache = true;
   m_features.pipeline_cache = false;
   m_features.prefer_unused_textures = false;
+  m_features.threaded_shader_creation = false;
   m_features.raster_order_views = false;
   if (!(disabled_features & FEATURE_MASK_RASTER_ORDER_VIEWS))
   {
@@ -589,6 +589,9 @@ std::optional<DynamicHeapArray<u8>> D3DCommon::CompileShaderWithDXC(u32 shader_m
 
 bool D3DCommon::LoadDXCompilerLibrary(Error* error)
 {
+  // Shaders can be compiled on several threads, see GPUDevice::Features::threaded_shader_creation.
+  static std::mutex load_mutex;
+  std::unique_lock lock(load_mutex);
   if (s_dxcompiler_library.IsOpen())
     return true;
 
@@ -347,7 +347,7 @@ GPUDevice::AdapterInfoList GPUDevice::GetAdapterListForAPI(RenderAPI api)
 }
 
 bool GPUDevice::Create(std::string_view adapter, std::string_view shader_cache_path, u32 shader_cache_version,
-                       bool debug_device, GPUVSyncMode vsync, bool allow_present_throttle,
+                       bool preload_shader_cache, bool debug_device, GPUVSyncMode vsync, bool allow_present_throttle,
                        std::optional<bool> exclusive_fullscreen_control, FeatureMask disabled_features, Error* error)
 {
   m_vsync_mode = vsync;
@@ -370,7 +370,7 @@ bool GPUDevice::Create(std::string_view adapter, std::string_view shader_cache_p
   INFO_LOG("Render API: {} Version {}", RenderAPIToString(m_render_api), m_render_api_version);
   INFO_LOG("Graphics Driver Info:\n{}", GetDriverInfo());
 
-  OpenShaderCache(shader_cache_path, shader_cache_version);
+  OpenShaderCache(shader_cache_path, shader_cache_version, preload_shader_cache);
 
   if (!CreateResources(error))
   {
@@ -396,7 +396,7 @@ bool GPUDevice::SupportsExclusiveFullscreen() const
   return false;
 }
 
-void GPUDevice::OpenShaderCache(std::string_view base_path, u32 version)
+void GPUDevice::OpenShaderCache(std::string_view base_path, u32 version, bool preload)
 {
   if (m_features.shader_cache && !base_path.empty())
   {
@@ -427,6 +427,10 @@ void GPUDevice::OpenShaderCache(std::string_view base_path, u32 version)
     m_shader_cache.Open(std::string_view(), m_render_api_version, version);
   }
 
+  // Get the binaries off disk while the caller is busy generating sources.
+  if (preload)
+    m_shader_cache.StartPreload();
+
   s_pipeline_cache_path = {};
   s_pipeline_cache_size = 0;
   s_pipeline_cache_hash = {};
@@ -473,9 +477,14 @@ void GPUDevice::CloseShaderCache()
 
 std::string GPUDevice::GetShaderCacheBaseName(std::string_view type) const
 {
-  const std::string_view debug_suffix = m_debug_device ? "_debug" : "";
+  return GetShaderCacheBaseName(m_render_api, m_debug_device, type);
+}
+
+std::string GPUDevice::GetShaderCacheBaseName(RenderAPI api, bool debug_device, std::string_view type)
+{
+  const std::string_view debug_suffix = debug_device ? "_debug" : "";
 
-  TinyString lower_api_name(RenderAPIToString(m_render_api));
+  TinyString lower_api_name(RenderAPIToString(api));
   lower_api_name.convert_to_lower_case();
 
   return fmt::format("{}_{}{}", lower_api_name, type, debug_suffix);
@@ -752,19 +761,31 @@ void GPUDevice::InvalidateRenderTarget(GPUTexture* t)
   t->SetState(GPUTexture::State::Invalidated);
 }
 
+bool GPUDevice::ExportShaderCache(const char* path, Error* error)
+{
+  std::unique_lock lock(m_shader_cache_mutex);
+  return m_shader_cache.ExportBundle(path, error);
+}
+
 std::unique_ptr<GPUShader> GPUDevice::CreateShader(GPUShaderStage stage, GPUShaderLanguage language,
                                                    std::string_view source, Error* error /* = nullptr */,
                                                    const char* entry_point /* = "main" */)
 {
   std::unique_ptr<GPUShader> shader;
+
+  // With threaded_shader_creation, this can be called from several threads at once. Only the cache needs the lock,
+  // compilation itself runs unlocked.
+  std::unique_lock lock(m_shader_cache_mutex);
   if (!m_shader_cache.IsOpen())
   {
+    lock.unlock();
     shader = CreateShaderFromSource(stage, language, source, entry_point, nullptr, error);
     return shader;
   }
 
   const GPUShaderCache::CacheIndexKey key = m_shader_cache.GetCacheKey(stage, language, source, entry_point);
   std::optional<GPUShaderCache::ShaderBinary> binary = m_shader_cache.Lookup(key);
+  lock.unlock();
   if (binary.has_value())
   {
     shader = CreateShaderFromBinary(stage, binary->cspan(), error);
@@ -772,7 +793,9 @@ std::unique_ptr<GPUShader> GPUDevice::CreateShader(GPUShaderStage stage, GPUShad
       return shader;
 
     ERROR_LOG("Failed to create shader from binary (driver changed?). Clearing cache.");
+    lock.lock();
     m_shader_cache.Clear();
+    lock.unlock();
     binary.reset();
   }
 
@@ -784,7 +807,8 @@ std::unique_ptr<GPUShader> GPUDevice::CreateShader(GPUShaderStage stage, GPUShad
   // Don't insert empty shaders into the cache...
   if (!new_binary.empty())
   {
-    if (!m_shader_cache.Insert(key, new_binary.data(), static_cast<u32>(new_binary.size())))
+    lock.lock();
+    if (m_shader_cache.IsOpen() && !m_shader_cache.Insert(key, new_binary.data(), static_cast<u32>(new_binary.size())))
       m_shader_cache.Close();
   }
 
@@ -1167,6 +1191,11 @@ bool GPUDevice::SetGPUTimingEnabled(bool enabled)
   return false;
 }
 
+bool GPUDevice::SetThreadedSubmission(bool enabled)
+{
+  return false;
+}
+
 float GPUDevice::GetAndResetAccumulatedGPUTime()
 {
   return 0.0f;
@@ -1275,6 +1304,7 @@ static DynamicLibrary s_shaderc_library;
 static DynamicLibrary s_spirv_cross_library;
 
 static shaderc_compiler_t s_shaderc_compiler = nullptr;
+static std::mutex s_open_mutex;
 
 static bool s_close_registered = false;
 
@@ -1289,6 +1319,8 @@ SPIRV_CROSS_MSL_FUNCTIONS(ADD_FUNC)
 
 bool dyn_libs::OpenShaderc(Error* error)
 {
+  // Shaders can be compiled on several threads, see GPUDevice::Features::threaded_shader_creation.
+  std::unique_lock lock(s_open_mutex);
   if (s_shaderc_library.IsOpen())
     return true;
 
@@ -1344,6 +1376,7 @@ void dyn_libs::CloseShaderc()
 
 bool dyn_libs::OpenSpirvCross(Error* error)
 {
+  std::unique_lock lock(s_open_mutex);
   if (s_spirv_cross_library.IsOpen())
     return true;
 
@@ -16,6 +16,7 @@
 #include <cstring>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
@@ -508,6 +509,7 @@ public:
     bool pipeline_cache : 1;
     bool prefer_unused_textures : 1;
     bool raster_order_views : 1;
+    bool threaded_shader_creation : 1;
   };
 
   struct Statistics
@@ -565,6 +567,9 @@ public:
   /// Returns a list of adapters for the given API.
   static AdapterInfoList GetAdapterListForAPI(RenderAPI api);
 
+  /// Returns the base filename of the shader/pipeline cache for the given API, without an extension.
+  static std::string GetShaderCacheBaseName(RenderAPI api, bool debug_device, std::string_view type);
+
   /// Parses a fullscreen mode into its components (width * height @ refresh hz)
   static bool GetRequestedExclusiveFullscreenMode(u32* width, u32* height, float* refresh_rate);
 
@@ -611,9 +616,9 @@ public:
 
   ALWAYS_INLINE bool IsGPUTimingEnabled() const { return m_gpu_timing_enabled; }
 
-  bool Create(std::string_view adapter, std::string_view shader_cache_path, u32 shader_cache_version, bool debug_device,
-              GPUVSyncMode vsync, bool allow_present_throttle, std::optional<bool> exclusive_fullscreen_control,
-              FeatureMask disabled_features, Error* error);
+  bool Create(std::string_view adapter, std::string_view shader_cache_path, u32 shader_cache_version,
+              bool preload_shader_cache, bool debug_device, GPUVSyncMode vsync, bool allow_present_throttle,
+              std::optional<bool> exclusive_fullscreen_control, FeatureMask disabled_features, Error* error);
   void Destroy();
 
   virtual bool HasSurface() const = 0;
@@ -668,6 +673,9 @@ public:
   virtual std::unique_ptr<GPUPipeline> CreatePipeline(const GPUPipeline::GraphicsConfig& config,
                                                       Error* error = nullptr) = 0;
 
+  /// Writes the shader cache to a portable bundle, see GPUShaderCache::ImportBundle().
+  bool ExportShaderCache(const char* path, Error* error);
+
   /// Debug messaging.
   virtual void PushDebugGroup(const char* name) = 0;
   virtual void PopDebugGroup() = 0;
@@ -738,6 +746,10 @@ public:
   /// Enables/disables GPU frame timing.
   virtual bool SetGPUTimingEnabled(bool enabled);
 
+  /// Enables/disables handing command buffer submission and presentation off to a worker thread.
+  /// Returns false if the backend does not support threaded submission.
+  virtual bool SetThreadedSubmission(bool enabled);
+
   /// Returns the amount of GPU time utilized since the last time this method was called.
   virtual float GetAndResetAccumulatedGPUTime();
 
@@ -788,6 +800,7 @@ protected:
   u64 m_last_frame_displayed_time = 0;
 
   GPUShaderCache m_shader_cache;
+  std::mutex m_shader_cache_mutex;
 
   std::unique_ptr<GPUSampler> m_nearest_sampler;
   std::unique_ptr<GPUSampler> m_linear_sampler;
@@ -832,7 +845,7 @@ private:
   static AdapterInfoList WrapGetMetalAdapterList();
 #endif
 
-  void OpenShaderCache(std::string_view base_path, u32 version);
+  void OpenShaderCache(std::string_view base_path, u32 version, bool preload);
   void CloseShaderCache();
   bool CreateResources(Error* error);
   void DestroyResources();
@@ -10,9 +10,12 @@
 #include "common/log.h"
 #include "common/md5_digest.h"
 #include "common/path.h"
+#include "common/threading.h"
 
 #include "fmt/format.h"
 
+#include <algorithm>
+
 #include "compress_helpers.h"
 
 Log_SetChannel(GPUShaderCache);
@@ -38,9 +41,21 @@ struct CacheIndexEntry
   u32 compressed_size;
   u32 uncompressed_size;
 };
+struct BundleFileHeader
+{
+  u32 signature;
+  u32 render_api_version;
+  u32 cache_version;
+  u32 num_entries;
+  char base_name[64];
+};
 #pragma pack(pop)
 
-static constexpr u32 EXPECTED_SIGNATURE = 0x434B5544; // DUKC
+static constexpr u32 EXPECTED_SIGNATURE = 0x434B5544;        // DUKC
+static constexpr u32 EXPECTED_BUNDLE_SIGNATURE = 0x424B5544; // DUKB
+
+// Stop preloading past this, the remaining shaders will be read on demand.
+static constexpr size_t MAX_PRELOAD_SIZE = 32 * 1024 * 1024;
 
 GPUShaderCache::GPUShaderCache() = default;
 
@@ -90,6 +105,8 @@ bool GPUShaderCache::Create()
 
 void GPUShaderCache::Close()
 {
+  StopPreload();
+
   if (m_index_file)
   {
     std::fclose(m_index_file);
@@ -268,6 +285,20 @@ std::optional<GPUShaderCache::ShaderBinary> GPUShaderCache::Lookup(const CacheIn
 {
   std::optional<ShaderBinary> ret;
 
+  {
+    // Shaders are generally only looked up once per pipeline compile, so there's no point keeping it around.
+    std::unique_lock lock(m_preload_mutex);
+    if (auto it = m_preloaded_shaders.find(key); it != m_preloaded_shaders.end())
+    {
+      ret = std::move(it->second);
+      m_preloaded_shaders.erase(it);
+      return ret;
+    }
+
+    // The preload thread may not have got to this entry yet. It'll skip it, otherwise it would sit in memory forever.
+    m_preload_pending.erase(key);
+  }
+
   auto iter = m_index.find(key);
   if (iter != m_index.end())
   {
@@ -304,13 +335,19 @@ bool GPUShaderCache::Insert(const CacheIndexKey& key, const void* data, u32 data
     return false;
   }
 
+  return WriteEntry(key, compress_buffer->data(), static_cast<u32>(compress_buffer->size()), data_size);
+}
+
+bool GPUShaderCache::WriteEntry(const CacheIndexKey& key, const void* compressed_data, u32 compressed_size,
+                                u32 uncompressed_size)
+{
   if (!m_blob_file || std::fseek(m_blob_file, 0, SEEK_END) != 0)
     return false;
 
   CacheIndexData idata;
   idata.file_offset = static_cast<u32>(std::ftell(m_blob_file));
-  idata.compressed_size = static_cast<u32>(compress_buffer->size());
-  idata.uncompressed_size = data_size;
+  idata.compressed_size = compressed_size;
+  idata.uncompressed_size = uncompressed_size;
 
   CacheIndexEntry entry = {};
   entry.shader_type = static_cast<u8>(key.shader_type);
@@ -324,17 +361,311 @@ bool GPUShaderCache::Insert(const CacheIndexKey& key, const void* data, u32 data
   entry.compressed_size = idata.compressed_size;
   entry.uncompressed_size = idata.uncompressed_size;
 
-  if (std::fwrite(compress_buffer->data(), compress_buffer->size(), 1, m_blob_file) != 1 ||
-      std::fflush(m_blob_file) != 0 || std::fwrite(&entry, sizeof(entry), 1, m_index_file) != 1 ||
-      std::fflush(m_index_file) != 0) [[unlikely]]
+  if (std::fwrite(compressed_data, compressed_size, 1, m_blob_file) != 1 || std::fflush(m_blob_file) != 0 ||
+      std::fwrite(&entry, sizeof(entry), 1, m_index_file) != 1 || std::fflush(m_index_file) != 0) [[unlikely]]
   {
-    ERROR_LOG("Failed to write {} byte {} shader blob to file", data_size,
+    ERROR_LOG("Failed to write {} byte {} shader blob to file", uncompressed_size,
               GPUShader::GetStageName(static_cast<GPUShaderStage>(key.shader_type)));
     return false;
   }
 
   DEV_LOG("Cached compressed {} shader: {} -> {} bytes",
-          GPUShader::GetStageName(static_cast<GPUShaderStage>(key.shader_type)), data_size, compress_buffer->size());
+          GPUShader::GetStageName(static_cast<GPUShaderStage>(key.shader_type)), uncompressed_size, compressed_size);
   m_index.emplace(key, idata);
   return true;
 }
+
+void GPUShaderCache::StartPreload()
+{
+  StopPreload();
+  if (!IsOpen() || m_index.empty())
+    return;
+
+  // Snapshot the index, new entries can be inserted while the thread is running. Read in file order.
+  std::vector<std::pair<CacheIndexKey, CacheIndexData>> entries(m_index.begin(), m_index.end());
+  std::sort(entries.begin(), entries.end(),
+            [](const auto& lhs, const auto& rhs) { return (lhs.second.file_offset < rhs.second.file_offset); });
+
+  {
+    std::unique_lock lock(m_preload_mutex);
+    m_preload_pending.reserve(entries.size());
+    for (const auto& it : entries)
+      m_preload_pending.insert(it.first);
+  }
+
+  m_preload_cancel.store(false, std::memory_order_release);
+  m_preload_thread = std::thread(&GPUShaderCache::PreloadThreadEntryPoint, this, std::move(entries));
+}
+
+void GPUShaderCache::StopPreload()
+{
+  if (m_preload_thread.joinable())
+  {
+    m_preload_cancel.store(true, std::memory_order_release);
+    m_preload_thread.join();
+  }
+
+  std::unique_lock lock(m_preload_mutex);
+  m_preloaded_shaders.clear();
+  m_preload_pending.clear();
+}
+
+void GPUShaderCache::PreloadThreadEntryPoint(std::vector<std::pair<CacheIndexKey, CacheIndexData>> entries)
+{
+  Threading::SetNameOfCurrentThread("Shader Cache Preload");
+
+  // Separate handle, the main one is used for lookups/inserts while we're running.
+  const std::string blob_filename = fmt::format("{}.bin", m_base_filename);
+  FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(blob_filename.c_str(), "rb");
+  if (!fp)
+  {
+    WARNING_LOG("Failed to open '{}' for preloading", Path::GetFileName(blob_filename));
+    std::unique_lock lock(m_preload_mutex);
+    m_preload_pending.clear();
+    return;
+  }
+
+  size_t total_size = 0;
+  u32 count = 0;
+  for (const auto& [key, data] : entries)
+  {
+    if (m_preload_cancel.load(std::memory_order_acquire) || (total_size + data.uncompressed_size) > MAX_PRELOAD_SIZE)
+      break;
+
+    // Skip the read entirely if it has already been looked up.
+    {
+      std::unique_lock lock(m_preload_mutex);
+      if (!m_preload_pending.contains(key))
+        continue;
+    }
+
+    DynamicHeapArray<u8> compressed_data(data.compressed_size);
+    if (std::fseek(fp.get(), data.file_offset, SEEK_SET) != 0 ||
+        std::fread(compressed_data.data(), data.compressed_size, 1, fp.get()) != 1) [[unlikely]]
+    {
+      WARNING_LOG("Failed to read {} bytes at offset {} while preloading", data.compressed_size, data.file_offset);
+      break;
+    }
+
+    Error error;
+    std::optional<ShaderBinary> binary = CompressHelpers::DecompressBuffer(
+      CompressHelpers::CompressType::Zstandard, CompressHelpers::OptionalByteBuffer(std::move(compressed_data)),
+      data.uncompressed_size, &error);
+    if (!binary.has_value()) [[unlikely]]
+    {
+      WARNING_LOG("Failed to decompress shader while preloading: {}", error.GetDescription());
+      continue;
+    }
+
+    // Already looked up and read from disk while we were decompressing, so nobody will ask for it again.
+    std::unique_lock lock(m_preload_mutex);
+    if (!m_preload_pending.erase(key))
+      continue;
+
+    total_size += data.uncompressed_size;
+    count++;
+    m_preloaded_shaders.emplace(key, std::move(binary.value()));
+  }
+
+  // Lookups for anything we didn't get to go to disk as usual.
+  {
+    std::unique_lock lock(m_preload_mutex);
+    m_preload_pending.clear();
+  }
+
+  DEV_LOG("Preloaded {} of {} shaders ({} bytes)", count, entries.size(), total_size);
+}
+
+bool GPUShaderCache::ExportBundle(const char* path, Error* error)
+{
+  if (!IsOpen())
+  {
+    Error::SetStringView(error, "Shader cache is not open.");
+    return false;
+  }
+
+  const std::string_view base_name = Path::GetFileName(m_base_filename);
+  BundleFileHeader header = {};
+  if (base_name.length() >= std::size(header.base_name))
+  {
+    Error::SetStringFmt(error, "Cache name '{}' is too long.", base_name);
+    return false;
+  }
+
+  header.signature = EXPECTED_BUNDLE_SIGNATURE;
+  header.render_api_version = m_render_api_version;
+  header.cache_version = m_version;
+  header.num_entries = static_cast<u32>(m_index.size());
+  std::memcpy(header.base_name, base_name.data(), base_name.length());
+
+  FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(path, "wb", error);
+  if (!fp)
+    return false;
+
+  if (std::fwrite(&header, sizeof(header), 1, fp.get()) != 1)
+  {
+    Error::SetErrno(error, "fwrite() failed: ", errno);
+    return false;
+  }
+
+  DynamicHeapArray<u8> compressed_data;
+  for (const auto& [key, data] : m_index)
+  {
+    CacheIndexEntry entry = {};
+    entry.shader_type = key.shader_type;
+    entry.shader_language = key.shader_language;
+    entry.source_length = key.source_length;
+    entry.source_hash_low = key.source_hash_low;
+    entry.source_hash_high = key.source_hash_high;
+    entry.entry_point_low = key.entry_point_low;
+    entry.entry_point_high = key.entry_point_high;
+    entry.compressed_size = data.compressed_size;
+    entry.uncompressed_size = data.uncompressed_size;
+
+    compressed_data.resize(data.compressed_size);
+    if (std::fseek(m_blob_file, data.file_offset, SEEK_SET) != 0 ||
+        std::fread(compressed_data.data(), data.compressed_size, 1, m_blob_file) != 1) [[unlikely]]
+    {
+      Error::SetStringFmt(error, "Failed to read {} bytes at offset {} from blob file.", data.compressed_size,
+                          data.file_offset);
+      return false;
+    }
+
+    if (std::fwrite(&entry, sizeof(entry), 1, fp.get()) != 1 ||
+        std::fwrite(compressed_data.data(), data.compressed_size, 1, fp.get()) != 1) [[unlikely]]
+    {
+      Error::SetErrno(error, "fwrite() failed: ", errno);
+      return false;
+    }
+  }
+
+  if (std::fflush(fp.get()) != 0)
+  {
+    Error::SetErrno(error, "fflush() failed: ", errno);
+    return false;
+  }
+
+  INFO_LOG("Exported {} shaders to '{}'", m_index.size(), Path::GetFileName(path));
+  return true;
+}
+
+bool GPUShaderCache::ExportBundle(std::string_view base_filename, u32 cache_version, const char* path, Error* error)
+{
+  // The render API version is only known by the device, so take it from the existing index.
+  const std::string index_filename = fmt::format("{}.idx", base_filename);
+  CacheFileHeader file_header;
+  {
+    FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(index_filename.c_str(), "rb", error);
+    if (!fp)
+      return false;
+
+    if (std::fread(&file_header, sizeof(file_header), 1, fp.get()) != 1 ||
+        file_header.signature != EXPECTED_SIGNATURE)
+    {
+      Error::SetStringFmt(error, "'{}' is not a shader cache index.", Path::GetFileName(index_filename));
+      return false;
+    }
+  }
+
+  GPUShaderCache cache;
+  if (!cache.Open(base_filename, file_header.render_api_version, cache_version) || !cache.IsOpen())
+  {
+    Error::SetStringFmt(error, "Failed to open shader cache '{}'.", Path::GetFileName(base_filename));
+    return false;
+  }
+
+  return cache.ExportBundle(path, error);
+}
+
+bool GPUShaderCache::ImportBundle(std::string_view cache_directory, const char* path, u32 cache_version, Error* error)
+{
+  FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(path, "rb", error);
+  if (!fp)
+    return false;
+
+  BundleFileHeader header;
+  if (std::fread(&header, sizeof(header), 1, fp.get()) != 1 || header.signature != EXPECTED_BUNDLE_SIGNATURE)
+  {
+    Error::SetStringFmt(error, "'{}' is not a shader cache bundle.", Path::GetFileName(path));
+    return false;
+  }
+
+  if (header.cache_version != cache_version)
+  {
+    Error::SetStringFmt(error, "Bundle is for cache version {}, expected {}.", header.cache_version, cache_version);
+    return false;
+  }
+
+  // Don't let the bundle write outside the cache directory.
+  const std::string_view base_name(header.base_name, strnlen(header.base_name, std::size(header.base_name)));
+  if (base_name.empty() || base_name.length() == std::size(header.base_name) ||
+      base_name.find_first_of("/\\:") != std::string_view::npos || base_name.find("..") != std::string_view::npos)
+  {
+    Error::SetStringView(error, "Bundle has an invalid cache name.");
+    return false;
+  }
+
+  // Opening fails if the render API version differs, in which case the cache is replaced.
+  GPUShaderCache cache;
+  if (!cache.Open(Path::Combine(cache_directory, base_name), header.render_api_version, header.cache_version) &&
+      !cache.Create())
+  {
+    Error::SetStringFmt(error, "Failed to create shader cache '{}'.", base_name);
+    return false;
+  }
+  else if (!cache.IsOpen())
+  {
+    Error::SetStringFmt(error, "Shader cache '{}' is in use.", base_name);
+    return false;
+  }
+
+  const s64 bundle_size = FileSystem::FSize64(fp.get(), error);
+  if (bundle_size < 0)
+    return false;
+
+  u32 imported = 0;
+  DynamicHeapArray<u8> compressed_data;
+  for (u32 i = 0; i < header.num_entries; i++)
+  {
+    CacheIndexEntry entry;
+    if (std::fread(&entry, sizeof(entry), 1, fp.get()) != 1) [[unlikely]]
+    {
+      Error::SetStringFmt(error, "Failed to read entry {} of {}, truncated bundle?", i, header.num_entries);
+      return false;
+    }
+
+    // Sizes come from the bundle, don't allocate more than is actually left in the file.
+    const s64 remaining = bundle_size - FileSystem::FTell64(fp.get());
+    if (entry.compressed_size == 0 || static_cast<s64>(entry.compressed_size) > remaining) [[unlikely]]
+    {
+      Error::SetStringFmt(error, "Entry {} of {} has invalid size {}, corrupted bundle?", i, header.num_entries,
+                          entry.compressed_size);
+      return false;
+    }
+
+    compressed_data.resize(entry.compressed_size);
+    if (std::fread(compressed_data.data(), entry.compressed_size, 1, fp.get()) != 1) [[unlikely]]
+    {
+      Error::SetStringFmt(error, "Failed to read data for entry {} of {}, truncated bundle?", i, header.num_entries);
+      return false;
+    }
+
+    const CacheIndexKey key{entry.shader_type,     entry.shader_language, {},
+                            entry.source_length,   entry.source_hash_low, entry.source_hash_high,
+                            entry.entry_point_low, entry.entry_point_high};
+    if (cache.m_index.contains(key))
+      continue;
+
+    if (!cache.WriteEntry(key, compressed_data.data(), entry.compressed_size, entry.uncompressed_size))
+    {
+      Error::SetStringFmt(error, "Failed to write entry {} to shader cache.", i);
+      return false;
+    }
+
+    imported++;
+  }
+
+  INFO_LOG("Imported {} of {} shaders from '{}' into '{}'", imported, header.num_entries, Path::GetFileName(path),
+           base_name);
+  return true;
+}
@@ -7,12 +7,18 @@
 #include "common/heap_array.h"
 #include "common/types.h"
 
+#include <atomic>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+class Error;
+
 enum class GPUShaderStage : u8;
 enum class GPUShaderLanguage : u8;
 
@@ -61,6 +67,22 @@ public:
   bool Insert(const CacheIndexKey& key, const void* data, u32 data_size);
   void Clear();
 
+  /// Decompresses the existing entries on a background thread, so later lookups don't hit the disk. Entries are
+  /// dropped once they have been looked up, and preloading stops at MAX_PRELOAD_SIZE.
+  void StartPreload();
+  void StopPreload();
+
+  /// Writes all entries to a single portable file, which can be imported on another machine with the same
+  /// render API version.
+  bool ExportBundle(const char* path, Error* error);
+
+  /// Exports the cache with the specified base filename without a device, for whichever render API version it was
+  /// created with.
+  static bool ExportBundle(std::string_view base_filename, u32 cache_version, const char* path, Error* error);
+
+  /// Merges the entries from a bundle into the cache in the specified directory, creating it if needed.
+  static bool ImportBundle(std::string_view cache_directory, const char* path, u32 cache_version, Error* error);
+
 private:
   struct CacheIndexData
   {
@@ -71,8 +93,13 @@ private:
 
   using CacheIndex = std::unordered_map<CacheIndexKey, CacheIndexData, CacheIndexEntryHash>;
 
+  using PreloadedShaders = std::unordered_map<CacheIndexKey, ShaderBinary, CacheIndexEntryHash>;
+  using PendingShaders = std::unordered_set<CacheIndexKey, CacheIndexEntryHash>;
+
   bool CreateNew(const std::string& index_filename, const std::string& blob_filename);
   bool ReadExisting(const std::string& index_filename, const std::string& blob_filename);
+  bool WriteEntry(const CacheIndexKey& key, const void* compressed_data, u32 compressed_size, u32 uncompressed_size);
+  void PreloadThreadEntryPoint(std::vector<std::pair<CacheIndexKey, CacheIndexData>> entries);
 
   CacheIndex m_index;
 
@@ -82,4 +109,10 @@ private:
 
   std::FILE* m_index_file = nullptr;
   std::FILE* m_blob_file = nullptr;
+
+  std::thread m_preload_thread;
+  std::mutex m_preload_mutex;
+  PreloadedShaders m_preloaded_shaders;
+  PendingShaders m_preload_pending;
+  std::atomic_bool m_preload_cancel{false};
 };
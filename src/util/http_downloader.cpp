@@ -9,10 +9,13 @@
 #include "common/string_util.h"
 #include "common/timer.h"
 
+#include <algorithm>
+
 Log_SetChannel(HTTPDownloader);
 
 static constexpr float DEFAULT_TIMEOUT_IN_SECONDS = 30;
 static constexpr u32 DEFAULT_MAX_ACTIVE_REQUESTS = 4;
+static constexpr u32 WAIT_FOR_ALL_POLL_INTERVAL_MS = 100;
 
 const char HTTPDownloader::DEFAULT_USER_AGENT[] =
   "Mozilla/5.0 (Windows NT 10.0; Win64; x64; rv:85.0) Gecko/20100101 Firefox/85.0";
@@ -46,7 +49,7 @@ void HTTPDownloader::CreateRequest(std::string url, Request::Callback callback,
   req->start_time = Common::Timer::GetCurrentValue();
 
   std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
-  if (LockedGetActiveRequestCount() < m_max_active_requests)
+  if (!LockedIsPollingOnOtherThread() && LockedGetActiveRequestCount() < m_max_active_requests)
   {
     if (!StartRequest(req))
       return;
@@ -68,7 +71,7 @@ void HTTPDownloader::CreatePostRequest(std::string url, std::string post_data, R
   req->start_time = Common::Timer::GetCurrentValue();
 
   std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
-  if (LockedGetActiveRequestCount() < m_max_active_requests)
+  if (!LockedIsPollingOnOtherThread() && LockedGetActiveRequestCount() < m_max_active_requests)
   {
     if (!StartRequest(req))
       return;
@@ -86,14 +89,12 @@ void HTTPDownloader::LockedPollRequests(std::unique_lock<std::mutex>& lock)
 
   const Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
   u32 active_requests = 0;
-  u32 unstarted_requests = 0;
 
   for (size_t index = 0; index < m_pending_http_requests.size();)
   {
     Request* req = m_pending_http_requests[index];
     if (req->state == Request::State::Pending)
     {
-      unstarted_requests++;
       index++;
       continue;
     }
@@ -164,8 +165,8 @@ void HTTPDownloader::LockedPollRequests(std::unique_lock<std::mutex>& lock)
     lock.lock();
   }
 
-  // start new requests when we finished some
-  if (unstarted_requests > 0 && active_requests < m_max_active_requests)
+  // start new requests when we finished some, or other threads queued them
+  if (active_requests < m_max_active_requests)
   {
     for (size_t index = 0; index < m_pending_http_requests.size();)
     {
@@ -191,26 +192,107 @@ void HTTPDownloader::LockedPollRequests(std::unique_lock<std::mutex>& lock)
   }
 }
 
-void HTTPDownloader::PollRequests()
+void HTTPDownloader::PollRequests(u32 wait_timeout_ms)
 {
   std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
+  LockedBeginPoll(lock);
+
+  if (wait_timeout_ms > 0 && !m_pending_http_requests.empty())
+  {
+    // other threads can queue requests while we wait, and wake us up to start them
+    lock.unlock();
+    InternalWaitForRequests(wait_timeout_ms);
+    lock.lock();
+  }
+
   LockedPollRequests(lock);
+  LockedEndPoll();
 }
 
 void HTTPDownloader::WaitForAllRequests()
 {
   std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
+  LockedBeginPoll(lock);
+
   while (!m_pending_http_requests.empty())
   {
     // Don't burn too much CPU.
-    Common::Timer::NanoSleep(1000000);
+    lock.unlock();
+    InternalWaitForRequests(WAIT_FOR_ALL_POLL_INTERVAL_MS);
+    lock.lock();
     LockedPollRequests(lock);
   }
+
+  LockedEndPoll();
+}
+
+void HTTPDownloader::InternalWaitForRequests(u32 timeout_ms)
+{
+  // Backends which can't wait on their sockets just sleep for a short while.
+  Common::Timer::NanoSleep(static_cast<u64>(std::min(timeout_ms, 1u)) * 1000000);
+}
+
+void HTTPDownloader::InternalInterruptWait()
+{
+  // The default wait is short enough that it doesn't need interrupting.
+}
+
+void HTTPDownloader::LockedBeginPoll(std::unique_lock<std::mutex>& lock)
+{
+  // Callbacks run on the polling thread, and are allowed to poll again.
+  while (LockedIsPollingOnOtherThread())
+  {
+    InternalInterruptWait();
+    m_poll_done_cv.wait(lock);
+  }
+
+  m_poll_thread = std::this_thread::get_id();
+  m_poll_depth++;
+}
+
+void HTTPDownloader::LockedEndPoll()
+{
+  DebugAssert(m_poll_depth > 0 && m_poll_thread == std::this_thread::get_id());
+  if (--m_poll_depth > 0)
+    return;
+
+  m_poll_thread = {};
+  m_poll_done_cv.notify_all();
+}
+
+bool HTTPDownloader::LockedIsPollingOnOtherThread() const
+{
+  return (m_poll_depth > 0 && m_poll_thread != std::this_thread::get_id());
+}
+
+void HTTPDownloader::CancelAllRequests()
+{
+  std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
+  LockedBeginPoll(lock);
+
+  while (!m_pending_http_requests.empty())
+  {
+    Request* req = m_pending_http_requests.back();
+    m_pending_http_requests.pop_back();
+    DEV_LOG("Request for '{}' cancelled", req->url);
+    req->state.store(Request::State::Cancelled);
+
+    lock.unlock();
+    req->callback(HTTP_STATUS_CANCELLED, std::string(), Request::Data());
+    CloseRequest(req);
+    lock.lock();
+  }
+
+  LockedEndPoll();
 }
 
 void HTTPDownloader::LockedAddRequest(Request* request)
 {
   m_pending_http_requests.push_back(request);
+
+  // the polling thread has to start it
+  if (LockedIsPollingOnOtherThread())
+    InternalInterruptWait();
 }
 
 u32 HTTPDownloader::LockedGetActiveRequestCount()
@@ -6,11 +6,13 @@
 #include "common/types.h"
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 class ProgressCallback;
@@ -73,15 +75,24 @@ public:
   void CreateRequest(std::string url, Request::Callback callback, ProgressCallback* progress = nullptr);
   void CreatePostRequest(std::string url, std::string post_data, Request::Callback callback,
                          ProgressCallback* progress = nullptr);
-  void PollRequests();
+  /// Dispatches callbacks for completed requests. If wait_timeout_ms is non-zero, blocks for up to that long waiting
+  /// for network activity first, instead of returning immediately when nothing has changed.
+  void PollRequests(u32 wait_timeout_ms = 0);
   void WaitForAllRequests();
   bool HasAnyRequests();
 
+  /// Cancels all pending and in-progress requests. Callbacks are invoked with HTTP_STATUS_CANCELLED.
+  void CancelAllRequests();
+
   static const char DEFAULT_USER_AGENT[];
 
 protected:
   virtual Request* InternalCreateRequest() = 0;
   virtual void InternalPollRequests() = 0;
+  virtual void InternalWaitForRequests(u32 timeout_ms);
+
+  /// Makes InternalWaitForRequests() on another thread return early. Must be safe to call from any thread.
+  virtual void InternalInterruptWait();
 
   virtual bool StartRequest(Request* request) = 0;
   virtual void CloseRequest(Request* request) = 0;
@@ -90,9 +101,19 @@ protected:
   u32 LockedGetActiveRequestCount();
   void LockedPollRequests(std::unique_lock<std::mutex>& lock);
 
+  /// Only one thread at a time may drive the backend, and it drops the lock while waiting or running callbacks.
+  /// Other threads queue their requests for it to start instead.
+  void LockedBeginPoll(std::unique_lock<std::mutex>& lock);
+  void LockedEndPoll();
+  bool LockedIsPollingOnOtherThread() const;
+
   float m_timeout;
   u32 m_max_active_requests;
 
   std::mutex m_pending_http_request_lock;
   std::vector<Request*> m_pending_http_requests;
+
+  std::condition_variable m_poll_done_cv;
+  std::thread::id m_poll_thread;
+  u32 m_poll_depth = 0;
 };
@@ -15,6 +15,9 @@
 
 Log_SetChannel(HTTPDownloader);
 
+// Idle connections kept open for reuse by later requests, so batches to the same host don't reconnect each time.
+static constexpr long MAX_CACHED_CONNECTIONS = 32;
+
 HTTPDownloaderCurl::HTTPDownloaderCurl() : HTTPDownloader()
 {
 }
@@ -65,6 +68,11 @@ bool HTTPDownloaderCurl::Initialize(std::string user_agent)
     return false;
   }
 
+  // Easy handles are freed after each request, but the connection cache belongs to the multi handle, so keep-alive
+  // connections survive across requests. Multiplex over HTTP/2 when the server supports it.
+  curl_multi_setopt(m_multi_handle, CURLMOPT_MAXCONNECTS, MAX_CACHED_CONNECTIONS);
+  curl_multi_setopt(m_multi_handle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
   m_user_agent = std::move(user_agent);
   return true;
 }
@@ -162,6 +170,21 @@ void HTTPDownloaderCurl::InternalPollRequests()
     WARNING_LOG("Failed to unblock SIGPIPE");
 }
 
+void HTTPDownloaderCurl::InternalWaitForRequests(u32 timeout_ms)
+{
+  const CURLMcode err = curl_multi_poll(m_multi_handle, nullptr, 0, static_cast<int>(timeout_ms), nullptr);
+  if (err != CURLM_OK)
+    ERROR_LOG("curl_multi_poll() returned {}", static_cast<int>(err));
+}
+
+void HTTPDownloaderCurl::InternalInterruptWait()
+{
+  // Unlike the rest of the multi interface, this is safe to call while another thread is in curl_multi_poll().
+  const CURLMcode err = curl_multi_wakeup(m_multi_handle);
+  if (err != CURLM_OK)
+    ERROR_LOG("curl_multi_wakeup() returned {}", static_cast<int>(err));
+}
+
 bool HTTPDownloaderCurl::StartRequest(HTTPDownloader::Request* request)
 {
   Request* req = static_cast<Request*>(request);
@@ -172,6 +195,7 @@ bool HTTPDownloaderCurl::StartRequest(HTTPDownloader::Request* request)
   curl_easy_setopt(req->handle, CURLOPT_NOSIGNAL, 1L);
   curl_easy_setopt(req->handle, CURLOPT_PRIVATE, req);
   curl_easy_setopt(req->handle, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(req->handle, CURLOPT_TCP_KEEPALIVE, 1L);
 
   if (request->type == Request::Type::Post)
   {
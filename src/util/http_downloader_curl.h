@@ -20,6 +20,8 @@ public:
 protected:
   Request* InternalCreateRequest() override;
   void InternalPollRequests() override;
+  void InternalWaitForRequests(u32 timeout_ms) override;
+  void InternalInterruptWait() override;
   bool StartRequest(HTTPDownloader::Request* request) override;
   void CloseRequest(HTTPDownloader::Request* request) override;
 
@@ -226,6 +226,51 @@ void RGBA8Image::Resize(const RGBA8Image* src_image, u32 new_width, u32 new_heig
 
 #endif
 
+void RGBA8Image::ResizeToFit(u32 max_width, u32 max_height)
+{
+  if (m_width <= max_width && m_height <= max_height)
+    return;
+
+  const float scale = std::min(static_cast<float>(max_width) / static_cast<float>(m_width),
+                               static_cast<float>(max_height) / static_cast<float>(m_height));
+  const u32 new_width = std::max(static_cast<u32>(static_cast<float>(m_width) * scale), 1u);
+  const u32 new_height = std::max(static_cast<u32>(static_cast<float>(m_height) * scale), 1u);
+
+  std::vector<u32> new_pixels(new_width * new_height);
+  u32* dst = new_pixels.data();
+  for (u32 dy = 0; dy < new_height; dy++)
+  {
+    const u32 sy_start = (dy * m_height) / new_height;
+    const u32 sy_end = std::max(((dy + 1) * m_height) / new_height, sy_start + 1);
+    for (u32 dx = 0; dx < new_width; dx++)
+    {
+      const u32 sx_start = (dx * m_width) / new_width;
+      const u32 sx_end = std::max(((dx + 1) * m_width) / new_width, sx_start + 1);
+
+      u32 r = 0, g = 0, b = 0, a = 0;
+      for (u32 sy = sy_start; sy < sy_end; sy++)
+      {
+        const u32* row = GetRowPixels(sy);
+        for (u32 sx = sx_start; sx < sx_end; sx++)
+        {
+          const u32 pixel = row[sx];
+          r += pixel & 0xFF;
+          g += (pixel >> 8) & 0xFF;
+          b += (pixel >> 16) & 0xFF;
+          a += pixel >> 24;
+        }
+      }
+
+      const u32 count = (sy_end - sy_start) * (sx_end - sx_start);
+      const u32 round = count / 2;
+      *(dst++) = ((r + round) / count) | (((g + round) / count) << 8) | (((b + round) / count) << 16) |
+                 (((a + round) / count) << 24);
+    }
+  }
+
+  SetPixels(new_width, new_height, std::move(new_pixels));
+}
+
 static bool PNGCommonLoader(RGBA8Image* image, png_structp png_ptr, png_infop info_ptr, std::vector<u32>& new_data,
                             std::vector<png_bytep>& row_pointers)
 {
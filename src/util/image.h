@@ -133,4 +133,8 @@ public:
   bool SaveToFile(const char* filename, u8 quality = DEFAULT_SAVE_QUALITY) const;
   bool SaveToFile(std::string_view filename, std::FILE* fp, u8 quality = DEFAULT_SAVE_QUALITY) const;
   std::optional<std::vector<u8>> SaveToBuffer(std::string_view filename, u8 quality = DEFAULT_SAVE_QUALITY) const;
+
+  /// Shrinks the image to fit within the specified dimensions, preserving the aspect ratio.
+  /// Each destination pixel is the average of the source pixels it covers. Images which already fit are unchanged.
+  void ResizeToFit(u32 max_width, u32 max_height);
 };
@@ -25,8 +25,11 @@
 #include "IconsFontAwesome5.h"
 #include "imgui_internal.h"
 #include "imgui_stdlib.h"
+#include "xxhash.h"
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <condition_variable>
 #include <deque>
@@ -43,9 +46,30 @@ using MessageDialogCallbackVariant = std::variant<InfoMessageDialogCallback, Con
 static constexpr float MENU_BACKGROUND_ANIMATION_TIME = 0.5f;
 static constexpr float SMOOTH_SCROLLING_SPEED = 3.5f;
 
+// Queued texture loads which haven't been requested for this many frames are dropped, e.g. scrolled off screen.
+static constexpr u32 TEXTURE_LOAD_CANCEL_FRAMES = 2;
+static constexpr u32 MAX_TEXTURE_LOAD_THREADS = 4;
+static constexpr u32 MIN_THUMBNAIL_SIZE = 64;
+
+namespace {
+struct TextureLoadRequest
+{
+  std::string key;
+  std::string path;
+  u32 thumbnail_size;
+  u32 last_requested_frame;
+};
+} // namespace
+
 static std::optional<RGBA8Image> LoadTextureImage(std::string_view path);
+static std::optional<RGBA8Image> LoadThumbnailImage(const std::string& path, u32 size,
+                                                    const std::string& cache_directory);
+static void PruneThumbnailCache(const std::string& cache_directory);
 static std::shared_ptr<GPUTexture> UploadTexture(std::string_view path, const RGBA8Image& image);
+static GPUTexture* GetCachedTextureAsync(std::string_view key, std::string_view path, u32 thumbnail_size);
+static void CancelStaleTextureLoads();
 static void TextureLoaderThread();
+static size_t GetTextureCacheCost(const std::shared_ptr<GPUTexture>& tex);
 
 static void DrawFileSelector();
 static void DrawChoiceDialog();
@@ -94,14 +118,26 @@ static FocusResetType s_focus_reset_queued = FocusResetType::None;
 static bool s_light_theme = false;
 static bool s_smooth_scrolling = false;
 
-static LRUCache<std::string, std::shared_ptr<GPUTexture>> s_texture_cache(128, true);
+// Texture cache is budgeted by VRAM usage rather than count, since cover art varies wildly in size.
+static constexpr size_t TEXTURE_CACHE_BUDGET = 128 * 1024 * 1024;
+
+// Placeholders share one texture, but still cost something, so that scrolling through a huge list can't grow the cache
+// without bound. Equivalent to a 128x128 thumbnail, i.e. at most 2048 entries.
+static constexpr size_t PLACEHOLDER_TEXTURE_CACHE_COST = 64 * 1024;
+static LRUCache<std::string, std::shared_ptr<GPUTexture>> s_texture_cache(TEXTURE_CACHE_BUDGET, true);
+
+// On-disk thumbnail cache is trimmed back under this size when the cache directory is set.
+static constexpr s64 THUMBNAIL_CACHE_BUDGET = 64 * 1024 * 1024;
 static std::shared_ptr<GPUTexture> s_placeholder_texture;
 static std::atomic_bool s_texture_load_thread_quit{false};
 static std::mutex s_texture_load_mutex;
 static std::condition_variable s_texture_load_cv;
-static std::deque<std::string> s_texture_load_queue;
+static std::vector<TextureLoadRequest> s_texture_load_queue;
 static std::deque<std::pair<std::string, RGBA8Image>> s_texture_upload_queue;
-static std::thread s_texture_load_thread;
+static std::vector<std::thread> s_texture_load_threads;
+static std::string s_thumbnail_cache_directory;
+static bool s_thumbnail_cache_prune_pending = false;
+static u32 s_texture_load_frame = 0;
 
 static SmallString s_fullscreen_footer_text;
 static SmallString s_last_fullscreen_footer_text;
@@ -223,24 +259,30 @@ bool ImGuiFullscreen::Initialize(const char* placeholder_image_path)
     return false;
   }
 
+  // Decoding is mostly CPU bound, so a few threads keep the grid filling quickly without starving the emulator.
+  const u32 num_load_threads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_TEXTURE_LOAD_THREADS);
   s_texture_load_thread_quit.store(false, std::memory_order_release);
-  s_texture_load_thread = std::thread(TextureLoaderThread);
+  for (u32 i = 0; i < num_load_threads; i++)
+    s_texture_load_threads.emplace_back(TextureLoaderThread);
   ResetMenuButtonFrame();
   return true;
 }
 
 void ImGuiFullscreen::Shutdown()
 {
-  if (s_texture_load_thread.joinable())
+  if (!s_texture_load_threads.empty())
   {
     {
       std::unique_lock lock(s_texture_load_mutex);
       s_texture_load_thread_quit.store(true, std::memory_order_release);
-      s_texture_load_cv.notify_one();
+      s_texture_load_cv.notify_all();
     }
-    s_texture_load_thread.join();
+    for (std::thread& thread : s_texture_load_threads)
+      thread.join();
+    s_texture_load_threads.clear();
   }
 
+  s_texture_load_queue.clear();
   s_texture_upload_queue.clear();
   s_placeholder_texture.reset();
   g_standard_font = nullptr;
@@ -283,6 +325,20 @@ void ImGuiFullscreen::SetSmoothScrolling(bool enabled)
   s_smooth_scrolling = enabled;
 }
 
+void ImGuiFullscreen::SetThumbnailCacheDirectory(std::string directory)
+{
+  if (!directory.empty() && !FileSystem::EnsureDirectoryExists(directory.c_str(), false))
+  {
+    ERROR_LOG("Failed to create thumbnail cache directory '{}'", directory);
+    directory = {};
+  }
+
+  // Trimmed by the loader thread once it has work, so scanning the directory doesn't hold up startup.
+  std::unique_lock lock(s_texture_load_mutex);
+  s_thumbnail_cache_directory = std::move(directory);
+  s_thumbnail_cache_prune_pending = !s_thumbnail_cache_directory.empty();
+}
+
 const std::shared_ptr<GPUTexture>& ImGuiFullscreen::GetPlaceholderTexture()
 {
   return s_placeholder_texture;
@@ -369,13 +425,19 @@ std::shared_ptr<GPUTexture> ImGuiFullscreen::LoadTexture(std::string_view path)
   return s_placeholder_texture;
 }
 
+size_t ImGuiFullscreen::GetTextureCacheCost(const std::shared_ptr<GPUTexture>& tex)
+{
+  return (tex && tex != s_placeholder_texture) ? tex->GetVRAMUsage() : PLACEHOLDER_TEXTURE_CACHE_COST;
+}
+
 GPUTexture* ImGuiFullscreen::GetCachedTexture(std::string_view name)
 {
   std::shared_ptr<GPUTexture>* tex_ptr = s_texture_cache.Lookup(name);
   if (!tex_ptr)
   {
     std::shared_ptr<GPUTexture> tex(LoadTexture(name));
-    tex_ptr = s_texture_cache.Insert(std::string(name), std::move(tex));
+    const size_t cost = GetTextureCacheCost(tex);
+    tex_ptr = s_texture_cache.Insert(std::string(name), std::move(tex), cost);
   }
 
   return tex_ptr->get();
@@ -383,17 +445,39 @@ GPUTexture* ImGuiFullscreen::GetCachedTexture(std::string_view name)
 
 GPUTexture* ImGuiFullscreen::GetCachedTextureAsync(std::string_view name)
 {
-  std::shared_ptr<GPUTexture>* tex_ptr = s_texture_cache.Lookup(name);
+  return GetCachedTextureAsync(name, name, 0);
+}
+
+GPUTexture* ImGuiFullscreen::GetCachedThumbnailAsync(std::string_view path, u32 max_size)
+{
+  // Round up to a power of two, so that small layout changes don't invalidate the cache.
+  const u32 thumbnail_size = std::bit_ceil(std::max(max_size, MIN_THUMBNAIL_SIZE));
+  return GetCachedTextureAsync(SmallString::from_format("{}@{}", path, thumbnail_size), path, thumbnail_size);
+}
+
+GPUTexture* ImGuiFullscreen::GetCachedTextureAsync(std::string_view key, std::string_view path, u32 thumbnail_size)
+{
+  std::shared_ptr<GPUTexture>* tex_ptr = s_texture_cache.Lookup(key);
   if (!tex_ptr)
   {
     // insert the placeholder
-    tex_ptr = s_texture_cache.Insert(std::string(name), s_placeholder_texture);
+    tex_ptr = s_texture_cache.Insert(std::string(key), s_placeholder_texture, PLACEHOLDER_TEXTURE_CACHE_COST);
 
     // queue the actual load
     std::unique_lock lock(s_texture_load_mutex);
-    s_texture_load_queue.emplace_back(name);
+    s_texture_load_queue.push_back(
+      TextureLoadRequest{std::string(key), std::string(path), thumbnail_size, s_texture_load_frame});
     s_texture_load_cv.notify_one();
   }
+  else if (*tex_ptr == s_placeholder_texture)
+  {
+    // still visible, so keep it at the front of the queue
+    std::unique_lock lock(s_texture_load_mutex);
+    const auto it = std::find_if(s_texture_load_queue.begin(), s_texture_load_queue.end(),
+                                 [&key](const TextureLoadRequest& req) { return (req.key == key); });
+    if (it != s_texture_load_queue.end())
+      it->last_requested_frame = s_texture_load_frame;
+  }
 
   return tex_ptr->get();
 }
@@ -414,12 +498,110 @@ void ImGuiFullscreen::UploadAsyncTextures()
 
     std::shared_ptr<GPUTexture> tex = UploadTexture(it.first.c_str(), it.second);
     if (tex)
-      s_texture_cache.Insert(std::move(it.first), std::move(tex));
+    {
+      const size_t cost = GetTextureCacheCost(tex);
+      s_texture_cache.Insert(std::move(it.first), std::move(tex), cost);
+    }
 
     lock.lock();
   }
 }
 
+void ImGuiFullscreen::CancelStaleTextureLoads()
+{
+  std::unique_lock lock(s_texture_load_mutex);
+  s_texture_load_frame++;
+
+  for (auto it = s_texture_load_queue.begin(); it != s_texture_load_queue.end();)
+  {
+    if ((s_texture_load_frame - it->last_requested_frame) <= TEXTURE_LOAD_CANCEL_FRAMES)
+    {
+      ++it;
+      continue;
+    }
+
+    // drop the placeholder too, otherwise it'd never be queued again
+    s_texture_cache.Remove(it->key);
+    it = s_texture_load_queue.erase(it);
+  }
+}
+
+std::optional<RGBA8Image> ImGuiFullscreen::LoadThumbnailImage(const std::string& path, u32 size,
+                                                              const std::string& cache_directory)
+{
+  // Thumbnails are keyed by the source path, and are stale if the source has been modified since.
+  FILESYSTEM_STAT_DATA source_sd, thumbnail_sd;
+  std::string thumbnail_path;
+  if (!cache_directory.empty() && Path::IsAbsolute(path) && FileSystem::StatFile(path.c_str(), &source_sd))
+  {
+    thumbnail_path = Path::Combine(
+      cache_directory, TinyString::from_format("{:016X}_{}.webp", XXH64(path.data(), path.size(), 0), size));
+    if (FileSystem::StatFile(thumbnail_path.c_str(), &thumbnail_sd) &&
+        thumbnail_sd.ModificationTime >= source_sd.ModificationTime)
+    {
+      RGBA8Image image;
+      if (image.LoadFromFile(thumbnail_path.c_str()))
+        return image;
+
+      WARNING_LOG("Failed to load thumbnail '{}', regenerating", thumbnail_path);
+    }
+  }
+
+  std::optional<RGBA8Image> image = LoadTextureImage(path);
+  if (!image.has_value() || (image->GetWidth() <= size && image->GetHeight() <= size))
+    return image;
+
+  image->ResizeToFit(size, size);
+
+  // Written to a temporary file and renamed into place, so a concurrent or interrupted save never leaves a truncated
+  // thumbnail behind that looks newer than its source.
+  if (!thumbnail_path.empty())
+  {
+    Error error;
+    const std::optional<std::vector<u8>> data = image->SaveToBuffer(thumbnail_path);
+    if (!data.has_value() || !FileSystem::WriteAtomicRenamedFile(thumbnail_path, data->data(), data->size(), &error))
+    {
+      WARNING_LOG("Failed to save thumbnail '{}': {}", thumbnail_path, error.GetDescription());
+    }
+  }
+
+  return image;
+}
+
+void ImGuiFullscreen::PruneThumbnailCache(const std::string& cache_directory)
+{
+  FileSystem::FindResultsArray files;
+  FileSystem::FindFiles(cache_directory.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES, &files);
+
+  s64 total_size = 0;
+  for (const FILESYSTEM_FIND_DATA& fd : files)
+    total_size += fd.Size;
+  if (total_size <= THUMBNAIL_CACHE_BUDGET)
+    return;
+
+  // Thumbnails are cheap to rebuild, so drop the oldest until we're comfortably under budget.
+  std::sort(files.begin(), files.end(), [](const FILESYSTEM_FIND_DATA& lhs, const FILESYSTEM_FIND_DATA& rhs) {
+    return lhs.ModificationTime < rhs.ModificationTime;
+  });
+
+  const s64 old_size = total_size;
+  u32 num_removed = 0;
+  for (const FILESYSTEM_FIND_DATA& fd : files)
+  {
+    if (total_size <= (THUMBNAIL_CACHE_BUDGET / 4) * 3)
+      break;
+
+    if (FileSystem::DeleteFile(fd.FileName.c_str()))
+    {
+      total_size -= fd.Size;
+      num_removed++;
+    }
+  }
+
+  INFO_LOG("Removed {} thumbnails from cache, size reduced from {} KB to {} KB", num_removed, old_size / 1024,
+           total_size / 1024);
+}
+
 void ImGuiFullscreen::TextureLoaderThread()
 {
   Threading::SetNameOfCurrentThread("ImGuiFullscreen Texture Loader");
@@ -435,22 +617,32 @@ void ImGuiFullscreen::TextureLoaderThread()
     if (s_texture_load_thread_quit.load(std::memory_order_acquire))
       break;
 
-    while (!s_texture_load_queue.empty())
+    // Service the most recently requested texture first, that's what's on screen right now.
+    auto it = s_texture_load_queue.begin();
+    for (auto cur = it + 1; cur != s_texture_load_queue.end(); ++cur)
     {
-      std::string path(std::move(s_texture_load_queue.front()));
-      s_texture_load_queue.pop_front();
+      if (cur->last_requested_frame > it->last_requested_frame)
+        it = cur;
+    }
 
-      lock.unlock();
-      std::optional<RGBA8Image> image(LoadTextureImage(path.c_str()));
-      lock.lock();
+    TextureLoadRequest req(std::move(*it));
+    s_texture_load_queue.erase(it);
+    const std::string cache_directory = s_thumbnail_cache_directory;
+    const bool prune_cache = std::exchange(s_thumbnail_cache_prune_pending, false);
 
-      // don't bother queuing back if it doesn't exist
-      if (image)
-        s_texture_upload_queue.emplace_back(std::move(path), std::move(image.value()));
-    }
-  }
+    lock.unlock();
+    if (prune_cache)
+      PruneThumbnailCache(cache_directory);
 
-  s_texture_load_queue.clear();
+    std::optional<RGBA8Image> image = (req.thumbnail_size > 0) ?
+                                        LoadThumbnailImage(req.path, req.thumbnail_size, cache_directory) :
+                                        LoadTextureImage(req.path);
+    lock.lock();
+
+    // don't bother queuing back if it doesn't exist
+    if (image)
+      s_texture_upload_queue.emplace_back(std::move(req.key), std::move(image.value()));
+  }
 }
 
 bool ImGuiFullscreen::UpdateLayoutScale()
@@ -521,6 +713,7 @@ void ImGuiFullscreen::BeginLayout()
   // we evict from the texture cache at the start of the frame, in case we go over mid-frame,
   // we need to keep all those textures alive until the end of the frame
   s_texture_cache.ManualEvict();
+  CancelStaleTextureLoads();
   PushResetLayout();
 }
 
@@ -121,6 +121,11 @@ bool Initialize(const char* placeholder_image_path);
 
 void SetTheme(bool light);
 void SetSmoothScrolling(bool enabled);
+
+/// Sets the directory used to store downscaled copies of images loaded with GetCachedThumbnailAsync().
+/// An empty directory disables the on-disk cache, thumbnails are then rebuilt from the source every time. The oldest
+/// thumbnails are removed when the directory grows past its size budget.
+void SetThumbnailCacheDirectory(std::string directory);
 void SetFonts(ImFont* medium_font, ImFont* large_font);
 bool UpdateLayoutScale();
 
@@ -133,6 +138,11 @@ std::unique_ptr<GPUTexture> CreateTextureFromImage(const RGBA8Image& image);
 std::shared_ptr<GPUTexture> LoadTexture(std::string_view path);
 GPUTexture* GetCachedTexture(std::string_view name);
 GPUTexture* GetCachedTextureAsync(std::string_view name);
+
+/// Asynchronously loads an image from disk, downscaled so that neither dimension exceeds max_size.
+/// Loads which are not requested again within a couple of frames are cancelled, and the most recently requested
+/// images are loaded first, so callers should only request what is currently visible.
+GPUTexture* GetCachedThumbnailAsync(std::string_view path, u32 max_size);
 bool InvalidateCachedTexture(const std::string& path);
 void UploadAsyncTextures();
 
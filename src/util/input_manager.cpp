@@ -844,9 +844,8 @@ void InputManager::AddPadBindings(SettingsInterface& si, const std::string& sect
                         if (!System::IsValid())
                           return;
 
-                        Controller* c = System::GetController(pad_index);
-                        if (c)
-                          c->SetBindState(bind_index, ApplySingleBindingScale(sensitivity, deadzone, value));
+                        System::SetControllerBindState(pad_index, bind_index,
+                                                       ApplySingleBindingScale(sensitivity, deadzone, value));
                       }});
         }
       }
@@ -858,9 +857,7 @@ void InputManager::AddPadBindings(SettingsInterface& si, const std::string& sect
           if (!System::IsValid())
             return;
 
-          Controller* c = System::GetController(pad_index);
-          if (c)
-            c->SetBindState(base + key.data, value);
+          System::SetControllerBindState(pad_index, base + key.data, value);
         };
 
         // bind pointer 0 by default
@@ -1740,13 +1737,9 @@ void InputManager::SetMacroButtonState(u32 pad, u32 index, bool state)
 
 void InputManager::ApplyMacroButton(u32 pad, const MacroButton& mb)
 {
-  Controller* const controller = System::GetController(pad);
-  if (!controller)
-    return;
-
   const float value = mb.toggle_state ? 1.0f : 0.0f;
   for (const u32 btn : mb.buttons)
-    controller->SetBindState(btn, value);
+    System::SetControllerBindState(pad, btn, value);
 }
 
 void InputManager::UpdateMacroButtons()
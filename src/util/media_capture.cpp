@@ -4,9 +4,11 @@
 #include "media_capture.h"
 #include "gpu_device.h"
 #include "host.h"
+#include "shadergen.h"
 
 #include "common/align.h"
 #include "common/assert.h"
+#include "common/bitutils.h"
 #include "common/dynamic_library.h"
 #include "common/error.h"
 #include "common/file_system.h"
@@ -79,16 +81,16 @@ static constexpr u32 VIDEO_HEIGHT_ALIGNMENT = 8;
 class ALIGN_TO_CACHE_LINE MediaCaptureBase : public MediaCapture
 {
 public:
-  static constexpr u32 NUM_FRAMES_IN_FLIGHT = 3;
-  static constexpr u32 MAX_PENDING_FRAMES = NUM_FRAMES_IN_FLIGHT * 2;
+  static constexpr u32 MAX_PENDING_FRAMES = MAX_VIDEO_FRAMES_IN_FLIGHT * 2;
   static constexpr u32 AUDIO_CHANNELS = 2;
 
   virtual ~MediaCaptureBase() override;
 
   bool BeginCapture(float fps, float aspect, u32 width, u32 height, GPUTexture::Format texture_format, u32 sample_rate,
                     std::string path, bool capture_video, std::string_view video_codec, u32 video_bitrate,
-                    std::string_view video_codec_args, bool capture_audio, std::string_view audio_codec,
-                    u32 audio_bitrate, std::string_view audio_codec_args, Error* error) override final;
+                    std::string_view video_codec_args, bool video_gpu_conversion, u32 video_frames_in_flight,
+                    bool capture_audio, std::string_view audio_codec, u32 audio_bitrate,
+                    std::string_view audio_codec_args, Error* error) override final;
 
   const std::string& GetPath() const override final;
   std::string GetNextCapturePath() const override final;
@@ -107,6 +109,15 @@ public:
   void Flush() override final;
 
 protected:
+  /// Layout of frames which were converted to YUV 4:2:0 on the GPU. Both are a single R8 texture of height * 3 / 2
+  /// rows, with the luma plane first.
+  enum class GPUConversionFormat : u8
+  {
+    None,
+    I420,
+    NV12,
+  };
+
   struct PendingFrame
   {
     enum class State
@@ -126,6 +137,12 @@ protected:
     return (static_cast<u32>(m_audio_buffer.size()) / AUDIO_CHANNELS);
   }
 
+  ALWAYS_INLINE u32 GetPendingFrameCount() const { return m_video_frames_in_flight * 2; }
+
+  /// Backends call this from InternalBeginCapture() when the encoder accepts one of the YUV layouts.
+  bool CreateGPUConversionResources(GPUConversionFormat format, Error* error);
+  GPUTexture* ConvertFrameOnGPU(GPUTexture* stex);
+
   void ProcessFramePendingMap(std::unique_lock<std::mutex>& lock);
   void ProcessAllInFlightFrames(std::unique_lock<std::mutex>& lock);
   void EncoderThreadEntryPoint();
@@ -151,10 +168,16 @@ protected:
   GPUTexture::Format m_video_render_texture_format = GPUTexture::Format::Unknown;
   u32 m_video_width = 0;
   u32 m_video_height = 0;
+  u32 m_video_frames_in_flight = DEFAULT_VIDEO_FRAMES_IN_FLIGHT;
   float m_video_fps = 0;
   s64 m_next_video_pts = 0;
   std::unique_ptr<GPUTexture> m_render_texture;
 
+  bool m_video_gpu_conversion_allowed = false;
+  GPUConversionFormat m_gpu_conversion_format = GPUConversionFormat::None;
+  std::unique_ptr<GPUPipeline> m_gpu_conversion_pipeline;
+  std::unique_ptr<GPUTexture> m_gpu_conversion_texture;
+
   s64 m_next_audio_pts = 0;
   u32 m_audio_frame_pos = 0;
   u32 m_audio_frame_size = 0;
@@ -186,14 +209,16 @@ MediaCaptureBase::~MediaCaptureBase() = default;
 
 bool MediaCaptureBase::BeginCapture(float fps, float aspect, u32 width, u32 height, GPUTexture::Format texture_format,
                                     u32 sample_rate, std::string path, bool capture_video, std::string_view video_codec,
-                                    u32 video_bitrate, std::string_view video_codec_args, bool capture_audio,
-                                    std::string_view audio_codec, u32 audio_bitrate, std::string_view audio_codec_args,
-                                    Error* error)
+                                    u32 video_bitrate, std::string_view video_codec_args, bool video_gpu_conversion,
+                                    u32 video_frames_in_flight, bool capture_audio, std::string_view audio_codec,
+                                    u32 audio_bitrate, std::string_view audio_codec_args, Error* error)
 {
   m_video_render_texture_format = texture_format;
   m_video_width = width;
   m_video_height = height;
   m_video_fps = fps;
+  m_video_frames_in_flight = std::clamp(video_frames_in_flight, 1u, MAX_VIDEO_FRAMES_IN_FLIGHT);
+  m_video_gpu_conversion_allowed = video_gpu_conversion;
 
   if (path.empty())
   {
@@ -213,13 +238,13 @@ bool MediaCaptureBase::BeginCapture(float fps, float aspect, u32 width, u32 heig
 
   // allocate audio buffer, dynamic based on sample rate
   if (capture_audio)
-    m_audio_buffer.resize(sample_rate * MAX_PENDING_FRAMES * AUDIO_CHANNELS);
+    m_audio_buffer.resize(sample_rate * GetPendingFrameCount() * AUDIO_CHANNELS);
 
   INFO_LOG("Initializing capture:");
   if (capture_video)
   {
-    INFO_LOG("  Video: {}x{} FPS={}, Aspect={}, Codec={}, Bitrate={}, Args={}", width, height, fps, aspect, video_codec,
-             video_bitrate, video_codec_args);
+    INFO_LOG("  Video: {}x{} FPS={}, Aspect={}, Codec={}, Bitrate={}, Args={}, FramesInFlight={}", width, height, fps,
+             aspect, video_codec, video_bitrate, video_codec_args, m_video_frames_in_flight);
   }
   if (capture_audio)
   {
@@ -234,6 +259,14 @@ bool MediaCaptureBase::BeginCapture(float fps, float aspect, u32 width, u32 heig
     return false;
   }
 
+  if (capture_video)
+  {
+    INFO_LOG("  GPU Conversion: {}",
+             (m_gpu_conversion_format == GPUConversionFormat::NV12) ?
+               "NV12" :
+               ((m_gpu_conversion_format == GPUConversionFormat::I420) ? "I420" : "Disabled"));
+  }
+
   StartEncoderThread();
   return true;
 }
@@ -254,6 +287,73 @@ GPUTexture* MediaCaptureBase::GetRenderTexture()
   return m_render_texture.get();
 }
 
+bool MediaCaptureBase::CreateGPUConversionResources(GPUConversionFormat format, Error* error)
+{
+  const RenderAPI render_api = g_gpu_device->GetRenderAPI();
+  ShaderGen shadergen(render_api, ShaderGen::GetShaderLanguageForAPI(render_api), false, false);
+
+  std::unique_ptr<GPUShader> vso = g_gpu_device->CreateShader(GPUShaderStage::Vertex, shadergen.GetLanguage(),
+                                                              shadergen.GenerateScreenQuadVertexShader(), error);
+  std::unique_ptr<GPUShader> fso =
+    g_gpu_device->CreateShader(GPUShaderStage::Fragment, shadergen.GetLanguage(),
+                               shadergen.GenerateRGBToYUV420FragmentShader(format == GPUConversionFormat::NV12), error);
+  if (!vso || !fso)
+    return false;
+  GL_OBJECT_NAME(vso, "Media Capture Conversion Vertex Shader");
+  GL_OBJECT_NAME(fso, "Media Capture Conversion Fragment Shader");
+
+  GPUPipeline::GraphicsConfig plconfig;
+  plconfig.layout = GPUPipeline::Layout::SingleTextureAndPushConstants;
+  plconfig.input_layout.vertex_stride = 0;
+  plconfig.primitive = GPUPipeline::Primitive::Triangles;
+  plconfig.rasterization = GPUPipeline::RasterizationState::GetNoCullState();
+  plconfig.depth = GPUPipeline::DepthState::GetNoTestsState();
+  plconfig.blend = GPUPipeline::BlendState::GetNoBlendingState();
+  plconfig.SetTargetFormats(GPUTexture::Format::R8);
+  plconfig.samples = 1;
+  plconfig.per_sample_shading = false;
+  plconfig.render_pass_flags = GPUPipeline::NoRenderPassFlags;
+  plconfig.vertex_shader = vso.get();
+  plconfig.geometry_shader = nullptr;
+  plconfig.fragment_shader = fso.get();
+  if (!(m_gpu_conversion_pipeline = g_gpu_device->CreatePipeline(plconfig, error)))
+    return false;
+  GL_OBJECT_NAME(m_gpu_conversion_pipeline, "Media Capture Conversion Pipeline");
+
+  // Luma plane followed by half as many rows of chroma.
+  const u32 texture_height = m_video_height + (m_video_height / 2);
+  if (!(m_gpu_conversion_texture = g_gpu_device->CreateTexture(m_video_width, texture_height, 1, 1, 1,
+                                                               GPUTexture::Type::RenderTarget, GPUTexture::Format::R8)))
+  {
+    Error::SetStringFmt(error, "Failed to create {}x{} conversion texture.", m_video_width, texture_height);
+    m_gpu_conversion_pipeline.reset();
+    return false;
+  }
+
+  m_gpu_conversion_format = format;
+  return true;
+}
+
+GPUTexture* MediaCaptureBase::ConvertFrameOnGPU(GPUTexture* stex)
+{
+  GL_SCOPE_FMT("MediaCapture ConvertFrameOnGPU({}x{})", m_video_width, m_video_height);
+
+  GPUTexture* dtex = m_gpu_conversion_texture.get();
+  stex->MakeReadyForSampling();
+
+  g_gpu_device->InvalidateRenderTarget(dtex);
+  g_gpu_device->SetRenderTarget(dtex);
+  g_gpu_device->SetPipeline(m_gpu_conversion_pipeline.get());
+  g_gpu_device->SetTextureSampler(0, stex, g_gpu_device->GetNearestSampler());
+
+  const u32 uniforms[] = {m_video_width, m_video_height, BoolToUInt32(g_gpu_device->UsesLowerLeftOrigin()), 0u};
+  g_gpu_device->PushUniformBuffer(uniforms, sizeof(uniforms));
+  g_gpu_device->SetViewportAndScissor(0, 0, dtex->GetWidth(), dtex->GetHeight());
+  g_gpu_device->Draw(3, 0);
+
+  return dtex;
+}
+
 bool MediaCaptureBase::DeliverVideoFrame(GPUTexture* stex)
 {
   std::unique_lock<std::mutex> lock(m_lock);
@@ -262,7 +362,7 @@ bool MediaCaptureBase::DeliverVideoFrame(GPUTexture* stex)
   if (m_encoding_error.load(std::memory_order_acquire))
     return false;
 
-  if (m_frames_pending_map >= NUM_FRAMES_IN_FLIGHT)
+  if (m_frames_pending_map >= m_video_frames_in_flight)
     ProcessFramePendingMap(lock);
 
   PendingFrame& pf = m_pending_frames[m_pending_frames_pos];
@@ -274,8 +374,12 @@ bool MediaCaptureBase::DeliverVideoFrame(GPUTexture* stex)
     m_frame_encoded_cv.wait(lock, [&pf]() { return pf.state == PendingFrame::State::Unused; });
   }
 
+  // Converted frames are read back as YUV, which is less than half the size of RGBA.
+  if (m_gpu_conversion_format != GPUConversionFormat::None)
+    stex = ConvertFrameOnGPU(stex);
+
   if (!pf.tex || pf.tex->GetWidth() != static_cast<u32>(stex->GetWidth()) ||
-      pf.tex->GetHeight() != static_cast<u32>(stex->GetHeight()))
+      pf.tex->GetHeight() != static_cast<u32>(stex->GetHeight()) || pf.tex->GetFormat() != stex->GetFormat())
   {
     pf.tex.reset();
     pf.tex = g_gpu_device->CreateDownloadTexture(stex->GetWidth(), stex->GetHeight(), stex->GetFormat());
@@ -290,11 +394,11 @@ bool MediaCaptureBase::DeliverVideoFrame(GPUTexture* stex)
 #endif
   }
 
-  pf.tex->CopyFromTexture(0, 0, stex, 0, 0, m_video_width, m_video_height, 0, 0);
+  pf.tex->CopyFromTexture(0, 0, stex, 0, 0, stex->GetWidth(), stex->GetHeight(), 0, 0);
   pf.pts = m_next_video_pts++;
   pf.state = PendingFrame::State::NeedsMap;
 
-  m_pending_frames_pos = (m_pending_frames_pos + 1) % MAX_PENDING_FRAMES;
+  m_pending_frames_pos = (m_pending_frames_pos + 1) % GetPendingFrameCount();
   m_frames_pending_map++;
   return true;
 }
@@ -315,14 +419,14 @@ void MediaCaptureBase::ProcessFramePendingMap(std::unique_lock<std::mutex>& lock
 
   // Even if the map failed, we need to kick it to the encode thread anyway, because
   // otherwise our queue indices will get desynchronized.
-  if (!pf.tex->Map(0, 0, m_video_width, m_video_height))
+  if (!pf.tex->Map(0, 0, pf.tex->GetWidth(), pf.tex->GetHeight()))
     WARNING_LOG("Failed to map previously flushed frame.");
 
   lock.lock();
 
   // Kick to encoder thread!
   pf.state = PendingFrame::State::NeedsEncoding;
-  m_frames_map_consume_pos = (m_frames_map_consume_pos + 1) % MAX_PENDING_FRAMES;
+  m_frames_map_consume_pos = (m_frames_map_consume_pos + 1) % GetPendingFrameCount();
   m_frames_pending_map--;
   m_frames_pending_encode++;
   m_frame_ready_cv.notify_one();
@@ -368,7 +472,7 @@ void MediaCaptureBase::EncoderThreadEntryPoint()
 
     // Done with this frame! Wait for the next.
     pf.state = PendingFrame::State::Unused;
-    m_frames_encode_consume_pos = (m_frames_encode_consume_pos + 1) % MAX_PENDING_FRAMES;
+    m_frames_encode_consume_pos = (m_frames_encode_consume_pos + 1) % GetPendingFrameCount();
     m_frames_pending_encode--;
     m_frame_encoded_cv.notify_all();
   }
@@ -450,7 +554,7 @@ bool MediaCaptureBase::DeliverAudioFrames(const s16* frames, u32 num_frames)
 
     PendingFrame& pf = m_pending_frames[m_pending_frames_pos];
     pf.state = PendingFrame::State::NeedsEncoding;
-    m_pending_frames_pos = (m_pending_frames_pos + 1) % MAX_PENDING_FRAMES;
+    m_pending_frames_pos = (m_pending_frames_pos + 1) % GetPendingFrameCount();
 
     m_frames_pending_encode++;
     m_frame_ready_cv.notify_one();
@@ -492,6 +596,10 @@ void MediaCaptureBase::ClearState()
   m_audio_buffer.deallocate();
 
   m_encoding_error.store(false, std::memory_order_release);
+
+  m_gpu_conversion_format = GPUConversionFormat::None;
+  m_gpu_conversion_pipeline.reset();
+  m_gpu_conversion_texture.reset();
 }
 
 bool MediaCaptureBase::EndCapture(Error* error)
@@ -1917,6 +2025,9 @@ private:
 
   bool IsUsingHardwareVideoEncoding();
 
+  bool ConvertFrameWithSWScale(const PendingFrame& pf, Error* error);
+  void CopyConvertedFrame(const PendingFrame& pf);
+
   bool ReceivePackets(AVCodecContext* codec_context, AVStream* stream, AVPacket* packet, Error* error);
 
   AVFormatContext* m_format_context = nullptr;
@@ -2299,6 +2410,20 @@ bool MediaCaptureFFmpeg::InternalBeginCapture(float fps, float aspect, u32 sampl
       return false;
     }
 
+    // If the encoder wants 4:2:0, we can skip swscale and convert on the GPU instead.
+    if (m_video_gpu_conversion_allowed)
+    {
+      const GPUConversionFormat gpu_format =
+        (sw_pix_fmt == AV_PIX_FMT_NV12) ?
+          GPUConversionFormat::NV12 :
+          ((sw_pix_fmt == AV_PIX_FMT_YUV420P) ? GPUConversionFormat::I420 : GPUConversionFormat::None);
+      Error gpu_error;
+      if (gpu_format == GPUConversionFormat::None)
+        WARNING_LOG("GPU conversion is not supported for pixel format {}.", static_cast<int>(sw_pix_fmt));
+      else if (!CreateGPUConversionResources(gpu_format, &gpu_error))
+        WARNING_LOG("Failed to set up GPU conversion, using swscale: {}", gpu_error.GetDescription());
+    }
+
     if (IsUsingHardwareVideoEncoding())
     {
       m_hw_video_frame->format = m_video_codec_context->pix_fmt;
@@ -2640,7 +2765,7 @@ bool MediaCaptureFFmpeg::ReceivePackets(AVCodecContext* codec_context, AVStream*
   return true;
 }
 
-bool MediaCaptureFFmpeg::SendFrame(const PendingFrame& pf, Error* error)
+bool MediaCaptureFFmpeg::ConvertFrameWithSWScale(const PendingFrame& pf, Error* error)
 {
   const u8* source_ptr = pf.tex->GetMapPointer();
   const int source_width = static_cast<int>(pf.tex->GetWidth());
@@ -2654,9 +2779,6 @@ bool MediaCaptureFFmpeg::SendFrame(const PendingFrame& pf, Error* error)
     source_pitch = -source_pitch;
   }
 
-  // In case a previous frame is still using the frame.
-  wrap_av_frame_make_writable(m_converted_video_frame);
-
   m_sws_context = wrap_sws_getCachedContext(m_sws_context, source_width, source_height, m_video_pixel_format,
                                             m_converted_video_frame->width, m_converted_video_frame->height,
                                             static_cast<AVPixelFormat>(m_converted_video_frame->format), SWS_BICUBIC,
@@ -2669,6 +2791,55 @@ bool MediaCaptureFFmpeg::SendFrame(const PendingFrame& pf, Error* error)
 
   wrap_sws_scale(m_sws_context, reinterpret_cast<const u8**>(&source_ptr), &source_pitch, 0, source_height,
                  m_converted_video_frame->data, m_converted_video_frame->linesize);
+  return true;
+}
+
+void MediaCaptureFFmpeg::CopyConvertedFrame(const PendingFrame& pf)
+{
+  const u8* src = pf.tex->GetMapPointer();
+  const u32 src_pitch = pf.tex->GetMapPitch();
+  const u32 width = m_video_width;
+  const u32 height = m_video_height;
+  const u32 chroma_width = width / 2;
+  const u32 chroma_height = height / 2;
+
+  for (u32 row = 0; row < height; row++)
+    std::memcpy(m_converted_video_frame->data[0] + row * m_converted_video_frame->linesize[0], src + row * src_pitch,
+                width);
+
+  const u8* chroma_src = src + height * src_pitch;
+  if (m_gpu_conversion_format == GPUConversionFormat::NV12)
+  {
+    for (u32 row = 0; row < chroma_height; row++)
+    {
+      std::memcpy(m_converted_video_frame->data[1] + row * m_converted_video_frame->linesize[1],
+                  chroma_src + row * src_pitch, width);
+    }
+  }
+  else
+  {
+    // U and V are packed two rows per line, see GenerateRGBToYUV420FragmentShader().
+    const u8* v_src = chroma_src + (height / 4) * src_pitch;
+    for (u32 row = 0; row < chroma_height; row++)
+    {
+      const u32 src_offset = (row / 2) * src_pitch + (row & 1) * chroma_width;
+      std::memcpy(m_converted_video_frame->data[1] + row * m_converted_video_frame->linesize[1],
+                  chroma_src + src_offset, chroma_width);
+      std::memcpy(m_converted_video_frame->data[2] + row * m_converted_video_frame->linesize[2], v_src + src_offset,
+                  chroma_width);
+    }
+  }
+}
+
+bool MediaCaptureFFmpeg::SendFrame(const PendingFrame& pf, Error* error)
+{
+  // In case a previous frame is still using the frame.
+  wrap_av_frame_make_writable(m_converted_video_frame);
+
+  if (m_gpu_conversion_format != GPUConversionFormat::None)
+    CopyConvertedFrame(pf);
+  else if (!ConvertFrameWithSWScale(pf, error))
+    return false;
 
   AVFrame* frame_to_send = m_converted_video_frame;
   if (IsUsingHardwareVideoEncoding())
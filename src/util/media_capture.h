@@ -47,11 +47,16 @@ public:
 
   static std::unique_ptr<MediaCapture> Create(MediaCaptureBackend backend, Error* error);
 
+  static constexpr u32 DEFAULT_VIDEO_FRAMES_IN_FLIGHT = 3;
+  static constexpr u32 MAX_VIDEO_FRAMES_IN_FLIGHT = 8;
+
+  /// If video_gpu_conversion is set and the encoder takes YUV 4:2:0 input, frames are converted on the GPU before
+  /// readback. video_frames_in_flight controls how many frames can be waiting on readback before the CPU stalls.
   virtual bool BeginCapture(float fps, float aspect, u32 width, u32 height, GPUTexture::Format texture_format,
                             u32 sample_rate, std::string path, bool capture_video, std::string_view video_codec,
-                            u32 video_bitrate, std::string_view video_codec_args, bool capture_audio,
-                            std::string_view audio_codec, u32 audio_bitrate, std::string_view audio_codec_args,
-                            Error* error) = 0;
+                            u32 video_bitrate, std::string_view video_codec_args, bool video_gpu_conversion,
+                            u32 video_frames_in_flight, bool capture_audio, std::string_view audio_codec,
+                            u32 audio_bitrate, std::string_view audio_codec_args, Error* error) = 0;
   virtual bool EndCapture(Error* error) = 0;
 
   // TODO: make non-virtual?
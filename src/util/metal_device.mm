@@ -256,6 +256,7 @@ void MetalDevice::SetFeatures(FeatureMask disabled_features)
   m_features.shader_cache = true;
   m_features.pipeline_cache = true;
   m_features.prefer_unused_textures = true;
+  m_features.threaded_shader_creation = false;
 
   // Disable pipeline cache on Intel, apparently it's buggy.
   if ([[m_device name] containsString:@"Intel"])
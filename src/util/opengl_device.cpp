@@ -514,6 +514,9 @@ bool OpenGLDevice::CheckFeatures(FeatureMask disabled_features)
   // Mobile drivers prefer textures to not be updated mid-frame.
   m_features.prefer_unused_textures = is_gles || vendor_id_arm || vendor_id_powervr || vendor_id_qualcomm;
 
+  // Contexts are bound to one thread.
+  m_features.threaded_shader_creation = false;
+
   if (vendor_id_intel)
   {
     // Intel drivers corrupt image on readback when syncs are used for downloads.
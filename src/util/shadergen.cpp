@@ -849,6 +849,68 @@ std::string ShaderGen::GenerateCopyFragmentShader()
   return ss.str();
 }
 
+std::string ShaderGen::GenerateRGBToYUV420FragmentShader(bool nv12)
+{
+  std::stringstream ss;
+  WriteHeader(ss);
+  DefineMacro(ss, "NV12", nv12);
+  DeclareUniformBuffer(ss, {"uint2 u_size", "uint u_flip", "uint u_pad"}, true);
+  DeclareTexture(ss, "samp0", 0);
+
+  ss << R"(
+float3 LoadSource(uint2 pos)
+{
+  // Lower-left origin sources are stored bottom-up, but the output always needs to be top-down.
+  if (u_flip != 0u)
+    pos.y = u_size.y - 1u - pos.y;
+
+  return LOAD_TEXTURE(samp0, int2(pos), 0).rgb;
+}
+
+float3 LoadChromaBlock(uint2 pos)
+{
+  uint2 tl = pos * 2u;
+  return (LoadSource(tl) + LoadSource(tl + uint2(1u, 0u)) + LoadSource(tl + uint2(0u, 1u)) +
+          LoadSource(tl + uint2(1u, 1u))) * 0.25;
+}
+
+float RGBToY(float3 rgb) { return (16.0 + dot(rgb, float3(65.481, 128.553, 24.966))) / 255.0; }
+float RGBToU(float3 rgb) { return (128.0 + dot(rgb, float3(-37.797, -74.203, 112.0))) / 255.0; }
+float RGBToV(float3 rgb) { return (128.0 + dot(rgb, float3(112.0, -93.786, -18.214))) / 255.0; }
+)";
+
+  DeclareFragmentEntryPoint(ss, 0, 1, {}, true);
+  ss << R"(
+{
+  uint2 pos = uint2(v_pos.xy);
+  float value;
+  if (pos.y < u_size.y)
+  {
+    value = RGBToY(LoadSource(pos));
+  }
+  else
+  {
+    uint row = pos.y - u_size.y;
+#if NV12
+    float3 rgb = LoadChromaBlock(uint2(pos.x / 2u, row));
+    value = ((pos.x & 1u) == 0u) ? RGBToU(rgb) : RGBToV(rgb);
+#else
+    uint half_width = u_size.x / 2u;
+    uint quarter_height = u_size.y / 4u;
+    bool is_v = (row >= quarter_height);
+    row = is_v ? (row - quarter_height) : row;
+    float3 rgb = LoadChromaBlock(uint2(pos.x % half_width, (row * 2u) + ((pos.x >= half_width) ? 1u : 0u)));
+    value = is_v ? RGBToV(rgb) : RGBToU(rgb);
+#endif
+  }
+
+  o_col0 = float4(value, value, value, value);
+}
+)";
+
+  return ss.str();
+}
+
 std::string ShaderGen::GenerateImGuiVertexShader()
 {
   std::stringstream ss;
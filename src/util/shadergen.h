@@ -30,6 +30,10 @@ public:
   std::string GenerateFillFragmentShader();
   std::string GenerateCopyFragmentShader();
 
+  /// Converts RGB to BT.601 limited-range YUV 4:2:0, written to a single R8 target of height * 3 / 2 rows. The luma
+  /// plane is followed by either interleaved UV (NV12) or separate U and V planes packed two rows per line (I420).
+  std::string GenerateRGBToYUV420FragmentShader(bool nv12);
+
   std::string GenerateImGuiVertexShader();
   std::string GenerateImGuiFragmentShader();
 
@@ -190,6 +190,25 @@ public:
     Do(data);
   }
 
+  /// Returns a pointer to the next bytes in the state, and skips over them. Only valid when reading, returns nullptr
+  /// if there aren't enough bytes left. Lets the caller compare the data before copying it.
+  const u8* ReadBytesInPlace(size_t count)
+  {
+    if (m_mode != Mode::Read)
+    {
+      m_error = true;
+      return nullptr;
+    }
+
+    m_error = (m_error || (m_pos + count) > m_size);
+    if (m_error) [[unlikely]]
+      return nullptr;
+
+    const u8* ptr = &m_data[m_pos];
+    m_pos += count;
+    return ptr;
+  }
+
   void SkipBytes(size_t count)
   {
     if (m_mode != Mode::Read)
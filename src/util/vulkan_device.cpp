@@ -19,6 +19,7 @@
 #include "common/path.h"
 #include "common/scoped_guard.h"
 #include "common/small_string.h"
+#include "common/threading.h"
 
 #include "fmt/format.h"
 #include "xxhash.h"
@@ -1268,6 +1269,7 @@ void VulkanDevice::WaitForFenceCounter(u64 fence_counter)
 
 void VulkanDevice::WaitForGPUIdle()
 {
+  WaitForSubmitThread();
   vkDeviceWaitIdle(m_device);
 }
 
@@ -1286,6 +1288,19 @@ bool VulkanDevice::SetGPUTimingEnabled(bool enabled)
 
 void VulkanDevice::WaitForCommandBufferCompletion(u32 index)
 {
+  // The fence can't be waited on until the submit thread has actually submitted it. Only one submission can be in
+  // flight on the thread, so anything older has been submitted already, and we can go straight to the fence.
+  if (m_submit_thread.joinable())
+  {
+    std::unique_lock lock(m_submit_mutex);
+    if (m_submit_queued && m_queued_submit_index == index)
+      m_submit_done_cv.wait(lock, [this]() { return !m_submit_queued; });
+    if (m_submit_failed) [[unlikely]]
+    {
+      m_submit_failed = false;
+      m_device_was_lost = true;
+    }
+  }
   if (m_device_was_lost)
     return;
 
@@ -1393,6 +1408,36 @@ void VulkanDevice::EndAndSubmitCommandBuffer(VulkanSwapChain* present_swap_chain
   // This command buffer now has commands, so can't be re-used without waiting.
   resources.needs_fence_wait = true;
 
+  if (present_swap_chain && !explicit_present && m_submit_thread.joinable())
+  {
+    // Hand the submit and present off to the worker, only one can be in flight at once.
+    WaitForSubmitThread();
+    if (m_device_was_lost) [[unlikely]]
+      return;
+
+    std::unique_lock lock(m_submit_mutex);
+    m_queued_submit_index = m_current_frame;
+    m_queued_submit_swap_chain = present_swap_chain;
+    m_submit_queued = true;
+    m_submit_cv.notify_one();
+    return;
+  }
+
+  WaitForSubmitThread();
+  if (!SubmitToQueue(m_current_frame, present_swap_chain))
+  {
+    m_device_was_lost = true;
+    return;
+  }
+
+  if (present_swap_chain && !explicit_present)
+    QueuePresent(present_swap_chain);
+}
+
+bool VulkanDevice::SubmitToQueue(u32 index, VulkanSwapChain* present_swap_chain)
+{
+  const CommandBuffer& resources = m_frame_resources[index];
+
   uint32_t wait_bits = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
   VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO,
                               nullptr,
@@ -1415,19 +1460,24 @@ void VulkanDevice::EndAndSubmitCommandBuffer(VulkanSwapChain* present_swap_chain
     submit_info.signalSemaphoreCount = 1;
   }
 
-  res = vkQueueSubmit(m_graphics_queue, 1, &submit_info, resources.fence);
+  const VkResult res = vkQueueSubmit(m_graphics_queue, 1, &submit_info, resources.fence);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkQueueSubmit failed: ");
-    m_device_was_lost = true;
-    return;
+    return false;
   }
 
-  if (present_swap_chain && !explicit_present)
-    QueuePresent(present_swap_chain);
+  return true;
 }
 
 void VulkanDevice::QueuePresent(VulkanSwapChain* present_swap_chain)
+{
+  // VK_ERROR_OUT_OF_DATE_KHR is not fatal, just means we need to recreate our swap chain.
+  if (!PresentToQueue(present_swap_chain))
+    ResizeWindow(0, 0, m_window_info.surface_scale);
+}
+
+bool VulkanDevice::PresentToQueue(VulkanSwapChain* present_swap_chain)
 {
   const VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
                                          nullptr,
@@ -1443,19 +1493,101 @@ void VulkanDevice::QueuePresent(VulkanSwapChain* present_swap_chain)
   const VkResult res = vkQueuePresentKHR(m_present_queue, &present_info);
   if (res != VK_SUCCESS && res != VK_SUBOPTIMAL_KHR)
   {
-    // VK_ERROR_OUT_OF_DATE_KHR is not fatal, just means we need to recreate our swap chain.
     if (res == VK_ERROR_OUT_OF_DATE_KHR)
-      ResizeWindow(0, 0, m_window_info.surface_scale);
-    else
-      LOG_VULKAN_ERROR(res, "vkQueuePresentKHR failed: ");
+      return false;
 
-    return;
+    LOG_VULKAN_ERROR(res, "vkQueuePresentKHR failed: ");
+    return true;
   }
 
   // Grab the next image as soon as possible, that way we spend less time blocked on the next
   // submission. Don't care if it fails, we'll deal with that at the presentation call site.
   // Credit to dxvk for the idea.
   present_swap_chain->AcquireNextImage();
+  return true;
+}
+
+bool VulkanDevice::SetThreadedSubmission(bool enabled)
+{
+  if (enabled == m_submit_thread.joinable())
+    return true;
+
+  if (enabled)
+    StartSubmitThread();
+  else
+    StopSubmitThread();
+
+  return true;
+}
+
+void VulkanDevice::StartSubmitThread()
+{
+  DebugAssert(!m_submit_thread.joinable());
+  INFO_LOG("Starting Vulkan submit thread.");
+
+  m_submit_queued = false;
+  m_submit_failed = false;
+  m_submit_thread_shutdown = false;
+  m_submit_thread = std::thread(&VulkanDevice::SubmitThreadEntryPoint, this);
+}
+
+void VulkanDevice::StopSubmitThread()
+{
+  if (!m_submit_thread.joinable())
+    return;
+
+  WaitForSubmitThread();
+
+  {
+    std::unique_lock lock(m_submit_mutex);
+    m_submit_thread_shutdown = true;
+    m_submit_cv.notify_one();
+  }
+
+  m_submit_thread.join();
+  INFO_LOG("Vulkan submit thread stopped.");
+}
+
+void VulkanDevice::SubmitThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Vulkan Submit");
+
+  std::unique_lock lock(m_submit_mutex);
+  for (;;)
+  {
+    m_submit_cv.wait(lock, [this]() { return m_submit_queued || m_submit_thread_shutdown; });
+    if (!m_submit_queued)
+      break;
+
+    // The CPU thread leaves the queues and this command buffer alone until the submit is done.
+    lock.unlock();
+
+    VulkanSwapChain* const swap_chain = m_queued_submit_swap_chain;
+    bool failed = !SubmitToQueue(m_queued_submit_index, swap_chain);
+
+    // Out of date swap chains are picked up by BeginPresent() when the next acquire fails.
+    if (!failed)
+      PresentToQueue(swap_chain);
+
+    lock.lock();
+    m_submit_failed |= failed;
+    m_submit_queued = false;
+    m_submit_done_cv.notify_one();
+  }
+}
+
+void VulkanDevice::WaitForSubmitThread()
+{
+  if (!m_submit_thread.joinable())
+    return;
+
+  std::unique_lock lock(m_submit_mutex);
+  m_submit_done_cv.wait(lock, [this]() { return !m_submit_queued; });
+  if (m_submit_failed) [[unlikely]]
+  {
+    m_submit_failed = false;
+    m_device_was_lost = true;
+  }
 }
 
 void VulkanDevice::MoveToNextCommandBuffer()
@@ -2047,6 +2179,8 @@ void VulkanDevice::DestroyDevice()
   if (InRenderPass())
     EndRenderPass();
 
+  StopSubmitThread();
+
   // Don't both submitting the current command buffer, just toss it.
   if (m_device != VK_NULL_HANDLE)
     WaitForGPUIdle();
@@ -2353,6 +2487,9 @@ GPUDevice::PresentResult VulkanDevice::BeginPresent(u32 clear_color)
   if (InRenderPass())
     EndRenderPass();
 
+  // The previous present may still be acquiring the next image.
+  WaitForSubmitThread();
+
   if (m_device_was_lost) [[unlikely]]
     return PresentResult::DeviceLost;
 
@@ -2426,6 +2563,7 @@ void VulkanDevice::SubmitPresent()
   if (m_device_was_lost) [[unlikely]]
     return;
 
+  WaitForSubmitThread();
   QueuePresent(m_swap_chain.get());
 }
 
@@ -2560,6 +2698,7 @@ void VulkanDevice::SetFeatures(FeatureMask disabled_features, const VkPhysicalDe
   m_features.shader_cache = true;
   m_features.pipeline_cache = true;
   m_features.prefer_unused_textures = true;
+  m_features.threaded_shader_creation = true;
   m_features.raster_order_views =
     (!(disabled_features & FEATURE_MASK_RASTER_ORDER_VIEWS) && vk_features.fragmentStoresAndAtomics &&
      m_optional_extensions.vk_ext_fragment_shader_interlock);
@@ -3078,6 +3217,7 @@ void VulkanDevice::DestroyPersistentDescriptorSets()
 
 void VulkanDevice::RenderBlankFrame()
 {
+  WaitForSubmitThread();
   VkResult res = m_swap_chain->AcquireNextImage();
   if (res != VK_SUCCESS)
   {
@@ -17,7 +17,9 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -138,6 +140,8 @@ public:
   bool SetGPUTimingEnabled(bool enabled) override;
   float GetAndResetAccumulatedGPUTime() override;
 
+  bool SetThreadedSubmission(bool enabled) override;
+
   void SetVSyncMode(GPUVSyncMode mode, bool allow_present_throttle) override;
 
   PresentResult BeginPresent(u32 clear_color) override;
@@ -387,8 +391,18 @@ private:
   void BeginCommandBuffer(u32 index);
   void WaitForCommandBufferCompletion(u32 index);
   void EndAndSubmitCommandBuffer(VulkanSwapChain* present_swap_chain, bool explicit_present);
+  bool SubmitToQueue(u32 index, VulkanSwapChain* present_swap_chain);
   void MoveToNextCommandBuffer();
   void QueuePresent(VulkanSwapChain* present_swap_chain);
+  bool PresentToQueue(VulkanSwapChain* present_swap_chain);
+
+  void StartSubmitThread();
+  void StopSubmitThread();
+  void SubmitThreadEntryPoint();
+
+  /// Blocks until the submit thread has finished with the last queued command buffer.
+  /// Must be called before touching the queue or swap chain from the CPU thread.
+  void WaitForSubmitThread();
 
   VkInstance m_instance = VK_NULL_HANDLE;
   VkPhysicalDevice m_physical_device = VK_NULL_HANDLE;
@@ -415,6 +429,17 @@ private:
 
   bool m_device_was_lost = false;
 
+  // Threaded submission: the CPU thread records, the submit thread calls vkQueueSubmit() and vkQueuePresentKHR().
+  std::thread m_submit_thread;
+  std::mutex m_submit_mutex;
+  std::condition_variable m_submit_cv;
+  std::condition_variable m_submit_done_cv;
+  VulkanSwapChain* m_queued_submit_swap_chain = nullptr;
+  u32 m_queued_submit_index = 0;
+  bool m_submit_queued = false;
+  bool m_submit_failed = false;
+  bool m_submit_thread_shutdown = false;
+
   std::unordered_map<RenderPassCacheKey, VkRenderPass, RenderPassCacheKeyHash> m_render_pass_cache;
   GPUFramebufferManager<VkFramebuffer, CreateFramebuffer, DestroyFramebuffer> m_framebuffer_manager;
   VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;